@@ -11,6 +11,7 @@
 #include "core/core.h"
 #include "core/hle/kernel/writable_event.h"
 #include "core/memory.h"
+#include "core/perf_stats.h"
 
 namespace AudioCore {
 
@@ -349,6 +350,8 @@ void AudioRenderer::QueueMixedBuffer(Buffer::Tag tag) {
 }
 
 void AudioRenderer::ReleaseAndQueueBuffers() {
+    Core::PerfStats::ScopedTimer timer{Core::System::GetInstance().GetPerfStats(),
+                                       Core::PerfSubsystem::Audio};
     const auto released_buffers{audio_out->GetTagsAndReleaseBuffers(stream, 2)};
     for (const auto& tag : released_buffers) {
         QueueMixedBuffer(tag);
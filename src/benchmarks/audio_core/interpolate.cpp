@@ -0,0 +1,30 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include "audio_core/algorithm/interpolate.h"
+#include "benchmarks/benchmark.h"
+
+TEST_CASE("AudioCore::Interpolate", "[audio_core]") {
+    // One audio renderer update worth of interleaved stereo samples
+    constexpr std::size_t NUM_FRAMES = 240;
+
+    const auto data = Benchmark::GenerateData(NUM_FRAMES * 2 * sizeof(s16));
+    std::vector<s16> samples(NUM_FRAMES * 2);
+    std::memcpy(samples.data(), data.data(), data.size());
+
+    // Resampling of 32kHz voices and of the 48kHz mix to a 44.1kHz device
+    for (const u32 input_rate : {32000, 48000}) {
+        const u32 output_rate = input_rate == 48000 ? 44100 : 48000;
+        AudioCore::InterpolationState state;
+        Benchmark::Run(fmt::format("AudioCore::Interpolate {} Hz to {} Hz", input_rate,
+                                   output_rate),
+                       data.size(), [&] {
+                           Benchmark::DoNotOptimize(
+                               AudioCore::Interpolate(state, samples, input_rate, output_rate));
+                       });
+    }
+}
@@ -0,0 +1,48 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <iostream>
+#include <random>
+#include <fmt/format.h>
+#include "benchmarks/benchmark.h"
+
+namespace Benchmark {
+
+std::vector<u8> GenerateData(std::size_t size, u32 seed) {
+    // The distributions of the standard library are implementation defined, only use the engine
+    std::mt19937 engine{seed};
+    std::vector<u8> data(size);
+    for (auto& byte : data) {
+        byte = static_cast<u8>(engine());
+    }
+    return data;
+}
+
+std::vector<u8> GenerateCompressibleData(std::size_t size, u32 seed) {
+    std::mt19937 engine{seed};
+    std::vector<u8> data;
+    data.reserve(size);
+    while (data.size() < size) {
+        const u32 random = engine();
+        const std::size_t run_length =
+            std::min<std::size_t>(1 + (random >> 28), size - data.size());
+        data.insert(data.end(), run_length, static_cast<u8>(random & 0x1F));
+    }
+    return data;
+}
+
+void Report(const std::string& name, const Result& result, std::size_t bytes_per_iteration) {
+    std::string throughput;
+    if (bytes_per_iteration != 0) {
+        const double seconds = std::chrono::duration<double>(result.median).count();
+        throughput = fmt::format("{:10.1f} MiB/s", bytes_per_iteration / seconds / (1 << 20));
+    }
+
+    std::cout << fmt::format("{:<48} {:>12} ns {:>12} ns min {:>10} iters {}", name,
+                             result.median.count(), result.min.count(), result.iterations,
+                             throughput)
+              << std::endl;
+}
+
+} // namespace Benchmark
@@ -0,0 +1,93 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Benchmark {
+
+/// Timings of a benchmarked function, per iteration
+struct Result {
+    std::size_t iterations;
+    std::chrono::nanoseconds median;
+    std::chrono::nanoseconds min;
+};
+
+/// Prevents the compiler from optimizing away the computation of a value
+template <typename T>
+void DoNotOptimize(const T& value) {
+#ifdef _MSC_VER
+    static const void* volatile sink;
+    sink = &value;
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/**
+ * Generates data that is identical on every run and host.
+ * @param seed Seed of the generator, fixtures with different seeds hold different data
+ */
+std::vector<u8> GenerateData(std::size_t size, u32 seed = 0);
+
+/**
+ * Generates data compressing like typical game assets, with runs of repeated bytes and a small
+ * alphabet instead of uniformly random bytes.
+ */
+std::vector<u8> GenerateCompressibleData(std::size_t size, u32 seed = 0);
+
+/// Prints the timings of a benchmark, with the throughput if it processes bytes_per_iteration
+void Report(const std::string& name, const Result& result, std::size_t bytes_per_iteration);
+
+/**
+ * Times a function and prints its timings.
+ *
+ * The function is called once to warm up caches and lazily initialized state. The number of
+ * iterations per sample is then doubled until a sample takes at least a few milliseconds, and the
+ * median and minimum of a fixed number of samples is reported. The median is robust against
+ * scheduling noise, the minimum estimates the cost without interference.
+ *
+ * @param name Name of the benchmark
+ * @param bytes_per_iteration Bytes processed by each call of func, zero to not report throughput
+ * @param func Function to benchmark
+ */
+template <typename Func>
+Result Run(const std::string& name, std::size_t bytes_per_iteration, Func&& func) {
+    using Clock = std::chrono::steady_clock;
+    constexpr std::size_t NUM_SAMPLES = 15;
+    constexpr std::chrono::milliseconds MIN_SAMPLE_TIME{10};
+
+    const auto run_sample = [&func](std::size_t iterations) {
+        const auto begin = Clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            func();
+        }
+        return Clock::now() - begin;
+    };
+
+    func();
+
+    std::size_t iterations = 1;
+    while (run_sample(iterations) < MIN_SAMPLE_TIME) {
+        iterations *= 2;
+    }
+
+    std::vector<std::chrono::nanoseconds> samples;
+    for (std::size_t sample = 0; sample < NUM_SAMPLES; ++sample) {
+        samples.push_back(run_sample(iterations) / iterations);
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const Result result{iterations, samples[NUM_SAMPLES / 2], samples.front()};
+    Report(name, result, bytes_per_iteration);
+    return result;
+}
+
+} // namespace Benchmark
@@ -0,0 +1,19 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include "benchmarks/benchmark.h"
+#include "common/cityhash.h"
+
+TEST_CASE("CityHash64", "[common]") {
+    // Shader programs, constant buffers and texture uploads respectively
+    for (const std::size_t size : {0x100, 0x2000, 0x100000}) {
+        const auto data = Benchmark::GenerateData(size);
+        Benchmark::Run(fmt::format("CityHash64 {} bytes", size), size, [&data] {
+            Benchmark::DoNotOptimize(
+                Common::CityHash64(reinterpret_cast<const char*>(data.data()), data.size()));
+        });
+    }
+}
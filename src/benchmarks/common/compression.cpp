@@ -0,0 +1,48 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+#include "benchmarks/benchmark.h"
+#include "common/lz4_compression.h"
+#include "common/zstd_compression.h"
+
+namespace {
+
+// Size of a typical entry of the shader disk cache
+constexpr std::size_t DATA_SIZE = 0x40000;
+
+} // Anonymous namespace
+
+TEST_CASE("LZ4", "[common]") {
+    const auto data = Benchmark::GenerateCompressibleData(DATA_SIZE);
+
+    Benchmark::Run("LZ4 compress", DATA_SIZE, [&data] {
+        Benchmark::DoNotOptimize(Common::Compression::CompressDataLZ4(data.data(), data.size()));
+    });
+    Benchmark::Run("LZ4 HC compress", DATA_SIZE, [&data] {
+        Benchmark::DoNotOptimize(
+            Common::Compression::CompressDataLZ4HC(data.data(), data.size(), 9));
+    });
+
+    const auto compressed = Common::Compression::CompressDataLZ4(data.data(), data.size());
+    REQUIRE(Common::Compression::DecompressDataLZ4(compressed, data.size()) == data);
+    Benchmark::Run("LZ4 decompress", DATA_SIZE, [&compressed] {
+        Benchmark::DoNotOptimize(Common::Compression::DecompressDataLZ4(compressed, DATA_SIZE));
+    });
+}
+
+TEST_CASE("Zstandard", "[common]") {
+    const auto data = Benchmark::GenerateCompressibleData(DATA_SIZE);
+
+    Benchmark::Run("Zstandard compress", DATA_SIZE, [&data] {
+        Benchmark::DoNotOptimize(
+            Common::Compression::CompressDataZSTDDefault(data.data(), data.size()));
+    });
+
+    const auto compressed = Common::Compression::CompressDataZSTDDefault(data.data(), data.size());
+    REQUIRE(Common::Compression::DecompressDataZSTD(compressed) == data);
+    Benchmark::Run("Zstandard decompress", DATA_SIZE, [&compressed] {
+        Benchmark::DoNotOptimize(Common::Compression::DecompressDataZSTD(compressed));
+    });
+}
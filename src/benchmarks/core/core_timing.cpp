@@ -0,0 +1,58 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <catch2/catch.hpp>
+#include "benchmarks/benchmark.h"
+#include "core/core_timing.h"
+
+namespace {
+
+u64 callback_count = 0;
+
+void Callback(u64 userdata, s64 cycles_late) {
+    ++callback_count;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("CoreTiming", "[core]") {
+    // About as many event types as a running title has registered
+    constexpr std::size_t NUM_EVENT_TYPES = 32;
+    constexpr std::size_t NUM_EVENTS = 1000;
+
+    Core::Timing::CoreTiming core_timing;
+    core_timing.Initialize();
+
+    std::array<Core::Timing::EventType*, NUM_EVENT_TYPES> event_types;
+    for (std::size_t i = 0; i < event_types.size(); ++i) {
+        event_types[i] = core_timing.RegisterEvent("Benchmark" + std::to_string(i), Callback);
+    }
+    core_timing.Advance();
+
+    Benchmark::Run("CoreTiming schedule and unschedule 1000 events", 0, [&] {
+        for (std::size_t i = 0; i < NUM_EVENTS; ++i) {
+            core_timing.ScheduleEvent(static_cast<s64>((i * 7919) % 20000),
+                                      event_types[i % NUM_EVENT_TYPES], i);
+        }
+        for (std::size_t i = 0; i < NUM_EVENTS; ++i) {
+            core_timing.UnscheduleEvent(event_types[i % NUM_EVENT_TYPES], i);
+        }
+    });
+
+    Benchmark::Run("CoreTiming schedule and advance 1000 events", 0, [&] {
+        callback_count = 0;
+        for (std::size_t i = 0; i < NUM_EVENTS; ++i) {
+            core_timing.ScheduleEvent(static_cast<s64>(1 + (i * 7919) % 20000),
+                                      event_types[i % NUM_EVENT_TYPES], i);
+        }
+        // Pretend the CPU executes exactly up to the next event every slice
+        while (callback_count < NUM_EVENTS) {
+            core_timing.AddTicks(core_timing.GetDowncount());
+            core_timing.Advance();
+        }
+    });
+
+    core_timing.Shutdown();
+}
@@ -0,0 +1,36 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include "benchmarks/benchmark.h"
+#include "core/crypto/ctr_encryption_layer.h"
+#include "core/file_sys/vfs_vector.h"
+
+TEST_CASE("CTREncryptionLayer::Read", "[core]") {
+    constexpr std::size_t FILE_SIZE = 0x400000;
+
+    const auto data = Benchmark::GenerateData(FILE_SIZE);
+    Core::Crypto::Key128 key{};
+    for (std::size_t i = 0; i < key.size(); ++i) {
+        key[i] = static_cast<u8>(i);
+    }
+
+    Core::Crypto::CTREncryptionLayer layer{std::make_shared<FileSys::VectorVfsFile>(data), key, 0};
+    layer.SetIV(std::vector<u8>(0x10));
+
+    std::vector<u8> out(FILE_SIZE);
+    // Sector aligned and unaligned reads, as done by RomFS and NCA section parsing
+    for (const std::size_t read_size : {0x200, 0x4000, 0x4001}) {
+        Benchmark::Run(fmt::format("CTREncryptionLayer::Read {} bytes", read_size), FILE_SIZE,
+                       [&layer, &out, read_size] {
+                           for (std::size_t offset = 0; offset + read_size <= FILE_SIZE;
+                                offset += read_size) {
+                               layer.Read(out.data() + offset, read_size, offset);
+                           }
+                           Benchmark::DoNotOptimize(out);
+                       });
+    }
+}
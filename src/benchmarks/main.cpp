@@ -0,0 +1,9 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+// Every benchmark is a Catch test case, so they can be selected by name or tag on the command
+// line, e.g. `benchmarks [video_core]`.
@@ -0,0 +1,103 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "benchmarks/benchmark.h"
+#include "core/core.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/macro_interpreter.h"
+#include "video_core/memory_manager.h"
+#include "video_core/rasterizer_interface.h"
+
+namespace {
+
+/// Rasterizer ignoring all requests, macros in the benchmark only write registers
+class NullRasterizer final : public VideoCore::RasterizerInterface {
+public:
+    void DrawArrays() override {}
+    void Clear() override {}
+    void DispatchCompute(GPUVAddr code_addr) override {}
+    void FlushAll() override {}
+    void FlushRegion(CacheAddr addr, u64 size) override {}
+    void InvalidateRegion(CacheAddr addr, u64 size) override {}
+    void FlushAndInvalidateRegion(CacheAddr addr, u64 size) override {}
+    void FlushCommands() override {}
+    void TickFrame() override {}
+};
+
+constexpr u32 AddImmediate(u32 result_operation, u32 dst, u32 src_a, s32 immediate,
+                           bool is_exit = false) {
+    return 1 | (result_operation << 4) | (static_cast<u32>(is_exit) << 7) | (dst << 8) |
+           (src_a << 11) | ((static_cast<u32>(immediate) & 0x3FFFF) << 14);
+}
+
+constexpr u32 BranchNotZero(u32 src_a, s32 target) {
+    // Annulled, so the branch has no delay slot
+    return 7 | (1 << 4) | (1 << 5) | (src_a << 11) | ((static_cast<u32>(target) & 0x3FFFF) << 14);
+}
+
+constexpr u32 RESULT_MOVE = 1;
+constexpr u32 RESULT_MOVE_AND_SET_METHOD = 2;
+constexpr u32 RESULT_MOVE_AND_SEND = 4;
+constexpr u32 RESULT_IGNORE_AND_FETCH = 0;
+
+} // Anonymous namespace
+
+TEST_CASE("MacroInterpreter::Execute", "[video_core]") {
+    using Tegra::Engines::Maxwell3D;
+    constexpr u32 NUM_ATTRIBUTES = Maxwell3D::Regs::NumVertexAttributes;
+
+    auto& system = Core::System::GetInstance();
+    NullRasterizer rasterizer;
+    Tegra::MemoryManager memory_manager{system, rasterizer};
+    auto maxwell3d = std::make_unique<Maxwell3D>(system, rasterizer, memory_manager);
+
+    // Writes its parameters to consecutive vertex attribute formats, the shape of the state
+    // setting macros games call between draws:
+    //     method = vertex_attrib_format, increment 1
+    //   loop:
+    //     r2 = fetch
+    //     send r2
+    //     r1 = r1 - 1
+    //     branch loop if r1 != 0
+    //     exit
+    const u32 method = MAXWELL3D_REG_INDEX(vertex_attrib_format) | (1 << 12);
+    const std::array<u32, 7> code{
+        AddImmediate(RESULT_MOVE_AND_SET_METHOD, 0, 0, static_cast<s32>(method)),
+        AddImmediate(RESULT_IGNORE_AND_FETCH, 2, 0, 0),
+        AddImmediate(RESULT_MOVE_AND_SEND, 0, 2, 0),
+        AddImmediate(RESULT_MOVE, 1, 1, -1),
+        BranchNotZero(1, -3),
+        AddImmediate(RESULT_MOVE, 0, 0, 0, true),
+        AddImmediate(RESULT_MOVE, 0, 0, 0),
+    };
+
+    maxwell3d->regs.macros.upload_address = 0;
+    for (const u32 word : code) {
+        maxwell3d->CallMethod({MAXWELL3D_REG_INDEX(macros.data), word});
+    }
+
+    // The first parameter is the number of attributes, followed by one format per attribute
+    std::vector<u32> parameters{NUM_ATTRIBUTES};
+    for (u32 i = 0; i < NUM_ATTRIBUTES; ++i) {
+        parameters.push_back(i << 7);
+    }
+
+    Tegra::MacroInterpreter interpreter{*maxwell3d};
+    u32 round = 0;
+    Benchmark::Run("MacroInterpreter::Execute 32 register writes", 0, [&] {
+        // Change the values every round so the writes are not filtered as redundant
+        ++round;
+        for (u32 i = 1; i <= NUM_ATTRIBUTES; ++i) {
+            parameters[i] = (parameters[i] & ~1U) | (round & 1);
+        }
+        interpreter.Execute(0, parameters);
+    });
+
+    REQUIRE(maxwell3d->regs.vertex_attrib_format[NUM_ATTRIBUTES - 1].hex ==
+            ((NUM_ATTRIBUTES - 1) << 7 | (round & 1)));
+}
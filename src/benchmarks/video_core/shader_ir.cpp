@@ -0,0 +1,78 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include "benchmarks/benchmark.h"
+#include "video_core/shader/shader_ir.h"
+
+namespace {
+
+using VideoCommon::Shader::ProgramCode;
+using VideoCommon::Shader::ShaderIR;
+
+/// Offset of the first instruction, after the shader program header
+constexpr u32 MAIN_OFFSET = 10;
+
+// Every fourth word is scheduling information instead of an instruction
+constexpr u64 SCHED = 0x001F8000FC0007E0ULL;
+constexpr u64 EXIT = 0xE30000000007000FULL;
+// Branch to itself, padding the end of every program
+constexpr u64 SELF_BRANCH = 0xE2400FFFFF87000FULL;
+
+/// MOV32I Rd, imm
+constexpr u64 Mov32Imm(u32 dst, u32 imm) {
+    return 0x010000000007F000ULL | (static_cast<u64>(imm) << 20) | dst;
+}
+
+/// FADD Rd, Ra, Rb
+constexpr u64 FaddReg(u32 dst, u32 src_a, u32 src_b) {
+    return 0x5C58000000070000ULL | (static_cast<u64>(src_b) << 20) | (src_a << 8) | dst;
+}
+
+/// FMUL Rd, Ra, Rb
+constexpr u64 FmulReg(u32 dst, u32 src_a, u32 src_b) {
+    return 0x5C68000000070000ULL | (static_cast<u64>(src_b) << 20) | (src_a << 8) | dst;
+}
+
+/**
+ * Builds a straight line arithmetic program shaped like the bulk of a game's fragment shader.
+ * @param num_instructions Number of instructions before the final EXIT
+ */
+ProgramCode BuildProgram(std::size_t num_instructions) {
+    ProgramCode code(MAIN_OFFSET);
+    std::size_t emitted = 0;
+    while (emitted <= num_instructions) {
+        if ((code.size() - MAIN_OFFSET) % 4 == 0) {
+            code.push_back(SCHED);
+            continue;
+        }
+
+        const u32 dst = static_cast<u32>(emitted % 16);
+        const u32 src = static_cast<u32>((emitted + 5) % 16);
+        if (emitted == num_instructions) {
+            code.push_back(EXIT);
+        } else if (emitted < 16) {
+            code.push_back(Mov32Imm(dst, 0x3F800000));
+        } else {
+            code.push_back(emitted % 2 == 0 ? FaddReg(dst, src, dst) : FmulReg(dst, src, dst));
+        }
+        ++emitted;
+    }
+    code.push_back(SELF_BRANCH);
+    return code;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ShaderIR", "[video_core]") {
+    for (const std::size_t num_instructions : {64, 512, 4096}) {
+        const ProgramCode code = BuildProgram(num_instructions);
+        const std::size_t size = code.size() * sizeof(u64);
+        Benchmark::Run(fmt::format("ShaderIR {} instructions", num_instructions), size, [&] {
+            const ShaderIR ir(code, MAIN_OFFSET, size);
+            Benchmark::DoNotOptimize(ir.GetBasicBlocks());
+        });
+    }
+}
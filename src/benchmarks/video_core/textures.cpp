@@ -0,0 +1,81 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstring>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include "benchmarks/benchmark.h"
+#include "video_core/textures/astc.h"
+#include "video_core/textures/decoders.h"
+
+TEST_CASE("Tegra::Texture::UnswizzleTexture", "[video_core]") {
+    constexpr u32 WIDTH = 1024;
+    constexpr u32 HEIGHT = 1024;
+    // Block dimensions are stored as log2 of the number of GOBs
+    constexpr u32 BLOCK_HEIGHT = 4;
+    constexpr u32 BLOCK_DEPTH = 0;
+    constexpr u32 WIDTH_SPACING = 1;
+
+    // RGBA8 render targets and BC1 compressed textures, in blocks of 16 GOBs
+    for (const u32 bytes_per_pixel : {4, 8}) {
+        const u32 tile_size = bytes_per_pixel == 8 ? 4 : 1;
+        const std::size_t size = WIDTH * HEIGHT * bytes_per_pixel / (tile_size * tile_size);
+
+        auto swizzled = Benchmark::GenerateData(size);
+        std::vector<u8> unswizzled(size);
+        Benchmark::Run(fmt::format("UnswizzleTexture {}x{} {} bytes per block", WIDTH, HEIGHT,
+                                   bytes_per_pixel),
+                       size, [&] {
+                           Tegra::Texture::UnswizzleTexture(
+                               unswizzled.data(), swizzled.data(), tile_size, tile_size,
+                               bytes_per_pixel, WIDTH, HEIGHT, 1, BLOCK_HEIGHT, BLOCK_DEPTH,
+                               WIDTH_SPACING);
+                           Benchmark::DoNotOptimize(unswizzled);
+                       });
+    }
+}
+
+TEST_CASE("Tegra::Texture::ASTC::Decompress", "[video_core]") {
+    constexpr u32 WIDTH = 256;
+    constexpr u32 HEIGHT = 256;
+
+    // The decoder asserts on blocks it does not support, so the texture is tiled with blocks that
+    // are known to decode. They cover single and multiple partitions and several weight grids.
+    constexpr std::array<std::array<u64, 2>, 16> BLOCKS{{
+        {0xF96CEC29152F315EULL, 0xF21C90A65110238EULL},
+        {0x34F04A437485A441ULL, 0xCF4E9CC870BB0834ULL},
+        {0x610AEF12F243B251ULL, 0x5103B6A553DC5A1EULL},
+        {0x1CFDCE77F969470FULL, 0x6751E92853677B28ULL},
+        {0x616419299259814DULL, 0x201F35733872C817ULL},
+        {0x1A788A0C1B37A30EULL, 0x7403205DDF72848AULL},
+        {0x13F7B98F50123B2EULL, 0xC7821865BC98F297ULL},
+        {0xE2D68281754F298DULL, 0x82897DF22ECDC9BBULL},
+        {0x0D8252C7169CEC12ULL, 0x0AFE3C5581CDDDC3ULL},
+        {0xF232342BD8416D5DULL, 0x1E40259FEE3A6DDCULL},
+        {0x23F1B3C562F2A71DULL, 0x40CBF4FFD54D7CECULL},
+        {0x7B23B1332933E9BFULL, 0x72E9F370A5CEEC9BULL},
+        {0xE5B74CD7C90AA13DULL, 0xB93F5C4C212C909EULL},
+        {0xD0AF996790E1599DULL, 0xCB1076CB904CAFB6ULL},
+        {0xC5E4136035A2AF1FULL, 0xAA99C492C86A7BCBULL},
+        {0x7F95E52B66A4858DULL, 0x953C9427492E68D8ULL},
+    }};
+
+    for (const u32 block_size : {4, 8}) {
+        const std::size_t num_blocks = (WIDTH / block_size) * (HEIGHT / block_size);
+        std::vector<u8> data(num_blocks * sizeof(BLOCKS[0]));
+        for (std::size_t i = 0; i < num_blocks; ++i) {
+            std::memcpy(&data[i * sizeof(BLOCKS[0])], BLOCKS[i % BLOCKS.size()].data(),
+                        sizeof(BLOCKS[0]));
+        }
+
+        Benchmark::Run(fmt::format("ASTC::Decompress {}x{} {}x{} blocks", WIDTH, HEIGHT,
+                                   block_size, block_size),
+                       WIDTH * HEIGHT * 4, [&] {
+                           Benchmark::DoNotOptimize(Tegra::Texture::ASTC::Decompress(
+                               data.data(), WIDTH, HEIGHT, 1, block_size, block_size));
+                       });
+    }
+}
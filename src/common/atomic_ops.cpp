@@ -0,0 +1,36 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include "common/atomic_ops.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Common {
+
+#ifdef _MSC_VER
+
+bool AtomicCompareAndSwap(volatile u64* pointer, u128 value, u128 expected) {
+    return _InterlockedCompareExchange128(reinterpret_cast<volatile __int64*>(pointer),
+                                          static_cast<__int64>(value[1]),
+                                          static_cast<__int64>(value[0]),
+                                          reinterpret_cast<__int64*>(expected.data())) != 0;
+}
+
+#else
+
+bool AtomicCompareAndSwap(volatile u64* pointer, u128 value, u128 expected) {
+    unsigned __int128 value_a;
+    unsigned __int128 expected_a;
+    std::memcpy(&value_a, value.data(), sizeof(u128));
+    std::memcpy(&expected_a, expected.data(), sizeof(u128));
+    return __sync_bool_compare_and_swap(reinterpret_cast<volatile unsigned __int128*>(pointer),
+                                        expected_a, value_a);
+}
+
+#endif
+
+} // namespace Common
@@ -0,0 +1,76 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "common/common_types.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Common {
+
+/**
+ * Atomically replaces the value at a plain, naturally aligned host pointer if it still holds the
+ * expected value. This is used on guest memory, which can't be declared as std::atomic.
+ * @returns true if the value was replaced
+ */
+#ifdef _MSC_VER
+
+inline bool AtomicCompareAndSwap(volatile u8* pointer, u8 value, u8 expected) {
+    const char result = _InterlockedCompareExchange8(reinterpret_cast<volatile char*>(pointer),
+                                                     static_cast<char>(value),
+                                                     static_cast<char>(expected));
+    return static_cast<u8>(result) == expected;
+}
+
+inline bool AtomicCompareAndSwap(volatile u16* pointer, u16 value, u16 expected) {
+    const short result = _InterlockedCompareExchange16(reinterpret_cast<volatile short*>(pointer),
+                                                       static_cast<short>(value),
+                                                       static_cast<short>(expected));
+    return static_cast<u16>(result) == expected;
+}
+
+inline bool AtomicCompareAndSwap(volatile u32* pointer, u32 value, u32 expected) {
+    const long result = _InterlockedCompareExchange(reinterpret_cast<volatile long*>(pointer),
+                                                    static_cast<long>(value),
+                                                    static_cast<long>(expected));
+    return static_cast<u32>(result) == expected;
+}
+
+inline bool AtomicCompareAndSwap(volatile u64* pointer, u64 value, u64 expected) {
+    const __int64 result = _InterlockedCompareExchange64(
+        reinterpret_cast<volatile __int64*>(pointer), static_cast<__int64>(value),
+        static_cast<__int64>(expected));
+    return static_cast<u64>(result) == expected;
+}
+
+#else
+
+inline bool AtomicCompareAndSwap(volatile u8* pointer, u8 value, u8 expected) {
+    return __sync_bool_compare_and_swap(pointer, expected, value);
+}
+
+inline bool AtomicCompareAndSwap(volatile u16* pointer, u16 value, u16 expected) {
+    return __sync_bool_compare_and_swap(pointer, expected, value);
+}
+
+inline bool AtomicCompareAndSwap(volatile u32* pointer, u32 value, u32 expected) {
+    return __sync_bool_compare_and_swap(pointer, expected, value);
+}
+
+inline bool AtomicCompareAndSwap(volatile u64* pointer, u64 value, u64 expected) {
+    return __sync_bool_compare_and_swap(pointer, expected, value);
+}
+
+#endif
+
+/**
+ * 128-bit variant, the pointer has to be aligned to 16 bytes. It is out of line because on x86-64
+ * only its translation unit is built with cmpxchg16b enabled.
+ */
+bool AtomicCompareAndSwap(volatile u64* pointer, u128 value, u128 expected);
+
+} // namespace Common
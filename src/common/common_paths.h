@@ -45,6 +45,7 @@
 #define LOGGER_CONFIG "logger.ini"
 // Files in the directory returned by GetUserPath(UserPath::LogDir)
 #define LOG_FILE "yuzu_log.txt"
+#define COMPRESSED_LOG_FILE "yuzu_log"
 
 // Sys files
 #define SHARED_FONT "shared_font.bin"
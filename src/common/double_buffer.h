@@ -0,0 +1,70 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <type_traits>
+#include "common/common_types.h"
+
+namespace Common {
+
+/**
+ * Lock-free double buffered value with a single writer and any number of readers.
+ *
+ * The writer always modifies the buffer that is not currently published and then publishes it, so
+ * readers never wait on the writer. The sequence counter is bumped once when the writer starts
+ * writing a buffer and once more when it is published, which lets a reader detect that the buffer
+ * it copied was reused by the writer in the meantime and retry.
+ */
+template <typename T>
+class DoubleBuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+
+public:
+    DoubleBuffer() = default;
+    explicit DoubleBuffer(const T& initial_value) : buffers{initial_value, initial_value} {}
+
+    /**
+     * Modifies a copy of the published value and publishes it. Must only be called by the writer.
+     * @param func Callable taking a reference to the value to modify
+     */
+    template <typename Func>
+    void Modify(Func&& func) {
+        const u32 current = sequence.load(std::memory_order_relaxed);
+        const u32 published_index = (current / 2) % 2;
+        sequence.store(current + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        T& next = buffers[published_index ^ 1];
+        next = buffers[published_index];
+        func(next);
+        sequence.store(current + 2, std::memory_order_release);
+    }
+
+    /// Publishes a new value. Must only be called by the writer.
+    void Publish(const T& value) {
+        Modify([&value](T& next) { next = value; });
+    }
+
+    /// Returns a consistent copy of the most recently published value
+    T Read() const {
+        while (true) {
+            const u32 begin = sequence.load(std::memory_order_acquire);
+            const T value = buffers[(begin / 2) % 2];
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // The copied buffer is only reused once the writer starts the second publish after it
+            if (sequence.load(std::memory_order_relaxed) - (begin & ~1U) < 3) {
+                return value;
+            }
+        }
+    }
+
+private:
+    std::array<T, 2> buffers{};
+    std::atomic<u32> sequence{0};
+};
+
+} // namespace Common
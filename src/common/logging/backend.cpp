@@ -5,11 +5,14 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
-#include <climits>
 #include <condition_variable>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
+#include <utility>
 #include <vector>
 #ifdef _WIN32
 #include <share.h>   // For _SH_DENYWR
@@ -17,15 +20,150 @@
 #else
 #define _SH_DENYWR 0
 #endif
+#include "common/alignment.h"
 #include "common/assert.h"
+#include "common/common_funcs.h"
 #include "common/logging/backend.h"
 #include "common/logging/log.h"
 #include "common/logging/text_formatter.h"
 #include "common/string_util.h"
-#include "common/threadsafe_queue.h"
+#include "common/zstd_compression.h"
 
 namespace Log {
 
+namespace {
+
+/// Fixed-size part of a log record, followed by its encoded arguments
+struct RecordHeader {
+    /// Steady clock timestamp of the message, in nanoseconds
+    s64 timestamp_ns;
+    const char* filename;
+    const char* function;
+    /// Format string of the message, nullptr if the record only pads the end of the ring
+    const char* format;
+    /// Total size of the record, including this header
+    u32 size;
+    u32 line_num;
+    Class log_class;
+    Level log_level;
+    u8 num_args;
+};
+
+/**
+ * Single producer, single consumer ring of log records. Each thread writes its messages into its
+ * own ring, which is drained by the logging thread.
+ */
+class LogRing {
+public:
+    static constexpr std::size_t SIZE = 512 * 1024;
+    static constexpr std::size_t ALIGNMENT = alignof(RecordHeader);
+
+    /// Reserves contiguous space for a record, returns nullptr if the ring is full
+    u8* Acquire(std::size_t size) {
+        const u64 write = write_pos.load(std::memory_order_relaxed);
+        const u64 read = read_pos.load(std::memory_order_acquire);
+        const std::size_t offset = static_cast<std::size_t>(write % SIZE);
+        const std::size_t tail = SIZE - offset;
+        const std::size_t padding = tail < size ? tail : 0;
+        if (write + padding + size - read > SIZE) {
+            return nullptr;
+        }
+
+        pending_size = padding + size;
+        if (padding == 0) {
+            return buffer.data() + offset;
+        }
+        if (padding >= sizeof(RecordHeader)) {
+            RecordHeader header{};
+            header.size = static_cast<u32>(padding);
+            std::memcpy(buffer.data() + offset, &header, sizeof(header));
+        }
+        return buffer.data();
+    }
+
+    /// Publishes the record reserved by the last call to Acquire
+    void Commit() {
+        const u64 write = write_pos.load(std::memory_order_relaxed);
+        write_pos.store(write + pending_size, std::memory_order_release);
+    }
+
+    /// Returns the oldest record in the ring, or nullptr if the ring is empty
+    const u8* Peek() {
+        while (true) {
+            const u64 read = read_pos.load(std::memory_order_relaxed);
+            if (read == write_pos.load(std::memory_order_acquire)) {
+                return nullptr;
+            }
+
+            const std::size_t offset = static_cast<std::size_t>(read % SIZE);
+            const std::size_t tail = SIZE - offset;
+            if (tail < sizeof(RecordHeader)) {
+                // Too small to hold a padding record, the writer wrapped around implicitly
+                read_pos.store(read + tail, std::memory_order_release);
+                continue;
+            }
+
+            RecordHeader header;
+            std::memcpy(&header, buffer.data() + offset, sizeof(header));
+            if (header.format == nullptr) {
+                read_pos.store(read + header.size, std::memory_order_release);
+                continue;
+            }
+            return buffer.data() + offset;
+        }
+    }
+
+    /// Frees the record returned by the last call to Peek
+    void Release(std::size_t size) {
+        const u64 read = read_pos.load(std::memory_order_relaxed);
+        read_pos.store(read + size, std::memory_order_release);
+    }
+
+    /// Set when the owning thread exits, the ring is destroyed once it has been drained
+    std::atomic_bool is_closed{false};
+
+    /// Level of the record being written, only accessed by the producer
+    Level pending_level{};
+    /// Holds a critical record that didn't fit in the ring, only accessed by the producer
+    std::vector<u8> spill_buffer;
+    /// Set when the record being written is in spill_buffer rather than the ring
+    bool is_spilled = false;
+
+private:
+    std::atomic<u64> write_pos{0};
+    std::atomic<u64> read_pos{0};
+    /// Size of the record being written, only accessed by the producer
+    std::size_t pending_size{0};
+    alignas(ALIGNMENT) std::array<u8, SIZE> buffer;
+};
+
+/// Decoded value of a record argument, kept alive while the record is being formatted
+struct ArgValue {
+    s64 signed_value;
+    u64 unsigned_value;
+    float float_value;
+    double double_value;
+    bool bool_value;
+    char char_value;
+    const void* pointer_value;
+    std::string_view string_value;
+};
+
+template <typename T>
+fmt::basic_format_arg<fmt::format_context> MakeFormatArg(const T& value) {
+    return fmt::format_args{fmt::make_format_args(value)}.get(0);
+}
+
+template <typename T>
+T ReadValue(const u8*& src) {
+    T value;
+    std::memcpy(&value, src, sizeof(value));
+    src += sizeof(value);
+    return value;
+}
+
+} // Anonymous namespace
+
 /**
  * Static state as a singleton.
  */
@@ -39,10 +177,75 @@ public:
     Impl(Impl const&) = delete;
     const Impl& operator=(Impl const&) = delete;
 
-    void PushEntry(Class log_class, Level log_level, const char* filename, unsigned int line_num,
-                   const char* function, std::string message) {
-        message_queue.Push(
-            CreateEntry(log_class, log_level, filename, line_num, function, std::move(message)));
+    u8* BeginRecord(Class log_class, Level log_level, const char* filename, unsigned int line_num,
+                    const char* function, const char* format, std::size_t num_args,
+                    std::size_t args_size) {
+        if (!filter.CheckMessage(log_class, log_level)) {
+            return nullptr;
+        }
+
+        const std::size_t size = Common::AlignUp(sizeof(RecordHeader) + args_size,
+                                                 LogRing::ALIGNMENT);
+        LogRing& ring = GetThreadRing();
+        u8* record = ring.Acquire(size);
+        if (record == nullptr && log_level == Level::Critical) {
+            // Critical messages usually precede a crash and must not be lost. Let the logging
+            // thread make room for them, or write them out from this thread when it can't.
+            WaitForWrite();
+            record = ring.Acquire(size);
+            if (record == nullptr) {
+                ring.spill_buffer.resize(size);
+                ring.is_spilled = true;
+                record = ring.spill_buffer.data();
+            }
+        }
+        if (record == nullptr) {
+            num_dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        ring.pending_level = log_level;
+
+        RecordHeader header;
+        header.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::steady_clock::now().time_since_epoch())
+                                  .count();
+        header.filename = filename;
+        header.function = function;
+        header.format = format;
+        header.size = static_cast<u32>(size);
+        header.line_num = line_num;
+        header.log_class = log_class;
+        header.log_level = log_level;
+        header.num_args = static_cast<u8>(num_args);
+        std::memcpy(record, &header, sizeof(header));
+
+        return record + sizeof(header);
+    }
+
+    void EndRecord() {
+        LogRing& ring = GetThreadRing();
+        if (ring.is_spilled) {
+            ring.is_spilled = false;
+            WriteEntry(DecodeRecord(ring.spill_buffer.data()));
+            return;
+        }
+        ring.Commit();
+
+        if (ring.pending_level == Level::Critical) {
+            // Critical messages usually precede a crash, write them out before returning
+            WaitForWrite();
+            return;
+        }
+        // Only the first record since the logging thread last woke up has to notify it. This has
+        // to be a read-modify-write: a plain load could see the flag before the logging thread
+        // clears it, while the logging thread misses the record committed above.
+        if (!has_new_records.exchange(true, std::memory_order_acq_rel)) {
+            {
+                // Pairs with the predicate check of the logging thread, so the wake up isn't lost
+                std::lock_guard lock{wake_mutex};
+            }
+            wake_cv.notify_one();
+        }
     }
 
     void AddBackend(std::unique_ptr<Backend> backend) {
@@ -76,64 +279,246 @@ public:
     }
 
 private:
+    /// Maximum number of records taken from a single ring at once, so no thread can starve others
+    static constexpr std::size_t MAX_RECORDS_PER_RING = 4096;
+
     Impl() {
         backend_thread = std::thread([&] {
-            Entry entry;
-            auto write_logs = [&](Entry& e) {
-                std::lock_guard lock{writing_mutex};
-                for (const auto& backend : backends) {
-                    backend->Write(e);
-                }
-            };
             while (true) {
-                entry = message_queue.PopWait();
-                if (entry.final_entry) {
-                    break;
+                u64 write_request;
+                {
+                    std::unique_lock lock{wake_mutex};
+                    wake_cv.wait(lock, [this] {
+                        return stop_requested || has_new_records.load(std::memory_order_acquire);
+                    });
+                    if (stop_requested) {
+                        break;
+                    }
+                    // Pairs with the exchange in EndRecord, which makes every record committed
+                    // before the flag was last set visible to the drain below
+                    has_new_records.exchange(false, std::memory_order_acq_rel);
+                    write_request = write_requested;
+                }
+
+                WritePendingEntries(std::numeric_limits<std::size_t>::max());
+
+                {
+                    std::lock_guard lock{wake_mutex};
+                    write_completed = write_request;
                 }
-                write_logs(entry);
+                write_cv.notify_all();
             }
 
-            // Drain the logging queue. Only writes out up to MAX_LOGS_TO_WRITE to prevent a case
+            // Drain the logging rings. Only writes out up to MAX_LOGS_TO_WRITE to prevent a case
             // where a system is repeatedly spamming logs even on close.
-            const int MAX_LOGS_TO_WRITE = filter.IsDebug() ? INT_MAX : 100;
-            int logs_written = 0;
-            while (logs_written++ < MAX_LOGS_TO_WRITE && message_queue.Pop(entry)) {
-                write_logs(entry);
+            const std::size_t MAX_LOGS_TO_WRITE =
+                filter.IsDebug() ? std::numeric_limits<std::size_t>::max() : 100;
+            WritePendingEntries(MAX_LOGS_TO_WRITE);
+
+            {
+                std::lock_guard lock{wake_mutex};
+                write_completed = write_requested;
             }
+            write_cv.notify_all();
         });
     }
 
     ~Impl() {
-        Entry entry;
-        entry.final_entry = true;
-        message_queue.Push(entry);
+        {
+            std::lock_guard lock{wake_mutex};
+            stop_requested = true;
+        }
+        wake_cv.notify_one();
         backend_thread.join();
     }
 
-    Entry CreateEntry(Class log_class, Level log_level, const char* filename, unsigned int line_nr,
-                      const char* function, std::string message) const {
-        using std::chrono::duration_cast;
-        using std::chrono::steady_clock;
+    /// Blocks until the records committed by the calling thread have been written out
+    void WaitForWrite() {
+        if (std::this_thread::get_id() == backend_thread.get_id()) {
+            return;
+        }
+        std::unique_lock lock{wake_mutex};
+        if (stop_requested) {
+            return;
+        }
+        const u64 request = ++write_requested;
+        has_new_records.store(true, std::memory_order_release);
+        wake_cv.notify_one();
+        write_cv.wait(lock, [this, request] { return write_completed >= request; });
+    }
+
+    LogRing& GetThreadRing() {
+        // The ring is owned by the logging thread, which frees it once the owning thread has
+        // exited and all of its records have been written out.
+        struct RingHandle {
+            ~RingHandle() {
+                ring->is_closed.store(true, std::memory_order_release);
+            }
+            LogRing* ring;
+        };
+        thread_local RingHandle handle{[this] {
+            std::lock_guard lock{rings_mutex};
+            return rings.emplace_back(std::make_unique<LogRing>()).get();
+        }()};
+        return *handle.ring;
+    }
+
+    /// Formats and writes out up to max_entries records from all rings, in timestamp order
+    void WritePendingEntries(std::size_t max_entries) {
+        pending_entries.clear();
+        {
+            std::lock_guard lock{rings_mutex};
+            for (const auto& ring : rings) {
+                for (std::size_t i = 0; i < MAX_RECORDS_PER_RING; ++i) {
+                    const u8* const record = ring->Peek();
+                    if (record == nullptr) {
+                        break;
+                    }
+                    pending_entries.push_back(DecodeRecord(record));
+                    ring->Release(reinterpret_cast<const RecordHeader*>(record)->size);
+                }
+            }
+
+            // Closed rings can't receive any more records, free them once they are empty
+            rings.erase(std::remove_if(rings.begin(), rings.end(),
+                                       [](const auto& ring) {
+                                           return ring->is_closed.load(std::memory_order_acquire) &&
+                                                  ring->Peek() == nullptr;
+                                       }),
+                        rings.end());
+        }
+
+        const u64 dropped = num_dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped != 0) {
+            Entry entry;
+            entry.timestamp = pending_entries.empty()
+                                  ? GetTimestamp(std::chrono::steady_clock::now())
+                                  : pending_entries.back().timestamp;
+            entry.log_class = Class::Log;
+            entry.log_level = Level::Warning;
+            entry.filename = Common::TrimSourcePath(__FILE__);
+            entry.line_num = __LINE__;
+            entry.function = __func__;
+            entry.message = fmt::format("Dropped {} log messages, the logging rings were full",
+                                        dropped);
+            pending_entries.push_back(std::move(entry));
+        }
+
+        std::stable_sort(pending_entries.begin(), pending_entries.end(),
+                         [](const Entry& a, const Entry& b) { return a.timestamp < b.timestamp; });
+        if (pending_entries.size() > max_entries) {
+            pending_entries.resize(max_entries);
+        }
+
+        std::lock_guard lock{writing_mutex};
+        for (const auto& entry : pending_entries) {
+            for (const auto& backend : backends) {
+                backend->Write(entry);
+            }
+        }
+    }
+
+    /// Writes out a single entry from the calling thread
+    void WriteEntry(const Entry& entry) {
+        std::lock_guard lock{writing_mutex};
+        for (const auto& backend : backends) {
+            backend->Write(entry);
+        }
+    }
+
+    Entry DecodeRecord(const u8* record) const {
+        RecordHeader header;
+        std::memcpy(&header, record, sizeof(header));
+
+        std::array<ArgValue, Detail::MAX_DEFERRED_ARGS> values;
+        std::array<fmt::basic_format_arg<fmt::format_context>, Detail::MAX_DEFERRED_ARGS> args;
+        const u8* src = record + sizeof(header);
+        for (std::size_t i = 0; i < header.num_args; ++i) {
+            ArgValue& value = values[i];
+            switch (ReadValue<Detail::ArgType>(src)) {
+            case Detail::ArgType::Signed:
+                value.signed_value = ReadValue<s64>(src);
+                args[i] = MakeFormatArg(value.signed_value);
+                break;
+            case Detail::ArgType::Unsigned:
+                value.unsigned_value = ReadValue<u64>(src);
+                args[i] = MakeFormatArg(value.unsigned_value);
+                break;
+            case Detail::ArgType::Float:
+                value.float_value = ReadValue<float>(src);
+                args[i] = MakeFormatArg(value.float_value);
+                break;
+            case Detail::ArgType::Double:
+                value.double_value = ReadValue<double>(src);
+                args[i] = MakeFormatArg(value.double_value);
+                break;
+            case Detail::ArgType::Bool:
+                value.bool_value = ReadValue<bool>(src);
+                args[i] = MakeFormatArg(value.bool_value);
+                break;
+            case Detail::ArgType::Char:
+                value.char_value = ReadValue<char>(src);
+                args[i] = MakeFormatArg(value.char_value);
+                break;
+            case Detail::ArgType::Pointer:
+                value.pointer_value = reinterpret_cast<const void*>(ReadValue<u64>(src));
+                args[i] = MakeFormatArg(value.pointer_value);
+                break;
+            case Detail::ArgType::String: {
+                const u32 length = ReadValue<u32>(src);
+                value.string_value = {reinterpret_cast<const char*>(src), length};
+                args[i] = MakeFormatArg(value.string_value);
+                src += length;
+                break;
+            }
+            }
+        }
 
         Entry entry;
         entry.timestamp =
-            duration_cast<std::chrono::microseconds>(steady_clock::now() - time_origin);
-        entry.log_class = log_class;
-        entry.log_level = log_level;
-        entry.filename = Common::TrimSourcePath(filename);
-        entry.line_num = line_nr;
-        entry.function = function;
-        entry.message = std::move(message);
-
+            GetTimestamp(std::chrono::steady_clock::time_point{
+                std::chrono::nanoseconds{header.timestamp_ns}});
+        entry.log_class = header.log_class;
+        entry.log_level = header.log_level;
+        entry.filename = Common::TrimSourcePath(header.filename);
+        entry.line_num = header.line_num;
+        entry.function = header.function;
+        try {
+            entry.message = fmt::vformat(
+                header.format, fmt::format_args(args.data(), static_cast<int>(header.num_args)));
+        } catch (const fmt::format_error& error) {
+            entry.message = fmt::format("Invalid log format string \"{}\": {}", header.format,
+                                        error.what());
+        }
         return entry;
     }
 
+    std::chrono::microseconds GetTimestamp(std::chrono::steady_clock::time_point time) const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(time - time_origin);
+    }
+
     std::mutex writing_mutex;
     std::thread backend_thread;
     std::vector<std::unique_ptr<Backend>> backends;
-    Common::MPSCQueue<Log::Entry> message_queue;
     Filter filter;
     std::chrono::steady_clock::time_point time_origin{std::chrono::steady_clock::now()};
+
+    std::mutex rings_mutex;
+    std::vector<std::unique_ptr<LogRing>> rings;
+    std::atomic<u64> num_dropped{0};
+    /// Entries decoded by the logging thread, kept around to reuse their allocation
+    std::vector<Entry> pending_entries;
+
+    /// Protects the logging thread wake up state below
+    std::mutex wake_mutex;
+    std::condition_variable wake_cv;
+    /// Set when records were committed since the logging thread last woke up
+    std::atomic_bool has_new_records{false};
+    bool stop_requested = false;
+    /// Number of synchronous writes requested, and the last one the logging thread completed
+    u64 write_requested = 0;
+    u64 write_completed = 0;
+    std::condition_variable write_cv;
 };
 
 void ConsoleBackend::Write(const Entry& entry) {
@@ -162,6 +547,214 @@ void FileBackend::Write(const Entry& entry) {
     }
 }
 
+namespace {
+
+constexpr u32 COMPRESSED_LOG_MAGIC = Common::MakeMagic('Y', 'Z', 'L', 'G');
+constexpr u32 COMPRESSED_LOG_VERSION = 1;
+
+/// Size of the uncompressed records after which they are compressed and written out
+constexpr std::size_t COMPRESSED_LOG_BLOCK_SIZE = 64 * 1024;
+
+struct CompressedLogHeader {
+    u32 magic;
+    u32 version;
+    u64 sequence_number;
+};
+static_assert(sizeof(CompressedLogHeader) == 16, "CompressedLogHeader has incorrect size.");
+
+struct CompressedLogBlockHeader {
+    u32 compressed_size;
+    u32 uncompressed_size;
+};
+static_assert(sizeof(CompressedLogBlockHeader) == 8,
+              "CompressedLogBlockHeader has incorrect size.");
+
+/// Fixed-size part of a binary log record, followed by the filename, function and message
+struct CompressedLogRecord {
+    u64 timestamp_us;
+    u32 line_num;
+    u32 message_size;
+    u16 filename_size;
+    u16 function_size;
+    Class log_class;
+    Level log_level;
+    INSERT_PADDING_BYTES(2);
+};
+static_assert(sizeof(CompressedLogRecord) == 24, "CompressedLogRecord has incorrect size.");
+
+std::string GetCompressedLogPath(const std::string& base_path, std::size_t index) {
+    return fmt::format("{}.{}.zlog", base_path, index);
+}
+
+std::optional<CompressedLogHeader> ReadCompressedLogHeader(const FileUtil::IOFile& file) {
+    CompressedLogHeader header;
+    if (file.ReadBytes(&header, sizeof(header)) != sizeof(header) ||
+        header.magic != COMPRESSED_LOG_MAGIC || header.version != COMPRESSED_LOG_VERSION) {
+        return std::nullopt;
+    }
+    return header;
+}
+
+} // Anonymous namespace
+
+CompressedFileBackend::CompressedFileBackend(std::string base_path, std::size_t num_files,
+                                             std::size_t max_file_size)
+    : base_path{std::move(base_path)}, num_files{num_files}, max_file_size{max_file_size} {
+    // Remove the files of previous sessions, so they don't get mixed up with this one
+    for (std::size_t index = 0; index < num_files; ++index) {
+        const std::string path = GetCompressedLogPath(this->base_path, index);
+        if (FileUtil::Exists(path)) {
+            FileUtil::Delete(path);
+        }
+    }
+    block.reserve(COMPRESSED_LOG_BLOCK_SIZE);
+    OpenNextFile();
+}
+
+CompressedFileBackend::~CompressedFileBackend() {
+    FlushBlock();
+}
+
+void CompressedFileBackend::Write(const Entry& entry) {
+    const std::string_view filename = entry.filename;
+    const std::string_view function = entry.function;
+
+    CompressedLogRecord record{};
+    record.timestamp_us = static_cast<u64>(entry.timestamp.count());
+    record.line_num = entry.line_num;
+    record.message_size = static_cast<u32>(entry.message.size());
+    record.filename_size = static_cast<u16>(filename.size());
+    record.function_size = static_cast<u16>(function.size());
+    record.log_class = entry.log_class;
+    record.log_level = entry.log_level;
+
+    const std::size_t offset = block.size();
+    block.resize(offset + sizeof(record) + filename.size() + function.size() +
+                 entry.message.size());
+    u8* dest = block.data() + offset;
+    std::memcpy(dest, &record, sizeof(record));
+    dest += sizeof(record);
+    std::memcpy(dest, filename.data(), filename.size());
+    dest += filename.size();
+    std::memcpy(dest, function.data(), function.size());
+    dest += function.size();
+    std::memcpy(dest, entry.message.data(), entry.message.size());
+
+    if (block.size() >= COMPRESSED_LOG_BLOCK_SIZE || entry.log_level >= Level::Error) {
+        FlushBlock();
+    }
+}
+
+void CompressedFileBackend::FlushBlock() {
+    if (block.empty() || !file.IsOpen()) {
+        return;
+    }
+
+    const std::vector<u8> compressed =
+        Common::Compression::CompressDataZSTDDefault(block.data(), block.size());
+    if (compressed.empty()) {
+        block.clear();
+        return;
+    }
+
+    const CompressedLogBlockHeader header{static_cast<u32>(compressed.size()),
+                                          static_cast<u32>(block.size())};
+    bytes_written += file.WriteBytes(&header, sizeof(header));
+    bytes_written += file.WriteBytes(compressed.data(), compressed.size());
+    file.Flush();
+    block.clear();
+
+    if (bytes_written >= max_file_size) {
+        OpenNextFile();
+    }
+}
+
+void CompressedFileBackend::OpenNextFile() {
+    const std::size_t index = static_cast<std::size_t>(sequence_number % num_files);
+    file = FileUtil::IOFile(GetCompressedLogPath(base_path, index), "wb", _SH_DENYWR);
+    bytes_written = 0;
+
+    const CompressedLogHeader header{COMPRESSED_LOG_MAGIC, COMPRESSED_LOG_VERSION,
+                                     sequence_number++};
+    bytes_written += file.WriteBytes(&header, sizeof(header));
+}
+
+std::vector<std::string> GetCompressedLogFiles(const std::string& base_path) {
+    std::vector<std::pair<u64, std::string>> files;
+    for (std::size_t index = 0;; ++index) {
+        std::string path = GetCompressedLogPath(base_path, index);
+        FileUtil::IOFile file(path, "rb");
+        if (!file.IsOpen()) {
+            break;
+        }
+        if (const auto header = ReadCompressedLogHeader(file)) {
+            files.emplace_back(header->sequence_number, std::move(path));
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    std::vector<std::string> paths;
+    paths.reserve(files.size());
+    for (auto& [sequence_number, path] : files) {
+        paths.push_back(std::move(path));
+    }
+    return paths;
+}
+
+bool ReadCompressedLogFile(const std::string& path,
+                           const std::function<void(const Entry&)>& callback) {
+    FileUtil::IOFile file(path, "rb");
+    if (!file.IsOpen() || !ReadCompressedLogHeader(file)) {
+        return false;
+    }
+
+    CompressedLogBlockHeader block_header;
+    while (file.ReadBytes(&block_header, sizeof(block_header)) == sizeof(block_header)) {
+        std::vector<u8> compressed(block_header.compressed_size);
+        if (file.ReadBytes(compressed.data(), compressed.size()) != compressed.size()) {
+            return false;
+        }
+        const std::vector<u8> block = Common::Compression::DecompressDataZSTD(compressed);
+        if (block.size() != block_header.uncompressed_size) {
+            return false;
+        }
+
+        std::size_t offset = 0;
+        while (offset < block.size()) {
+            CompressedLogRecord record;
+            if (block.size() - offset < sizeof(record)) {
+                return false;
+            }
+            std::memcpy(&record, block.data() + offset, sizeof(record));
+            offset += sizeof(record);
+
+            const std::size_t strings_size =
+                std::size_t{record.filename_size} + record.function_size + record.message_size;
+            if (block.size() - offset < strings_size) {
+                return false;
+            }
+            const char* const strings = reinterpret_cast<const char*>(block.data() + offset);
+            offset += strings_size;
+
+            // Entries reference the filename and function as null terminated strings
+            const std::string filename(strings, record.filename_size);
+            const std::string function(strings + record.filename_size, record.function_size);
+
+            Entry entry;
+            entry.timestamp = std::chrono::microseconds{record.timestamp_us};
+            entry.log_class = record.log_class;
+            entry.log_level = record.log_level;
+            entry.filename = filename.c_str();
+            entry.line_num = record.line_num;
+            entry.function = function.c_str();
+            entry.message.assign(strings + record.filename_size + record.function_size,
+                                 record.message_size);
+            callback(entry);
+        }
+    }
+    return true;
+}
+
 void DebuggerBackend::Write(const Entry& entry) {
 #ifdef _WIN32
     ::OutputDebugStringW(Common::UTF8ToUTF16W(FormatLogMessage(entry).append(1, '\n')).c_str());
@@ -316,7 +909,23 @@ void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
     if (!filter.CheckMessage(log_class, log_level))
         return;
 
-    instance.PushEntry(log_class, log_level, filename, line_num, function,
-                       fmt::vformat(format, args));
+    // Arguments that can't be copied into the record are formatted on the calling thread
+    FmtLogMessage(log_class, log_level, filename, line_num, function, "{}",
+                  fmt::vformat(format, args));
+}
+
+namespace Detail {
+
+u8* BeginRecord(Class log_class, Level log_level, const char* filename, unsigned int line_num,
+                const char* function, const char* format, std::size_t num_args,
+                std::size_t args_size) {
+    return Impl::Instance().BeginRecord(log_class, log_level, filename, line_num, function, format,
+                                        num_args, args_size);
+}
+
+void EndRecord() {
+    Impl::Instance().EndRecord();
 }
+
+} // namespace Detail
 } // namespace Log
@@ -4,9 +4,11 @@
 #pragma once
 
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 #include "common/file_util.h"
 #include "common/logging/filter.h"
 #include "common/logging/log.h"
@@ -23,17 +25,10 @@ struct Entry {
     std::chrono::microseconds timestamp;
     Class log_class;
     Level log_level;
-    std::string filename;
+    const char* filename;
     unsigned int line_num;
-    std::string function;
+    const char* function;
     std::string message;
-    bool final_entry = false;
-
-    Entry() = default;
-    Entry(Entry&& o) = default;
-
-    Entry& operator=(Entry&& o) = default;
-    Entry& operator=(const Entry& o) = default;
 };
 
 /**
@@ -104,6 +99,68 @@ private:
     std::size_t bytes_written;
 };
 
+/**
+ * Backend that writes binary log records to a set of rotating files, compressing them in blocks
+ * with Zstandard. Once all files are full, the oldest one is overwritten, so the end of long
+ * sessions is never lost. Use ReadCompressedLogFile or yuzu-log-decoder to read them back.
+ */
+class CompressedFileBackend : public Backend {
+public:
+    /**
+     * @param base_path Path of the log files without extension, the files are named
+     *                  "<base_path>.<index>.zlog"
+     * @param num_files Number of files to rotate across
+     * @param max_file_size Size after which the next file is started
+     */
+    explicit CompressedFileBackend(std::string base_path, std::size_t num_files = 4,
+                                   std::size_t max_file_size = 16 * 1024 * 1024);
+    ~CompressedFileBackend() override;
+
+    static const char* Name() {
+        return "compressed_file";
+    }
+
+    const char* GetName() const override {
+        return Name();
+    }
+
+    void Write(const Entry& entry) override;
+
+private:
+    /// Compresses the pending records and appends them to the current file
+    void FlushBlock();
+
+    /// Starts writing to the next file in the rotation
+    void OpenNextFile();
+
+    std::string base_path;
+    std::size_t num_files;
+    std::size_t max_file_size;
+
+    FileUtil::IOFile file;
+    std::size_t bytes_written = 0;
+    /// Number of files opened so far, used to order the files when reading them back
+    u64 sequence_number = 0;
+    /// Uncompressed records waiting to be written
+    std::vector<u8> block;
+};
+
+/**
+ * Returns the paths of the files written by a CompressedFileBackend, oldest first.
+ * @param base_path Base path given to the CompressedFileBackend
+ */
+std::vector<std::string> GetCompressedLogFiles(const std::string& base_path);
+
+/**
+ * Reads a file written by a CompressedFileBackend.
+ * @param path Path of the file to read
+ * @param callback Called for each entry in the order they were written. The strings referenced by
+ *                 the entry are only valid for the duration of the call.
+ * @returns false if the file could not be opened or is corrupt
+ */
+bool ReadCompressedLogFile(const std::string& path,
+                           const std::function<void(const Entry&)>& callback);
+
 /**
  * Backend that writes to Visual Studio's output window
  */
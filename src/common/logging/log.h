@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <fmt/format.h>
 #include "common/common_types.h"
 
@@ -129,11 +133,131 @@ void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, const char* format,
                        const fmt::format_args& args);
 
+namespace Detail {
+
+/// Maximum number of arguments of a message whose formatting can be deferred
+constexpr std::size_t MAX_DEFERRED_ARGS = 16;
+
+/// Type of an argument stored in a log record
+enum class ArgType : u8 {
+    Signed,
+    Unsigned,
+    Float,
+    Double,
+    Bool,
+    Char,
+    Pointer,
+    String,
+};
+
+template <typename T>
+constexpr bool IsStringArg =
+    std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+    std::is_same_v<T, const char*> || std::is_same_v<T, char*> ||
+    (std::is_array_v<T> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<T>>, char>);
+
+/// Whether an argument of type T can be copied into a log record and formatted later
+template <typename T>
+constexpr bool IsDeferrableArg =
+    IsStringArg<T> || std::is_same_v<T, bool> || std::is_same_v<T, char> ||
+    (std::is_integral_v<T> && sizeof(T) <= sizeof(u64) && !std::is_same_v<T, wchar_t> &&
+     !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>) ||
+    std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, void*> ||
+    std::is_same_v<T, const void*>;
+
+template <typename... Args>
+constexpr bool CanDeferFormatting =
+    sizeof...(Args) <= MAX_DEFERRED_ARGS && (IsDeferrableArg<Args> && ...);
+
+template <typename T>
+std::string_view ToStringView(const T& value) {
+    if constexpr (std::is_pointer_v<T>) {
+        return value != nullptr ? std::string_view{value} : std::string_view{"(null)"};
+    } else {
+        return std::string_view{value};
+    }
+}
+
+template <typename T>
+std::size_t GetEncodedSize(const T& value) {
+    if constexpr (IsStringArg<T>) {
+        return sizeof(ArgType) + sizeof(u32) + ToStringView(value).size();
+    } else if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, char> ||
+                         std::is_floating_point_v<T>) {
+        return sizeof(ArgType) + sizeof(T);
+    } else {
+        return sizeof(ArgType) + sizeof(u64);
+    }
+}
+
+template <typename T>
+void EncodeValue(u8*& dest, ArgType type, const T& value) {
+    std::memcpy(dest, &type, sizeof(type));
+    std::memcpy(dest + sizeof(type), &value, sizeof(value));
+    dest += sizeof(type) + sizeof(value);
+}
+
+template <typename T>
+void EncodeArg(u8*& dest, const T& value) {
+    if constexpr (IsStringArg<T>) {
+        const std::string_view string = ToStringView(value);
+        EncodeValue(dest, ArgType::String, static_cast<u32>(string.size()));
+        std::memcpy(dest, string.data(), string.size());
+        dest += string.size();
+    } else if constexpr (std::is_same_v<T, bool>) {
+        EncodeValue(dest, ArgType::Bool, value);
+    } else if constexpr (std::is_same_v<T, char>) {
+        EncodeValue(dest, ArgType::Char, value);
+    } else if constexpr (std::is_same_v<T, float>) {
+        EncodeValue(dest, ArgType::Float, value);
+    } else if constexpr (std::is_same_v<T, double>) {
+        EncodeValue(dest, ArgType::Double, value);
+    } else if constexpr (std::is_pointer_v<T>) {
+        EncodeValue(dest, ArgType::Pointer, reinterpret_cast<u64>(value));
+    } else if constexpr (std::is_signed_v<T>) {
+        EncodeValue(dest, ArgType::Signed, static_cast<s64>(value));
+    } else {
+        EncodeValue(dest, ArgType::Unsigned, static_cast<u64>(value));
+    }
+}
+
+/**
+ * Reserves a record in the log ring of the calling thread. Neither locks nor allocates, except
+ * for critical messages finding the ring full, which wait for it to drain rather than be dropped.
+ * @returns Pointer where the encoded arguments have to be written, or nullptr if the message is
+ *          filtered out or dropped because the ring is full. EndRecord must be called after writing
+ *          the arguments unless nullptr was returned.
+ */
+u8* BeginRecord(Class log_class, Level log_level, const char* filename, unsigned int line_num,
+                const char* function, const char* format, std::size_t num_args,
+                std::size_t args_size);
+
+/// Publishes the record reserved by the last call to BeginRecord to the logging thread
+void EndRecord();
+
+} // namespace Detail
+
+/**
+ * Logs a message to the global logger, using fmt. Formatting is deferred to the logging thread
+ * when all arguments are plain values or strings, otherwise the message is formatted immediately.
+ * The filename, function and format strings must have static storage duration.
+ */
 template <typename... Args>
 void FmtLogMessage(Class log_class, Level log_level, const char* filename, unsigned int line_num,
                    const char* function, const char* format, const Args&... args) {
-    FmtLogMessageImpl(log_class, log_level, filename, line_num, function, format,
-                      fmt::make_format_args(args...));
+    if constexpr (Detail::CanDeferFormatting<Args...>) {
+        const std::size_t args_size = (Detail::GetEncodedSize(args) + ... + 0);
+        u8* dest = Detail::BeginRecord(log_class, log_level, filename, line_num, function, format,
+                                       sizeof...(Args), args_size);
+        if (dest == nullptr) {
+            return;
+        }
+        (Detail::EncodeArg(dest, args), ...);
+        Detail::EndRecord();
+    } else {
+        FmtLogMessageImpl(log_class, log_level, filename, line_num, function, format,
+                          fmt::make_format_args(args...));
+    }
 }
 
 } // namespace Log
@@ -24,6 +24,16 @@ typedef void* HANDLE;
 
 #define MP_RGB(r, g, b) ((r) << 16 | (g) << 8 | (b) << 0)
 
+#if MICROPROFILE_ENABLED
+#include "common/trace.h"
+
+// Feed scopes to the headless trace sink as well, so they can be inspected without the UI.
+#undef MICROPROFILE_SCOPE
+#define MICROPROFILE_SCOPE(var)                                                                    \
+    MicroProfileScopeHandler MICROPROFILE_TOKEN_PASTE(foo, __LINE__)(g_mp_##var);                  \
+    Common::Trace::ScopeRecorder MICROPROFILE_TOKEN_PASTE(trace, __LINE__)(g_mp_##var)
+#endif
+
 // On OS X, some Mach header included by MicroProfile defines these as macros, conflicting with
 // identifiers we use.
 #ifdef PAGE_SIZE
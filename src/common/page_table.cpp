@@ -2,10 +2,13 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <atomic>
 #include "common/page_table.h"
 
 namespace Common {
 
+static std::atomic<u64> next_layout_id{1};
+
 PageTable::PageTable(std::size_t page_size_in_bits) : page_size_in_bits{page_size_in_bits} {}
 
 PageTable::~PageTable() = default;
@@ -26,6 +29,8 @@ void PageTable::Resize(std::size_t address_space_width_in_bits) {
     pointers.shrink_to_fit();
     attributes.shrink_to_fit();
     backing_addr.shrink_to_fit();
+
+    layout_id = next_layout_id.fetch_add(1, std::memory_order_relaxed);
 }
 
 } // namespace Common
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <memory>
+#include <set>
+#include <unordered_map>
 #include <vector>
 #include <boost/icl/interval_map.hpp>
 #include "common/common_types.h"
@@ -42,6 +45,24 @@ struct SpecialRegion {
     }
 };
 
+/**
+ * Read-only copy of the special regions of a page table, used by accesses to pages of type
+ * `Special`. It is replaced as a whole whenever the regions change, so readers never lock.
+ */
+struct SpecialRegionCache {
+    struct Segment {
+        u64 begin; ///< First address of the segment
+        u64 end;   ///< Address past the last one of the segment
+        std::vector<SpecialRegion> regions; ///< Debug hooks come before I/O devices
+    };
+
+    /// Segments with at least one region, sorted by address
+    std::vector<Segment> segments;
+
+    /// Copy of PageTable::hooked_pages
+    std::unordered_map<u64, u8*> hooked_pages;
+};
+
 /**
  * A (reasonably) fast way of allowing switchable and remappable process address spaces. It loosely
  * mimics the way a real CPU page table works.
@@ -70,6 +91,15 @@ struct PageTable {
      */
     boost::icl::interval_map<u64, std::set<SpecialRegion>> special_regions;
 
+    /**
+     * Memory backing the pages that are of type `Special` only because debug hooks are placed on
+     * them, indexed by page. Accesses the hooks let through go to this memory.
+     */
+    std::unordered_map<u64, u8*> hooked_pages;
+
+    /// Copy of `special_regions` and `hooked_pages` that accesses to `Special` pages read.
+    std::shared_ptr<const SpecialRegionCache> special_region_cache;
+
     /**
      * Vector of fine grained page attributes. If it is set to any value other than `Memory`, then
      * the corresponding entry in `pointers` MUST be set to null.
@@ -78,6 +108,13 @@ struct PageTable {
 
     std::vector<u64> backing_addr;
 
+    /**
+     * Identifier of the current layout of the page table. It is unique among all page tables and
+     * changes whenever the table is resized, so state cached for a page table, such as recompiled
+     * code, can tell whether it still belongs to the same address space.
+     */
+    u64 layout_id{};
+
     const std::size_t page_size_in_bits{};
 };
 
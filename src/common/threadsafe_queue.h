@@ -46,9 +46,12 @@ public:
         ElementPtr* new_ptr = new ElementPtr();
         write_ptr->next.store(new_ptr, std::memory_order_release);
         write_ptr = new_ptr;
-        cv.notify_one();
-
         ++size;
+
+        // Notifying without cv_mutex loses the wakeup when the reader is between its emptiness
+        // check and the wait
+        std::lock_guard lock{cv_mutex};
+        cv.notify_one();
     }
 
     void Pop() {
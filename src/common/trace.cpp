@@ -0,0 +1,159 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <fmt/format.h>
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "common/trace.h"
+
+namespace Common::Trace {
+
+namespace Detail {
+std::atomic_bool is_enabled{false};
+} // namespace Detail
+
+namespace {
+
+struct Event {
+    u64 token;
+    u64 begin;
+    u64 end;
+};
+
+/**
+ * Slot of a thread ring, guarded by a sequence lock as the owning thread may overwrite it while
+ * the trace is written out. The sequence is odd while an event is being written, and twice the
+ * number of events recorded up to and including the slot's event once it is complete.
+ */
+struct EventSlot {
+    std::atomic<u64> sequence{0};
+    std::atomic<u64> token{0};
+    std::atomic<u64> begin{0};
+    std::atomic<u64> end{0};
+};
+
+/// Ring of events written by a single thread and read when the trace is written
+struct ThreadBuffer {
+    explicit ThreadBuffer(u32 thread_index) : thread_index{thread_index} {}
+
+    /// Reads the event with the given index, returns false if it was overwritten or is torn
+    bool ReadEvent(u64 index, Event& event) const {
+        const EventSlot& slot = events[index % EVENTS_PER_THREAD];
+        const u64 sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != (index + 1) * 2) {
+            return false;
+        }
+        event.token = slot.token.load(std::memory_order_relaxed);
+        event.begin = slot.begin.load(std::memory_order_relaxed);
+        event.end = slot.end.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.sequence.load(std::memory_order_relaxed) == sequence;
+    }
+
+    u32 thread_index;
+    std::atomic<u64> num_events{0};
+    std::array<EventSlot, EVENTS_PER_THREAD> events;
+};
+
+std::mutex buffers_mutex;
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+const auto time_origin = std::chrono::steady_clock::now();
+
+ThreadBuffer& GetThreadBuffer() {
+    // Buffers are never freed, so events of finished threads can still be written out
+    thread_local ThreadBuffer* buffer = [] {
+        std::lock_guard lock{buffers_mutex};
+        const auto thread_index = static_cast<u32>(buffers.size());
+        return buffers.emplace_back(std::make_unique<ThreadBuffer>(thread_index)).get();
+    }();
+    return *buffer;
+}
+
+std::string GetScopeName(u64 token) {
+#if MICROPROFILE_ENABLED
+    const MicroProfile* const profile = MicroProfileGet();
+    const MicroProfileTimerInfo& timer = profile->TimerInfo[MicroProfileGetTimerIndex(token)];
+    return fmt::format("{}/{}", profile->GroupInfo[timer.nGroupIndex].pName, timer.pName);
+#else
+    return fmt::format("0x{:X}", token);
+#endif
+}
+
+} // Anonymous namespace
+
+void Enable() {
+    Detail::is_enabled.store(true, std::memory_order_relaxed);
+}
+
+void Disable() {
+    Detail::is_enabled.store(false, std::memory_order_relaxed);
+}
+
+u64 GetTimestamp() {
+    const auto elapsed = std::chrono::steady_clock::now() - time_origin;
+    // Zero is reserved to mark scopes that were entered while the sink was disabled
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() + 1;
+}
+
+void RecordScope(u64 token, u64 begin, u64 end) {
+    ThreadBuffer& buffer = GetThreadBuffer();
+    const u64 index = buffer.num_events.load(std::memory_order_relaxed);
+    EventSlot& slot = buffer.events[index % EVENTS_PER_THREAD];
+    slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.token.store(token, std::memory_order_relaxed);
+    slot.begin.store(begin, std::memory_order_relaxed);
+    slot.end.store(end, std::memory_order_relaxed);
+    slot.sequence.store((index + 1) * 2, std::memory_order_release);
+    buffer.num_events.store(index + 1, std::memory_order_release);
+}
+
+bool WriteChromeTrace(const std::string& path) {
+    FileUtil::IOFile file(path, "w");
+    if (!file.IsOpen()) {
+        LOG_ERROR(Common, "Failed to open {} for writing the trace", path);
+        return false;
+    }
+
+    std::string out = "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    bool first_event = true;
+
+    std::lock_guard lock{buffers_mutex};
+    for (const auto& buffer : buffers) {
+        out += fmt::format("{}\n{{\"ph\": \"M\", \"pid\": 1, \"tid\": {}, \"name\": "
+                           "\"thread_name\", \"args\": {{\"name\": \"Thread {}\"}}}}",
+                           first_event ? "" : ",", buffer->thread_index, buffer->thread_index);
+        first_event = false;
+
+        // Events may still be recorded by the owning thread while they are being written out, the
+        // ones it overwrites in the meantime are skipped
+        const u64 num_events = buffer->num_events.load(std::memory_order_acquire);
+        const u64 num_kept = std::min<u64>(num_events, EVENTS_PER_THREAD);
+        for (u64 index = num_events - num_kept; index < num_events; ++index) {
+            Event event;
+            if (!buffer->ReadEvent(index, event)) {
+                continue;
+            }
+            out += fmt::format(",\n{{\"ph\": \"X\", \"pid\": 1, \"tid\": {}, \"name\": \"{}\", "
+                               "\"ts\": {:.3f}, \"dur\": {:.3f}}}",
+                               buffer->thread_index, GetScopeName(event.token),
+                               static_cast<double>(event.begin) / 1000.0,
+                               static_cast<double>(event.end - event.begin) / 1000.0);
+        }
+    }
+
+    out += "\n]}\n";
+    return file.WriteString(out) == out.size();
+}
+
+} // namespace Common::Trace
@@ -0,0 +1,77 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include "common/common_types.h"
+
+/**
+ * Headless sink for MicroProfile scopes.
+ *
+ * While enabled, every MICROPROFILE_SCOPE records its begin and end time into a fixed-size ring
+ * buffer owned by the calling thread. Recording never locks nor allocates after the first scope
+ * of a thread, and the rings only keep the most recent events so the sink can stay enabled for
+ * long sessions. The recorded events can be written as Chrome trace_event JSON, which can be
+ * opened by chrome://tracing or Perfetto.
+ */
+namespace Common::Trace {
+
+/// Number of events kept per thread before the oldest ones are overwritten
+constexpr std::size_t EVENTS_PER_THREAD = 1 << 16;
+
+namespace Detail {
+extern std::atomic_bool is_enabled;
+} // namespace Detail
+
+/// Starts recording scopes
+void Enable();
+
+/// Stops recording scopes, already recorded events are kept
+void Disable();
+
+/// Returns true if scopes are currently being recorded
+inline bool IsEnabled() {
+    return Detail::is_enabled.load(std::memory_order_relaxed);
+}
+
+/// Returns the current trace timestamp in nanoseconds
+u64 GetTimestamp();
+
+/**
+ * Records a completed scope on the calling thread.
+ * @param token MicroProfile token of the scope
+ * @param begin Timestamp at which the scope was entered
+ * @param end Timestamp at which the scope was left
+ */
+void RecordScope(u64 token, u64 begin, u64 end);
+
+/**
+ * Writes the events recorded so far by all threads as Chrome trace_event JSON.
+ * @param path Path of the file to write
+ * @returns true if the file was written successfully
+ */
+bool WriteChromeTrace(const std::string& path);
+
+/// Records the enclosing scope into the trace sink if it was enabled when the scope was entered
+class ScopeRecorder {
+public:
+    explicit ScopeRecorder(u64 token) : token{token}, begin{IsEnabled() ? GetTimestamp() : 0} {}
+
+    ~ScopeRecorder() {
+        if (begin != 0) {
+            RecordScope(token, begin, GetTimestamp());
+        }
+    }
+
+    ScopeRecorder(const ScopeRecorder&) = delete;
+    ScopeRecorder& operator=(const ScopeRecorder&) = delete;
+
+private:
+    u64 token;
+    u64 begin;
+};
+
+} // namespace Common::Trace
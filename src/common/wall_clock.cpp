@@ -0,0 +1,62 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/uint128.h"
+#include "common/wall_clock.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include "common/x64/cpu_detect.h"
+#include "common/x64/native_clock.h"
+#endif
+
+namespace Common {
+
+namespace {
+
+/// Converts a duration in nanoseconds into ticks of the given frequency without overflowing
+u64 NanosecondsToTicks(std::chrono::nanoseconds ns, u64 frequency) {
+    const u128 temp = Multiply64Into128(static_cast<u64>(ns.count()), frequency);
+    return Divide128On32(temp, 1000000000).first;
+}
+
+class StandardWallClock final : public WallClock {
+public:
+    StandardWallClock(u64 emulated_cpu_frequency, u64 emulated_clock_frequency)
+        : WallClock(emulated_cpu_frequency, emulated_clock_frequency, false),
+          start_time{std::chrono::steady_clock::now()} {}
+
+    std::chrono::nanoseconds GetTimeNS() const override {
+        return std::chrono::steady_clock::now() - start_time;
+    }
+
+    std::chrono::microseconds GetTimeUS() const override {
+        return std::chrono::duration_cast<std::chrono::microseconds>(GetTimeNS());
+    }
+
+    u64 GetClockCycles() const override {
+        return NanosecondsToTicks(GetTimeNS(), emulated_clock_frequency);
+    }
+
+    u64 GetCPUCycles() const override {
+        return NanosecondsToTicks(GetTimeNS(), emulated_cpu_frequency);
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_time;
+};
+
+} // Anonymous namespace
+
+std::unique_ptr<WallClock> CreateBestMatchingClock(u32 emulated_cpu_frequency,
+                                                   u32 emulated_clock_frequency) {
+#ifdef ARCHITECTURE_x86_64
+    if (GetCPUCaps().invariant_tsc) {
+        return std::make_unique<X64::NativeClock>(emulated_cpu_frequency, emulated_clock_frequency,
+                                                  X64::EstimateRDTSCFrequency());
+    }
+#endif
+    return std::make_unique<StandardWallClock>(emulated_cpu_frequency, emulated_clock_frequency);
+}
+
+} // namespace Common
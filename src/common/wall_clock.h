@@ -0,0 +1,57 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include "common/common_types.h"
+
+namespace Common {
+
+/// Monotonic host clock that reports the time elapsed since its creation in emulated units
+class WallClock {
+public:
+    virtual ~WallClock() = default;
+
+    /// Returns the elapsed wall time in nanoseconds
+    virtual std::chrono::nanoseconds GetTimeNS() const = 0;
+
+    /// Returns the elapsed wall time in microseconds
+    virtual std::chrono::microseconds GetTimeUS() const = 0;
+
+    /// Returns the elapsed wall time in emulated system counter ticks
+    virtual u64 GetClockCycles() const = 0;
+
+    /// Returns the elapsed wall time in emulated CPU cycles
+    virtual u64 GetCPUCycles() const = 0;
+
+    /// Returns true if the clock reads the hardware counter of the host CPU
+    bool IsNative() const {
+        return is_native;
+    }
+
+protected:
+    WallClock(u64 emulated_cpu_frequency, u64 emulated_clock_frequency, bool is_native)
+        : emulated_cpu_frequency{emulated_cpu_frequency},
+          emulated_clock_frequency{emulated_clock_frequency}, is_native{is_native} {}
+
+    u64 emulated_cpu_frequency;
+    u64 emulated_clock_frequency;
+
+private:
+    bool is_native;
+};
+
+/**
+ * Creates the most precise wall clock available on the host. This is a clock based on the
+ * calibrated time stamp counter of the CPU when it is invariant, and std::chrono::steady_clock
+ * otherwise.
+ * @param emulated_cpu_frequency Frequency of the emulated CPU in Hz
+ * @param emulated_clock_frequency Frequency of the emulated system counter in Hz
+ */
+std::unique_ptr<WallClock> CreateBestMatchingClock(u32 emulated_cpu_frequency,
+                                                   u32 emulated_clock_frequency);
+
+} // namespace Common
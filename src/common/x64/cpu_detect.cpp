@@ -154,6 +154,12 @@ static CPUCaps Detect() {
             caps.long_mode = true;
     }
 
+    if (max_ex_fn >= 0x80000007) {
+        __cpuid(cpu_id, 0x80000007);
+        if ((cpu_id[3] >> 8) & 1)
+            caps.invariant_tsc = true;
+    }
+
     return caps;
 }
 
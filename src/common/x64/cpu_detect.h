@@ -49,6 +49,9 @@ struct CPUCaps {
     bool lahf_sahf_64;
 
     bool long_mode;
+
+    // The time stamp counter runs at a constant rate in all power states
+    bool invariant_tsc;
 };
 
 /**
@@ -0,0 +1,80 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <thread>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#include "common/uint128.h"
+#include "common/x64/native_clock.h"
+
+namespace Common::X64 {
+
+namespace {
+
+/// Returns frequency / rdtsc_frequency as a 32.32 fixed point factor
+u64 GetFixedPointFactor(u64 frequency, u64 rdtsc_frequency) {
+    return (frequency << 32) / rdtsc_frequency;
+}
+
+/// Multiplies a tick count by a 32.32 fixed point factor
+u64 MultiplyFixedPoint(u64 ticks, u64 factor) {
+    const u128 product = Multiply64Into128(ticks, factor);
+    return (product[1] << 32) | (product[0] >> 32);
+}
+
+} // Anonymous namespace
+
+u64 EstimateRDTSCFrequency() {
+    // Serialize the time stamp counter reads against the steady clock reads around them
+    _mm_mfence();
+    const auto begin_time = std::chrono::steady_clock::now();
+    const u64 begin_rdtsc = __rdtsc();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+
+    _mm_mfence();
+    const auto end_time = std::chrono::steady_clock::now();
+    const u64 end_rdtsc = __rdtsc();
+
+    const auto elapsed_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - begin_time).count();
+    const u128 scaled_ticks = Multiply64Into128(end_rdtsc - begin_rdtsc, 1000000000);
+    return Divide128On32(scaled_ticks, static_cast<u32>(elapsed_ns)).first;
+}
+
+NativeClock::NativeClock(u64 emulated_cpu_frequency, u64 emulated_clock_frequency,
+                         u64 rdtsc_frequency)
+    : WallClock(emulated_cpu_frequency, emulated_clock_frequency, true), start_rdtsc{__rdtsc()},
+      ns_factor{GetFixedPointFactor(1000000000, rdtsc_frequency)},
+      us_factor{GetFixedPointFactor(1000000, rdtsc_frequency)},
+      clock_factor{GetFixedPointFactor(emulated_clock_frequency, rdtsc_frequency)},
+      cpu_factor{GetFixedPointFactor(emulated_cpu_frequency, rdtsc_frequency)} {}
+
+u64 NativeClock::GetElapsedRDTSC() const {
+    return __rdtsc() - start_rdtsc;
+}
+
+std::chrono::nanoseconds NativeClock::GetTimeNS() const {
+    return std::chrono::nanoseconds{MultiplyFixedPoint(GetElapsedRDTSC(), ns_factor)};
+}
+
+std::chrono::microseconds NativeClock::GetTimeUS() const {
+    return std::chrono::microseconds{MultiplyFixedPoint(GetElapsedRDTSC(), us_factor)};
+}
+
+u64 NativeClock::GetClockCycles() const {
+    return MultiplyFixedPoint(GetElapsedRDTSC(), clock_factor);
+}
+
+u64 NativeClock::GetCPUCycles() const {
+    return MultiplyFixedPoint(GetElapsedRDTSC(), cpu_factor);
+}
+
+} // namespace Common::X64
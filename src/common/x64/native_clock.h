@@ -0,0 +1,40 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "common/wall_clock.h"
+
+namespace Common::X64 {
+
+/// Wall clock reading the invariant time stamp counter of the host CPU
+class NativeClock final : public WallClock {
+public:
+    NativeClock(u64 emulated_cpu_frequency, u64 emulated_clock_frequency, u64 rdtsc_frequency);
+
+    std::chrono::nanoseconds GetTimeNS() const override;
+
+    std::chrono::microseconds GetTimeUS() const override;
+
+    u64 GetClockCycles() const override;
+
+    u64 GetCPUCycles() const override;
+
+private:
+    /// Returns the time stamp counter ticks elapsed since the clock was created
+    u64 GetElapsedRDTSC() const;
+
+    u64 start_rdtsc;
+
+    // Conversion factors from time stamp counter ticks in 32.32 fixed point
+    u64 ns_factor;
+    u64 us_factor;
+    u64 clock_factor;
+    u64 cpu_factor;
+};
+
+/// Measures the frequency of the time stamp counter against the steady clock of the host
+u64 EstimateRDTSCFrequency();
+
+} // namespace Common::X64
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cinttypes>
 #include <memory>
 #include <dynarmic/A64/a64.h>
@@ -14,6 +15,7 @@
 #include "core/core_timing.h"
 #include "core/core_timing_util.h"
 #include "core/gdbstub/gdbstub.h"
+#include "core/guest_profiler.h"
 #include "core/hle/kernel/process.h"
 #include "core/hle/kernel/svc.h"
 #include "core/hle/kernel/vm_manager.h"
@@ -61,8 +63,14 @@ public:
     }
 
     void InterpreterFallback(u64 pc, std::size_t num_instructions) override {
+        const u32 instruction = MemoryReadCode(pc);
         LOG_INFO(Core_ARM, "Unicorn fallback @ 0x{:X} for {} instructions (instr = {:08X})", pc,
-                 num_instructions, MemoryReadCode(pc));
+                 num_instructions, instruction);
+
+        auto& profiler = parent.system.GetGuestProfiler();
+        if (profiler.IsEnabled()) {
+            profiler.RecordInterpreterFallback(pc, num_instructions, instruction);
+        }
 
         ARM_Interface::ThreadContext ctx;
         parent.SaveContext(ctx);
@@ -119,7 +127,7 @@ public:
         return std::max(parent.system.CoreTiming().GetDowncount(), 0);
     }
     u64 GetCNTPCT() override {
-        return Timing::CpuCyclesToClockCycles(parent.system.CoreTiming().GetTicks());
+        return parent.system.CoreTiming().GetClockTicks();
     }
 
     ARM_Dynarmic& parent;
@@ -163,6 +171,13 @@ void ARM_Dynarmic::Run() {
     MICROPROFILE_SCOPE(ARM_Jit_Dynarmic);
 
     jit->Run();
+
+    // Watchpoints halt the JIT from a memory hook, report them once it stopped
+    if (GDBStub::IsServerEnabled() && GDBStub::IsMemoryBreak()) {
+        Kernel::Thread* const thread = Kernel::GetCurrentThread();
+        SaveContext(thread->GetContext());
+        GDBStub::SendTrap(thread, 5);
+    }
 }
 
 void ARM_Dynarmic::Step() {
@@ -252,7 +267,11 @@ void ARM_Dynarmic::PrepareReschedule() {
 }
 
 void ARM_Dynarmic::ClearInstructionCache() {
-    jit->ClearCache();
+    // Cached JITs of other page tables may hold code from the invalidated memory as well
+    for (auto& cached_jit : jit_cache) {
+        cached_jit.jit->ClearCache();
+    }
+    ++jit_cache_stats.cache_clears;
 }
 
 void ARM_Dynarmic::ClearExclusiveState() {
@@ -261,15 +280,61 @@ void ARM_Dynarmic::ClearExclusiveState() {
 
 void ARM_Dynarmic::PageTableChanged(Common::PageTable& page_table,
                                     std::size_t new_address_space_size_in_bits) {
-    jit = MakeJit(page_table, new_address_space_size_in_bits);
+    const auto it = std::find_if(jit_cache.begin(), jit_cache.end(),
+                                 [&page_table](const CachedJit& cached_jit) {
+                                     return cached_jit.page_table_layout_id ==
+                                            page_table.layout_id;
+                                 });
+
+    if (it != jit_cache.end()) {
+        ++jit_cache_stats.hits;
+        jit_cache.splice(jit_cache.begin(), jit_cache, it);
+    } else {
+        ++jit_cache_stats.misses;
+        if (jit_cache.size() >= MAX_CACHED_JITS) {
+            ++jit_cache_stats.evictions;
+            jit_cache.pop_back();
+        }
+        jit_cache.push_front(
+            {page_table.layout_id, MakeJit(page_table, new_address_space_size_in_bits)});
+    }
+    jit = jit_cache.front().jit.get();
+
+    LOG_DEBUG(Core_ARM, "Core {} JIT cache: hits={}, misses={}, evictions={}, clears={}",
+              core_index, jit_cache_stats.hits, jit_cache_stats.misses, jit_cache_stats.evictions,
+              jit_cache_stats.cache_clears);
+}
+
+const ARM_Dynarmic::JitCacheStats& ARM_Dynarmic::GetJitCacheStats() const {
+    return jit_cache_stats;
 }
 
 DynarmicExclusiveMonitor::DynarmicExclusiveMonitor(std::size_t core_count) : monitor(core_count) {}
 DynarmicExclusiveMonitor::~DynarmicExclusiveMonitor() = default;
 
-void DynarmicExclusiveMonitor::SetExclusive(std::size_t core_index, VAddr addr) {
-    // Size doesn't actually matter.
+u8 DynarmicExclusiveMonitor::ExclusiveRead8(std::size_t core_index, VAddr addr) {
+    monitor.Mark(core_index, addr, 1);
+    return Memory::Read8(addr);
+}
+
+u16 DynarmicExclusiveMonitor::ExclusiveRead16(std::size_t core_index, VAddr addr) {
+    monitor.Mark(core_index, addr, 2);
+    return Memory::Read16(addr);
+}
+
+u32 DynarmicExclusiveMonitor::ExclusiveRead32(std::size_t core_index, VAddr addr) {
+    monitor.Mark(core_index, addr, 4);
+    return Memory::Read32(addr);
+}
+
+u64 DynarmicExclusiveMonitor::ExclusiveRead64(std::size_t core_index, VAddr addr) {
+    monitor.Mark(core_index, addr, 8);
+    return Memory::Read64(addr);
+}
+
+u128 DynarmicExclusiveMonitor::ExclusiveRead128(std::size_t core_index, VAddr addr) {
     monitor.Mark(core_index, addr, 16);
+    return {Memory::Read64(addr), Memory::Read64(addr + 8)};
 }
 
 void DynarmicExclusiveMonitor::ClearExclusive() {
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <list>
 #include <memory>
 #include <dynarmic/A64/a64.h>
 #include <dynarmic/A64/exclusive_monitor.h>
@@ -48,13 +49,36 @@ public:
     void PageTableChanged(Common::PageTable& new_page_table,
                           std::size_t new_address_space_size_in_bits) override;
 
+    /// Counters of the JIT cache of this core
+    struct JitCacheStats {
+        u64 hits = 0;         ///< Page table switches that reused the JIT of the page table
+        u64 misses = 0;       ///< JITs created for a page table, starting without compiled code
+        u64 evictions = 0;    ///< JITs destroyed to stay within the cache capacity
+        u64 cache_clears = 0; ///< Instruction cache invalidations, which clear every cached JIT
+    };
+
+    const JitCacheStats& GetJitCacheStats() const;
+
 private:
+    /// Maximum number of JITs kept by a core. Every JIT reserves its own code cache, so this
+    /// bounds the host memory used for recompiled code.
+    static constexpr std::size_t MAX_CACHED_JITS = 4;
+
+    struct CachedJit {
+        u64 page_table_layout_id;
+        std::unique_ptr<Dynarmic::A64::Jit> jit;
+    };
+
     std::unique_ptr<Dynarmic::A64::Jit> MakeJit(Common::PageTable& page_table,
                                                 std::size_t address_space_bits) const;
 
     friend class ARM_Dynarmic_Callbacks;
     std::unique_ptr<ARM_Dynarmic_Callbacks> cb;
-    std::unique_ptr<Dynarmic::A64::Jit> jit;
+    /// JITs of the page tables this core ran recently, the most recently used one first
+    std::list<CachedJit> jit_cache;
+    /// JIT of the current page table, owned by jit_cache
+    Dynarmic::A64::Jit* jit = nullptr;
+    JitCacheStats jit_cache_stats;
     ARM_Unicorn inner_unicorn;
 
     std::size_t core_index;
@@ -67,7 +91,11 @@ public:
     explicit DynarmicExclusiveMonitor(std::size_t core_count);
     ~DynarmicExclusiveMonitor() override;
 
-    void SetExclusive(std::size_t core_index, VAddr addr) override;
+    u8 ExclusiveRead8(std::size_t core_index, VAddr addr) override;
+    u16 ExclusiveRead16(std::size_t core_index, VAddr addr) override;
+    u32 ExclusiveRead32(std::size_t core_index, VAddr addr) override;
+    u64 ExclusiveRead64(std::size_t core_index, VAddr addr) override;
+    u128 ExclusiveRead128(std::size_t core_index, VAddr addr) override;
     void ClearExclusive() override;
 
     bool ExclusiveWrite8(std::size_t core_index, VAddr vaddr, u8 value) override;
@@ -0,0 +1,70 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "core/arm/striped_exclusive_monitor.h"
+#include "core/memory.h"
+
+namespace Core {
+
+StripedExclusiveMonitor::StripedExclusiveMonitor(std::size_t core_count) : table{core_count} {}
+
+StripedExclusiveMonitor::~StripedExclusiveMonitor() = default;
+
+u8 StripedExclusiveMonitor::ExclusiveRead8(std::size_t core_index, VAddr addr) {
+    return table.Mark<u8>(core_index, addr, [addr] { return Memory::Read8(addr); });
+}
+
+u16 StripedExclusiveMonitor::ExclusiveRead16(std::size_t core_index, VAddr addr) {
+    return table.Mark<u16>(core_index, addr, [addr] { return Memory::Read16(addr); });
+}
+
+u32 StripedExclusiveMonitor::ExclusiveRead32(std::size_t core_index, VAddr addr) {
+    return table.Mark<u32>(core_index, addr, [addr] { return Memory::Read32(addr); });
+}
+
+u64 StripedExclusiveMonitor::ExclusiveRead64(std::size_t core_index, VAddr addr) {
+    return table.Mark<u64>(core_index, addr, [addr] { return Memory::Read64(addr); });
+}
+
+u128 StripedExclusiveMonitor::ExclusiveRead128(std::size_t core_index, VAddr addr) {
+    return table.Mark<u128>(core_index, addr, [addr] {
+        return u128{Memory::Read64(addr), Memory::Read64(addr + 8)};
+    });
+}
+
+void StripedExclusiveMonitor::ClearExclusive() {
+    table.Clear();
+}
+
+bool StripedExclusiveMonitor::ExclusiveWrite8(std::size_t core_index, VAddr vaddr, u8 value) {
+    return table.Commit<u8>(core_index, vaddr, [vaddr, value](u8 expected) {
+        return Memory::WriteExclusive8(vaddr, value, expected);
+    });
+}
+
+bool StripedExclusiveMonitor::ExclusiveWrite16(std::size_t core_index, VAddr vaddr, u16 value) {
+    return table.Commit<u16>(core_index, vaddr, [vaddr, value](u16 expected) {
+        return Memory::WriteExclusive16(vaddr, value, expected);
+    });
+}
+
+bool StripedExclusiveMonitor::ExclusiveWrite32(std::size_t core_index, VAddr vaddr, u32 value) {
+    return table.Commit<u32>(core_index, vaddr, [vaddr, value](u32 expected) {
+        return Memory::WriteExclusive32(vaddr, value, expected);
+    });
+}
+
+bool StripedExclusiveMonitor::ExclusiveWrite64(std::size_t core_index, VAddr vaddr, u64 value) {
+    return table.Commit<u64>(core_index, vaddr, [vaddr, value](u64 expected) {
+        return Memory::WriteExclusive64(vaddr, value, expected);
+    });
+}
+
+bool StripedExclusiveMonitor::ExclusiveWrite128(std::size_t core_index, VAddr vaddr, u128 value) {
+    return table.Commit<u128>(core_index, vaddr, [vaddr, &value](const u128& expected) {
+        return Memory::WriteExclusive128(vaddr, value, expected);
+    });
+}
+
+} // namespace Core
@@ -0,0 +1,144 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <vector>
+#include "common/common_types.h"
+#include "core/arm/exclusive_monitor.h"
+
+namespace Core {
+
+/**
+ * Tracks the exclusive reservations of each core without a global lock.
+ *
+ * Reservations are tracked per cache line. Every line maps to one stripe of a table of sequence
+ * numbers. A successful exclusive store holds its stripe for the duration of the store by making
+ * its sequence odd, and leaves it with a new even sequence. A reservation stays valid as long as
+ * the sequence of its stripe did not change since it was marked. Stores to other lines of the same
+ * stripe therefore make it fail spuriously, which the architecture allows.
+ *
+ * The reservation of a core may only be used by the host thread running that core.
+ */
+class ReservationTable {
+public:
+    static constexpr std::size_t NUM_STRIPES = 256;
+    static constexpr VAddr LINE_SIZE = 64;
+
+    explicit ReservationTable(std::size_t core_count) : reservations(core_count) {}
+
+    /**
+     * Marks an address as reserved by a core and reads its current value.
+     * @param read Reads the value at the address
+     * @returns the value returned by read
+     */
+    template <typename T, typename ReadFunc>
+    T Mark(std::size_t core_index, VAddr addr, ReadFunc&& read) {
+        static_assert(sizeof(T) <= sizeof(Reservation::value));
+
+        Reservation& reservation = reservations[core_index];
+        reservation.generation = clear_generation.load(std::memory_order_acquire);
+        reservation.sequence = GetStripe(addr).load(std::memory_order_acquire);
+        const T value = read();
+
+        reservation.address = addr;
+        // A store to the stripe is in progress, the value read may already be stale
+        reservation.is_valid = (reservation.sequence & 1) == 0;
+        std::memcpy(reservation.value.data(), &value, sizeof(T));
+        return value;
+    }
+
+    /**
+     * Performs an exclusive store if the core still holds a reservation for the address. The
+     * reservation is released in any case.
+     * @param write Writes the new value if the memory still holds the expected value passed to it,
+     *              returning true on success
+     * @returns true if the value was stored
+     */
+    template <typename T, typename WriteFunc>
+    bool Commit(std::size_t core_index, VAddr addr, WriteFunc&& write) {
+        Reservation& reservation = reservations[core_index];
+        if (!reservation.is_valid || reservation.address != addr) {
+            return false;
+        }
+        reservation.is_valid = false;
+
+        if (clear_generation.load(std::memory_order_acquire) != reservation.generation) {
+            return false;
+        }
+
+        std::atomic<u64>& stripe = GetStripe(addr);
+        u64 sequence = reservation.sequence;
+        if (!stripe.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+            return false;
+        }
+
+        T expected;
+        std::memcpy(&expected, reservation.value.data(), sizeof(T));
+        const bool result = write(expected);
+
+        stripe.store(sequence + 2, std::memory_order_release);
+        return result;
+    }
+
+    /// Invalidates the reservations of all cores
+    void Clear() {
+        clear_generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+private:
+    struct alignas(64) Stripe {
+        std::atomic<u64> sequence{0};
+    };
+
+    struct alignas(64) Reservation {
+        VAddr address = 0;
+        u64 sequence = 0;
+        u64 generation = 0;
+        bool is_valid = false;
+        std::array<u8, 16> value{};
+    };
+
+    std::atomic<u64>& GetStripe(VAddr addr) {
+        return stripes[(addr / LINE_SIZE) % NUM_STRIPES].sequence;
+    }
+
+    std::array<Stripe, NUM_STRIPES> stripes;
+    std::vector<Reservation> reservations;
+    std::atomic<u64> clear_generation{0};
+};
+
+/**
+ * Exclusive monitor backed by a ReservationTable. Exclusive stores of naturally aligned values up
+ * to 128 bits use a host compare-and-swap against the value read by the exclusive load, so plain
+ * stores from other cores to a reserved address also make them fail.
+ */
+class StripedExclusiveMonitor final : public ExclusiveMonitor {
+public:
+    explicit StripedExclusiveMonitor(std::size_t core_count);
+    ~StripedExclusiveMonitor() override;
+
+    u8 ExclusiveRead8(std::size_t core_index, VAddr addr) override;
+    u16 ExclusiveRead16(std::size_t core_index, VAddr addr) override;
+    u32 ExclusiveRead32(std::size_t core_index, VAddr addr) override;
+    u64 ExclusiveRead64(std::size_t core_index, VAddr addr) override;
+    u128 ExclusiveRead128(std::size_t core_index, VAddr addr) override;
+
+    void ClearExclusive() override;
+
+    bool ExclusiveWrite8(std::size_t core_index, VAddr vaddr, u8 value) override;
+    bool ExclusiveWrite16(std::size_t core_index, VAddr vaddr, u16 value) override;
+    bool ExclusiveWrite32(std::size_t core_index, VAddr vaddr, u32 value) override;
+    bool ExclusiveWrite64(std::size_t core_index, VAddr vaddr, u64 value) override;
+    bool ExclusiveWrite128(std::size_t core_index, VAddr vaddr, u128 value) override;
+
+private:
+    ReservationTable table;
+};
+
+} // namespace Core
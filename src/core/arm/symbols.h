@@ -0,0 +1,71 @@
+// Copyright 2018 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/bit_field.h"
+#include "common/common_types.h"
+
+namespace Core::Symbols {
+
+enum class ELFSymbolType : u8 {
+    None = 0,
+    Object = 1,
+    Function = 2,
+    Section = 3,
+    File = 4,
+    Common = 5,
+    TLS = 6,
+};
+
+enum class ELFSymbolBinding : u8 {
+    Local = 0,
+    Global = 1,
+    Weak = 2,
+};
+
+enum class ELFSymbolVisibility : u8 {
+    Default = 0,
+    Internal = 1,
+    Hidden = 2,
+    Protected = 3,
+};
+
+struct ELFSymbol {
+    u32 name_index;
+    union {
+        u8 info;
+
+        BitField<0, 4, ELFSymbolType> type;
+        BitField<4, 4, ELFSymbolBinding> binding;
+    };
+    ELFSymbolVisibility visibility;
+    u16 sh_index;
+    u64 value;
+    u64 size;
+};
+static_assert(sizeof(ELFSymbol) == 0x18, "ELFSymbol has incorrect size.");
+
+using Symbols = std::vector<std::pair<ELFSymbol, std::string>>;
+
+/**
+ * Reads the dynamic symbol table of a module loaded in the current process.
+ * @param text_offset Address the text segment of the module is loaded at
+ * @returns the symbols of the module, with values relative to text_offset
+ */
+Symbols GetSymbols(VAddr text_offset);
+
+/**
+ * Finds the symbol that contains an address.
+ * @param symbols Symbols of the module the address belongs to
+ * @param func_address Address relative to the text segment of the module
+ * @returns the name of the symbol, if one contains the address
+ */
+std::optional<std::string> GetSymbolName(const Symbols& symbols, VAddr func_address);
+
+} // namespace Core::Symbols
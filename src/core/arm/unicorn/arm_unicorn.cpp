@@ -38,6 +38,11 @@ LoadDll LoadDll::g_load_dll;
     } while (0)
 
 static void CodeHook(uc_engine* uc, uint64_t address, uint32_t size, void* user_data) {
+    if (!GDBStub::IsMemoryBreak() &&
+        !GDBStub::IsBreakpointPage(address, GDBStub::BreakpointType::Execute)) {
+        return;
+    }
+
     GDBStub::BreakpointAddress bkpt =
         GDBStub::GetNextBreakpointFromAddress(address, GDBStub::BreakpointType::Execute);
     if (GDBStub::IsMemoryBreak() ||
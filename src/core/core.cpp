@@ -19,6 +19,7 @@
 #include "core/file_sys/vfs_concat.h"
 #include "core/file_sys/vfs_real.h"
 #include "core/gdbstub/gdbstub.h"
+#include "core/guest_profiler.h"
 #include "core/hardware_interrupt_manager.h"
 #include "core/hle/kernel/client_port.h"
 #include "core/hle/kernel/kernel.h"
@@ -123,6 +124,7 @@ struct System::Impl {
 
         core_timing.Initialize();
         cpu_core_manager.Initialize();
+        core_timing.StartHostTimer();
         kernel.Initialize();
 
         const auto current_time = std::chrono::duration_cast<std::chrono::seconds>(
@@ -143,6 +145,8 @@ struct System::Impl {
         arp_manager.ResetAll();
 
         telemetry_session = std::make_unique<Core::TelemetrySession>();
+        guest_profiler = std::make_unique<Core::GuestProfiler>(system);
+        memory_freezer = std::make_unique<Tools::Freezer>(core_timing);
         service_manager = std::make_shared<Service::SM::ServiceManager>();
 
         Service::Init(service_manager, system);
@@ -227,10 +231,13 @@ struct System::Impl {
         Service::Shutdown();
         service_manager.reset();
         cheat_engine.reset();
+        memory_freezer.reset();
+        guest_profiler.reset();
         telemetry_session.reset();
         gpu_core.reset();
 
         // Close all CPU/threading state
+        core_timing.StopHostTimer();
         cpu_core_manager.Shutdown();
 
         // Shutdown kernel and core timing
@@ -321,6 +328,9 @@ struct System::Impl {
     /// Telemetry session for this emulation session
     std::unique_ptr<Core::TelemetrySession> telemetry_session;
 
+    /// Sampling profiler for guest code of this emulation session
+    std::unique_ptr<Core::GuestProfiler> guest_profiler;
+
     Reporter reporter;
 
     ResultStatus status = ResultStatus::Success;
@@ -486,6 +496,22 @@ const Core::PerfStats& System::GetPerfStats() const {
     return impl->perf_stats;
 }
 
+Core::GuestProfiler& System::GetGuestProfiler() {
+    return *impl->guest_profiler;
+}
+
+const Core::GuestProfiler& System::GetGuestProfiler() const {
+    return *impl->guest_profiler;
+}
+
+Tools::Freezer& System::GetMemoryFreezer() {
+    return *impl->memory_freezer;
+}
+
+const Tools::Freezer& System::GetMemoryFreezer() const {
+    return *impl->memory_freezer;
+}
+
 Core::FrameLimiter& System::FrameLimiter() {
     return impl->frame_limiter;
 }
@@ -74,12 +74,17 @@ namespace Core::Hardware {
 class InterruptManager;
 }
 
+namespace Tools {
+class Freezer;
+}
+
 namespace Core {
 
 class ARM_Interface;
 class Cpu;
 class ExclusiveMonitor;
 class FrameLimiter;
+class GuestProfiler;
 class PerfStats;
 class Reporter;
 class TelemetrySession;
@@ -256,6 +261,18 @@ public:
     /// Provides a constant reference to the internal PerfStats instance.
     const Core::PerfStats& GetPerfStats() const;
 
+    /// Provides a reference to the guest code profiler of this emulation session.
+    Core::GuestProfiler& GetGuestProfiler();
+
+    /// Provides a constant reference to the guest code profiler of this emulation session.
+    const Core::GuestProfiler& GetGuestProfiler() const;
+
+    /// Provides a reference to the memory freezer of this emulation session.
+    Tools::Freezer& GetMemoryFreezer();
+
+    /// Provides a constant reference to the memory freezer of this emulation session.
+    const Tools::Freezer& GetMemoryFreezer() const;
+
     /// Provides a reference to the frame limiter;
     Core::FrameLimiter& FrameLimiter();
 
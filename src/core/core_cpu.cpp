@@ -10,6 +10,7 @@
 #include "core/arm/dynarmic/arm_dynarmic.h"
 #endif
 #include "core/arm/exclusive_monitor.h"
+#include "core/arm/striped_exclusive_monitor.h"
 #include "core/arm/unicorn/arm_unicorn.h"
 #include "core/core.h"
 #include "core/core_cpu.h"
@@ -17,6 +18,7 @@
 #include "core/hle/kernel/scheduler.h"
 #include "core/hle/kernel/thread.h"
 #include "core/hle/lock.h"
+#include "core/perf_stats.h"
 #include "core/settings.h"
 
 namespace Core {
@@ -52,7 +54,8 @@ bool CpuBarrier::Rendezvous() {
 
 Cpu::Cpu(System& system, ExclusiveMonitor& exclusive_monitor, CpuBarrier& cpu_barrier,
          std::size_t core_index)
-    : cpu_barrier{cpu_barrier}, core_timing{system.CoreTiming()}, core_index{core_index} {
+    : cpu_barrier{cpu_barrier}, core_timing{system.CoreTiming()},
+      perf_stats{system.GetPerfStats()}, core_index{core_index} {
 #ifdef ARCHITECTURE_x86_64
     arm_interface = std::make_unique<ARM_Dynarmic>(system, exclusive_monitor, core_index);
 #else
@@ -69,8 +72,7 @@ std::unique_ptr<ExclusiveMonitor> Cpu::MakeExclusiveMonitor(std::size_t num_core
 #ifdef ARCHITECTURE_x86_64
     return std::make_unique<DynarmicExclusiveMonitor>(num_cores);
 #else
-    // TODO(merry): Passthrough exclusive monitor
-    return nullptr;
+    return std::make_unique<StripedExclusiveMonitor>(num_cores);
 #endif
 }
 
@@ -98,6 +100,7 @@ void Cpu::RunLoop(bool tight_loop) {
             core_timing.Advance();
         }
 
+        PerfStats::ScopedTimer timer{perf_stats, PerfSubsystem::CpuEmulation};
         if (tight_loop) {
             arm_interface->Run();
         } else {
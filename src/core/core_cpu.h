@@ -27,6 +27,7 @@ namespace Core {
 
 class ARM_Interface;
 class ExclusiveMonitor;
+class PerfStats;
 
 constexpr unsigned NUM_CPU_CORES{4};
 
@@ -92,6 +93,7 @@ private:
     CpuBarrier& cpu_barrier;
     std::unique_ptr<Kernel::Scheduler> scheduler;
     Timing::CoreTiming& core_timing;
+    PerfStats& perf_stats;
 
     std::atomic<bool> reschedule_pending = false;
     std::size_t core_index;
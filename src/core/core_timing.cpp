@@ -10,8 +10,11 @@
 #include <tuple>
 
 #include "common/assert.h"
+#include "common/logging/log.h"
 #include "common/thread.h"
+#include "common/wall_clock.h"
 #include "core/core_timing_util.h"
+#include "core/settings.h"
 
 namespace Core::Timing {
 
@@ -53,13 +56,75 @@ void CoreTiming::Initialize() {
 
     const auto empty_timed_callback = [](u64, s64) {};
     ev_lost = RegisterEvent("_lost_event", empty_timed_callback);
+
+    is_host_timing = Settings::values.use_host_timing;
+    if (is_host_timing) {
+        clock = Common::CreateBestMatchingClock(static_cast<u32>(BASE_CLOCK_RATE),
+                                                static_cast<u32>(CNTFREQ));
+        LOG_INFO(Core_Timing, "Using {} host clock for guest time",
+                 clock->IsNative() ? "native" : "standard");
+    }
+}
+
+void CoreTiming::StartHostTimer() {
+    if (!is_host_timing || host_timer_thread.joinable()) {
+        return;
+    }
+    host_timer_stop = false;
+    last_reported_event_time = -1;
+    event_due = false;
+    host_timer_thread = std::thread(&CoreTiming::HostTimerLoop, this);
 }
 
 void CoreTiming::Shutdown() {
+    StopHostTimer();
     ClearPendingEvents();
     UnregisterAllEvents();
 }
 
+void CoreTiming::StopHostTimer() {
+    if (!host_timer_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard guard{inner_mutex};
+        host_timer_stop = true;
+    }
+    host_timer_cv.notify_all();
+    host_timer_thread.join();
+}
+
+void CoreTiming::HostTimerLoop() {
+    Common::SetCurrentThreadName("yuzu:HostTimer");
+
+    std::unique_lock lock{inner_mutex};
+    while (!host_timer_stop) {
+        if (event_queue.empty()) {
+            host_timer_cv.wait(lock);
+            continue;
+        }
+
+        const s64 next_event_time = event_queue.front().time;
+        const s64 remaining = next_event_time - static_cast<s64>(clock->GetCPUCycles());
+        if (remaining > 0) {
+            // Wake up at least once per second, which also keeps CyclesToNs from overflowing
+            const s64 wait_cycles = std::min<s64>(remaining, BASE_CLOCK_RATE);
+            host_timer_cv.wait_for(lock, CyclesToNs(wait_cycles));
+            continue;
+        }
+
+        if (next_event_time == last_reported_event_time) {
+            // Already reported, wait for Advance() to run it or for an earlier event
+            host_timer_cv.wait(lock);
+            continue;
+        }
+
+        // The main core sees this through its downcount and runs Advance() after its slice
+        last_reported_event_time = next_event_time;
+        event_due = true;
+    }
+}
+
 EventType* CoreTiming::RegisterEvent(const std::string& name, TimedCallback callback) {
     std::lock_guard guard{inner_mutex};
     // check for existing type with same name.
@@ -86,12 +151,17 @@ void CoreTiming::ScheduleEvent(s64 cycles_into_future, const EventType* event_ty
     const s64 timeout = GetTicks() + cycles_into_future;
 
     // If this event needs to be scheduled before the next advance(), force one early
-    if (!is_global_timer_sane) {
+    if (!is_global_timer_sane && !is_host_timing) {
         ForceExceptionCheck(cycles_into_future);
     }
 
     event_queue.emplace_back(Event{timeout, event_fifo_id++, userdata, event_type});
     std::push_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+
+    // Let the timer thread pick up the new deadline if it is the earliest one
+    if (is_host_timing && event_queue.front().fifo_order == event_fifo_id - 1) {
+        host_timer_cv.notify_all();
+    }
 }
 
 void CoreTiming::UnscheduleEvent(const EventType* event_type, u64 userdata) {
@@ -108,6 +178,10 @@ void CoreTiming::UnscheduleEvent(const EventType* event_type, u64 userdata) {
 }
 
 u64 CoreTiming::GetTicks() const {
+    if (is_host_timing) {
+        return clock->GetCPUCycles();
+    }
+
     u64 ticks = static_cast<u64>(global_timer);
     if (!is_global_timer_sane) {
         ticks += slice_length - downcount;
@@ -119,8 +193,15 @@ u64 CoreTiming::GetIdleTicks() const {
     return static_cast<u64>(idled_cycles);
 }
 
+u64 CoreTiming::GetClockTicks() const {
+    if (is_host_timing) {
+        return clock->GetClockCycles();
+    }
+    return CpuCyclesToClockCycles(GetTicks());
+}
+
 void CoreTiming::AddTicks(u64 ticks) {
-    downcount -= static_cast<int>(ticks);
+    downcount.fetch_sub(static_cast<int>(ticks), std::memory_order_relaxed);
 }
 
 void CoreTiming::ClearPendingEvents() {
@@ -155,7 +236,12 @@ void CoreTiming::Advance() {
     std::unique_lock<std::mutex> guard(inner_mutex);
 
     const int cycles_executed = slice_length - downcount;
-    global_timer += cycles_executed;
+    if (is_host_timing) {
+        event_due = false;
+        global_timer = static_cast<s64>(clock->GetCPUCycles());
+    } else {
+        global_timer += cycles_executed;
+    }
     slice_length = MAX_SLICE_LENGTH;
 
     is_global_timer_sane = true;
@@ -171,8 +257,11 @@ void CoreTiming::Advance() {
 
     is_global_timer_sane = false;
 
-    // Still events left (scheduled in the future)
-    if (!event_queue.empty()) {
+    if (is_host_timing) {
+        slice_length = MAX_SLICE_LENGTH;
+        host_timer_cv.notify_all();
+    } else if (!event_queue.empty()) {
+        // Still events left (scheduled in the future)
         slice_length = static_cast<int>(
             std::min<s64>(event_queue.front().time - global_timer, MAX_SLICE_LENGTH));
     }
@@ -181,16 +270,42 @@ void CoreTiming::Advance() {
 }
 
 void CoreTiming::Idle() {
-    idled_cycles += downcount;
+    if (!is_host_timing) {
+        idled_cycles += downcount;
+        downcount = 0;
+        return;
+    }
+
+    // Guest time follows the host clock and can't skip ahead to the next event. Sleep until it is
+    // due instead of spinning through empty slices, ScheduleEvent wakes us up for earlier events.
+    std::unique_lock lock{inner_mutex};
+    const u64 idle_begin = clock->GetCPUCycles();
+    while (!host_timer_stop && !event_due) {
+        const s64 now = static_cast<s64>(clock->GetCPUCycles());
+        const s64 remaining =
+            event_queue.empty() ? static_cast<s64>(BASE_CLOCK_RATE) : event_queue.front().time - now;
+        if (remaining <= 0) {
+            break;
+        }
+        host_timer_cv.wait_for(lock, CyclesToNs(std::min<s64>(remaining, BASE_CLOCK_RATE)));
+    }
+    idled_cycles += static_cast<s64>(clock->GetCPUCycles() - idle_begin);
     downcount = 0;
 }
 
 std::chrono::microseconds CoreTiming::GetGlobalTimeUs() const {
+    if (is_host_timing) {
+        return clock->GetTimeUS();
+    }
     return std::chrono::microseconds{GetTicks() * 1000000 / BASE_CLOCK_RATE};
 }
 
 int CoreTiming::GetDowncount() const {
-    return downcount;
+    // A due event ends the slice as soon as the core checks its downcount
+    if (event_due.load(std::memory_order_relaxed)) {
+        return 0;
+    }
+    return downcount.load(std::memory_order_relaxed);
 }
 
 } // namespace Core::Timing
@@ -4,15 +4,23 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 #include "common/common_types.h"
 #include "common/threadsafe_queue.h"
 
+namespace Common {
+class WallClock;
+}
+
 namespace Core::Timing {
 
 /// A callback that may be scheduled for a particular core timing event.
@@ -37,6 +45,10 @@ struct EventType {
  * So to schedule a new event on a regular basis:
  * inside callback:
  *   ScheduleEvent(periodInCycles - cyclesLate, callback, "whatever")
+ *
+ * With host timing enabled, time is read from a scaled host clock instead of being derived from
+ * the number of cycles executed. A timer thread then waits for the next event deadline and flags
+ * it as due, which zeroes the downcount so the main core calls Advance() after its current slice.
  */
 class CoreTiming {
 public:
@@ -56,6 +68,18 @@ public:
     /// Tears down all timing related functionality.
     void Shutdown();
 
+    /// Starts the host timer thread if host timing is enabled. This must be called once the CPU
+    /// cores are initialized, as they are the ones running the events it reports.
+    void StartHostTimer();
+
+    /// Stops the host timer thread, which must be done before the CPU cores are shut down.
+    void StopHostTimer();
+
+    /// Returns true if time is read from the host clock
+    bool IsHostTiming() const {
+        return is_host_timing;
+    }
+
     /// Registers a core timing event with the given name and callback.
     ///
     /// @param name     The name of the core timing event to register.
@@ -90,6 +114,10 @@ public:
 
     u64 GetIdleTicks() const;
 
+    /// Returns the current value of the guest system counter, which runs at CNTFREQ
+    u64 GetClockTicks() const;
+
+    /// Charges ticks to the current slice. This may be called from any core.
     void AddTicks(u64 ticks);
 
     /// Advance must be called at the beginning of dispatcher loops, not the end. Advance() ends
@@ -99,7 +127,8 @@ public:
     /// instructions is executed.
     void Advance();
 
-    /// Pretend that the main CPU has executed enough cycles to reach the next event.
+    /// Pretend that the main CPU has executed enough cycles to reach the next event. Under host
+    /// timing, this sleeps until the next event is due instead.
     void Idle();
 
     std::chrono::microseconds GetGlobalTimeUs() const;
@@ -112,10 +141,14 @@ private:
     /// Clear all pending events. This should ONLY be done on exit.
     void ClearPendingEvents();
 
+    /// Waits for event deadlines on the host clock and reports due events
+    void HostTimerLoop();
+
     s64 global_timer = 0;
     s64 idled_cycles = 0;
     int slice_length = 0;
-    int downcount = 0;
+    /// Atomic as the cores other than the main one charge ticks from SVCs outside of any lock
+    std::atomic<int> downcount{0};
 
     // Are we in a function that has been called from Advance()
     // If events are scheduled from a function that gets called from Advance(),
@@ -136,6 +169,16 @@ private:
     EventType* ev_lost = nullptr;
 
     std::mutex inner_mutex;
+
+    bool is_host_timing = false;
+    std::unique_ptr<Common::WallClock> clock;
+    std::thread host_timer_thread;
+    /// Set by the timer thread when an event is due, cleared by Advance()
+    std::atomic_bool event_due{false};
+    std::condition_variable host_timer_cv;
+    bool host_timer_stop = false;
+    /// Time of the last due event reported by the timer thread
+    s64 last_reported_event_time = -1;
 };
 
 } // namespace Core::Timing
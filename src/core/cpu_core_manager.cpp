@@ -112,11 +112,12 @@ void CpuCoreManager::RunLoop(bool tight_loop) {
         GDBStub::HandlePacket();
 
         // If the loop is halted and we want to step, use a tiny (1) number of instructions to
-        // execute. Otherwise, get out of the loop function.
+        // execute. Otherwise, wait for gdb and get out of the loop function.
         if (GDBStub::GetCpuHaltFlag()) {
             if (GDBStub::GetCpuStepFlag()) {
                 tight_loop = false;
             } else {
+                GDBStub::WaitForPacket();
                 return;
             }
         }
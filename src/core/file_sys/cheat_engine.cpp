@@ -2,6 +2,8 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <cstring>
+#include <limits>
 #include <locale>
 #include "common/hex_util.h"
 #include "common/microprofile.h"
@@ -14,6 +16,7 @@
 #include "core/hle/service/hid/controllers/npad.h"
 #include "core/hle/service/hid/hid.h"
 #include "core/hle/service/sm/sm.h"
+#include "core/memory.h"
 
 namespace FileSys {
 
@@ -46,13 +49,18 @@ u32 Cheat::KeypadValue() const {
 }
 
 void CheatList::SetMemoryParameters(VAddr main_begin, VAddr heap_begin, VAddr main_end,
-                                    VAddr heap_end, MemoryWriter writer, MemoryReader reader) {
+                                    VAddr heap_end, MemoryWriter writer, MemoryReader reader,
+                                    MemoryResolver resolver) {
     this->main_region_begin = main_begin;
     this->main_region_end = main_end;
     this->heap_region_begin = heap_begin;
     this->heap_region_end = heap_end;
     this->writer = writer;
     this->reader = reader;
+    this->resolver = resolver;
+
+    // Addresses relative to a memory region are resolved at compile time
+    Compile();
 }
 
 MICROPROFILE_DEFINE(Cheat_Engine, "Add-Ons", "Cheat Engine", MP_RGB(70, 200, 70));
@@ -61,173 +69,269 @@ void CheatList::Execute() {
     MICROPROFILE_SCOPE(Cheat_Engine);
 
     std::fill(scratch.begin(), scratch.end(), 0);
-    in_standard = false;
-    for (std::size_t i = 0; i < master_list.size(); ++i) {
-        LOG_DEBUG(Common_Filesystem, "Executing block #{:08X} ({})", i, master_list[i].first);
-        current_block = i;
-        ExecuteBlock(master_list[i].second);
-    }
 
-    in_standard = true;
-    for (std::size_t i = 0; i < standard_list.size(); ++i) {
-        LOG_DEBUG(Common_Filesystem, "Executing block #{:08X} ({})", i, standard_list[i].first);
-        current_block = i;
-        ExecuteBlock(standard_list[i].second);
+    const std::size_t program_size = program.size();
+    for (std::size_t pc = 0; pc < program_size; ++pc) {
+        const Instruction& instruction = program[pc];
+        u64& reg = scratch[instruction.reg];
+
+        switch (instruction.opcode) {
+        case Opcode::Write:
+            WriteMemory(instruction.width, instruction.address + reg, instruction.value);
+            break;
+        case Opcode::CompareMemory:
+            if (!EvaluateComparison(instruction)) {
+                pc = instruction.target - 1;
+            }
+            break;
+        case Opcode::CompareInput:
+            if (!EvaluateInput(static_cast<u32>(instruction.value))) {
+                pc = instruction.target - 1;
+            }
+            break;
+        case Opcode::LoopBegin: {
+            s64& counter = loop_counters[instruction.address];
+            counter = static_cast<s32>(instruction.value);
+            if (counter < 0) {
+                pc = instruction.target - 1;
+            } else {
+                reg = static_cast<u64>(counter);
+            }
+            break;
+        }
+        case Opcode::LoopEnd: {
+            s64& counter = loop_counters[instruction.address];
+            if (--counter >= 0) {
+                reg = static_cast<u64>(counter);
+                pc = instruction.target - 1;
+            }
+            break;
+        }
+        case Opcode::LoadImmediate:
+            reg = instruction.value;
+            break;
+        case Opcode::LoadMemory:
+            reg = ReadMemory(instruction.width, instruction.address);
+            break;
+        case Opcode::LoadMemoryIndexed:
+            reg = ReadMemory(instruction.width, reg + instruction.address);
+            break;
+        case Opcode::StoreIndexed: {
+            const u64 offset = instruction.add_register ? scratch[instruction.aux] : 0;
+            WriteMemory(instruction.width, reg + offset, instruction.value);
+            if (instruction.increment) {
+                reg += instruction.width;
+            }
+            break;
+        }
+        case Opcode::Arithmetic:
+            EvaluateArithmetic(instruction);
+            break;
+        }
     }
 }
 
 CheatList::CheatList(const Core::System& system_, ProgramSegment master, ProgramSegment standard)
     : master_list{std::move(master)}, standard_list{std::move(standard)}, system{&system_} {}
 
-bool CheatList::EvaluateConditional(const Cheat& cheat) const {
-    using ComparisonFunction = bool (*)(u64, u64);
-    constexpr std::array<ComparisonFunction, 6> comparison_functions{
-        [](u64 a, u64 b) { return a > b; },  [](u64 a, u64 b) { return a >= b; },
-        [](u64 a, u64 b) { return a < b; },  [](u64 a, u64 b) { return a <= b; },
-        [](u64 a, u64 b) { return a == b; }, [](u64 a, u64 b) { return a != b; },
-    };
+void CheatList::Compile() {
+    program.clear();
+    loop_counters.clear();
 
-    if (cheat.type == CodeType::ConditionalInput) {
-        const auto applet_resource =
-            system->ServiceManager().GetService<Service::HID::Hid>("hid")->GetAppletResource();
-        if (applet_resource == nullptr) {
-            LOG_WARNING(
-                Common_Filesystem,
-                "Attempted to evaluate input conditional, but applet resource is not initialized!");
-            return false;
+    for (const auto* segment : {&master_list, &standard_list}) {
+        for (const auto& [name, block] : *segment) {
+            if (!CompileBlock(block)) {
+                LOG_ERROR(Common_Filesystem, "Cheat '{}' is malformed and will not be executed",
+                          name);
+            }
         }
-
-        const auto press_state =
-            applet_resource
-                ->GetController<Service::HID::Controller_NPad>(Service::HID::HidController::NPad)
-                .GetAndResetPressState();
-        return ((press_state & cheat.KeypadValue()) & KEYPAD_BITMASK) != 0;
     }
 
-    ASSERT(cheat.type == CodeType::Conditional);
+    LOG_DEBUG(Common_Filesystem, "Compiled {} cheats into {} instructions",
+              master_list.size() + standard_list.size(), program.size());
+}
 
-    const auto offset =
-        cheat.memory_type == MemoryType::MainNSO ? main_region_begin : heap_region_begin;
-    ASSERT(static_cast<u8>(cheat.comparison_op.Value()) < 6);
-    auto* function = comparison_functions[static_cast<u8>(cheat.comparison_op.Value())];
-    const auto addr = cheat.Address() + offset;
+bool CheatList::CompileBlock(const Block& block) {
+    const std::size_t block_begin = program.size();
+    const std::size_t num_loop_counters = loop_counters.size();
 
-    return function(reader(cheat.width, SanitizeAddress(addr)), cheat.ValueWidth(8));
-}
+    // Indices of the instructions opening the scopes that are not closed yet
+    std::vector<std::size_t> scopes;
 
-void CheatList::ProcessBlockPairs(const Block& block) {
-    block_pairs.clear();
+    const auto fail = [&] {
+        program.resize(block_begin);
+        loop_counters.resize(num_loop_counters);
+        return false;
+    };
 
-    u64 scope = 0;
-    std::map<u64, u64> pairs;
+    for (const Cheat& cheat : block) {
+        const auto width = static_cast<u8>(cheat.width.Value());
+        const u64 region_offset =
+            cheat.memory_type == MemoryType::MainNSO ? main_region_begin : heap_region_begin;
 
-    for (std::size_t i = 0; i < block.size(); ++i) {
-        const auto& cheat = block[i];
+        Instruction instruction{};
+        instruction.width = width;
+        instruction.reg = static_cast<u8>(cheat.register_3.Value());
 
         switch (cheat.type) {
-        case CodeType::Conditional:
+        case CodeType::WriteImmediate:
+            instruction.opcode = Opcode::Write;
+            instruction.address = cheat.Address() + region_offset;
+            instruction.value = cheat.ValueWidth(8);
+            break;
+        case CodeType::Conditional: {
+            const auto op = static_cast<u8>(cheat.comparison_op.Value());
+            if (op < static_cast<u8>(ComparisonOp::GreaterThan) ||
+                op > static_cast<u8>(ComparisonOp::Inequal)) {
+                LOG_ERROR(Common_Filesystem, "Invalid comparison operation {}", op);
+                return fail();
+            }
+            instruction.opcode = Opcode::CompareMemory;
+            instruction.aux = op;
+            instruction.address = cheat.Address() + region_offset;
+            instruction.value = cheat.ValueWidth(8);
+            scopes.push_back(program.size());
+            break;
+        }
         case CodeType::ConditionalInput:
-            pairs.insert_or_assign(scope, i);
-            ++scope;
+            instruction.opcode = Opcode::CompareInput;
+            instruction.value = cheat.KeypadValue() & KEYPAD_BITMASK;
+            scopes.push_back(program.size());
             break;
         case CodeType::EndConditional: {
-            --scope;
-            const auto idx = pairs.at(scope);
-            block_pairs.insert_or_assign(idx, i);
-            break;
+            if (scopes.empty() || program[scopes.back()].opcode == Opcode::LoopBegin) {
+                LOG_ERROR(Common_Filesystem, "EndConditional without a matching conditional");
+                return fail();
+            }
+            // Conditionals jump past their end, which doesn't need an instruction of its own
+            program[scopes.back()].target = static_cast<u32>(program.size());
+            scopes.pop_back();
+            continue;
         }
         case CodeType::Loop: {
-            if (cheat.end_of_loop) {
-                --scope;
-                const auto idx = pairs.at(scope);
-                block_pairs.insert_or_assign(idx, i);
+            if (!cheat.end_of_loop) {
+                instruction.opcode = Opcode::LoopBegin;
+                instruction.address = loop_counters.size();
+                instruction.value = cheat.Value(4, sizeof(s32));
+                loop_counters.push_back(0);
+                scopes.push_back(program.size());
+                break;
+            }
+            if (scopes.empty() || program[scopes.back()].opcode != Opcode::LoopBegin) {
+                LOG_ERROR(Common_Filesystem, "Loop end without a matching loop begin");
+                return fail();
+            }
+            const std::size_t begin_index = scopes.back();
+            scopes.pop_back();
+            Instruction& begin = program[begin_index];
+            begin.target = static_cast<u32>(program.size() + 1);
+            instruction.opcode = Opcode::LoopEnd;
+            instruction.reg = begin.reg;
+            instruction.address = begin.address;
+            instruction.target = static_cast<u32>(begin_index + 1);
+            break;
+        }
+        case CodeType::LoadImmediate:
+            instruction.opcode = Opcode::LoadImmediate;
+            instruction.value = cheat.Value(4, 8);
+            break;
+        case CodeType::LoadIndexed:
+            if (cheat.load_from_register) {
+                instruction.opcode = Opcode::LoadMemoryIndexed;
+                instruction.address = cheat.Address();
             } else {
-                pairs.insert_or_assign(scope, i);
-                ++scope;
+                instruction.opcode = Opcode::LoadMemory;
+                instruction.address = cheat.Address() + region_offset;
             }
             break;
+        case CodeType::StoreIndexed:
+            instruction.opcode = Opcode::StoreIndexed;
+            instruction.aux = static_cast<u8>(cheat.register_6.Value());
+            instruction.add_register = cheat.add_additional_register != 0;
+            instruction.increment = cheat.increment_register != 0;
+            instruction.value = cheat.ValueWidth(4);
+            break;
+        case CodeType::RegisterArithmetic: {
+            const auto op = static_cast<u8>(cheat.arithmetic_op.Value());
+            if (op > static_cast<u8>(ArithmeticOp::RShift)) {
+                LOG_ERROR(Common_Filesystem, "Invalid arithmetic operation {}", op);
+                return fail();
+            }
+            instruction.opcode = Opcode::Arithmetic;
+            instruction.aux = op;
+            instruction.value = cheat.ValueWidth(4);
+            break;
         }
+        default:
+            LOG_ERROR(Common_Filesystem, "Unknown cheat code type {}",
+                      static_cast<u32>(cheat.type.Value()));
+            return fail();
         }
-    }
-}
-
-void CheatList::WriteImmediate(const Cheat& cheat) {
-    const auto offset =
-        cheat.memory_type == MemoryType::MainNSO ? main_region_begin : heap_region_begin;
-    const auto& register_3 = scratch.at(cheat.register_3);
 
-    const auto addr = cheat.Address() + offset + register_3;
-    LOG_DEBUG(Common_Filesystem, "writing value={:016X} to addr={:016X}", addr,
-              cheat.Value(8, cheat.width));
-    writer(cheat.width, SanitizeAddress(addr), cheat.ValueWidth(8));
-}
+        const bool accesses_memory =
+            instruction.opcode == Opcode::Write || instruction.opcode == Opcode::CompareMemory ||
+            instruction.opcode == Opcode::LoadMemory ||
+            instruction.opcode == Opcode::LoadMemoryIndexed ||
+            instruction.opcode == Opcode::StoreIndexed;
+        if (accesses_memory && width != 1 && width != 2 && width != 4 && width != 8) {
+            LOG_ERROR(Common_Filesystem, "Invalid access width {}", width);
+            return fail();
+        }
 
-void CheatList::BeginConditional(const Cheat& cheat) {
-    if (EvaluateConditional(cheat)) {
-        return;
+        program.push_back(instruction);
     }
 
-    const auto iter = block_pairs.find(current_index);
-    ASSERT(iter != block_pairs.end());
-    current_index = iter->second - 1;
-}
-
-void CheatList::EndConditional(const Cheat& cheat) {
-    LOG_DEBUG(Common_Filesystem, "Ending conditional block.");
-}
-
-void CheatList::Loop(const Cheat& cheat) {
-    if (cheat.end_of_loop.Value())
-        ASSERT(!cheat.end_of_loop.Value());
-
-    auto& register_3 = scratch.at(cheat.register_3);
-    const auto iter = block_pairs.find(current_index);
-    ASSERT(iter != block_pairs.end());
-    ASSERT(iter->first < iter->second);
-
-    const s32 initial_value = static_cast<s32>(cheat.Value(4, sizeof(s32)));
-    for (s32 i = initial_value; i >= 0; --i) {
-        register_3 = static_cast<u64>(i);
-        for (std::size_t c = iter->first + 1; c < iter->second; ++c) {
-            current_index = c;
-            ExecuteSingleCheat(
-                (in_standard ? standard_list : master_list)[current_block].second[c]);
+    for (const std::size_t scope : scopes) {
+        if (program[scope].opcode == Opcode::LoopBegin) {
+            LOG_ERROR(Common_Filesystem, "Loop without a matching loop end");
+            return fail();
         }
+        // Conditionals implicitly end with the cheat
+        program[scope].target = static_cast<u32>(program.size());
     }
-
-    current_index = iter->second;
+    return true;
 }
 
-void CheatList::LoadImmediate(const Cheat& cheat) {
-    auto& register_3 = scratch.at(cheat.register_3);
-
-    LOG_DEBUG(Common_Filesystem, "setting register={:01X} equal to value={:016X}", cheat.register_3,
-              cheat.Value(4, 8));
-    register_3 = cheat.Value(4, 8);
-}
-
-void CheatList::LoadIndexed(const Cheat& cheat) {
-    const auto offset =
-        cheat.memory_type == MemoryType::MainNSO ? main_region_begin : heap_region_begin;
-    auto& register_3 = scratch.at(cheat.register_3);
+bool CheatList::EvaluateInput(u32 key_mask) const {
+    const auto applet_resource =
+        system->ServiceManager().GetService<Service::HID::Hid>("hid")->GetAppletResource();
+    if (applet_resource == nullptr) {
+        LOG_WARNING(
+            Common_Filesystem,
+            "Attempted to evaluate input conditional, but applet resource is not initialized!");
+        return false;
+    }
 
-    const auto addr = (cheat.load_from_register.Value() ? register_3 : offset) + cheat.Address();
-    LOG_DEBUG(Common_Filesystem, "writing indexed value to register={:01X}, addr={:016X}",
-              cheat.register_3, addr);
-    register_3 = reader(cheat.width, SanitizeAddress(addr));
+    const auto press_state =
+        applet_resource
+            ->GetController<Service::HID::Controller_NPad>(Service::HID::HidController::NPad)
+            .GetAndResetPressState();
+    return (press_state & key_mask) != 0;
 }
 
-void CheatList::StoreIndexed(const Cheat& cheat) {
-    const auto& register_3 = scratch.at(cheat.register_3);
-
-    const auto addr =
-        register_3 + (cheat.add_additional_register.Value() ? scratch.at(cheat.register_6) : 0);
-    LOG_DEBUG(Common_Filesystem, "writing value={:016X} to addr={:016X}",
-              cheat.Value(4, cheat.width), addr);
-    writer(cheat.width, SanitizeAddress(addr), cheat.ValueWidth(4));
+bool CheatList::EvaluateComparison(const Instruction& instruction) const {
+    const u64 lhs = ReadMemory(instruction.width, instruction.address);
+    const u64 rhs = instruction.value;
+
+    switch (static_cast<ComparisonOp>(instruction.aux)) {
+    case ComparisonOp::GreaterThan:
+        return lhs > rhs;
+    case ComparisonOp::GreaterThanEqual:
+        return lhs >= rhs;
+    case ComparisonOp::LessThan:
+        return lhs < rhs;
+    case ComparisonOp::LessThanEqual:
+        return lhs <= rhs;
+    case ComparisonOp::Equal:
+        return lhs == rhs;
+    case ComparisonOp::Inequal:
+        return lhs != rhs;
+    }
+    UNREACHABLE();
+    return false;
 }
 
-void CheatList::RegisterArithmetic(const Cheat& cheat) {
+void CheatList::EvaluateArithmetic(const Instruction& instruction) {
     using ArithmeticFunction = u64 (*)(u64, u64);
     constexpr std::array<ArithmeticFunction, 5> arithmetic_functions{
         [](u64 a, u64 b) { return a + b; },  [](u64 a, u64 b) { return a - b; },
@@ -247,32 +351,38 @@ void CheatList::RegisterArithmetic(const Cheat& cheat) {
     static_assert(sizeof(arithmetic_functions) == sizeof(arithmetic_overflow_checks),
                   "Missing or have extra arithmetic overflow checks compared to functions!");
 
-    auto& register_3 = scratch.at(cheat.register_3);
-
-    ASSERT(static_cast<u8>(cheat.arithmetic_op.Value()) < 5);
-    auto* function = arithmetic_functions[static_cast<u8>(cheat.arithmetic_op.Value())];
-    auto* overflow_function =
-        arithmetic_overflow_checks[static_cast<u8>(cheat.arithmetic_op.Value())];
-    LOG_DEBUG(Common_Filesystem, "performing arithmetic with register={:01X}, value={:016X}",
-              cheat.register_3, cheat.ValueWidth(4));
-
-    if (overflow_function(register_3, cheat.ValueWidth(4))) {
+    u64& reg = scratch[instruction.reg];
+    if (arithmetic_overflow_checks[instruction.aux](reg, instruction.value)) {
         LOG_WARNING(Common_Filesystem,
                     "overflow will occur when performing arithmetic operation={:02X} with operands "
                     "a={:016X}, b={:016X}!",
-                    static_cast<u8>(cheat.arithmetic_op.Value()), register_3, cheat.ValueWidth(4));
+                    instruction.aux, reg, instruction.value);
     }
 
-    register_3 = function(register_3, cheat.ValueWidth(4));
+    reg = arithmetic_functions[instruction.aux](reg, instruction.value);
 }
 
-void CheatList::BeginConditionalInput(const Cheat& cheat) {
-    if (EvaluateConditional(cheat))
-        return;
+u64 CheatList::ReadMemory(u32 width, VAddr addr) const {
+    addr = SanitizeAddress(addr);
+    if (resolver != nullptr) {
+        if (const u8* const pointer = resolver(width, addr)) {
+            u64 value = 0;
+            std::memcpy(&value, pointer, width);
+            return value;
+        }
+    }
+    return reader(width, addr);
+}
 
-    const auto iter = block_pairs.find(current_index);
-    ASSERT(iter != block_pairs.end());
-    current_index = iter->second - 1;
+void CheatList::WriteMemory(u32 width, VAddr addr, u64 value) const {
+    addr = SanitizeAddress(addr);
+    if (resolver != nullptr) {
+        if (u8* const pointer = resolver(width, addr)) {
+            std::memcpy(pointer, &value, width);
+            return;
+        }
+    }
+    writer(width, addr, value);
 }
 
 VAddr CheatList::SanitizeAddress(VAddr in) const {
@@ -289,33 +399,6 @@ VAddr CheatList::SanitizeAddress(VAddr in) const {
     return in;
 }
 
-void CheatList::ExecuteSingleCheat(const Cheat& cheat) {
-    using CheatOperationFunction = void (CheatList::*)(const Cheat&);
-    constexpr std::array<CheatOperationFunction, 9> cheat_operation_functions{
-        &CheatList::WriteImmediate,        &CheatList::BeginConditional,
-        &CheatList::EndConditional,        &CheatList::Loop,
-        &CheatList::LoadImmediate,         &CheatList::LoadIndexed,
-        &CheatList::StoreIndexed,          &CheatList::RegisterArithmetic,
-        &CheatList::BeginConditionalInput,
-    };
-
-    const auto index = static_cast<u8>(cheat.type.Value());
-    ASSERT(index < sizeof(cheat_operation_functions));
-    const auto op = cheat_operation_functions[index];
-    (this->*op)(cheat);
-}
-
-void CheatList::ExecuteBlock(const Block& block) {
-    encountered_loops.clear();
-
-    ProcessBlockPairs(block);
-    for (std::size_t i = 0; i < block.size(); ++i) {
-        current_index = i;
-        ExecuteSingleCheat(block[i]);
-        i = current_index;
-    }
-}
-
 CheatParser::~CheatParser() = default;
 
 CheatList CheatParser::MakeCheatList(const Core::System& system, CheatList::ProgramSegment master,
@@ -440,6 +523,14 @@ u64 MemoryReadImpl(u32 width, VAddr addr) {
     }
 }
 
+u8* MemoryResolveImpl(u32 width, VAddr addr) {
+    // Accesses crossing a page boundary may be backed by unrelated host memory
+    if ((addr & Memory::PAGE_MASK) + width > Memory::PAGE_SIZE) {
+        return nullptr;
+    }
+    return Memory::GetPlainMemoryPointer(addr);
+}
+
 void MemoryWriteImpl(u32 width, VAddr addr, u64 value) {
     switch (width) {
     case 1:
@@ -473,7 +564,7 @@ CheatEngine::CheatEngine(Core::System& system, std::vector<CheatList> cheats_,
     for (auto& list : this->cheats) {
         list.SetMemoryParameters(code_region_start, vm_manager.GetHeapRegionBaseAddress(),
                                  code_region_end, vm_manager.GetHeapRegionEndAddress(),
-                                 &MemoryWriteImpl, &MemoryReadImpl);
+                                 &MemoryWriteImpl, &MemoryReadImpl, &MemoryResolveImpl);
     }
 }
 
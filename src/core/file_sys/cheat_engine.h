@@ -4,8 +4,9 @@
 
 #pragma once
 
-#include <map>
-#include <set>
+#include <array>
+#include <string>
+#include <utility>
 #include <vector>
 #include "common/bit_field.h"
 #include "common/common_types.h"
@@ -119,6 +120,9 @@ class CheatParser;
 // interval that all cheats should be executed. Clients should not directly instantiate this class
 // (hence private constructor), they should instead receive an instance from CheatParser, which
 // guarantees the list is always in an acceptable state.
+//
+// When the memory parameters are set, the cheats are compiled into a linear program with resolved
+// jump targets and region offsets, so executing them does not need to decode or pair any code.
 class CheatList {
 public:
     friend class CheatParser;
@@ -130,32 +134,61 @@ public:
     using MemoryWriter = void (*)(u32, VAddr, u64);
     // (width in bytes, address) -> value
     using MemoryReader = u64 (*)(u32, VAddr);
+    // (width in bytes, address) -> host pointer if the access only touches plain memory, nullptr
+    // otherwise
+    using MemoryResolver = u8* (*)(u32, VAddr);
 
     void SetMemoryParameters(VAddr main_begin, VAddr heap_begin, VAddr main_end, VAddr heap_end,
-                             MemoryWriter writer, MemoryReader reader);
+                             MemoryWriter writer, MemoryReader reader,
+                             MemoryResolver resolver = nullptr);
 
     void Execute();
 
+    /// Returns the number of instructions of the compiled program
+    std::size_t GetProgramSize() const {
+        return program.size();
+    }
+
 private:
-    CheatList(const Core::System& system_, ProgramSegment master, ProgramSegment standard);
+    enum class Opcode : u8 {
+        Write,             ///< [address + R] = value
+        CompareMemory,     ///< If !([address] op value), jump to target
+        CompareInput,      ///< If no key of the mask in value is pressed, jump to target
+        LoopBegin,         ///< counters[address] = R = value, jump to target if negative
+        LoopEnd,           ///< If --counters[address] is not negative, R = it and jump to target
+        LoadImmediate,     ///< R = value
+        LoadMemory,        ///< R = [address]
+        LoadMemoryIndexed, ///< R = [R + address]
+        StoreIndexed,      ///< [R + (add_register ? aux : 0)] = value, R += width if increment
+        Arithmetic,        ///< R = R op value
+    };
+
+    struct Instruction {
+        Opcode opcode;
+        u8 width;
+        u8 reg;
+        /// Comparison or arithmetic operation, or second register of StoreIndexed
+        u8 aux;
+        bool add_register;
+        bool increment;
+        /// Index of the instruction to continue at when a condition fails or a loop repeats
+        u32 target;
+        /// Guest address with the region offset applied, or the loop counter index
+        u64 address;
+        u64 value;
+    };
 
-    void ProcessBlockPairs(const Block& block);
-    void ExecuteSingleCheat(const Cheat& cheat);
+    CheatList(const Core::System& system_, ProgramSegment master, ProgramSegment standard);
 
-    void ExecuteBlock(const Block& block);
+    void Compile();
+    bool CompileBlock(const Block& block);
 
-    bool EvaluateConditional(const Cheat& cheat) const;
+    bool EvaluateInput(u32 key_mask) const;
+    bool EvaluateComparison(const Instruction& instruction) const;
+    void EvaluateArithmetic(const Instruction& instruction);
 
-    // Individual cheat operations
-    void WriteImmediate(const Cheat& cheat);
-    void BeginConditional(const Cheat& cheat);
-    void EndConditional(const Cheat& cheat);
-    void Loop(const Cheat& cheat);
-    void LoadImmediate(const Cheat& cheat);
-    void LoadIndexed(const Cheat& cheat);
-    void StoreIndexed(const Cheat& cheat);
-    void RegisterArithmetic(const Cheat& cheat);
-    void BeginConditionalInput(const Cheat& cheat);
+    u64 ReadMemory(u32 width, VAddr addr) const;
+    void WriteMemory(u32 width, VAddr addr, u64 value) const;
 
     VAddr SanitizeAddress(VAddr in) const;
 
@@ -165,29 +198,23 @@ private:
     // All other codes
     ProgramSegment standard_list;
 
-    bool in_standard = false;
+    // Master and standard codes compiled into a single program, in execution order
+    std::vector<Instruction> program;
+    // Remaining iterations of each loop of the program
+    std::vector<s64> loop_counters;
 
     // 16 (0x0-0xF) scratch registers that can be used by cheats
     std::array<u64, 16> scratch{};
 
     MemoryWriter writer = nullptr;
     MemoryReader reader = nullptr;
+    MemoryResolver resolver = nullptr;
 
     u64 main_region_begin{};
     u64 heap_region_begin{};
     u64 main_region_end{};
     u64 heap_region_end{};
 
-    u64 current_block{};
-    // The current index of the cheat within the current Block
-    u64 current_index{};
-
-    // The 'stack' of the program. When a conditional or loop statement is encountered, its index is
-    // pushed onto this queue. When a end block is encountered, the condition is checked.
-    std::map<u64, u64> block_pairs;
-
-    std::set<u64> encountered_loops;
-
     const Core::System* system;
 };
 
@@ -6,13 +6,21 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <climits>
+#include <condition_variable>
 #include <csignal>
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
 #include <map>
+#include <mutex>
 #include <numeric>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 #include <fcntl.h>
 
 #ifdef _WIN32
@@ -31,8 +39,11 @@
 #endif
 
 #include "common/logging/log.h"
+#include "common/memory_hook.h"
 #include "common/string_util.h"
 #include "common/swap.h"
+#include "common/thread.h"
+#include "common/threadsafe_queue.h"
 #include "core/arm/arm_interface.h"
 #include "core/core.h"
 #include "core/core_cpu.h"
@@ -42,6 +53,7 @@
 #include "core/hle/kernel/vm_manager.h"
 #include "core/loader/loader.h"
 #include "core/memory.h"
+#include "core/memory_setup.h"
 
 namespace GDBStub {
 namespace {
@@ -51,6 +63,11 @@ constexpr char GDB_STUB_START = '$';
 constexpr char GDB_STUB_END = '#';
 constexpr char GDB_STUB_ACK = '+';
 constexpr char GDB_STUB_NACK = '-';
+constexpr u8 GDB_STUB_BREAK = 0x03;
+constexpr u8 GDB_STUB_ESCAPE = 0x7d;
+
+// How long the server thread waits for data before checking whether it should stop
+constexpr long SERVER_POLL_INTERVAL_US = 100000;
 
 #ifndef SIGTRAP
 constexpr u32 SIGTRAP = 5;
@@ -60,10 +77,6 @@ constexpr u32 SIGTRAP = 5;
 constexpr u32 SIGTERM = 15;
 #endif
 
-#ifndef MSG_WAITALL
-constexpr u32 MSG_WAITALL = 8;
-#endif
-
 constexpr u32 LR_REGISTER = 30;
 constexpr u32 SP_REGISTER = 31;
 constexpr u32 PC_REGISTER = 32;
@@ -140,7 +153,23 @@ constexpr char target_xml[] =
 </target>
 )";
 
-int gdbserver_socket = -1;
+// Socket of the connected client, owned by the server thread
+std::atomic<int> gdbserver_socket{-1};
+
+// The server thread accepts the client and splits what it sends into packets. The packets are
+// handled on the emulation thread, which only has to check the queue when it polls for them.
+std::thread server_thread;
+std::atomic_bool server_running{false};
+Common::SPSCQueue<std::vector<u8>> packet_queue;
+// Set by the server thread when the client disconnects, the emulation thread then listens again
+std::atomic_bool client_disconnected{false};
+
+// Wakes the emulation thread while it waits for packets with the CPU halted
+std::mutex halt_mutex;
+std::condition_variable halt_cv;
+
+// Both threads send to the client, the server thread acknowledges packets
+std::mutex send_mutex;
 
 u8 command_buffer[GDB_BUFFER_SIZE];
 u32 command_length;
@@ -148,6 +177,9 @@ u32 command_length;
 u32 latest_signal = 0;
 bool memory_break = false;
 
+// Set while the stub itself accesses guest memory, which must not trigger watchpoints
+thread_local bool is_debugger_access = false;
+
 Kernel::Thread* current_thread = nullptr;
 u32 current_core = 0;
 
@@ -155,8 +187,8 @@ u32 current_core = 0;
 // so default to a port outside of that range.
 u16 gdbstub_port = 24689;
 
-bool halt_loop = true;
-bool step_loop = false;
+std::atomic_bool halt_loop{true};
+std::atomic_bool step_loop{false};
 bool send_trap = false;
 
 // If set to false, the server will never be started and no
@@ -179,12 +211,87 @@ BreakpointMap breakpoints_execute;
 BreakpointMap breakpoints_read;
 BreakpointMap breakpoints_write;
 
-struct Module {
-    std::string name;
-    VAddr beg;
-    VAddr end;
+// Number of breakpoints on each page, so that accesses to other pages are rejected with a
+// single lookup
+using BreakpointPageMap = std::unordered_map<VAddr, u32>;
+BreakpointPageMap breakpoint_pages_execute;
+BreakpointPageMap breakpoint_pages_read;
+BreakpointPageMap breakpoint_pages_write;
+
+/// Halts emulation when the guest accesses memory covered by a read or write breakpoint
+class WatchpointHook final : public Common::MemoryHook {
+public:
+    explicit WatchpointHook(BreakpointType type) : type{type} {}
+
+    std::optional<bool> IsValidAddress(VAddr addr) override {
+        return std::nullopt;
+    }
+
+    std::optional<u8> Read8(VAddr addr) override {
+        return OnRead(addr);
+    }
+    std::optional<u16> Read16(VAddr addr) override {
+        return OnRead(addr);
+    }
+    std::optional<u32> Read32(VAddr addr) override {
+        return OnRead(addr);
+    }
+    std::optional<u64> Read64(VAddr addr) override {
+        return OnRead(addr);
+    }
+
+    bool ReadBlock(VAddr src_addr, void* dest_buffer, std::size_t size) override {
+        OnAccess(BreakpointType::Read, src_addr);
+        return false;
+    }
+
+    bool Write8(VAddr addr, u8 data) override {
+        return OnWrite(addr);
+    }
+    bool Write16(VAddr addr, u16 data) override {
+        return OnWrite(addr);
+    }
+    bool Write32(VAddr addr, u32 data) override {
+        return OnWrite(addr);
+    }
+    bool Write64(VAddr addr, u64 data) override {
+        return OnWrite(addr);
+    }
+
+    bool WriteBlock(VAddr dest_addr, const void* src_buffer, std::size_t size) override {
+        return OnWrite(dest_addr);
+    }
+
+private:
+    std::nullopt_t OnRead(VAddr addr) {
+        OnAccess(BreakpointType::Read, addr);
+        return std::nullopt;
+    }
+
+    bool OnWrite(VAddr addr) {
+        OnAccess(BreakpointType::Write, addr);
+        return false;
+    }
+
+    void OnAccess(BreakpointType access, VAddr addr) {
+        if (access != type || is_debugger_access) {
+            return;
+        }
+
+        LOG_DEBUG(Debug_GDBStub, "Hit breakpoint type {} @ {:016X}", static_cast<int>(type), addr);
+
+        // The access itself completes, the CPU stops once it leaves the current block
+        Break(true);
+        Core::System::GetInstance().CurrentArmInterface().PrepareReschedule();
+    }
+
+    BreakpointType type;
 };
 
+const auto read_watchpoint_hook = std::make_shared<WatchpointHook>(BreakpointType::Read);
+const auto write_watchpoint_hook = std::make_shared<WatchpointHook>(BreakpointType::Write);
+
+/// Registered modules, sorted by their start address
 std::vector<Module> modules;
 } // Anonymous namespace
 
@@ -198,7 +305,22 @@ void RegisterModule(std::string name, VAddr beg, VAddr end, bool add_elf_ext) {
     }
     module.beg = beg;
     module.end = end;
-    modules.push_back(std::move(module));
+    const auto iter = std::upper_bound(
+        modules.begin(), modules.end(), beg,
+        [](VAddr value, const Module& other) { return value < other.beg; });
+    modules.insert(iter, std::move(module));
+}
+
+const Module* FindModule(VAddr addr) {
+    // Modules don't overlap, only the last module starting at or before addr can contain it
+    const auto iter =
+        std::upper_bound(modules.begin(), modules.end(), addr,
+                         [](VAddr value, const Module& module) { return value < module.beg; });
+    if (iter == modules.begin()) {
+        return nullptr;
+    }
+    const Module& module = *std::prev(iter);
+    return addr < module.end ? &module : nullptr;
 }
 
 static Kernel::Thread* FindThreadById(s64 id) {
@@ -456,16 +578,36 @@ static u128 GdbHexToU128(const u8* src) {
     return output;
 }
 
-/// Read a byte from the gdb client.
-static u8 ReadByte() {
-    u8 c;
-    std::size_t received_size = recv(gdbserver_socket, reinterpret_cast<char*>(&c), 1, MSG_WAITALL);
-    if (received_size != 1) {
-        LOG_ERROR(Debug_GDBStub, "recv failed: {}", received_size);
-        Shutdown();
-    }
+/// Close a socket owned by the server thread.
+static void CloseSocket(int socket) {
+    shutdown(socket, SHUT_RDWR);
+#ifdef _WIN32
+    closesocket(socket);
+#else
+    close(socket);
+#endif
+}
 
-    return c;
+/**
+ * Wait until a socket has data to read, or until the poll interval expired.
+ *
+ * @return True if there is data to read.
+ */
+static bool WaitForData(int socket) {
+    fd_set fd_socket;
+
+    FD_ZERO(&fd_socket);
+    FD_SET(static_cast<u32>(socket), &fd_socket);
+
+    struct timeval t;
+    t.tv_sec = 0;
+    t.tv_usec = SERVER_POLL_INTERVAL_US;
+
+    const int result = select(socket + 1, &fd_socket, nullptr, nullptr, &t);
+    if (result < 0) {
+        LOG_ERROR(Debug_GDBStub, "select failed");
+    }
+    return result > 0;
 }
 
 /// Calculate the checksum of the current command buffer.
@@ -491,6 +633,53 @@ static BreakpointMap& GetBreakpointMap(BreakpointType type) {
     }
 }
 
+/**
+ * Get the per page breakpoint counts for a given breakpoint type.
+ *
+ * @param type Type of breakpoint map.
+ */
+static BreakpointPageMap& GetBreakpointPageMap(BreakpointType type) {
+    switch (type) {
+    case BreakpointType::Execute:
+        return breakpoint_pages_execute;
+    case BreakpointType::Read:
+        return breakpoint_pages_read;
+    case BreakpointType::Write:
+        return breakpoint_pages_write;
+    default:
+        return breakpoint_pages_read;
+    }
+}
+
+/// Get the memory hook implementing breakpoints of the given memory access type.
+static Common::MemoryHookPointer GetWatchpointHook(BreakpointType type) {
+    if (type == BreakpointType::Write) {
+        return write_watchpoint_hook;
+    }
+    return read_watchpoint_hook;
+}
+
+/// Get the number of bytes a breakpoint covers.
+static u64 GetBreakpointLength(BreakpointType type, const Breakpoint& breakpoint) {
+    // Execute breakpoints only cover the instruction they are placed on, see CheckBreakpoint.
+    return type == BreakpointType::Execute ? 1 : std::max<u64>(breakpoint.len, 1);
+}
+
+/// Add or remove a breakpoint from the count of breakpoints on the pages it covers.
+static void CountBreakpointPages(BreakpointType type, const Breakpoint& breakpoint, bool add) {
+    BreakpointPageMap& pages = GetBreakpointPageMap(type);
+    const VAddr last_addr = breakpoint.addr + GetBreakpointLength(type, breakpoint) - 1;
+
+    for (VAddr page = breakpoint.addr >> Memory::PAGE_BITS;
+         page <= (last_addr >> Memory::PAGE_BITS); ++page) {
+        if (add) {
+            ++pages[page];
+        } else if (--pages[page] == 0) {
+            pages.erase(page);
+        }
+    }
+}
+
 /**
  * Remove the breakpoint from the given address of the specified type.
  *
@@ -508,11 +697,45 @@ static void RemoveBreakpoint(BreakpointType type, VAddr addr) {
     LOG_DEBUG(Debug_GDBStub, "gdb: removed a breakpoint: {:016X} bytes at {:016X} of type {}",
               bp->second.len, bp->second.addr, static_cast<int>(type));
 
+    const Breakpoint breakpoint = bp->second;
+    CountBreakpointPages(type, breakpoint, false);
+    p.erase(addr);
+
     if (type == BreakpointType::Execute) {
-        Memory::WriteBlock(bp->second.addr, bp->second.inst.data(), bp->second.inst.size());
+        is_debugger_access = true;
+        Memory::WriteBlock(breakpoint.addr, breakpoint.inst.data(), breakpoint.inst.size());
+        is_debugger_access = false;
         Core::System::GetInstance().InvalidateCpuInstructionCaches();
+        return;
+    }
+
+    auto& page_table = Core::CurrentProcess()->VMManager().page_table;
+    const auto hook = GetWatchpointHook(type);
+    const u64 len = GetBreakpointLength(type, breakpoint);
+    Memory::RemoveDebugHook(page_table, breakpoint.addr, len, hook);
+
+    // A region holds the hook only once, restore it for the breakpoints that overlap this one
+    for (const auto& [other_addr, other] : p) {
+        const u64 other_len = GetBreakpointLength(type, other);
+        if (other_addr < breakpoint.addr + len && breakpoint.addr < other_addr + other_len) {
+            Memory::AddDebugHook(page_table, other_addr, other_len, hook);
+        }
     }
-    p.erase(addr);
+}
+
+/// Remove all breakpoints, restoring the instructions replaced by execute breakpoints.
+static void RemoveAllBreakpoints() {
+    for (const auto type : {BreakpointType::Execute, BreakpointType::Read, BreakpointType::Write}) {
+        const BreakpointMap& p = GetBreakpointMap(type);
+        while (!p.empty()) {
+            RemoveBreakpoint(type, p.begin()->first);
+        }
+    }
+}
+
+bool IsBreakpointPage(VAddr addr, BreakpointType type) {
+    const BreakpointPageMap& pages = GetBreakpointPageMap(type);
+    return !pages.empty() && pages.count(addr >> Memory::PAGE_BITS) != 0;
 }
 
 BreakpointAddress GetNextBreakpointFromAddress(VAddr addr, BreakpointType type) {
@@ -532,7 +755,7 @@ BreakpointAddress GetNextBreakpointFromAddress(VAddr addr, BreakpointType type)
 }
 
 bool CheckBreakpoint(VAddr addr, BreakpointType type) {
-    if (!IsConnected()) {
+    if (!IsConnected() || !IsBreakpointPage(addr, type)) {
         return false;
     }
 
@@ -574,7 +797,13 @@ bool CheckBreakpoint(VAddr addr, BreakpointType type) {
  * @param packet Packet to be sent to client.
  */
 static void SendPacket(const char packet) {
-    std::size_t sent_size = send(gdbserver_socket, &packet, 1, 0);
+    std::lock_guard lock{send_mutex};
+    const int socket = gdbserver_socket;
+    if (socket == -1) {
+        return;
+    }
+
+    std::size_t sent_size = send(socket, &packet, 1, 0);
     if (sent_size != 1) {
         LOG_ERROR(Debug_GDBStub, "send failed");
     }
@@ -583,38 +812,39 @@ static void SendPacket(const char packet) {
 /**
  * Send reply to gdb client.
  *
- * @param reply Reply to be sent to client.
+ * @param reply Reply to be sent to client, may contain binary data.
+ * @param length Length of the reply.
  */
-static void SendReply(const char* reply) {
+static void SendReply(const u8* reply, std::size_t length) {
     if (!IsConnected()) {
         return;
     }
 
-    LOG_DEBUG(Debug_GDBStub, "Reply: {}", reply);
-
-    memset(command_buffer, 0, sizeof(command_buffer));
-
-    command_length = static_cast<u32>(strlen(reply));
-    if (command_length + 4 > sizeof(command_buffer)) {
+    if (length + 4 > sizeof(command_buffer)) {
         LOG_ERROR(Debug_GDBStub, "command_buffer overflow in SendReply");
         return;
     }
 
-    memcpy(command_buffer + 1, reply, command_length);
+    command_length = static_cast<u32>(length);
+    std::memmove(command_buffer + 1, reply, command_length);
 
-    u8 checksum = CalculateChecksum(command_buffer, command_length + 1);
+    u8 checksum = CalculateChecksum(command_buffer + 1, command_length);
     command_buffer[0] = GDB_STUB_START;
     command_buffer[command_length + 1] = GDB_STUB_END;
     command_buffer[command_length + 2] = NibbleToHex(checksum >> 4);
     command_buffer[command_length + 3] = NibbleToHex(checksum);
 
+    std::lock_guard lock{send_mutex};
+    const int socket = gdbserver_socket;
     u8* ptr = command_buffer;
     u32 left = command_length + 4;
     while (left > 0) {
-        int sent_size = send(gdbserver_socket, reinterpret_cast<char*>(ptr), left, 0);
+        int sent_size = send(socket, reinterpret_cast<char*>(ptr), left, 0);
         if (sent_size < 0) {
+            // The server thread notices the closed connection and detaches
             LOG_ERROR(Debug_GDBStub, "gdb: send failed");
-            return Shutdown();
+            shutdown(socket, SHUT_RDWR);
+            return;
         }
 
         left -= sent_size;
@@ -622,6 +852,21 @@ static void SendReply(const char* reply) {
     }
 }
 
+/**
+ * Send reply to gdb client.
+ *
+ * @param reply Reply to be sent to client.
+ */
+static void SendReply(const char* reply) {
+    if (!IsConnected()) {
+        return;
+    }
+
+    LOG_DEBUG(Debug_GDBStub, "Reply: {}", reply);
+
+    SendReply(reinterpret_cast<const u8*>(reply), strlen(reply));
+}
+
 /// Handle query command from gdb client.
 static void HandleQuery() {
     LOG_DEBUG(Debug_GDBStub, "gdb: query '{}'", command_buffer + 1);
@@ -632,7 +877,8 @@ static void HandleQuery() {
         SendReply("T0");
     } else if (strncmp(query, "Supported", strlen("Supported")) == 0) {
         // PacketSize needs to be large enough for target xml
-        std::string buffer = "PacketSize=2000;qXfer:features:read+;qXfer:threads:read+";
+        std::string buffer =
+            "PacketSize=2000;qXfer:features:read+;qXfer:threads:read+;binary-upload+";
         if (!modules.empty()) {
             buffer += ";qXfer:libraries:read+";
         }
@@ -752,74 +998,160 @@ static void SendSignal(Kernel::Thread* thread, u32 signal, bool full = true) {
     SendReply(buffer.c_str());
 }
 
-/// Read command from gdb client.
-static void ReadCommand() {
-    command_length = 0;
-    memset(command_buffer, 0, sizeof(command_buffer));
+/// Wake the emulation thread if it is waiting for a packet with the CPU halted.
+static void WakeEmulationThread() {
+    std::lock_guard lock{halt_mutex};
+    halt_cv.notify_one();
+}
 
-    u8 c = ReadByte();
-    if (c == '+') {
-        // ignore ack
-        return;
-    } else if (c == 0x03) {
-        LOG_INFO(Debug_GDBStub, "gdb: found break command");
-        halt_loop = true;
-        SendSignal(current_thread, SIGTRAP);
-        return;
-    } else if (c != GDB_STUB_START) {
-        LOG_DEBUG(Debug_GDBStub, "gdb: read invalid byte {:02X}", c);
-        return;
-    }
+/// Queue a packet to be handled on the emulation thread.
+static void QueuePacket(std::vector<u8> packet) {
+    packet_queue.Push(std::move(packet));
+    WakeEmulationThread();
+}
 
-    while ((c = ReadByte()) != GDB_STUB_END) {
-        if (command_length >= sizeof(command_buffer)) {
-            LOG_ERROR(Debug_GDBStub, "gdb: command_buffer overflow");
-            SendPacket(GDB_STUB_NACK);
-            return;
+/// Splits the data received from the gdb client into packets and acknowledges them.
+class PacketReader {
+public:
+    /// Process data received from the client, queueing the complete packets.
+    void Feed(const u8* data, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i) {
+            Feed(data[i]);
         }
-        command_buffer[command_length++] = c;
     }
 
-    u8 checksum_received = HexCharToValue(ReadByte()) << 4;
-    checksum_received |= HexCharToValue(ReadByte());
+private:
+    enum class State {
+        Idle,
+        Payload,
+        ChecksumHigh,
+        ChecksumLow,
+    };
+
+    void Feed(u8 c) {
+        switch (state) {
+        case State::Idle:
+            if (c == GDB_STUB_START) {
+                payload.clear();
+                state = State::Payload;
+            } else if (c == GDB_STUB_BREAK) {
+                LOG_INFO(Debug_GDBStub, "gdb: found break command");
+                QueuePacket(std::vector<u8>{GDB_STUB_BREAK});
+            } else if (c != GDB_STUB_ACK) {
+                LOG_DEBUG(Debug_GDBStub, "gdb: read invalid byte {:02X}", c);
+            }
+            break;
+        case State::Payload:
+            if (c == GDB_STUB_END) {
+                state = State::ChecksumHigh;
+            } else if (payload.size() + 1 >= GDB_BUFFER_SIZE) {
+                LOG_ERROR(Debug_GDBStub, "gdb: command_buffer overflow");
+                SendPacket(GDB_STUB_NACK);
+                state = State::Idle;
+            } else {
+                payload.push_back(c);
+            }
+            break;
+        case State::ChecksumHigh:
+            checksum_received = HexCharToValue(c) << 4;
+            state = State::ChecksumLow;
+            break;
+        case State::ChecksumLow: {
+            checksum_received |= HexCharToValue(c);
+            state = State::Idle;
+
+            const u8 checksum_calculated = CalculateChecksum(payload.data(), payload.size());
+            if (checksum_received != checksum_calculated) {
+                LOG_ERROR(Debug_GDBStub,
+                          "gdb: invalid checksum: calculated {:02X} and read {:02X} (length: {})",
+                          checksum_calculated, checksum_received, payload.size());
+                SendPacket(GDB_STUB_NACK);
+                break;
+            }
 
-    u8 checksum_calculated = CalculateChecksum(command_buffer, command_length);
+            SendPacket(GDB_STUB_ACK);
+            if (!payload.empty()) {
+                QueuePacket(std::move(payload));
+                payload = {};
+            }
+            break;
+        }
+        }
+    }
 
-    if (checksum_received != checksum_calculated) {
-        LOG_ERROR(Debug_GDBStub,
-                  "gdb: invalid checksum: calculated {:02X} and read {:02X} for ${}# (length: {})",
-                  checksum_calculated, checksum_received, command_buffer, command_length);
+    State state = State::Idle;
+    std::vector<u8> payload;
+    u8 checksum_received = 0;
+};
 
-        command_length = 0;
+/// Accept the gdb client and receive its packets until it disconnects or the server stops.
+static void ServerLoop(int listen_socket) {
+    Common::SetCurrentThreadName("yuzu:GDBStub");
 
-        SendPacket(GDB_STUB_NACK);
-        return;
+    // Wait for gdb to connect
+    LOG_INFO(Debug_GDBStub, "Waiting for gdb to connect...");
+    int client_socket = -1;
+    while (server_running && client_socket < 0) {
+        if (!WaitForData(listen_socket)) {
+            continue;
+        }
+
+        sockaddr_in saddr_client;
+        sockaddr* client_addr = reinterpret_cast<sockaddr*>(&saddr_client);
+        socklen_t client_addrlen = sizeof(saddr_client);
+        client_socket = static_cast<int>(accept(listen_socket, client_addr, &client_addrlen));
+        if (client_socket < 0) {
+            LOG_ERROR(Debug_GDBStub, "Failed to accept gdb client");
+            break;
+        }
+        LOG_INFO(Debug_GDBStub, "Client connected.");
     }
 
-    SendPacket(GDB_STUB_ACK);
-}
+    // Clean up temporary socket if it's still alive at this point.
+    CloseSocket(listen_socket);
 
-/// Check if there is data to be read from the gdb client.
-static bool IsDataAvailable() {
-    if (!IsConnected()) {
-        return false;
+    if (client_socket < 0) {
+        // In the case that we couldn't start the server for whatever reason, just start CPU
+        // execution like normal.
+        halt_loop = false;
+        step_loop = false;
+        WakeEmulationThread();
+        return;
     }
 
-    fd_set fd_socket;
+    // gdb expects the target to be stopped when it connects, which a client reconnecting while
+    // the game runs would not find
+    halt_loop = true;
+    gdbserver_socket = client_socket;
 
-    FD_ZERO(&fd_socket);
-    FD_SET(static_cast<u32>(gdbserver_socket), &fd_socket);
+    PacketReader reader;
+    std::array<u8, GDB_BUFFER_SIZE> buffer;
+    while (server_running) {
+        if (!WaitForData(client_socket)) {
+            continue;
+        }
 
-    struct timeval t;
-    t.tv_sec = 0;
-    t.tv_usec = 0;
+        const auto received_size =
+            recv(client_socket, reinterpret_cast<char*>(buffer.data()), buffer.size(), 0);
+        if (received_size <= 0) {
+            LOG_INFO(Debug_GDBStub, "Client disconnected.");
+            break;
+        }
+        reader.Feed(buffer.data(), static_cast<std::size_t>(received_size));
+    }
 
-    if (select(gdbserver_socket + 1, &fd_socket, nullptr, nullptr, &t) < 0) {
-        LOG_ERROR(Debug_GDBStub, "select failed");
-        return false;
+    {
+        std::lock_guard lock{send_mutex};
+        gdbserver_socket = -1;
     }
+    CloseSocket(client_socket);
 
-    return FD_ISSET(gdbserver_socket, &fd_socket) != 0;
+    // Unless the server is being shut down, let the emulation thread clean up the breakpoints,
+    // resume the CPU and listen for the next client
+    if (server_running.exchange(false)) {
+        client_disconnected = true;
+        QueuePacket(std::vector<u8>{'D'});
+    }
 }
 
 /// Send requested register to gdb client.
@@ -955,22 +1287,42 @@ static void WriteRegisters() {
     SendReply("OK");
 }
 
-/// Read location in memory specified by gdb client.
-static void ReadMemory() {
-    static u8 reply[GDB_BUFFER_SIZE - 4];
+/**
+ * Parse the address and length of a memory transfer command from gdb client.
+ *
+ * @param separator Character following the length, or '\0' if it ends the command.
+ * @return Address, length and pointer to the data following the separator.
+ */
+static std::tuple<VAddr, u64, const u8*> ParseMemoryCommand(u8 separator) {
+    const u8* const command_end = command_buffer + command_length;
 
-    auto start_offset = command_buffer + 1;
-    const auto addr_pos = std::find(start_offset, command_buffer + command_length, ',');
+    const u8* start_offset = command_buffer + 1;
+    const u8* const addr_pos = std::find(start_offset, command_end, ',');
     const VAddr addr = HexToLong(start_offset, static_cast<u64>(addr_pos - start_offset));
 
     start_offset = addr_pos + 1;
-    const u64 len =
-        HexToLong(start_offset, static_cast<u64>((command_buffer + command_length) - start_offset));
+    const u8* const len_pos =
+        separator != '\0' ? std::find(start_offset, command_end, separator) : command_end;
+    const u64 len = HexToLong(start_offset, static_cast<u64>(len_pos - start_offset));
+
+    return {addr, len, std::min(len_pos + 1, command_end)};
+}
+
+/// Returns true if a byte has to be escaped in binary data sent to gdb client.
+static bool NeedsEscape(u8 c) {
+    return c == GDB_STUB_START || c == GDB_STUB_END || c == GDB_STUB_ESCAPE || c == '*';
+}
+
+/// Read location in memory specified by gdb client.
+static void ReadMemory() {
+    static u8 reply[GDB_BUFFER_SIZE - 4];
+
+    const auto [addr, len, data_pos] = ParseMemoryCommand('\0');
 
     LOG_DEBUG(Debug_GDBStub, "gdb: addr: {:016X} len: {:016X}", addr, len);
 
     if (len * 2 > sizeof(reply)) {
-        SendReply("E01");
+        return SendReply("E01");
     }
 
     if (!Memory::IsValidVirtualAddress(addr)) {
@@ -978,31 +1330,107 @@ static void ReadMemory() {
     }
 
     std::vector<u8> data(len);
+    is_debugger_access = true;
     Memory::ReadBlock(addr, data.data(), len);
+    is_debugger_access = false;
 
     MemToGdbHex(reply, data.data(), len);
-    reply[len * 2] = '\0';
-    SendReply(reinterpret_cast<char*>(reply));
+    SendReply(reply, len * 2);
+}
+
+/// Read location in memory specified by gdb client, replying with binary data.
+static void ReadMemoryBinary() {
+    static u8 reply[GDB_BUFFER_SIZE - 4];
+
+    const auto [addr, len, data_pos] = ParseMemoryCommand('\0');
+
+    LOG_DEBUG(Debug_GDBStub, "gdb: addr: {:016X} len: {:016X}", addr, len);
+
+    // Every byte may need to be escaped
+    if (len * 2 + 1 > sizeof(reply)) {
+        return SendReply("E01");
+    }
+
+    if (!Memory::IsValidVirtualAddress(addr)) {
+        return SendReply("E00");
+    }
+
+    std::vector<u8> data(len);
+    is_debugger_access = true;
+    Memory::ReadBlock(addr, data.data(), len);
+    is_debugger_access = false;
+
+    std::size_t reply_length = 0;
+    reply[reply_length++] = 'b';
+    for (const u8 c : data) {
+        if (NeedsEscape(c)) {
+            reply[reply_length++] = GDB_STUB_ESCAPE;
+            reply[reply_length++] = c ^ 0x20;
+        } else {
+            reply[reply_length++] = c;
+        }
+    }
+    SendReply(reply, reply_length);
 }
 
 /// Modify location in memory with data received from the gdb client.
 static void WriteMemory() {
-    auto start_offset = command_buffer + 1;
-    auto addr_pos = std::find(start_offset, command_buffer + command_length, ',');
-    VAddr addr = HexToLong(start_offset, static_cast<u64>(addr_pos - start_offset));
-
-    start_offset = addr_pos + 1;
-    auto len_pos = std::find(start_offset, command_buffer + command_length, ':');
-    u64 len = HexToLong(start_offset, static_cast<u64>(len_pos - start_offset));
+    const auto [addr, len, data_pos] = ParseMemoryCommand(':');
 
     if (!Memory::IsValidVirtualAddress(addr)) {
         return SendReply("E00");
     }
 
+    if (len * 2 > static_cast<u64>(command_buffer + command_length - data_pos)) {
+        return SendReply("E01");
+    }
+
     std::vector<u8> data(len);
 
-    GdbHexToMem(data.data(), len_pos + 1, len);
+    GdbHexToMem(data.data(), data_pos, len);
+    is_debugger_access = true;
     Memory::WriteBlock(addr, data.data(), len);
+    is_debugger_access = false;
+    Core::System::GetInstance().InvalidateCpuInstructionCaches();
+    SendReply("OK");
+}
+
+/// Modify location in memory with binary data received from the gdb client.
+static void WriteMemoryBinary() {
+    const auto [addr, len, data_pos] = ParseMemoryCommand(':');
+
+    // gdb probes for binary transfer support with an empty write
+    if (len == 0) {
+        return SendReply("OK");
+    }
+
+    // Escaping only makes the payload longer, a length it can't hold is bogus
+    const u8* const data_end = command_buffer + command_length;
+    if (len > static_cast<u64>(data_end - data_pos)) {
+        return SendReply("E01");
+    }
+
+    if (!Memory::IsValidVirtualAddress(addr)) {
+        return SendReply("E00");
+    }
+
+    std::vector<u8> data;
+    data.reserve(len);
+    for (const u8* c = data_pos; c < data_end; ++c) {
+        if (*c == GDB_STUB_ESCAPE && c + 1 < data_end) {
+            data.push_back(*++c ^ 0x20);
+        } else {
+            data.push_back(*c);
+        }
+    }
+
+    if (data.size() != len) {
+        return SendReply("E01");
+    }
+
+    is_debugger_access = true;
+    Memory::WriteBlock(addr, data.data(), len);
+    is_debugger_access = false;
     Core::System::GetInstance().InvalidateCpuInstructionCaches();
     SendReply("OK");
 }
@@ -1055,18 +1483,29 @@ static void Continue() {
 static bool CommitBreakpoint(BreakpointType type, VAddr addr, u64 len) {
     BreakpointMap& p = GetBreakpointMap(type);
 
+    if (p.count(addr) != 0) {
+        RemoveBreakpoint(type, addr);
+    }
+
     Breakpoint breakpoint;
     breakpoint.active = true;
     breakpoint.addr = addr;
     breakpoint.len = len;
+    is_debugger_access = true;
     Memory::ReadBlock(addr, breakpoint.inst.data(), breakpoint.inst.size());
 
     static constexpr std::array<u8, 4> btrap{0x00, 0x7d, 0x20, 0xd4};
     if (type == BreakpointType::Execute) {
         Memory::WriteBlock(addr, btrap.data(), btrap.size());
         Core::System::GetInstance().InvalidateCpuInstructionCaches();
+    } else {
+        // Only the pages holding the breakpoint are routed through the hook
+        Memory::AddDebugHook(Core::CurrentProcess()->VMManager().page_table, addr,
+                             GetBreakpointLength(type, breakpoint), GetWatchpointHook(type));
     }
+    is_debugger_access = false;
     p.insert({addr, breakpoint});
+    CountBreakpointPages(type, breakpoint, true);
 
     LOG_DEBUG(Debug_GDBStub, "gdb: added {} breakpoint: {:016X} bytes at {:016X}",
               static_cast<int>(type), breakpoint.len, breakpoint.addr);
@@ -1162,22 +1601,20 @@ static void RemoveBreakpoint() {
     SendReply("OK");
 }
 
-void HandlePacket() {
-    if (!IsConnected()) {
-        return;
-    }
-
-    if (!IsDataAvailable()) {
-        return;
-    }
-
-    ReadCommand();
-    if (command_length == 0) {
-        return;
-    }
-
-    LOG_DEBUG(Debug_GDBStub, "Packet: {}", command_buffer);
+/// Detach gdb client, removing its breakpoints and resuming the CPU.
+static void Detach() {
+    LOG_INFO(Debug_GDBStub, "gdb: detached");
+    RemoveAllBreakpoints();
+    SendReply("OK");
+    Continue();
+}
 
+/**
+ * Handle the command in the command buffer.
+ *
+ * @return False if the CPU should resume before handling more commands.
+ */
+static bool HandleCommand() {
     switch (command_buffer[0]) {
     case 'q':
         HandleQuery();
@@ -1191,7 +1628,10 @@ void HandlePacket() {
     case 'k':
         Shutdown();
         LOG_INFO(Debug_GDBStub, "killed by gdb");
-        return;
+        return false;
+    case 'D':
+        Detach();
+        return false;
     case 'g':
         ReadRegisters();
         break;
@@ -1210,13 +1650,19 @@ void HandlePacket() {
     case 'M':
         WriteMemory();
         break;
+    case 'x':
+        ReadMemoryBinary();
+        break;
+    case 'X':
+        WriteMemoryBinary();
+        break;
     case 's':
         Step();
-        return;
+        return false;
     case 'C':
     case 'c':
         Continue();
-        return;
+        return false;
     case 'z':
         RemoveBreakpoint();
         break;
@@ -1230,6 +1676,42 @@ void HandlePacket() {
         SendReply("");
         break;
     }
+    return true;
+}
+
+static void StartServer(u16 port);
+
+void HandlePacket() {
+    if (client_disconnected.exchange(false) && server_enabled && !server_running) {
+        StartServer(gdbstub_port);
+    }
+
+    std::vector<u8> packet;
+    while (packet_queue.Pop(packet)) {
+        if (packet.size() == 1 && packet[0] == GDB_STUB_BREAK) {
+            halt_loop = true;
+            SendSignal(current_thread, SIGTRAP);
+            continue;
+        }
+
+        command_length = static_cast<u32>(packet.size());
+        std::memcpy(command_buffer, packet.data(), packet.size());
+        command_buffer[command_length] = '\0';
+
+        LOG_DEBUG(Debug_GDBStub, "Packet: {}", command_buffer);
+
+        if (!HandleCommand()) {
+            // The CPU resumes, the remaining packets are handled when it stops again
+            return;
+        }
+    }
+}
+
+void WaitForPacket() {
+    std::unique_lock lock{halt_mutex};
+    halt_cv.wait_for(lock, std::chrono::microseconds{SERVER_POLL_INTERVAL_US}, [] {
+        return !packet_queue.Empty() || !halt_loop || step_loop || client_disconnected;
+    });
 }
 
 void SetServerPort(u16 port) {
@@ -1241,12 +1723,12 @@ void ToggleServer(bool status) {
         server_enabled = status;
 
         // Start server
-        if (!IsConnected() && Core::System::GetInstance().IsPoweredOn()) {
+        if (!server_running && Core::System::GetInstance().IsPoweredOn()) {
             Init();
         }
     } else {
         // Stop server
-        if (IsConnected()) {
+        if (server_running) {
             Shutdown();
         }
 
@@ -1263,6 +1745,10 @@ static void Init(u16 port) {
         return;
     }
 
+    if (server_running) {
+        return;
+    }
+
     // Setup initial gdbstub status
     halt_loop = true;
     step_loop = false;
@@ -1270,8 +1756,23 @@ static void Init(u16 port) {
     breakpoints_execute.clear();
     breakpoints_read.clear();
     breakpoints_write.clear();
+    breakpoint_pages_execute.clear();
+    breakpoint_pages_read.clear();
+    breakpoint_pages_write.clear();
 
     modules.clear();
+    packet_queue.Clear();
+    client_disconnected = false;
+
+    StartServer(port);
+}
+
+/// Listen for a client on a new server thread.
+static void StartServer(u16 port) {
+    // A previous server thread exits on its own when its client disconnects
+    if (server_thread.joinable()) {
+        server_thread.join();
+    }
 
     // Start gdb server
     LOG_INFO(Debug_GDBStub, "Starting GDB server on port {}...", port);
@@ -1288,6 +1789,8 @@ static void Init(u16 port) {
     int tmpsock = static_cast<int>(socket(PF_INET, SOCK_STREAM, 0));
     if (tmpsock == -1) {
         LOG_ERROR(Debug_GDBStub, "Failed to create gdb socket");
+        halt_loop = false;
+        return;
     }
 
     // Set socket to SO_REUSEADDR so it can always bind on the same port
@@ -1307,28 +1810,9 @@ static void Init(u16 port) {
         LOG_ERROR(Debug_GDBStub, "Failed to listen to gdb socket");
     }
 
-    // Wait for gdb to connect
-    LOG_INFO(Debug_GDBStub, "Waiting for gdb to connect...");
-    sockaddr_in saddr_client;
-    sockaddr* client_addr = reinterpret_cast<sockaddr*>(&saddr_client);
-    socklen_t client_addrlen = sizeof(saddr_client);
-    gdbserver_socket = static_cast<int>(accept(tmpsock, client_addr, &client_addrlen));
-    if (gdbserver_socket < 0) {
-        // In the case that we couldn't start the server for whatever reason, just start CPU
-        // execution like normal.
-        halt_loop = false;
-        step_loop = false;
-
-        LOG_ERROR(Debug_GDBStub, "Failed to accept gdb client");
-    } else {
-        LOG_INFO(Debug_GDBStub, "Client connected.");
-        saddr_client.sin_addr.s_addr = ntohl(saddr_client.sin_addr.s_addr);
-    }
-
-    // Clean up temporary socket if it's still alive at this point.
-    if (tmpsock != -1) {
-        shutdown(tmpsock, SHUT_RDWR);
-    }
+    // Accept the client on the server thread, the CPU stays halted until gdb resumes it
+    server_running = true;
+    server_thread = std::thread(ServerLoop, tmpsock);
 }
 
 void Init() {
@@ -1341,9 +1825,20 @@ void Shutdown() {
     }
 
     LOG_INFO(Debug_GDBStub, "Stopping GDB ...");
-    if (gdbserver_socket != -1) {
-        shutdown(gdbserver_socket, SHUT_RDWR);
-        gdbserver_socket = -1;
+    server_running = false;
+    {
+        std::lock_guard lock{send_mutex};
+        const int socket = gdbserver_socket.exchange(-1);
+        if (socket != -1) {
+            shutdown(socket, SHUT_RDWR);
+        }
+    }
+    if (server_thread.joinable() && server_thread.get_id() != std::this_thread::get_id()) {
+        server_thread.join();
+    }
+
+    if (Core::CurrentProcess() != nullptr) {
+        RemoveAllBreakpoints();
     }
 
 #ifdef _WIN32
@@ -52,9 +52,19 @@ bool IsServerEnabled();
 /// Returns true if there is an active socket connection.
 bool IsConnected();
 
+/// A module loaded into the emulated process.
+struct Module {
+    std::string name;
+    VAddr beg;
+    VAddr end;
+};
+
 /// Register module.
 void RegisterModule(std::string name, VAddr beg, VAddr end, bool add_elf_ext = true);
 
+/// Returns the registered module containing the given address, or nullptr if there is none.
+const Module* FindModule(VAddr addr);
+
 /**
  * Signal to the gdbstub server that it should halt CPU execution.
  *
@@ -65,9 +75,18 @@ void Break(bool is_memory_break = false);
 /// Determine if there was a memory breakpoint.
 bool IsMemoryBreak();
 
-/// Read and handle packet from gdb client.
+/**
+ * Handle the packets received from gdb client since the last call. The packets are received on a
+ * separate thread, this only checks a queue when there is nothing to handle.
+ */
 void HandlePacket();
 
+/**
+ * Block the emulation thread while the CPU is halted, until a packet is received from the gdb
+ * client. Returns after a short timeout regardless, so that emulation can still be stopped.
+ */
+void WaitForPacket();
+
 /**
  * Get the nearest breakpoint of the specified type at the given address.
  *
@@ -76,6 +95,15 @@ void HandlePacket();
  */
 BreakpointAddress GetNextBreakpointFromAddress(VAddr addr, GDBStub::BreakpointType type);
 
+/**
+ * Check if the page containing the given address holds a breakpoint of the specified type. This
+ * lets callers checking every instruction or access skip pages without breakpoints.
+ *
+ * @param addr Address to check.
+ * @param type Type of breakpoint.
+ */
+bool IsBreakpointPage(VAddr addr, GDBStub::BreakpointType type);
+
 /**
  * Check if a breakpoint of the specified type exists at the given address.
  *
@@ -0,0 +1,253 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <vector>
+#include <fmt/format.h>
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "core/arm/arm_interface.h"
+#include "core/arm/symbols.h"
+#include "core/core.h"
+#include "core/core_cpu.h"
+#include "core/core_timing.h"
+#include "core/core_timing_util.h"
+#include "core/gdbstub/gdbstub.h"
+#include "core/guest_profiler.h"
+#include "core/hle/kernel/scheduler.h"
+
+namespace Core {
+
+namespace {
+
+/// Resolves guest addresses to module and function names, caching the symbols of each module
+class Symbolizer {
+public:
+    struct Location {
+        std::string module;
+        std::string function;
+        /// Address the location is aggregated at, the function start if it is known
+        VAddr address;
+    };
+
+    Location Resolve(VAddr address) {
+        const GDBStub::Module* const module = GDBStub::FindModule(address);
+        if (module == nullptr) {
+            return {"[unknown]", fmt::format("0x{:016X}", address), address};
+        }
+
+        auto iter = functions.find(module->beg);
+        if (iter == functions.end()) {
+            iter = functions.emplace(module->beg, GetFunctions(module->beg)).first;
+        }
+
+        // Only the last function starting at or before the offset can contain it
+        const VAddr offset = address - module->beg;
+        const auto& module_functions = iter->second;
+        const auto function = std::upper_bound(
+            module_functions.begin(), module_functions.end(), offset,
+            [](VAddr value, const Function& other) { return value < other.begin; });
+        if (function != module_functions.begin() && offset < std::prev(function)->end) {
+            const Function& match = *std::prev(function);
+            return {module->name, match.name, module->beg + match.begin};
+        }
+        return {module->name, fmt::format("{}+0x{:X}", module->name, offset), address};
+    }
+
+private:
+    /// Function symbol of a module, relative to its start
+    struct Function {
+        VAddr begin;
+        VAddr end;
+        std::string name;
+    };
+
+    /// Returns the function symbols of the module starting at base, sorted by their start
+    static std::vector<Function> GetFunctions(VAddr base) {
+        std::vector<Function> module_functions;
+        for (auto& [symbol, name] : Symbols::GetSymbols(base)) {
+            if (symbol.type == Symbols::ELFSymbolType::Function && symbol.size != 0) {
+                module_functions.push_back({symbol.value, symbol.value + symbol.size, name});
+            }
+        }
+        std::sort(module_functions.begin(), module_functions.end(),
+                  [](const Function& lhs, const Function& rhs) { return lhs.begin < rhs.begin; });
+        return module_functions;
+    }
+
+    std::map<VAddr, std::vector<Function>> functions;
+};
+
+} // Anonymous namespace
+
+GuestProfiler::GuestProfiler(System& system) : system{system} {}
+
+GuestProfiler::~GuestProfiler() = default;
+
+void GuestProfiler::Start(std::chrono::microseconds interval) {
+    auto& core_timing = system.CoreTiming();
+    if (sample_event == nullptr) {
+        sample_event = core_timing.RegisterEvent(
+            "GuestProfiler::Sample", [this](u64, s64 cycles_late) { Sample(cycles_late); });
+    }
+
+    {
+        std::lock_guard lock{mutex};
+        samples.clear();
+        fallbacks.clear();
+        total_samples = 0;
+        idle_samples = 0;
+        svc_statistics_origin = Kernel::GetSVCStatistics();
+    }
+
+    interval_ticks = std::max<s64>(Timing::usToCycles(interval), 1);
+    if (!is_enabled.exchange(true, std::memory_order_relaxed)) {
+        core_timing.ScheduleEvent(interval_ticks, sample_event);
+    }
+}
+
+void GuestProfiler::Stop() {
+    if (is_enabled.exchange(false, std::memory_order_relaxed)) {
+        system.CoreTiming().UnscheduleEvent(sample_event, 0);
+    }
+}
+
+void GuestProfiler::Sample(s64 cycles_late) {
+    if (!IsEnabled()) {
+        return;
+    }
+
+    {
+        std::lock_guard lock{mutex};
+        for (std::size_t core = 0; core < NUM_CPU_CORES; ++core) {
+            ++total_samples;
+            // Cores without a current thread are idling in the host, there is no guest PC
+            if (system.Scheduler(core).GetCurrentThread() == nullptr) {
+                ++idle_samples;
+                continue;
+            }
+            // In multicore mode the other cores keep running while they are sampled, so their PC
+            // is only as recent as the last block they left. This is precise enough for sampling.
+            ++samples[system.ArmInterface(core).GetPC()];
+        }
+    }
+
+    system.CoreTiming().ScheduleEvent(interval_ticks - cycles_late, sample_event);
+}
+
+void GuestProfiler::RecordInterpreterFallback(VAddr pc, std::size_t num_instructions,
+                                              u32 instruction) {
+    std::lock_guard lock{mutex};
+    FallbackCounter& counter = fallbacks[pc];
+    counter.instruction = instruction;
+    ++counter.count;
+    counter.num_instructions += num_instructions;
+}
+
+GuestProfiler::Report GuestProfiler::GenerateReport() const {
+    std::unordered_map<VAddr, u64> samples_copy;
+    std::unordered_map<VAddr, FallbackCounter> fallbacks_copy;
+    Kernel::SVCStatistics svc_origin;
+    Report report{};
+    {
+        std::lock_guard lock{mutex};
+        samples_copy = samples;
+        fallbacks_copy = fallbacks;
+        svc_origin = svc_statistics_origin;
+        report.total_samples = total_samples;
+        report.idle_samples = idle_samples;
+    }
+
+    const Kernel::SVCStatistics svc_statistics = Kernel::GetSVCStatistics();
+    for (u32 immediate = 0; immediate < Kernel::NUM_SVCS; ++immediate) {
+        const u64 calls = svc_statistics.calls[immediate] - svc_origin.calls[immediate];
+        if (calls != 0) {
+            report.svcs.push_back({immediate, Kernel::GetSVCName(immediate),
+                                   Kernel::IsLockFreeSVC(immediate), calls});
+        }
+    }
+
+    Symbolizer symbolizer;
+
+    std::unordered_map<VAddr, std::size_t> function_indices;
+    for (const auto& [pc, count] : samples_copy) {
+        auto location = symbolizer.Resolve(pc);
+        const auto [iter, inserted] =
+            function_indices.emplace(location.address, report.functions.size());
+        if (inserted) {
+            report.functions.push_back({std::move(location.module), std::move(location.function),
+                                        location.address, 0});
+        }
+        report.functions[iter->second].samples += count;
+    }
+
+    for (const auto& [pc, counter] : fallbacks_copy) {
+        auto location = symbolizer.Resolve(pc);
+        report.fallbacks.push_back({std::move(location.module), std::move(location.function), pc,
+                                    counter.instruction, counter.count,
+                                    counter.num_instructions});
+    }
+
+    std::sort(report.functions.begin(), report.functions.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.samples > rhs.samples; });
+    std::sort(report.fallbacks.begin(), report.fallbacks.end(),
+              [](const auto& lhs, const auto& rhs) {
+                  return lhs.num_instructions > rhs.num_instructions;
+              });
+    std::sort(report.svcs.begin(), report.svcs.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.calls > rhs.calls; });
+    return report;
+}
+
+std::string GuestProfiler::FormatReport(const Report& report, std::size_t max_entries) const {
+    const u64 busy_samples = report.total_samples - report.idle_samples;
+    std::string out = fmt::format("Guest samples: {} ({} idle)\n", report.total_samples,
+                                  report.idle_samples);
+
+    out += "\nTop guest functions:\n";
+    const std::size_t num_functions = std::min(max_entries, report.functions.size());
+    for (std::size_t i = 0; i < num_functions; ++i) {
+        const FunctionEntry& entry = report.functions[i];
+        const double percent =
+            busy_samples != 0 ? 100.0 * static_cast<double>(entry.samples) / busy_samples : 0.0;
+        out += fmt::format("  {:6.2f}% {:>8} 0x{:016X} {} ({})\n", percent, entry.samples,
+                           entry.address, entry.function, entry.module);
+    }
+
+    out += "\nInterpreter fallbacks:\n";
+    const std::size_t num_fallbacks = std::min(max_entries, report.fallbacks.size());
+    for (std::size_t i = 0; i < num_fallbacks; ++i) {
+        const FallbackEntry& entry = report.fallbacks[i];
+        out += fmt::format("  {:>8} calls {:>10} instructions 0x{:016X} instr={:08X} {} ({})\n",
+                           entry.count, entry.num_instructions, entry.pc, entry.instruction,
+                           entry.function, entry.module);
+    }
+
+    out += "\nSVC calls:\n";
+    for (const SVCEntry& entry : report.svcs) {
+        out += fmt::format("  {:>10} 0x{:02X} {}{}\n", entry.calls, entry.immediate, entry.name,
+                           entry.is_lock_free ? " (lock-free)" : "");
+    }
+    return out;
+}
+
+bool GuestProfiler::WriteReport(const std::string& path, std::size_t max_entries) const {
+    FileUtil::IOFile file(path, "w");
+    if (!file.IsOpen()) {
+        LOG_ERROR(Core, "Failed to open {} for writing the guest profile", path);
+        return false;
+    }
+
+    const std::string out = FormatReport(GenerateReport(), max_entries);
+    return file.WriteString(out) == out.size();
+}
+
+void GuestProfiler::LogReport(std::size_t max_entries) const {
+    LOG_INFO(Core, "Guest profile:\n{}", FormatReport(GenerateReport(), max_entries));
+}
+
+} // namespace Core
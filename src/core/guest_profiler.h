@@ -0,0 +1,136 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "common/common_types.h"
+#include "core/hle/kernel/svc.h"
+
+namespace Core::Timing {
+struct EventType;
+}
+
+namespace Core {
+
+class System;
+
+/**
+ * Sampling profiler for guest code.
+ *
+ * While enabled, a CoreTiming event periodically samples the guest PC of every core that is
+ * running a guest thread. The profiler also counts the instructions the JIT hands over to the
+ * interpreter, by PC, and reports the SVCs called meanwhile. Samples are symbolized against the
+ * modules registered with the GDB stub only when a report is generated, so sampling stays cheap.
+ */
+class GuestProfiler {
+public:
+    /// Samples attributed to a single guest function
+    struct FunctionEntry {
+        std::string module;
+        std::string function;
+        VAddr address;
+        u64 samples;
+    };
+
+    /// Interpreter fallbacks that happened at a single guest PC
+    struct FallbackEntry {
+        std::string module;
+        std::string function;
+        VAddr pc;
+        u32 instruction;
+        u64 count;
+        u64 num_instructions;
+    };
+
+    /// Calls to a single SVC
+    struct SVCEntry {
+        u32 immediate;
+        const char* name;
+        bool is_lock_free;
+        u64 calls;
+    };
+
+    struct Report {
+        u64 total_samples;
+        u64 idle_samples;
+        std::vector<FunctionEntry> functions;
+        std::vector<FallbackEntry> fallbacks;
+        std::vector<SVCEntry> svcs;
+    };
+
+    explicit GuestProfiler(System& system);
+    ~GuestProfiler();
+
+    GuestProfiler(const GuestProfiler&) = delete;
+    GuestProfiler& operator=(const GuestProfiler&) = delete;
+
+    /**
+     * Starts sampling the guest PCs. Samples of a previous session are discarded.
+     * @param interval Emulated time between two samples
+     */
+    void Start(std::chrono::microseconds interval = std::chrono::microseconds{100});
+
+    /// Stops sampling, samples taken so far are kept until the next Start
+    void Stop();
+
+    /// Returns true if guest PCs are currently being sampled
+    bool IsEnabled() const {
+        return is_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Records that the JIT fell back to the interpreter.
+     * @param pc Guest address of the first interpreted instruction
+     * @param num_instructions Number of instructions that were interpreted
+     * @param instruction Encoding of the first interpreted instruction
+     */
+    void RecordInterpreterFallback(VAddr pc, std::size_t num_instructions, u32 instruction);
+
+    /// Aggregates the samples taken so far by guest function, sorted by descending sample count
+    Report GenerateReport() const;
+
+    /**
+     * Writes a human readable report of the samples taken so far.
+     * @param path Path of the file to write
+     * @param max_entries Maximum number of functions and fallbacks listed
+     * @returns true if the file was written successfully
+     */
+    bool WriteReport(const std::string& path, std::size_t max_entries = 100) const;
+
+    /// Prints the hottest guest functions and interpreter fallbacks to the log
+    void LogReport(std::size_t max_entries = 10) const;
+
+private:
+    struct FallbackCounter {
+        u32 instruction;
+        u64 count;
+        u64 num_instructions;
+    };
+
+    void Sample(s64 cycles_late);
+
+    std::string FormatReport(const Report& report, std::size_t max_entries) const;
+
+    System& system;
+
+    std::atomic_bool is_enabled{false};
+    s64 interval_ticks = 0;
+    Timing::EventType* sample_event = nullptr;
+
+    mutable std::mutex mutex;
+    std::unordered_map<VAddr, u64> samples;
+    u64 total_samples = 0;
+    u64 idle_samples = 0;
+    std::unordered_map<VAddr, FallbackCounter> fallbacks;
+    /// SVC counters when sampling started, the report only covers calls made since then
+    Kernel::SVCStatistics svc_statistics_origin;
+};
+
+} // namespace Core
@@ -295,6 +295,21 @@ std::vector<u8> HLERequestContext::ReadBuffer(int buffer_index) const {
     return buffer;
 }
 
+std::size_t HLERequestContext::ReadBuffer(void* buffer, std::size_t size,
+                                          int buffer_index) const {
+    const bool is_buffer_a{BufferDescriptorA().size() && BufferDescriptorA()[buffer_index].Size()};
+
+    if (is_buffer_a) {
+        size = std::min<std::size_t>(size, BufferDescriptorA()[buffer_index].Size());
+        Memory::ReadBlock(BufferDescriptorA()[buffer_index].Address(), buffer, size);
+    } else {
+        size = std::min<std::size_t>(size, BufferDescriptorX()[buffer_index].Size());
+        Memory::ReadBlock(BufferDescriptorX()[buffer_index].Address(), buffer, size);
+    }
+
+    return size;
+}
+
 std::size_t HLERequestContext::WriteBuffer(const void* buffer, std::size_t size,
                                            int buffer_index) const {
     if (size == 0) {
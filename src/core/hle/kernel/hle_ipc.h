@@ -179,6 +179,13 @@ public:
     /// Helper function to read a buffer using the appropriate buffer descriptor
     std::vector<u8> ReadBuffer(int buffer_index = 0) const;
 
+    /**
+     * Helper function to read a buffer into caller provided memory using the appropriate buffer
+     * descriptor, without allocating
+     * @returns the number of bytes read, which is at most the size of the input buffer
+     */
+    std::size_t ReadBuffer(void* buffer, std::size_t size, int buffer_index = 0) const;
+
     /// Helper function to write a buffer using the appropriate buffer descriptor
     std::size_t WriteBuffer(const void* buffer, std::size_t size, int buffer_index = 0) const;
 
@@ -3,8 +3,10 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
 #include <cinttypes>
 #include <iterator>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -38,6 +40,7 @@
 #include "core/hle/result.h"
 #include "core/hle/service/service.h"
 #include "core/memory.h"
+#include "core/perf_stats.h"
 #include "core/reporter.h"
 
 namespace Kernel {
@@ -1680,10 +1683,8 @@ static ResultCode SignalProcessWideKey(Core::System& system, VAddr condition_var
         // Atomically read the value of the mutex.
         u32 mutex_val = 0;
         do {
-            monitor.SetExclusive(current_core, thread->GetMutexWaitAddress());
-
             // If the mutex is not yet acquired, acquire it.
-            mutex_val = Memory::Read32(thread->GetMutexWaitAddress());
+            mutex_val = monitor.ExclusiveRead32(current_core, thread->GetMutexWaitAddress());
 
             if (mutex_val != 0) {
                 monitor.ClearExclusive();
@@ -1708,10 +1709,9 @@ static ResultCode SignalProcessWideKey(Core::System& system, VAddr condition_var
         } else {
             // Atomically signal that the mutex now has a waiting thread.
             do {
-                monitor.SetExclusive(current_core, thread->GetMutexWaitAddress());
-
                 // Ensure that the mutex value is still what we expect.
-                u32 value = Memory::Read32(thread->GetMutexWaitAddress());
+                const u32 value =
+                    monitor.ExclusiveRead32(current_core, thread->GetMutexWaitAddress());
                 // TODO(Subv): When this happens, the kernel just clears the exclusive state and
                 // retries the initial read for this thread.
                 ASSERT_MSG(mutex_val == value, "Unhandled synchronization primitive case");
@@ -1784,10 +1784,12 @@ static ResultCode SignalToAddress(Core::System& system, VAddr address, u32 type,
 static u64 GetSystemTick(Core::System& system) {
     LOG_TRACE(Kernel_SVC, "called");
 
+    // The same counter the guest reads from CNTPCT_EL0
     auto& core_timing = system.CoreTiming();
-    const u64 result{core_timing.GetTicks()};
+    const u64 result{core_timing.GetClockTicks()};
 
-    // Advance time to defeat dumb games that busy-wait for the frame to end.
+    // Advance time to defeat dumb games that busy-wait for the frame to end. AddTicks is atomic,
+    // so this needs no lock.
     core_timing.AddTicks(400);
 
     return result;
@@ -2345,6 +2347,10 @@ struct FunctionDef {
     u32 id;
     Func* func;
     const char* name;
+    /// Pure queries of state that is either immutable, owned by the calling core or already
+    /// synchronized on its own. These skip the global HLE lock, so that cores spinning on them
+    /// don't stall the others.
+    bool is_lock_free = false;
 };
 } // namespace
 
@@ -2365,7 +2371,7 @@ static const FunctionDef SVC_Table[] = {
     {0x0D, SvcWrap<SetThreadPriority>, "SetThreadPriority"},
     {0x0E, SvcWrap<GetThreadCoreMask>, "GetThreadCoreMask"},
     {0x0F, SvcWrap<SetThreadCoreMask>, "SetThreadCoreMask"},
-    {0x10, SvcWrap<GetCurrentProcessorNumber>, "GetCurrentProcessorNumber"},
+    {0x10, SvcWrap<GetCurrentProcessorNumber>, "GetCurrentProcessorNumber", true},
     {0x11, SvcWrap<SignalEvent>, "SignalEvent"},
     {0x12, SvcWrap<ClearEvent>, "ClearEvent"},
     {0x13, SvcWrap<MapSharedMemory>, "MapSharedMemory"},
@@ -2379,7 +2385,7 @@ static const FunctionDef SVC_Table[] = {
     {0x1B, SvcWrap<ArbitrateUnlock>, "ArbitrateUnlock"},
     {0x1C, SvcWrap<WaitProcessWideKeyAtomic>, "WaitProcessWideKeyAtomic"},
     {0x1D, SvcWrap<SignalProcessWideKey>, "SignalProcessWideKey"},
-    {0x1E, SvcWrap<GetSystemTick>, "GetSystemTick"},
+    {0x1E, SvcWrap<GetSystemTick>, "GetSystemTick", true},
     {0x1F, SvcWrap<ConnectToNamedPort>, "ConnectToNamedPort"},
     {0x20, nullptr, "SendSyncRequestLight"},
     {0x21, SvcWrap<SendSyncRequest>, "SendSyncRequest"},
@@ -2388,7 +2394,7 @@ static const FunctionDef SVC_Table[] = {
     {0x24, SvcWrap<GetProcessId>, "GetProcessId"},
     {0x25, SvcWrap<GetThreadId>, "GetThreadId"},
     {0x26, SvcWrap<Break>, "Break"},
-    {0x27, SvcWrap<OutputDebugString>, "OutputDebugString"},
+    {0x27, SvcWrap<OutputDebugString>, "OutputDebugString", true},
     {0x28, nullptr, "ReturnFromException"},
     {0x29, SvcWrap<GetInfo>, "GetInfo"},
     {0x2A, nullptr, "FlushEntireDataCache"},
@@ -2478,6 +2484,7 @@ static const FunctionDef SVC_Table[] = {
     {0x7E, SvcWrap<SetResourceLimitLimitValue>, "SetResourceLimitLimitValue"},
     {0x7F, nullptr, "CallSecureMonitor"},
 };
+static_assert(std::size(SVC_Table) == NUM_SVCS, "SVC_Table does not cover all SVCs");
 
 static const FunctionDef* GetSVCInfo(u32 func_num) {
     if (func_num >= std::size(SVC_Table)) {
@@ -2487,18 +2494,48 @@ static const FunctionDef* GetSVCInfo(u32 func_num) {
     return &SVC_Table[func_num];
 }
 
+namespace {
+
+/// SVC call counters of a single host thread. Only the owning thread writes them, so incrementing
+/// them does not need an atomic read-modify-write nor bounce cache lines between cores.
+struct ThreadSVCCounters {
+    std::array<std::atomic<u64>, NUM_SVCS + 1> calls{};
+};
+
+std::mutex svc_counters_mutex;
+std::vector<std::unique_ptr<ThreadSVCCounters>> svc_counters;
+
+void CountSVC(u32 immediate) {
+    // Counters are never freed, so the calls of finished threads are still reported
+    thread_local ThreadSVCCounters* counters = [] {
+        std::lock_guard lock{svc_counters_mutex};
+        return svc_counters.emplace_back(std::make_unique<ThreadSVCCounters>()).get();
+    }();
+
+    std::atomic<u64>& counter = counters->calls[std::min<std::size_t>(immediate, NUM_SVCS)];
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+} // Anonymous namespace
+
 MICROPROFILE_DEFINE(Kernel_SVC, "Kernel", "SVC", MP_RGB(70, 200, 70));
 
 void CallSVC(Core::System& system, u32 immediate) {
     MICROPROFILE_SCOPE(Kernel_SVC);
+    Core::PerfStats::ScopedTimer timer{system.GetPerfStats(), Core::PerfSubsystem::Svc};
 
-    // Lock the global kernel mutex when we enter the kernel HLE.
-    std::lock_guard lock{HLE::g_hle_lock};
+    CountSVC(immediate);
 
     const FunctionDef* info = GetSVCInfo(immediate);
     if (info) {
         if (info->func) {
-            info->func(system);
+            if (info->is_lock_free) {
+                info->func(system);
+            } else {
+                // Lock the global kernel mutex when we enter the kernel HLE.
+                std::lock_guard lock{HLE::g_hle_lock};
+                info->func(system);
+            }
         } else {
             LOG_CRITICAL(Kernel_SVC, "Unimplemented SVC function {}(..)", info->name);
         }
@@ -2507,4 +2544,28 @@ void CallSVC(Core::System& system, u32 immediate) {
     }
 }
 
+const char* GetSVCName(u32 immediate) {
+    if (immediate >= std::size(SVC_Table)) {
+        return nullptr;
+    }
+    return SVC_Table[immediate].name;
+}
+
+bool IsLockFreeSVC(u32 immediate) {
+    return immediate < std::size(SVC_Table) && SVC_Table[immediate].is_lock_free;
+}
+
+SVCStatistics GetSVCStatistics() {
+    SVCStatistics statistics;
+
+    std::lock_guard lock{svc_counters_mutex};
+    for (const auto& counters : svc_counters) {
+        for (std::size_t i = 0; i < NUM_SVCS; ++i) {
+            statistics.calls[i] += counters->calls[i].load(std::memory_order_relaxed);
+        }
+        statistics.unknown_calls += counters->calls[NUM_SVCS].load(std::memory_order_relaxed);
+    }
+    return statistics;
+}
+
 } // namespace Kernel
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include "common/common_types.h"
 
 namespace Core {
@@ -12,6 +13,25 @@ class System;
 
 namespace Kernel {
 
+/// Number of SVC immediates known to the kernel
+constexpr std::size_t NUM_SVCS = 0x80;
+
+/// Number of calls to each SVC since the emulator started, indexed by SVC immediate
+struct SVCStatistics {
+    std::array<u64, NUM_SVCS> calls{};
+    /// Calls to immediates outside of the SVC table
+    u64 unknown_calls = 0;
+};
+
 void CallSVC(Core::System& system, u32 immediate);
 
+/// Returns the name of an SVC, or nullptr if the immediate is not a known SVC
+const char* GetSVCName(u32 immediate);
+
+/// Returns true if an SVC only queries state and is dispatched without the global HLE lock
+bool IsLockFreeSVC(u32 immediate);
+
+/// Gathers the SVC call counters of all host threads. This may be called from any thread.
+SVCStatistics GetSVCStatistics();
+
 } // namespace Kernel
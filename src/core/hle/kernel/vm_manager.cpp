@@ -893,6 +893,7 @@ void VMManager::ClearVMAMap() {
 void VMManager::ClearPageTable() {
     std::fill(page_table.pointers.begin(), page_table.pointers.end(), nullptr);
     page_table.special_regions.clear();
+    page_table.hooked_pages.clear();
     std::fill(page_table.attributes.begin(), page_table.attributes.end(),
               Common::PageType::Unmapped);
 }
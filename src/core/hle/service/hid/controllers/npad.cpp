@@ -234,183 +234,147 @@ void Controller_NPad::OnLoadInputDevices() {
 
 void Controller_NPad::OnRelease() {}
 
-void Controller_NPad::RequestPadStateUpdate(u32 npad_id) {
-    const auto controller_idx = NPadIdToIndex(npad_id);
-    const auto controller_type = connected_controllers[controller_idx].type;
-    if (!connected_controllers[controller_idx].is_connected) {
-        return;
+void Controller_NPad::AdvanceLayout(NPadGeneric& layout, s64 timestamp) {
+    const auto& last_entry = layout.npad[layout.common.last_entry_index];
+    const s64 entry_timestamp = last_entry.timestamp + 1;
+
+    layout.common.entry_count = 16;
+    layout.common.total_entry_count = 17;
+    layout.common.timestamp = timestamp;
+    layout.common.last_entry_index = (layout.common.last_entry_index + 1) % 17;
+
+    auto& cur_entry = layout.npad[layout.common.last_entry_index];
+    cur_entry.timestamp = entry_timestamp;
+    cur_entry.timestamp2 = entry_timestamp;
+}
+
+Controller_NPad::GenericStates& Controller_NPad::GetCurrentEntry(NPadGeneric& layout) {
+    return layout.npad[layout.common.last_entry_index];
+}
+
+Controller_NPad::NPadGeneric Controller_NPad::NPadEntry::*Controller_NPad::GetLayoutForController(
+    NPadControllerType type) {
+    switch (type) {
+    case NPadControllerType::Handheld:
+        return &NPadEntry::handheld_states;
+    case NPadControllerType::JoyDual:
+        return &NPadEntry::dual_states;
+    case NPadControllerType::JoyLeft:
+        return &NPadEntry::left_joy_states;
+    case NPadControllerType::JoyRight:
+        return &NPadEntry::right_joy_states;
+    case NPadControllerType::Pokeball:
+        return &NPadEntry::pokeball_states;
+    case NPadControllerType::ProController:
+        return &NPadEntry::main_controller_states;
+    default:
+        return nullptr;
     }
-    auto& pad_state = npad_pad_states[controller_idx].pad_states;
-    auto& lstick_entry = npad_pad_states[controller_idx].l_stick;
-    auto& rstick_entry = npad_pad_states[controller_idx].r_stick;
+}
+
+Controller_NPad::ConnectionState Controller_NPad::GetConnectionState(NPadControllerType type) {
+    ConnectionState state{};
+    switch (type) {
+    case NPadControllerType::Handheld:
+        state.IsWired.Assign(1);
+        state.IsLeftJoyConnected.Assign(1);
+        state.IsRightJoyConnected.Assign(1);
+        state.IsLeftJoyWired.Assign(1);
+        state.IsRightJoyWired.Assign(1);
+        break;
+    case NPadControllerType::JoyDual:
+        state.IsLeftJoyConnected.Assign(1);
+        state.IsRightJoyConnected.Assign(1);
+        state.IsConnected.Assign(1);
+        break;
+    case NPadControllerType::JoyLeft:
+    case NPadControllerType::JoyRight:
+        state.IsConnected.Assign(1);
+        break;
+    case NPadControllerType::Pokeball:
+    case NPadControllerType::ProController:
+        state.IsConnected.Assign(1);
+        state.IsWired.Assign(1);
+        break;
+    default:
+        break;
+    }
+    return state;
+}
+
+void Controller_NPad::RequestPadStateUpdate(std::size_t controller_idx) {
     const auto& button_state = buttons[controller_idx];
     const auto& analog_state = sticks[controller_idx];
 
-    using namespace Settings::NativeButton;
-    pad_state.a.Assign(button_state[A - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.b.Assign(button_state[B - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.x.Assign(button_state[X - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.y.Assign(button_state[Y - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.l_stick.Assign(button_state[LStick - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.r_stick.Assign(button_state[RStick - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.l.Assign(button_state[L - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.r.Assign(button_state[R - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.zl.Assign(button_state[ZL - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.zr.Assign(button_state[ZR - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.plus.Assign(button_state[Plus - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.minus.Assign(button_state[Minus - BUTTON_HID_BEGIN]->GetStatus());
-
-    pad_state.d_left.Assign(button_state[DLeft - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.d_up.Assign(button_state[DUp - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.d_right.Assign(button_state[DRight - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.d_down.Assign(button_state[DDown - BUTTON_HID_BEGIN]->GetStatus());
-
-    pad_state.l_stick_left.Assign(button_state[LStick_Left - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.l_stick_up.Assign(button_state[LStick_Up - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.l_stick_right.Assign(button_state[LStick_Right - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.l_stick_down.Assign(button_state[LStick_Down - BUTTON_HID_BEGIN]->GetStatus());
-
-    pad_state.r_stick_left.Assign(button_state[RStick_Left - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.r_stick_up.Assign(button_state[RStick_Up - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.r_stick_right.Assign(button_state[RStick_Right - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.r_stick_down.Assign(button_state[RStick_Down - BUTTON_HID_BEGIN]->GetStatus());
-
-    pad_state.left_sl.Assign(button_state[SL - BUTTON_HID_BEGIN]->GetStatus());
-    pad_state.left_sr.Assign(button_state[SR - BUTTON_HID_BEGIN]->GetStatus());
+    static_assert(Settings::NativeButton::BUTTON_HID_BEGIN == 0 &&
+                      Settings::NativeButton::NUM_BUTTONS_HID == 26,
+                  "HID buttons do not match the bits of ControllerPadState");
+
+    // The HID buttons are laid out in the same order as the bits of ControllerPadState, so all of
+    // them can be gathered into a single word instead of assigning every bitfield separately.
+    u64 pad_states = 0;
+    for (std::size_t index = 0; index < button_state.size(); ++index) {
+        pad_states |= static_cast<u64>(button_state[index]->GetStatus()) << index;
+    }
+
+    auto& pad = npad_pad_states[controller_idx];
+    pad.pad_states.raw = pad_states;
 
     const auto [stick_l_x_f, stick_l_y_f] =
         analog_state[static_cast<std::size_t>(JoystickId::Joystick_Left)]->GetStatus();
     const auto [stick_r_x_f, stick_r_y_f] =
         analog_state[static_cast<std::size_t>(JoystickId::Joystick_Right)]->GetStatus();
-    lstick_entry.x = static_cast<s32>(stick_l_x_f * HID_JOYSTICK_MAX);
-    lstick_entry.y = static_cast<s32>(stick_l_y_f * HID_JOYSTICK_MAX);
-    rstick_entry.x = static_cast<s32>(stick_r_x_f * HID_JOYSTICK_MAX);
-    rstick_entry.y = static_cast<s32>(stick_r_y_f * HID_JOYSTICK_MAX);
+    pad.l_stick.x = static_cast<s32>(stick_l_x_f * HID_JOYSTICK_MAX);
+    pad.l_stick.y = static_cast<s32>(stick_l_y_f * HID_JOYSTICK_MAX);
+    pad.r_stick.x = static_cast<s32>(stick_r_x_f * HID_JOYSTICK_MAX);
+    pad.r_stick.y = static_cast<s32>(stick_r_y_f * HID_JOYSTICK_MAX);
 }
 
 void Controller_NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing, u8* data,
                                std::size_t data_len) {
     if (!IsControllerActivated())
         return;
-    for (std::size_t i = 0; i < shared_memory_entries.size(); i++) {
-        auto& npad = shared_memory_entries[i];
-        const std::array<NPadGeneric*, 7> controller_npads{&npad.main_controller_states,
-                                                           &npad.handheld_states,
-                                                           &npad.dual_states,
-                                                           &npad.left_joy_states,
-                                                           &npad.right_joy_states,
-                                                           &npad.pokeball_states,
-                                                           &npad.libnx};
-
-        for (auto* main_controller : controller_npads) {
-            main_controller->common.entry_count = 16;
-            main_controller->common.total_entry_count = 17;
 
-            const auto& last_entry =
-                main_controller->npad[main_controller->common.last_entry_index];
-
-            main_controller->common.timestamp = core_timing.GetTicks();
-            main_controller->common.last_entry_index =
-                (main_controller->common.last_entry_index + 1) % 17;
+    static constexpr std::array<NPadGeneric NPadEntry::*, 7> NPAD_LAYOUTS{
+        &NPadEntry::main_controller_states, &NPadEntry::handheld_states,
+        &NPadEntry::dual_states,            &NPadEntry::left_joy_states,
+        &NPadEntry::right_joy_states,       &NPadEntry::pokeball_states,
+        &NPadEntry::libnx,
+    };
 
-            auto& cur_entry = main_controller->npad[main_controller->common.last_entry_index];
+    // Every layout of every entry is stamped with the same tick count
+    const s64 timestamp = static_cast<s64>(core_timing.GetTicks());
 
-            cur_entry.timestamp = last_entry.timestamp + 1;
-            cur_entry.timestamp2 = cur_entry.timestamp;
+    for (std::size_t i = 0; i < shared_memory_entries.size(); i++) {
+        auto& npad = shared_memory_entries[i];
+        for (const auto layout : NPAD_LAYOUTS) {
+            AdvanceLayout(npad.*layout, timestamp);
         }
 
-        const auto& controller_type = connected_controllers[i].type;
-
-        if (controller_type == NPadControllerType::None || !connected_controllers[i].is_connected) {
+        const auto& controller = connected_controllers[i];
+        if (controller.type == NPadControllerType::None || !controller.is_connected) {
             continue;
         }
-        const u32 npad_index = static_cast<u32>(i);
-        RequestPadStateUpdate(npad_index);
-        auto& pad_state = npad_pad_states[npad_index];
-
-        auto& main_controller =
-            npad.main_controller_states.npad[npad.main_controller_states.common.last_entry_index];
-        auto& handheld_entry =
-            npad.handheld_states.npad[npad.handheld_states.common.last_entry_index];
-        auto& dual_entry = npad.dual_states.npad[npad.dual_states.common.last_entry_index];
-        auto& left_entry = npad.left_joy_states.npad[npad.left_joy_states.common.last_entry_index];
-        auto& right_entry =
-            npad.right_joy_states.npad[npad.right_joy_states.common.last_entry_index];
-        auto& pokeball_entry =
-            npad.pokeball_states.npad[npad.pokeball_states.common.last_entry_index];
-        auto& libnx_entry = npad.libnx.npad[npad.libnx.common.last_entry_index];
+        RequestPadStateUpdate(i);
+        const auto& pad_state = npad_pad_states[i];
 
+        auto& libnx_entry = GetCurrentEntry(npad.libnx);
         libnx_entry.connection_status.raw = 0;
-
-        switch (controller_type) {
-        case NPadControllerType::Handheld:
-            handheld_entry.connection_status.raw = 0;
-            handheld_entry.connection_status.IsWired.Assign(1);
-            handheld_entry.connection_status.IsLeftJoyConnected.Assign(1);
-            handheld_entry.connection_status.IsRightJoyConnected.Assign(1);
-            handheld_entry.connection_status.IsLeftJoyWired.Assign(1);
-            handheld_entry.connection_status.IsRightJoyWired.Assign(1);
-            handheld_entry.pad.pad_states.raw = pad_state.pad_states.raw;
-            handheld_entry.pad.l_stick = pad_state.l_stick;
-            handheld_entry.pad.r_stick = pad_state.r_stick;
-            break;
-        case NPadControllerType::JoyDual:
-            dual_entry.connection_status.raw = 0;
-
-            dual_entry.connection_status.IsLeftJoyConnected.Assign(1);
-            dual_entry.connection_status.IsRightJoyConnected.Assign(1);
-            dual_entry.connection_status.IsConnected.Assign(1);
-
+        if (controller.type == NPadControllerType::JoyDual) {
             libnx_entry.connection_status.IsLeftJoyConnected.Assign(1);
             libnx_entry.connection_status.IsRightJoyConnected.Assign(1);
             libnx_entry.connection_status.IsConnected.Assign(1);
+        }
 
-            dual_entry.pad.pad_states.raw = pad_state.pad_states.raw;
-            dual_entry.pad.l_stick = pad_state.l_stick;
-            dual_entry.pad.r_stick = pad_state.r_stick;
-            break;
-        case NPadControllerType::JoyLeft:
-            left_entry.connection_status.raw = 0;
-
-            left_entry.connection_status.IsConnected.Assign(1);
-            left_entry.pad.pad_states.raw = pad_state.pad_states.raw;
-            left_entry.pad.l_stick = pad_state.l_stick;
-            left_entry.pad.r_stick = pad_state.r_stick;
-            break;
-        case NPadControllerType::JoyRight:
-            right_entry.connection_status.raw = 0;
-
-            right_entry.connection_status.IsConnected.Assign(1);
-            right_entry.pad.pad_states.raw = pad_state.pad_states.raw;
-            right_entry.pad.l_stick = pad_state.l_stick;
-            right_entry.pad.r_stick = pad_state.r_stick;
-            break;
-        case NPadControllerType::Pokeball:
-            pokeball_entry.connection_status.raw = 0;
-
-            pokeball_entry.connection_status.IsConnected.Assign(1);
-            pokeball_entry.connection_status.IsWired.Assign(1);
-
-            pokeball_entry.pad.pad_states.raw = pad_state.pad_states.raw;
-            pokeball_entry.pad.l_stick = pad_state.l_stick;
-            pokeball_entry.pad.r_stick = pad_state.r_stick;
-            break;
-        case NPadControllerType::ProController:
-            main_controller.connection_status.raw = 0;
-
-            main_controller.connection_status.IsConnected.Assign(1);
-            main_controller.connection_status.IsWired.Assign(1);
-            main_controller.pad.pad_states.raw = pad_state.pad_states.raw;
-            main_controller.pad.l_stick = pad_state.l_stick;
-            main_controller.pad.r_stick = pad_state.r_stick;
-            break;
+        if (const auto layout = GetLayoutForController(controller.type); layout != nullptr) {
+            auto& entry = GetCurrentEntry(npad.*layout);
+            entry.connection_status = GetConnectionState(controller.type);
+            entry.pad = pad_state;
         }
 
         // LibNX exclusively uses this section, so we always update it since LibNX doesn't activate
         // any controllers.
-        libnx_entry.pad.pad_states.raw = pad_state.pad_states.raw;
-        libnx_entry.pad.l_stick = pad_state.l_stick;
-        libnx_entry.pad.r_stick = pad_state.r_stick;
+        libnx_entry.pad = pad_state;
 
         press_state |= static_cast<u32>(pad_state.pad_states.raw);
     }
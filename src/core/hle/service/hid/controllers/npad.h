@@ -322,7 +322,17 @@ private:
     void InitNewlyAddedControler(std::size_t controller_idx);
     bool IsControllerSupported(NPadControllerType controller) const;
     NPadControllerType DecideBestController(NPadControllerType priority) const;
-    void RequestPadStateUpdate(u32 npad_id);
+    void RequestPadStateUpdate(std::size_t controller_idx);
+
+    /// Advances the ring of a layout to its next entry and stamps it
+    static void AdvanceLayout(NPadGeneric& layout, s64 timestamp);
+    /// Returns the most recent entry of a layout
+    static GenericStates& GetCurrentEntry(NPadGeneric& layout);
+    /// Returns the layout an emulated controller of the given type reports its state in, or
+    /// nullptr if the type has no layout of its own
+    static NPadGeneric NPadEntry::*GetLayoutForController(NPadControllerType type);
+    /// Returns the connection state reported for a connected controller of the given type
+    static ConnectionState GetConnectionState(NPadControllerType type);
     std::array<ControllerPad, 10> npad_pad_states{};
     bool IsControllerSupported(NPadControllerType controller);
     bool is_in_lr_assignment_mode{false};
@@ -111,11 +111,12 @@ void IAppletResource::UpdateControllers(u64 userdata, s64 cycles_late) {
     auto& core_timing = Core::System::GetInstance().CoreTiming();
 
     const bool should_reload = Settings::values.is_device_reload_pending.exchange(false);
+    u8* const shared_mem_ptr = shared_mem->GetPointer();
     for (const auto& controller : controllers) {
         if (should_reload) {
             controller->OnLoadInputDevices();
         }
-        controller->OnUpdate(core_timing, shared_mem->GetPointer(), SHARED_MEMORY_SIZE);
+        controller->OnUpdate(core_timing, shared_mem_ptr, SHARED_MEMORY_SIZE);
     }
 
     core_timing.ScheduleEvent(pad_update_ticks - cycles_late, pad_update_event);
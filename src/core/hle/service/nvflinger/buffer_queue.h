@@ -82,6 +82,7 @@ public:
                      const Common::Rectangle<int>& crop_rect, u32 swap_interval,
                      Service::Nvidia::MultiFence& multi_fence);
     std::optional<std::reference_wrapper<const Buffer>> AcquireBuffer();
+    const Buffer& GetAcquiredBuffer(u32 slot) const;
     void ReleaseBuffer(u32 slot);
     u32 Query(QueryType type);
 
@@ -22,6 +22,7 @@
 #include "core/hle/service/vi/layer/vi_layer.h"
 #include "core/perf_stats.h"
 #include "core/settings.h"
+#include "video_core/gpu.h"
 #include "video_core/renderer_base.h"
 
 namespace Service::NVFlinger {
@@ -178,18 +179,48 @@ void NVFlinger::Compose() {
         // TODO(Subv): Support more than 1 layer.
         VI::Layer& layer = display.GetLayer(0);
         auto& buffer_queue = layer.GetBufferQueue();
+        auto& system_instance = Core::System::GetInstance();
+        auto& gpu = system_instance.GPU();
+
+        const auto present_mode = Settings::values.present_mode;
+
+        if (present_mode == Settings::PresentMode::Mailbox) {
+            // Hold on to the newest queued frame, the older frames it replaces are given back to
+            // the game without being presented.
+            while (const auto newer_buffer = buffer_queue.AcquireBuffer()) {
+                const auto [itr, inserted] =
+                    mailbox_slots.try_emplace(buffer_queue.GetId(), newer_buffer->get().slot);
+                if (!inserted) {
+                    buffer_queue.ReleaseBuffer(itr->second);
+                    itr->second = newer_buffer->get().slot;
+                }
+            }
+            if (gpu.IsSwapPending()) {
+                // The held frame is presented on a later vsync, once the GPU has caught up
+                continue;
+            }
+        } else if (present_mode == Settings::PresentMode::Fifo && gpu.IsSwapPending()) {
+            Core::PerfStats::ScopedTimer timer{system_instance.GetPerfStats(),
+                                               Core::PerfSubsystem::Wait};
+            gpu.WaitForSwap();
+        }
 
-        // Search for a queued buffer and acquire it
-        auto buffer = buffer_queue.AcquireBuffer();
+        // Take the frame held in mailbox mode, if any, otherwise search for a queued buffer and
+        // acquire it
+        std::optional<std::reference_wrapper<const BufferQueue::Buffer>> buffer;
+        if (const auto itr = mailbox_slots.find(buffer_queue.GetId()); itr != mailbox_slots.end()) {
+            buffer = buffer_queue.GetAcquiredBuffer(itr->second);
+            mailbox_slots.erase(itr);
+        } else {
+            buffer = buffer_queue.AcquireBuffer();
+        }
 
         MicroProfileFlip();
 
         if (!buffer) {
-            auto& system_instance = Core::System::GetInstance();
-
             // There was no queued buffer to draw, render previous frame
             system_instance.GetPerfStats().EndGameFrame();
-            system_instance.GPU().SwapBuffers({});
+            gpu.SwapBuffers({});
             continue;
         }
 
@@ -8,6 +8,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "common/common_types.h"
@@ -102,6 +103,10 @@ private:
 
     u32 swap_interval = 1;
 
+    /// Slots of the frames held back in mailbox mode until the GPU presents the previous frame,
+    /// keyed by buffer queue ID.
+    std::unordered_map<u32, u32> mailbox_slots;
+
     /// Event that handles screen composition.
     Core::Timing::EventType* composition_event;
 
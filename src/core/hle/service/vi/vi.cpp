@@ -59,22 +59,32 @@ struct DisplayInfo {
 };
 static_assert(sizeof(DisplayInfo) == 0x60, "DisplayInfo has wrong size");
 
+/**
+ * Parcels exchanged with the binder driver are small, so they are parsed from and built in a
+ * fixed-size buffer instead of heap allocated ones. Requests are read from guest memory with a
+ * single block read and responses are written back with a single block write.
+ */
 class Parcel {
 public:
-    // This default size was chosen arbitrarily.
-    static constexpr std::size_t DefaultBufferSize = 0x40;
-    Parcel() : buffer(DefaultBufferSize) {}
-    explicit Parcel(std::vector<u8> data) : buffer(std::move(data)) {}
+    /// Largest parcel that can be read or written. Guest buffers only carry a few hundred bytes.
+    static constexpr std::size_t MaxSize = 0x800;
+    /// Smallest parcel written back to the guest.
+    static constexpr std::size_t MinSerializedSize = 0x40;
+
+    Parcel() = default;
+    explicit Parcel(const Kernel::HLERequestContext& ctx) {
+        const std::size_t input_size = ctx.GetReadBufferSize();
+        if (input_size > MaxSize) {
+            LOG_ERROR(Service_VI, "Parcel of 0x{:X} bytes exceeds the maximum of 0x{:X} bytes",
+                      input_size, MaxSize);
+        }
+        size = ctx.ReadBuffer(buffer.data(), std::min(input_size, MaxSize));
+    }
     virtual ~Parcel() = default;
 
     template <typename T>
     T Read() {
-        static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable.");
-        ASSERT(read_index + sizeof(T) <= buffer.size());
-
-        T val;
-        std::memcpy(&val, buffer.data() + read_index, sizeof(T));
-        read_index += sizeof(T);
+        T val = ReadUnaligned<T>();
         read_index = Common::AlignUp(read_index, 4);
         return val;
     }
@@ -82,7 +92,7 @@ public:
     template <typename T>
     T ReadUnaligned() {
         static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable.");
-        ASSERT(read_index + sizeof(T) <= buffer.size());
+        ASSERT(read_index + sizeof(T) <= size);
 
         T val;
         std::memcpy(&val, buffer.data() + read_index, sizeof(T));
@@ -90,42 +100,33 @@ public:
         return val;
     }
 
-    std::vector<u8> ReadBlock(std::size_t length) {
-        ASSERT(read_index + length <= buffer.size());
-        const u8* const begin = buffer.data() + read_index;
-        const u8* const end = begin + length;
-        std::vector<u8> data(begin, end);
+    /// Returns a pointer to the next block of the parcel. It is valid as long as the parcel is.
+    const u8* ReadBlock(std::size_t length) {
+        ASSERT(read_index + length <= size);
+        const u8* const data = buffer.data() + read_index;
         read_index += length;
         read_index = Common::AlignUp(read_index, 4);
         return data;
     }
 
-    std::u16string ReadInterfaceToken() {
-        u32 unknown = Read<u32_le>();
-        u32 length = Read<u32_le>();
-
-        std::u16string token{};
+    void SkipInterfaceToken() {
+        Read<u32_le>(); // Unknown
+        const u32 length = Read<u32_le>();
 
-        for (u32 ch = 0; ch < length + 1; ++ch) {
-            token.push_back(ReadUnaligned<u16_le>());
-        }
-
-        read_index = Common::AlignUp(read_index, 4);
-
-        return token;
+        // The token is a null terminated UTF-16 string, which is never used
+        ReadBlock((length + 1) * sizeof(u16_le));
     }
 
     template <typename T>
     void Write(const T& val) {
         static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable.");
 
-        if (buffer.size() < write_index + sizeof(T)) {
-            buffer.resize(buffer.size() + sizeof(T) + DefaultBufferSize);
-        }
+        const std::size_t aligned_size = Common::AlignUp(sizeof(T), 4);
+        ASSERT(write_index + aligned_size <= MaxSize);
 
         std::memcpy(buffer.data() + write_index, &val, sizeof(T));
-        write_index += sizeof(T);
-        write_index = Common::AlignUp(write_index, 4);
+        std::memset(buffer.data() + write_index + sizeof(T), 0, aligned_size - sizeof(T));
+        write_index += aligned_size;
     }
 
     template <typename T>
@@ -140,7 +141,7 @@ public:
     }
 
     void Deserialize() {
-        ASSERT(buffer.size() > sizeof(Header));
+        ASSERT(size > sizeof(Header));
 
         Header header{};
         std::memcpy(&header, buffer.data(), sizeof(Header));
@@ -149,7 +150,12 @@ public:
         DeserializeData();
     }
 
-    std::vector<u8> Serialize() {
+    /**
+     * Builds the parcel and writes it to the output buffer of a request.
+     * @param ctx Request to write the parcel to
+     * @returns the number of bytes written
+     */
+    std::size_t Serialize(const Kernel::HLERequestContext& ctx) {
         ASSERT(read_index == 0);
         write_index = sizeof(Header);
 
@@ -162,7 +168,13 @@ public:
         header.objects_offset = sizeof(Header) + header.data_size;
         std::memcpy(buffer.data(), &header, sizeof(Header));
 
-        return buffer;
+        // Zero the objects section and pad small parcels to the size they always had
+        const std::size_t total_size =
+            std::max<std::size_t>(write_index + header.objects_size, MinSerializedSize);
+        ASSERT(total_size <= MaxSize);
+        std::memset(buffer.data() + write_index, 0, total_size - write_index);
+
+        return ctx.WriteBuffer(buffer.data(), total_size);
     }
 
 protected:
@@ -179,7 +191,8 @@ private:
     };
     static_assert(sizeof(Header) == 16, "ParcelHeader has wrong size");
 
-    std::vector<u8> buffer;
+    std::array<u8, MaxSize> buffer;
+    std::size_t size = 0;
     std::size_t read_index = 0;
     std::size_t write_index = 0;
 };
@@ -212,13 +225,13 @@ private:
 
 class IGBPConnectRequestParcel : public Parcel {
 public:
-    explicit IGBPConnectRequestParcel(std::vector<u8> buffer) : Parcel(std::move(buffer)) {
+    explicit IGBPConnectRequestParcel(const Kernel::HLERequestContext& ctx) : Parcel(ctx) {
         Deserialize();
     }
     ~IGBPConnectRequestParcel() override = default;
 
     void DeserializeData() override {
-        std::u16string token = ReadInterfaceToken();
+        SkipInterfaceToken();
         data = Read<Data>();
     }
 
@@ -275,14 +288,14 @@ private:
 
 class IGBPSetPreallocatedBufferRequestParcel : public Parcel {
 public:
-    explicit IGBPSetPreallocatedBufferRequestParcel(std::vector<u8> buffer)
-        : Parcel(std::move(buffer)) {
+    explicit IGBPSetPreallocatedBufferRequestParcel(const Kernel::HLERequestContext& ctx)
+        : Parcel(ctx) {
         Deserialize();
     }
     ~IGBPSetPreallocatedBufferRequestParcel() override = default;
 
     void DeserializeData() override {
-        std::u16string token = ReadInterfaceToken();
+        SkipInterfaceToken();
         data = Read<Data>();
         buffer = Read<NVFlinger::IGBPBuffer>();
     }
@@ -308,13 +321,13 @@ protected:
 
 class IGBPDequeueBufferRequestParcel : public Parcel {
 public:
-    explicit IGBPDequeueBufferRequestParcel(std::vector<u8> buffer) : Parcel(std::move(buffer)) {
+    explicit IGBPDequeueBufferRequestParcel(const Kernel::HLERequestContext& ctx) : Parcel(ctx) {
         Deserialize();
     }
     ~IGBPDequeueBufferRequestParcel() override = default;
 
     void DeserializeData() override {
-        std::u16string token = ReadInterfaceToken();
+        SkipInterfaceToken();
         data = Read<Data>();
     }
 
@@ -349,13 +362,13 @@ protected:
 
 class IGBPRequestBufferRequestParcel : public Parcel {
 public:
-    explicit IGBPRequestBufferRequestParcel(std::vector<u8> buffer) : Parcel(std::move(buffer)) {
+    explicit IGBPRequestBufferRequestParcel(const Kernel::HLERequestContext& ctx) : Parcel(ctx) {
         Deserialize();
     }
     ~IGBPRequestBufferRequestParcel() override = default;
 
     void DeserializeData() override {
-        std::u16string token = ReadInterfaceToken();
+        SkipInterfaceToken();
         slot = Read<u32_le>();
     }
 
@@ -381,13 +394,13 @@ protected:
 
 class IGBPQueueBufferRequestParcel : public Parcel {
 public:
-    explicit IGBPQueueBufferRequestParcel(std::vector<u8> buffer) : Parcel(std::move(buffer)) {
+    explicit IGBPQueueBufferRequestParcel(const Kernel::HLERequestContext& ctx) : Parcel(ctx) {
         Deserialize();
     }
     ~IGBPQueueBufferRequestParcel() override = default;
 
     void DeserializeData() override {
-        std::u16string token = ReadInterfaceToken();
+        SkipInterfaceToken();
         data = Read<Data>();
     }
 
@@ -444,13 +457,13 @@ private:
 
 class IGBPQueryRequestParcel : public Parcel {
 public:
-    explicit IGBPQueryRequestParcel(std::vector<u8> buffer) : Parcel(std::move(buffer)) {
+    explicit IGBPQueryRequestParcel(const Kernel::HLERequestContext& ctx) : Parcel(ctx) {
         Deserialize();
     }
     ~IGBPQueryRequestParcel() override = default;
 
     void DeserializeData() override {
-        std::u16string token = ReadInterfaceToken();
+        SkipInterfaceToken();
         type = Read<u32_le>();
     }
 
@@ -514,22 +527,22 @@ private:
         auto& buffer_queue = nv_flinger->FindBufferQueue(id);
 
         if (transaction == TransactionId::Connect) {
-            IGBPConnectRequestParcel request{ctx.ReadBuffer()};
+            IGBPConnectRequestParcel request{ctx};
             IGBPConnectResponseParcel response{
                 static_cast<u32>(static_cast<u32>(DisplayResolution::UndockedWidth) *
                                  Settings::values.resolution_factor),
                 static_cast<u32>(static_cast<u32>(DisplayResolution::UndockedHeight) *
                                  Settings::values.resolution_factor)};
-            ctx.WriteBuffer(response.Serialize());
+            response.Serialize(ctx);
         } else if (transaction == TransactionId::SetPreallocatedBuffer) {
-            IGBPSetPreallocatedBufferRequestParcel request{ctx.ReadBuffer()};
+            IGBPSetPreallocatedBufferRequestParcel request{ctx};
 
             buffer_queue.SetPreallocatedBuffer(request.data.slot, request.buffer);
 
             IGBPSetPreallocatedBufferResponseParcel response{};
-            ctx.WriteBuffer(response.Serialize());
+            response.Serialize(ctx);
         } else if (transaction == TransactionId::DequeueBuffer) {
-            IGBPDequeueBufferRequestParcel request{ctx.ReadBuffer()};
+            IGBPDequeueBufferRequestParcel request{ctx};
             const u32 width{request.data.width};
             const u32 height{request.data.height};
             auto result = buffer_queue.DequeueBuffer(width, height);
@@ -537,7 +550,7 @@ private:
             if (result) {
                 // Buffer is available
                 IGBPDequeueBufferResponseParcel response{result->first, *result->second};
-                ctx.WriteBuffer(response.Serialize());
+                response.Serialize(ctx);
             } else {
                 // Wait the current thread until a buffer becomes available
                 ctx.SleepClientThread(
@@ -550,44 +563,42 @@ private:
                         ASSERT_MSG(result != std::nullopt, "Could not dequeue buffer.");
 
                         IGBPDequeueBufferResponseParcel response{result->first, *result->second};
-                        ctx.WriteBuffer(response.Serialize());
+                        response.Serialize(ctx);
                         IPC::ResponseBuilder rb{ctx, 2};
                         rb.Push(RESULT_SUCCESS);
                     },
                     buffer_queue.GetWritableBufferWaitEvent());
             }
         } else if (transaction == TransactionId::RequestBuffer) {
-            IGBPRequestBufferRequestParcel request{ctx.ReadBuffer()};
+            IGBPRequestBufferRequestParcel request{ctx};
 
             auto& buffer = buffer_queue.RequestBuffer(request.slot);
 
             IGBPRequestBufferResponseParcel response{buffer};
-            ctx.WriteBuffer(response.Serialize());
+            response.Serialize(ctx);
         } else if (transaction == TransactionId::QueueBuffer) {
-            IGBPQueueBufferRequestParcel request{ctx.ReadBuffer()};
+            IGBPQueueBufferRequestParcel request{ctx};
 
             buffer_queue.QueueBuffer(request.data.slot, request.data.transform,
                                      request.data.GetCropRect(), request.data.swap_interval,
                                      request.data.multi_fence);
 
             IGBPQueueBufferResponseParcel response{1280, 720};
-            ctx.WriteBuffer(response.Serialize());
+            response.Serialize(ctx);
         } else if (transaction == TransactionId::Query) {
-            IGBPQueryRequestParcel request{ctx.ReadBuffer()};
+            IGBPQueryRequestParcel request{ctx};
 
             const u32 value =
                 buffer_queue.Query(static_cast<NVFlinger::BufferQueue::QueryType>(request.type));
 
             IGBPQueryResponseParcel response{value};
-            ctx.WriteBuffer(response.Serialize());
+            response.Serialize(ctx);
         } else if (transaction == TransactionId::CancelBuffer) {
             LOG_CRITICAL(Service_VI, "(STUBBED) called, transaction=CancelBuffer");
         } else if (transaction == TransactionId::Disconnect ||
                    transaction == TransactionId::DetachBuffer) {
-            const auto buffer = ctx.ReadBuffer();
-
             IGBPEmptyResponseParcel response{};
-            ctx.WriteBuffer(response.Serialize());
+            response.Serialize(ctx);
         } else {
             ASSERT_MSG(false, "Unimplemented");
         }
@@ -1057,7 +1068,7 @@ private:
         NativeWindow native_window{*buffer_queue_id};
         IPC::ResponseBuilder rb{ctx, 4};
         rb.Push(RESULT_SUCCESS);
-        rb.Push<u64>(ctx.WriteBuffer(native_window.Serialize()));
+        rb.Push<u64>(native_window.Serialize(ctx));
     }
 
     void CreateStrayLayer(Kernel::HLERequestContext& ctx) {
@@ -1088,7 +1099,7 @@ private:
         IPC::ResponseBuilder rb{ctx, 6};
         rb.Push(RESULT_SUCCESS);
         rb.Push(*layer_id);
-        rb.Push<u64>(ctx.WriteBuffer(native_window.Serialize()));
+        rb.Push<u64>(native_window.Serialize(ctx));
     }
 
     void DestroyStrayLayer(Kernel::HLERequestContext& ctx) {
@@ -186,12 +186,14 @@ static bool LoadNroImpl(Kernel::Process& process, const std::vector<u8>& data,
     codeset.DataSegment().size += bss_size;
     program_image.resize(static_cast<u32>(program_image.size()) + bss_size);
 
+    const std::size_t image_size = program_image.size();
+
     // Load codeset for current process
     codeset.memory = std::move(program_image);
     process.LoadModule(std::move(codeset), load_base);
 
     // Register module with GDBStub
-    GDBStub::RegisterModule(name, load_base, load_base);
+    GDBStub::RegisterModule(name, load_base, load_base + image_size);
 
     return true;
 }
@@ -3,17 +3,26 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <utility>
+#include <vector>
 
 #include "common/assert.h"
+#include "common/atomic_ops.h"
 #include "common/common_types.h"
 #include "common/logging/log.h"
 #include "common/page_table.h"
 #include "common/swap.h"
 #include "core/arm/arm_interface.h"
 #include "core/core.h"
+#include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/process.h"
 #include "core/hle/kernel/vm_manager.h"
 #include "core/memory.h"
@@ -24,12 +33,51 @@ namespace Memory {
 
 static Common::PageTable* current_page_table = nullptr;
 
+/// Guards the special regions of all page tables, debug hooks are added while the guest runs
+static std::mutex special_regions_mutex;
+
+static u8* GetPointerFromVMA(const Kernel::Process& process, VAddr vaddr);
+
+/// Publishes the special regions of a page table to the accesses of its Special pages. Must be
+/// called with special_regions_mutex held.
+static void UpdateSpecialRegionCache(Common::PageTable& page_table) {
+    auto cache = std::make_shared<Common::SpecialRegionCache>();
+    cache->segments.reserve(page_table.special_regions.iterative_size());
+    for (const auto& [interval, regions] : page_table.special_regions) {
+        cache->segments.push_back(
+            {boost::icl::first(interval), boost::icl::last(interval) + 1,
+             std::vector<Common::SpecialRegion>(regions.begin(), regions.end())});
+    }
+    cache->hooked_pages = page_table.hooked_pages;
+
+    std::atomic_store(&page_table.special_region_cache,
+                      std::shared_ptr<const Common::SpecialRegionCache>{std::move(cache)});
+}
+
+/// Forgets the memory behind the hooked pages of a range. Must be called with
+/// special_regions_mutex held.
+static void ForgetHookedPages(Common::PageTable& page_table, VAddr base, u64 size) {
+    auto& hooked_pages = page_table.hooked_pages;
+    for (auto iter = hooked_pages.begin(); iter != hooked_pages.end();) {
+        const VAddr page_base = iter->first << PAGE_BITS;
+        if (page_base >= base && page_base < base + size) {
+            iter = hooked_pages.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
 void SetCurrentPageTable(Kernel::Process& process) {
     current_page_table = &process.VMManager().page_table;
 
-    const std::size_t address_space_width = process.VMManager().GetAddressSpaceWidth();
-
+    // The CPU cores only exist while the system is powered on, tests use page tables without them
     auto& system = Core::System::GetInstance();
+    if (!system.IsPoweredOn()) {
+        return;
+    }
+
+    const std::size_t address_space_width = process.VMManager().GetAddressSpaceWidth();
     system.ArmInterface(0).PageTableChanged(*current_page_table, address_space_width);
     system.ArmInterface(1).PageTableChanged(*current_page_table, address_space_width);
     system.ArmInterface(2).PageTableChanged(*current_page_table, address_space_width);
@@ -69,6 +117,23 @@ void MapMemoryRegion(Common::PageTable& page_table, VAddr base, u64 size, u8* ta
     ASSERT_MSG((size & PAGE_MASK) == 0, "non-page aligned size: {:016X}", size);
     ASSERT_MSG((base & PAGE_MASK) == 0, "non-page aligned base: {:016X}", base);
     MapPages(page_table, base / PAGE_SIZE, size / PAGE_SIZE, target, Common::PageType::Memory);
+
+    // Remapping memory must not silently drop the debug hooks placed on it
+    std::lock_guard lock{special_regions_mutex};
+    ForgetHookedPages(page_table, base, size);
+    const auto interval = boost::icl::discrete_interval<VAddr>::right_open(base, base + size);
+    const auto [begin, end] = page_table.special_regions.equal_range(interval);
+    for (auto iter = begin; iter != end; ++iter) {
+        const VAddr first_page = std::max(boost::icl::first(iter->first), base) >> PAGE_BITS;
+        const VAddr last_page =
+            std::min(boost::icl::last(iter->first), base + size - 1) >> PAGE_BITS;
+        for (VAddr page = first_page; page <= last_page; ++page) {
+            page_table.attributes[page] = Common::PageType::Special;
+            page_table.pointers[page] = nullptr;
+            page_table.hooked_pages[page] = target + ((page << PAGE_BITS) - base);
+        }
+    }
+    UpdateSpecialRegionCache(page_table);
 }
 
 void MapIoRegion(Common::PageTable& page_table, VAddr base, u64 size,
@@ -77,10 +142,13 @@ void MapIoRegion(Common::PageTable& page_table, VAddr base, u64 size,
     ASSERT_MSG((base & PAGE_MASK) == 0, "non-page aligned base: {:016X}", base);
     MapPages(page_table, base / PAGE_SIZE, size / PAGE_SIZE, nullptr, Common::PageType::Special);
 
+    std::lock_guard lock{special_regions_mutex};
     auto interval = boost::icl::discrete_interval<VAddr>::closed(base, base + size - 1);
     Common::SpecialRegion region{Common::SpecialRegion::Type::IODevice, std::move(mmio_handler)};
     page_table.special_regions.add(
         std::make_pair(interval, std::set<Common::SpecialRegion>{region}));
+    ForgetHookedPages(page_table, base, size);
+    UpdateSpecialRegionCache(page_table);
 }
 
 void UnmapRegion(Common::PageTable& page_table, VAddr base, u64 size) {
@@ -88,24 +156,104 @@ void UnmapRegion(Common::PageTable& page_table, VAddr base, u64 size) {
     ASSERT_MSG((base & PAGE_MASK) == 0, "non-page aligned base: {:016X}", base);
     MapPages(page_table, base / PAGE_SIZE, size / PAGE_SIZE, nullptr, Common::PageType::Unmapped);
 
+    std::lock_guard lock{special_regions_mutex};
     auto interval = boost::icl::discrete_interval<VAddr>::closed(base, base + size - 1);
     page_table.special_regions.erase(interval);
+    ForgetHookedPages(page_table, base, size);
+    UpdateSpecialRegionCache(page_table);
+}
+
+/// Returns the process that owns a page table, or nullptr if no process does
+static const Kernel::Process* GetPageTableOwner(const Common::PageTable& page_table) {
+    for (const auto& process : Core::System::GetInstance().Kernel().GetProcessList()) {
+        if (&process->VMManager().page_table == &page_table) {
+            return process.get();
+        }
+    }
+    return nullptr;
 }
 
 void AddDebugHook(Common::PageTable& page_table, VAddr base, u64 size,
                   Common::MemoryHookPointer hook) {
+    std::lock_guard lock{special_regions_mutex};
+
     auto interval = boost::icl::discrete_interval<VAddr>::closed(base, base + size - 1);
     Common::SpecialRegion region{Common::SpecialRegion::Type::DebugHook, std::move(hook)};
     page_table.special_regions.add(
         std::make_pair(interval, std::set<Common::SpecialRegion>{region}));
+
+    // Route every access to the hooked pages through the slow path, which falls back to the
+    // memory that was behind them
+    for (VAddr page = base >> PAGE_BITS; page <= (base + size - 1) >> PAGE_BITS; ++page) {
+        Common::PageType& page_type = page_table.attributes[page];
+        if (page_type == Common::PageType::Memory) {
+            page_table.hooked_pages[page] = page_table.pointers[page];
+        } else if (page_type == Common::PageType::RasterizerCachedMemory) {
+            // The rasterizer clears the pointers of the pages it caches
+            const Kernel::Process* const owner = GetPageTableOwner(page_table);
+            ASSERT(owner != nullptr);
+            page_table.hooked_pages[page] = GetPointerFromVMA(*owner, page << PAGE_BITS);
+        } else {
+            continue;
+        }
+        page_type = Common::PageType::Special;
+        page_table.pointers[page] = nullptr;
+    }
+    UpdateSpecialRegionCache(page_table);
+}
+
+/// Returns true if a page of type Special has no special region left on it
+static bool IsUnhookedPage(const Common::PageTable& page_table, VAddr page) {
+    const VAddr page_base = page << PAGE_BITS;
+    const auto interval =
+        boost::icl::discrete_interval<VAddr>::right_open(page_base, page_base + PAGE_SIZE);
+    return page_table.attributes[page] == Common::PageType::Special &&
+           !boost::icl::intersects(page_table.special_regions, interval);
 }
 
 void RemoveDebugHook(Common::PageTable& page_table, VAddr base, u64 size,
                      Common::MemoryHookPointer hook) {
-    auto interval = boost::icl::discrete_interval<VAddr>::closed(base, base + size - 1);
-    Common::SpecialRegion region{Common::SpecialRegion::Type::DebugHook, std::move(hook)};
-    page_table.special_regions.subtract(
-        std::make_pair(interval, std::set<Common::SpecialRegion>{region}));
+    std::vector<std::pair<VAddr, u8*>> unhooked_pages;
+    {
+        std::lock_guard lock{special_regions_mutex};
+
+        auto interval = boost::icl::discrete_interval<VAddr>::closed(base, base + size - 1);
+        Common::SpecialRegion region{Common::SpecialRegion::Type::DebugHook, std::move(hook)};
+        page_table.special_regions.subtract(
+            std::make_pair(interval, std::set<Common::SpecialRegion>{region}));
+        UpdateSpecialRegionCache(page_table);
+
+        for (VAddr page = base >> PAGE_BITS; page <= (base + size - 1) >> PAGE_BITS; ++page) {
+            if (IsUnhookedPage(page_table, page)) {
+                const auto iter = page_table.hooked_pages.find(page);
+                unhooked_pages.emplace_back(
+                    page, iter != page_table.hooked_pages.end() ? iter->second : nullptr);
+            }
+        }
+    }
+
+    // Give the fast path back to pages without any hook left
+    auto& system = Core::System::GetInstance();
+    for (const auto& [page, pointer] : unhooked_pages) {
+        // The rasterizer may have started caching the page while it was hooked. Drop what it
+        // cached, it marks the page as cached again when it uses it next.
+        if (pointer != nullptr && system.IsPoweredOn()) {
+            system.GPU().FlushAndInvalidateRegion(ToCacheAddr(pointer), PAGE_SIZE);
+        }
+
+        std::lock_guard lock{special_regions_mutex};
+        if (!IsUnhookedPage(page_table, page)) {
+            // Hooked again in the meantime
+            continue;
+        }
+        page_table.attributes[page] =
+            pointer != nullptr ? Common::PageType::Memory : Common::PageType::Unmapped;
+        page_table.pointers[page] = pointer;
+        page_table.hooked_pages.erase(page);
+    }
+
+    std::lock_guard lock{special_regions_mutex};
+    UpdateSpecialRegionCache(page_table);
 }
 
 /**
@@ -144,6 +292,220 @@ static u8* GetPointerFromVMA(VAddr vaddr) {
     return GetPointerFromVMA(*Core::CurrentProcess(), vaddr);
 }
 
+/// Returns the special regions of a page table as seen by accesses to its Special pages
+static std::shared_ptr<const Common::SpecialRegionCache> GetSpecialRegionCache(
+    const Common::PageTable& page_table) {
+    static const auto empty_cache = std::make_shared<const Common::SpecialRegionCache>();
+    auto cache = std::atomic_load(&page_table.special_region_cache);
+    return cache != nullptr ? cache : empty_cache;
+}
+
+/**
+ * Calls func on the special regions overlapping a range, debug hooks before I/O devices, until it
+ * returns true.
+ * @returns whether func returned true
+ */
+template <typename Func>
+bool VisitSpecialRegions(const Common::SpecialRegionCache& cache, VAddr vaddr, std::size_t size,
+                         Func func) {
+    const VAddr end = vaddr + size;
+    const auto& segments = cache.segments;
+    const auto first = std::partition_point(
+        segments.begin(), segments.end(),
+        [vaddr](const Common::SpecialRegionCache::Segment& segment) {
+            return segment.end <= vaddr;
+        });
+    if (first == segments.end() || first->begin >= end) {
+        return false;
+    }
+
+    const auto next = std::next(first);
+    if (next == segments.end() || next->begin >= end) {
+        return std::any_of(first->regions.begin(), first->regions.end(), func);
+    }
+
+    // Only accesses straddling the edge of a region overlap several segments
+    std::set<Common::SpecialRegion> regions;
+    for (auto iter = first; iter != segments.end() && iter->begin < end; ++iter) {
+        regions.insert(iter->regions.begin(), iter->regions.end());
+    }
+    return std::any_of(regions.begin(), regions.end(), func);
+}
+
+/// Returns the memory behind a page that is Special because of debug hooks, nullptr otherwise
+static u8* GetHookedPointer(const Common::SpecialRegionCache& cache, VAddr vaddr) {
+    const auto iter = cache.hooked_pages.find(vaddr >> PAGE_BITS);
+    if (iter == cache.hooked_pages.end()) {
+        return nullptr;
+    }
+    return iter->second + (vaddr & PAGE_MASK);
+}
+
+// The rasterizer may cache the memory behind hooked pages, but unlike for RasterizerCachedMemory
+// pages there may be no GPU at all, as tools hook pages outside of emulation sessions too.
+
+static void FlushHookedRegion(const u8* pointer, std::size_t size) {
+    auto& system = Core::System::GetInstance();
+    if (system.IsPoweredOn()) {
+        system.GPU().FlushRegion(ToCacheAddr(pointer), size);
+    }
+}
+
+static void InvalidateHookedRegion(const u8* pointer, std::size_t size) {
+    auto& system = Core::System::GetInstance();
+    if (system.IsPoweredOn()) {
+        system.GPU().InvalidateRegion(ToCacheAddr(pointer), size);
+    }
+}
+
+template <typename T>
+std::optional<T> ReadHook(Common::MemoryHook& hook, VAddr vaddr) {
+    if constexpr (sizeof(T) == 1) {
+        return hook.Read8(vaddr);
+    } else if constexpr (sizeof(T) == 2) {
+        return hook.Read16(vaddr);
+    } else if constexpr (sizeof(T) == 4) {
+        return hook.Read32(vaddr);
+    } else {
+        return hook.Read64(vaddr);
+    }
+}
+
+template <typename T>
+bool WriteHook(Common::MemoryHook& hook, VAddr vaddr, T data) {
+    if constexpr (sizeof(T) == 1) {
+        return hook.Write8(vaddr, data);
+    } else if constexpr (sizeof(T) == 2) {
+        return hook.Write16(vaddr, data);
+    } else if constexpr (sizeof(T) == 4) {
+        return hook.Write32(vaddr, data);
+    } else {
+        return hook.Write64(vaddr, data);
+    }
+}
+
+/// Reads from a page of type Special, through the hooks registered over it or from the memory
+/// they let the read through to
+template <typename T>
+T ReadSpecial(const Common::PageTable& page_table, VAddr vaddr) {
+    const auto cache = GetSpecialRegionCache(page_table);
+
+    std::optional<T> value;
+    VisitSpecialRegions(*cache, vaddr, sizeof(T), [&](const Common::SpecialRegion& region) {
+        value = ReadHook<T>(*region.handler, vaddr);
+        if (!value && region.type == Common::SpecialRegion::Type::IODevice) {
+            LOG_ERROR(HW_Memory, "Unhandled I/O Read{} @ 0x{:016X}", sizeof(T) * 8, vaddr);
+            value = T{};
+        }
+        return value.has_value();
+    });
+    if (value) {
+        return *value;
+    }
+
+    const u8* const host_ptr = GetHookedPointer(*cache, vaddr);
+    if (host_ptr == nullptr) {
+        LOG_ERROR(HW_Memory, "Unmapped Read{} @ 0x{:016X}", sizeof(T) * 8, vaddr);
+        return T{};
+    }
+    FlushHookedRegion(host_ptr, sizeof(T));
+    T result;
+    std::memcpy(&result, host_ptr, sizeof(T));
+    return result;
+}
+
+/// Writes to a page of type Special, through the hooks registered over it or to the memory they
+/// let the write through to
+template <typename T>
+void WriteSpecial(const Common::PageTable& page_table, VAddr vaddr, T data) {
+    const auto cache = GetSpecialRegionCache(page_table);
+
+    const bool handled =
+        VisitSpecialRegions(*cache, vaddr, sizeof(T), [&](const Common::SpecialRegion& region) {
+            if (WriteHook<T>(*region.handler, vaddr, data)) {
+                return true;
+            }
+            if (region.type == Common::SpecialRegion::Type::IODevice) {
+                LOG_ERROR(HW_Memory, "Unhandled I/O Write{} @ 0x{:016X}", sizeof(T) * 8, vaddr);
+                return true;
+            }
+            return false;
+        });
+    if (handled) {
+        return;
+    }
+
+    u8* const host_ptr = GetHookedPointer(*cache, vaddr);
+    if (host_ptr == nullptr) {
+        LOG_ERROR(HW_Memory, "Unmapped Write{} @ 0x{:016X}", sizeof(T) * 8, vaddr);
+        return;
+    }
+    InvalidateHookedRegion(host_ptr, sizeof(T));
+    std::memcpy(host_ptr, &data, sizeof(T));
+}
+
+/// Block version of ReadSpecial
+static void ReadBlockSpecial(const Common::PageTable& page_table, VAddr vaddr, void* dest_buffer,
+                             std::size_t size) {
+    const auto cache = GetSpecialRegionCache(page_table);
+
+    const bool handled =
+        VisitSpecialRegions(*cache, vaddr, size, [&](const Common::SpecialRegion& region) {
+            if (region.handler->ReadBlock(vaddr, dest_buffer, size)) {
+                return true;
+            }
+            if (region.type == Common::SpecialRegion::Type::IODevice) {
+                LOG_ERROR(HW_Memory, "Unhandled I/O ReadBlock @ 0x{:016X} (size = {})", vaddr,
+                          size);
+                std::memset(dest_buffer, 0, size);
+                return true;
+            }
+            return false;
+        });
+    if (handled) {
+        return;
+    }
+
+    const u8* const host_ptr = GetHookedPointer(*cache, vaddr);
+    if (host_ptr == nullptr) {
+        LOG_ERROR(HW_Memory, "Unmapped ReadBlock @ 0x{:016X} (size = {})", vaddr, size);
+        std::memset(dest_buffer, 0, size);
+        return;
+    }
+    FlushHookedRegion(host_ptr, size);
+    std::memcpy(dest_buffer, host_ptr, size);
+}
+
+/// Block version of WriteSpecial
+static void WriteBlockSpecial(const Common::PageTable& page_table, VAddr vaddr,
+                              const void* src_buffer, std::size_t size) {
+    const auto cache = GetSpecialRegionCache(page_table);
+
+    const bool handled =
+        VisitSpecialRegions(*cache, vaddr, size, [&](const Common::SpecialRegion& region) {
+            if (region.handler->WriteBlock(vaddr, src_buffer, size)) {
+                return true;
+            }
+            if (region.type == Common::SpecialRegion::Type::IODevice) {
+                LOG_ERROR(HW_Memory, "Unhandled I/O WriteBlock @ 0x{:016X} (size = {})", vaddr,
+                          size);
+                return true;
+            }
+            return false;
+        });
+    if (handled) {
+        return;
+    }
+
+    u8* const host_ptr = GetHookedPointer(*cache, vaddr);
+    if (host_ptr == nullptr) {
+        LOG_ERROR(HW_Memory, "Unmapped WriteBlock @ 0x{:016X} (size = {})", vaddr, size);
+        return;
+    }
+    InvalidateHookedRegion(host_ptr, size);
+    std::memcpy(host_ptr, src_buffer, size);
+}
+
 template <typename T>
 T Read(const VAddr vaddr) {
     const u8* page_pointer = current_page_table->pointers[vaddr >> PAGE_BITS];
@@ -162,6 +524,8 @@ T Read(const VAddr vaddr) {
     case Common::PageType::Memory:
         ASSERT_MSG(false, "Mapped memory page without a pointer @ {:016X}", vaddr);
         break;
+    case Common::PageType::Special:
+        return ReadSpecial<T>(*current_page_table, vaddr);
     case Common::PageType::RasterizerCachedMemory: {
         auto host_ptr{GetPointerFromVMA(vaddr)};
         Core::System::GetInstance().GPU().FlushRegion(ToCacheAddr(host_ptr), sizeof(T));
@@ -193,6 +557,9 @@ void Write(const VAddr vaddr, const T data) {
     case Common::PageType::Memory:
         ASSERT_MSG(false, "Mapped memory page without a pointer @ {:016X}", vaddr);
         break;
+    case Common::PageType::Special:
+        WriteSpecial<T>(*current_page_table, vaddr, data);
+        break;
     case Common::PageType::RasterizerCachedMemory: {
         auto host_ptr{GetPointerFromVMA(vaddr)};
         Core::System::GetInstance().GPU().InvalidateRegion(ToCacheAddr(host_ptr), sizeof(T));
@@ -217,7 +584,8 @@ bool IsValidVirtualAddress(const Kernel::Process& process, const VAddr vaddr) {
     if (page_table.attributes[vaddr >> PAGE_BITS] != Common::PageType::Special)
         return false;
 
-    return false;
+    // Pages with debug hooks are still backed by memory, unlike I/O regions
+    return GetHookedPointer(*GetSpecialRegionCache(page_table), vaddr) != nullptr;
 }
 
 bool IsValidVirtualAddress(const VAddr vaddr) {
@@ -239,10 +607,25 @@ u8* GetPointer(const VAddr vaddr) {
         return GetPointerFromVMA(vaddr);
     }
 
+    if (current_page_table->attributes[vaddr >> PAGE_BITS] == Common::PageType::Special) {
+        const auto cache = GetSpecialRegionCache(*current_page_table);
+        if (u8* const pointer = GetHookedPointer(*cache, vaddr)) {
+            return pointer;
+        }
+    }
+
     LOG_ERROR(HW_Memory, "Unknown GetPointer @ 0x{:016X}", vaddr);
     return nullptr;
 }
 
+u8* GetPlainMemoryPointer(const VAddr vaddr) {
+    u8* const page_pointer = current_page_table->pointers[vaddr >> PAGE_BITS];
+    if (page_pointer == nullptr) {
+        return nullptr;
+    }
+    return page_pointer + (vaddr & PAGE_MASK);
+}
+
 std::string ReadCString(VAddr vaddr, std::size_t max_length) {
     std::string string;
     string.reserve(max_length);
@@ -286,6 +669,9 @@ void RasterizerMarkRegionCached(VAddr vaddr, u64 size, bool cached) {
                 // There can be more than one GPU region mapped per CPU region, so it's common that
                 // this area is already marked as cached.
                 break;
+            case Common::PageType::Special:
+                // Accesses to hooked pages always flush and invalidate the rasterizer cache
+                break;
             default:
                 UNREACHABLE();
             }
@@ -300,6 +686,8 @@ void RasterizerMarkRegionCached(VAddr vaddr, u64 size, bool cached) {
                 // There can be more than one GPU region mapped per CPU region, so it's common that
                 // this area is already unmarked as cached.
                 break;
+            case Common::PageType::Special:
+                break;
             case Common::PageType::RasterizerCachedMemory: {
                 u8* pointer = GetPointerFromVMA(vaddr & ~PAGE_MASK);
                 if (pointer == nullptr) {
@@ -364,6 +752,9 @@ void ReadBlock(const Kernel::Process& process, const VAddr src_addr, void* dest_
             std::memcpy(dest_buffer, src_ptr, copy_amount);
             break;
         }
+        case Common::PageType::Special:
+            ReadBlockSpecial(page_table, current_vaddr, dest_buffer, copy_amount);
+            break;
         case Common::PageType::RasterizerCachedMemory: {
             const auto& host_ptr{GetPointerFromVMA(process, current_vaddr)};
             Core::System::GetInstance().GPU().FlushRegion(ToCacheAddr(host_ptr), copy_amount);
@@ -401,6 +792,65 @@ void Write64(const VAddr addr, const u64 data) {
     Write<u64_le>(addr, data);
 }
 
+/// Returns the host pointer of a guest address if it can be accessed with a host atomic of the
+/// given size, which requires plain memory and a host pointer aligned to the size
+static u8* GetAtomicPointer(const VAddr vaddr, std::size_t size) {
+    u8* const page_pointer = current_page_table->pointers[vaddr >> PAGE_BITS];
+    if (page_pointer == nullptr) {
+        return nullptr;
+    }
+    u8* const pointer = &page_pointer[vaddr & PAGE_MASK];
+    if ((reinterpret_cast<std::uintptr_t>(pointer) & (size - 1)) != 0) {
+        return nullptr;
+    }
+    return pointer;
+}
+
+template <typename T>
+bool WriteExclusive(const VAddr vaddr, const T data, const T expected) {
+    if (u8* const pointer = GetAtomicPointer(vaddr, sizeof(T))) {
+        return Common::AtomicCompareAndSwap(reinterpret_cast<volatile T*>(pointer), data,
+                                            expected);
+    }
+
+    if (Read<T>(vaddr) != expected) {
+        return false;
+    }
+    Write<T>(vaddr, data);
+    return true;
+}
+
+bool WriteExclusive8(const VAddr addr, const u8 data, const u8 expected) {
+    return WriteExclusive<u8>(addr, data, expected);
+}
+
+bool WriteExclusive16(const VAddr addr, const u16 data, const u16 expected) {
+    return WriteExclusive<u16>(addr, data, expected);
+}
+
+bool WriteExclusive32(const VAddr addr, const u32 data, const u32 expected) {
+    return WriteExclusive<u32>(addr, data, expected);
+}
+
+bool WriteExclusive64(const VAddr addr, const u64 data, const u64 expected) {
+    return WriteExclusive<u64>(addr, data, expected);
+}
+
+bool WriteExclusive128(const VAddr addr, const u128 data, const u128 expected) {
+    // cmpxchg16b faults on pointers that are not aligned to 16 bytes
+    if (u8* const pointer = GetAtomicPointer(addr, sizeof(u128))) {
+        return Common::AtomicCompareAndSwap(reinterpret_cast<volatile u64*>(pointer), data,
+                                            expected);
+    }
+
+    if (Read<u64_le>(addr) != expected[0] || Read<u64_le>(addr + 8) != expected[1]) {
+        return false;
+    }
+    Write<u64_le>(addr, data[0]);
+    Write<u64_le>(addr + 8, data[1]);
+    return true;
+}
+
 void WriteBlock(const Kernel::Process& process, const VAddr dest_addr, const void* src_buffer,
                 const std::size_t size) {
     const auto& page_table = process.VMManager().page_table;
@@ -427,6 +877,9 @@ void WriteBlock(const Kernel::Process& process, const VAddr dest_addr, const voi
             std::memcpy(dest_ptr, src_buffer, copy_amount);
             break;
         }
+        case Common::PageType::Special:
+            WriteBlockSpecial(page_table, current_vaddr, src_buffer, copy_amount);
+            break;
         case Common::PageType::RasterizerCachedMemory: {
             const auto& host_ptr{GetPointerFromVMA(process, current_vaddr)};
             Core::System::GetInstance().GPU().InvalidateRegion(ToCacheAddr(host_ptr), copy_amount);
@@ -473,6 +926,11 @@ void ZeroBlock(const Kernel::Process& process, const VAddr dest_addr, const std:
             std::memset(dest_ptr, 0, copy_amount);
             break;
         }
+        case Common::PageType::Special: {
+            static constexpr std::array<u8, PAGE_SIZE> zeros{};
+            WriteBlock(process, current_vaddr, zeros.data(), copy_amount);
+            break;
+        }
         case Common::PageType::RasterizerCachedMemory: {
             const auto& host_ptr{GetPointerFromVMA(process, current_vaddr)};
             Core::System::GetInstance().GPU().InvalidateRegion(ToCacheAddr(host_ptr), copy_amount);
@@ -521,6 +979,12 @@ void CopyBlock(const Kernel::Process& process, VAddr dest_addr, VAddr src_addr,
             WriteBlock(process, dest_addr, host_ptr, copy_amount);
             break;
         }
+        case Common::PageType::Special: {
+            std::array<u8, PAGE_SIZE> buffer;
+            ReadBlock(process, current_vaddr, buffer.data(), copy_amount);
+            WriteBlock(process, dest_addr, buffer.data(), copy_amount);
+            break;
+        }
         default:
             UNREACHABLE();
         }
@@ -56,6 +56,18 @@ void Write16(VAddr addr, u16 data);
 void Write32(VAddr addr, u32 data);
 void Write64(VAddr addr, u64 data);
 
+/**
+ * Writes a value only if the memory still holds the expected value. Accesses to plain memory whose
+ * host address is naturally aligned use a host compare-and-swap, any other access is only atomic
+ * if the callers serialize it among themselves.
+ * @returns true if the value was written
+ */
+bool WriteExclusive8(VAddr addr, u8 data, u8 expected);
+bool WriteExclusive16(VAddr addr, u16 data, u16 expected);
+bool WriteExclusive32(VAddr addr, u32 data, u32 expected);
+bool WriteExclusive64(VAddr addr, u64 data, u64 expected);
+bool WriteExclusive128(VAddr addr, u128 data, u128 expected);
+
 void ReadBlock(const Kernel::Process& process, VAddr src_addr, void* dest_buffer, std::size_t size);
 void ReadBlock(VAddr src_addr, void* dest_buffer, std::size_t size);
 void WriteBlock(const Kernel::Process& process, VAddr dest_addr, const void* src_buffer,
@@ -66,6 +78,13 @@ void CopyBlock(VAddr dest_addr, VAddr src_addr, std::size_t size);
 
 u8* GetPointer(VAddr vaddr);
 
+/**
+ * Gets the host memory backing a guest address without going through the slow path of GetPointer.
+ * @returns the host pointer, or nullptr if the page is not plain memory, such as unmapped pages or
+ *          pages cached by the rasterizer, which must be accessed through Read and Write.
+ */
+u8* GetPlainMemoryPointer(VAddr vaddr);
+
 std::string ReadCString(VAddr vaddr, std::size_t max_length);
 
 /**
@@ -35,8 +35,18 @@ void MapIoRegion(Common::PageTable& page_table, VAddr base, u64 size,
 
 void UnmapRegion(Common::PageTable& page_table, VAddr base, u64 size);
 
+/**
+ * Registers a hook that sees every access to a region before it reaches memory. The pages
+ * containing the region are switched to the slow path until their last hook is removed.
+ * @param page_table The page table of the emulated process.
+ * @param base The first address of the region, need not be page-aligned.
+ * @param size The size of the region in bytes.
+ * @param hook The hook to call on accesses to the region.
+ */
 void AddDebugHook(Common::PageTable& page_table, VAddr base, u64 size,
                   Common::MemoryHookPointer hook);
+
+/// Unregisters a hook previously registered with AddDebugHook for the same region.
 void RemoveDebugHook(Common::PageTable& page_table, VAddr base, u64 size,
                      Common::MemoryHookPointer hook);
 
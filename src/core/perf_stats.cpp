@@ -3,9 +3,14 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <mutex>
 #include <thread>
+#include <vector>
+#include <fmt/format.h>
+#include "common/file_util.h"
+#include "common/logging/log.h"
 #include "common/math_util.h"
 #include "core/perf_stats.h"
 #include "core/settings.h"
@@ -32,6 +37,33 @@ void PerfStats::EndSystemFrame() {
 
     previous_frame_length = frame_end - previous_frame_end;
     previous_frame_end = frame_end;
+
+    PerfFrameRecord& record = frame_history[total_frames % HistorySize];
+    if (total_frames >= HistorySize) {
+        // The oldest record is about to be overwritten, remove it from the histogram
+        histogram[GetHistogramBucket(record.frame_length_us)] -= 1;
+    }
+
+    record.index = total_frames;
+    record.frame_length_us = duration_cast<microseconds>(previous_frame_length).count();
+    record.frametime_us = duration_cast<microseconds>(frame_end - frame_begin).count();
+    std::array<u64, NumPerfSubsystems> subsystem_time_ns{};
+    {
+        std::lock_guard thread_times_lock{thread_times_mutex};
+        for (const auto& [thread_id, thread_time] : thread_times) {
+            for (std::size_t i = 0; i < NumPerfSubsystems; ++i) {
+                subsystem_time_ns[i] += thread_time->time_ns[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+    for (std::size_t i = 0; i < NumPerfSubsystems; ++i) {
+        // The thread counters are never reset, only the growth since the previous frame counts
+        record.subsystem_us[i] = (subsystem_time_ns[i] - merged_subsystem_time_ns[i]) / 1000;
+        merged_subsystem_time_ns[i] = subsystem_time_ns[i];
+    }
+
+    histogram[GetHistogramBucket(record.frame_length_us)] += 1;
+    total_frames += 1;
 }
 
 void PerfStats::EndGameFrame() {
@@ -40,6 +72,37 @@ void PerfStats::EndGameFrame() {
     game_frames += 1;
 }
 
+void PerfStats::AddSubsystemTime(PerfSubsystem subsystem, Clock::duration duration) {
+    const auto duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration);
+    auto& time_ns = GetThreadSubsystemTime().time_ns[static_cast<std::size_t>(subsystem)];
+    // Only this thread writes its counters, a plain store avoids a locked read-modify-write
+    time_ns.store(time_ns.load(std::memory_order_relaxed) + static_cast<u64>(duration_ns.count()),
+                  std::memory_order_relaxed);
+}
+
+u64 PerfStats::GenerateInstanceId() {
+    static std::atomic<u64> next_instance_id{1};
+    return next_instance_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+PerfStats::ThreadSubsystemTime& PerfStats::GetThreadSubsystemTime() {
+    // Threads rarely report to more than one instance, cache the counters of the last one
+    thread_local u64 cached_instance_id = 0;
+    thread_local ThreadSubsystemTime* cached_thread_time = nullptr;
+    if (cached_instance_id == instance_id) {
+        return *cached_thread_time;
+    }
+
+    std::lock_guard lock{thread_times_mutex};
+    auto& thread_time = thread_times[std::this_thread::get_id()];
+    if (!thread_time) {
+        thread_time = std::make_unique<ThreadSubsystemTime>();
+    }
+    cached_instance_id = instance_id;
+    cached_thread_time = thread_time.get();
+    return *thread_time;
+}
+
 PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us) {
     std::lock_guard lock{object_mutex};
 
@@ -56,12 +119,32 @@ PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us
                         static_cast<double>(system_frames);
     results.emulation_speed = system_us_per_second.count() / 1'000'000.0;
 
+    const std::size_t num_samples =
+        static_cast<std::size_t>(std::min<u64>(total_frames - reset_point_frames, HistorySize));
+    if (num_samples > 0) {
+        std::vector<u64> frame_lengths(num_samples);
+        for (std::size_t i = 0; i < num_samples; ++i) {
+            frame_lengths[i] = frame_history[(total_frames - 1 - i) % HistorySize].frame_length_us;
+        }
+
+        const auto percentile = [&frame_lengths](std::size_t percent) {
+            const auto nth = frame_lengths.begin() + (frame_lengths.size() - 1) * percent / 100;
+            std::nth_element(frame_lengths.begin(), nth, frame_lengths.end());
+            return static_cast<double>(*nth) / 1'000'000.0;
+        };
+        results.frametime_p50 = percentile(50);
+        results.frametime_p95 = percentile(95);
+        results.frametime_p99 = percentile(99);
+        results.frametime_max = percentile(100);
+    }
+
     // Reset counters
     reset_point = now;
     reset_point_system_us = current_system_time_us;
     accumulated_frametime = Clock::duration::zero();
     system_frames = 0;
     game_frames = 0;
+    reset_point_frames = total_frames;
 
     return results;
 }
@@ -73,6 +156,83 @@ double PerfStats::GetLastFrameTimeScale() {
     return duration_cast<DoubleSecs>(previous_frame_length).count() / FRAME_LENGTH;
 }
 
+PerfStats::Histogram PerfStats::GetFrameLengthHistogram() {
+    std::lock_guard lock{object_mutex};
+
+    return histogram;
+}
+
+u64 PerfStats::GetTotalSystemFrames() {
+    std::lock_guard lock{object_mutex};
+    return total_frames;
+}
+
+bool PerfStats::DumpFrameRecords(const std::string& path, DumpFormat format) {
+    std::lock_guard lock{object_mutex};
+
+    FileUtil::IOFile file(path, "w");
+    if (!file.IsOpen()) {
+        LOG_ERROR(Core, "Failed to open {} for writing frame records", path);
+        return false;
+    }
+
+    static constexpr std::array<const char*, NumPerfSubsystems> subsystem_names{
+        "cpu_emulation_us", "gpu_thread_us", "svc_us", "audio_us", "wait_us",
+    };
+
+    std::string out;
+    if (format == DumpFormat::CSV) {
+        out += "frame,frame_length_us,frametime_us";
+        for (const char* name : subsystem_names) {
+            out += fmt::format(",{}", name);
+        }
+        out += '\n';
+    } else {
+        out += "{\n  \"frames\": [";
+    }
+
+    const u64 first_frame = total_frames - std::min<u64>(total_frames, HistorySize);
+    for (u64 frame = first_frame; frame < total_frames; ++frame) {
+        const PerfFrameRecord& record = frame_history[frame % HistorySize];
+        if (format == DumpFormat::CSV) {
+            out += fmt::format("{},{},{}", record.index, record.frame_length_us,
+                               record.frametime_us);
+            for (const u64 subsystem_us : record.subsystem_us) {
+                out += fmt::format(",{}", subsystem_us);
+            }
+            out += '\n';
+        } else {
+            out += fmt::format("{}\n    {{\"frame\": {}, \"frame_length_us\": {}, "
+                               "\"frametime_us\": {}",
+                               frame == first_frame ? "" : ",", record.index,
+                               record.frame_length_us, record.frametime_us);
+            for (std::size_t i = 0; i < NumPerfSubsystems; ++i) {
+                out += fmt::format(", \"{}\": {}", subsystem_names[i], record.subsystem_us[i]);
+            }
+            out += '}';
+        }
+    }
+
+    if (format == DumpFormat::JSON) {
+        out += "\n  ],\n  \"histogram\": {\n";
+        out += fmt::format("    \"bucket_width_us\": {},\n",
+                           duration_cast<microseconds>(HistogramBucketWidth).count());
+        out += "    \"counts\": [";
+        for (std::size_t i = 0; i < histogram.size(); ++i) {
+            out += fmt::format("{}{}", i == 0 ? "" : ", ", histogram[i]);
+        }
+        out += "]\n  }\n}\n";
+    }
+
+    return file.WriteString(out) == out.size();
+}
+
+std::size_t PerfStats::GetHistogramBucket(u64 frame_length_us) {
+    const u64 bucket_width_us = duration_cast<microseconds>(HistogramBucketWidth).count();
+    return static_cast<std::size_t>(
+        std::min<u64>(frame_length_us / bucket_width_us, NumHistogramBuckets - 1));
+}
+
 void FrameLimiter::DoFrameLimiting(microseconds current_system_time_us) {
     if (!Settings::values.use_frame_limit) {
         return;
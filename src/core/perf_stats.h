@@ -4,12 +4,43 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
 #include "common/common_types.h"
 
 namespace Core {
 
+/// Subsystems whose walltime is attributed to the system frame during which it was spent
+enum class PerfSubsystem : std::size_t {
+    CpuEmulation, ///< Guest code execution, including any SVCs it performs
+    GpuThread,    ///< Processing of GPU command lists and presentation
+    Svc,          ///< Kernel SVC handling
+    Audio,        ///< Audio renderer mixing
+    Wait,         ///< Frame limiting and waits on the GPU
+
+    Count,
+};
+
+constexpr std::size_t NumPerfSubsystems = static_cast<std::size_t>(PerfSubsystem::Count);
+
+/// Timing breakdown of a single system frame
+struct PerfFrameRecord {
+    /// Index of the frame since the start of the emulation session
+    u64 index;
+    /// Walltime between this and the previous presented system frame, in microseconds
+    u64 frame_length_us;
+    /// Walltime spent on this frame excluding frame-limiting, in microseconds
+    u64 frametime_us;
+    /// Walltime spent in each subsystem during this frame, in microseconds
+    std::array<u64, NumPerfSubsystems> subsystem_us;
+};
+
 struct PerfStatsResults {
     /// System FPS (LCD VBlanks) in Hz
     double system_fps;
@@ -19,6 +50,14 @@ struct PerfStatsResults {
     double frametime;
     /// Ratio of walltime / emulated time elapsed
     double emulation_speed;
+    /// Median walltime between presented system frames, in seconds
+    double frametime_p50;
+    /// 95th percentile walltime between presented system frames, in seconds
+    double frametime_p95;
+    /// 99th percentile walltime between presented system frames, in seconds
+    double frametime_p99;
+    /// Longest walltime between presented system frames, in seconds
+    double frametime_max;
 };
 
 /**
@@ -29,10 +68,49 @@ class PerfStats {
 public:
     using Clock = std::chrono::high_resolution_clock;
 
+    /// Number of frames kept in the rolling frame history
+    static constexpr std::size_t HistorySize = 4096;
+    /// Width of each frame length histogram bucket
+    static constexpr std::chrono::milliseconds HistogramBucketWidth{1};
+    /// Number of frame length histogram buckets, the last one also holds any longer frames
+    static constexpr std::size_t NumHistogramBuckets = 64;
+
+    using Histogram = std::array<u32, NumHistogramBuckets>;
+
+    enum class DumpFormat {
+        CSV,
+        JSON,
+    };
+
+    /// Measures the walltime of a scope and attributes it to a subsystem
+    class ScopedTimer {
+    public:
+        ScopedTimer(PerfStats& perf_stats, PerfSubsystem subsystem)
+            : perf_stats{perf_stats}, subsystem{subsystem}, begin{Clock::now()} {}
+
+        ~ScopedTimer() {
+            perf_stats.AddSubsystemTime(subsystem, Clock::now() - begin);
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        PerfStats& perf_stats;
+        PerfSubsystem subsystem;
+        Clock::time_point begin;
+    };
+
     void BeginSystemFrame();
     void EndSystemFrame();
     void EndGameFrame();
 
+    /**
+     * Attributes walltime to a subsystem for the current system frame. This may be called from any
+     * thread, each thread accumulates into its own counters which are merged when a frame ends.
+     */
+    void AddSubsystemTime(PerfSubsystem subsystem, Clock::duration duration);
+
     PerfStatsResults GetAndResetStats(std::chrono::microseconds current_system_time_us);
 
     /**
@@ -41,7 +119,44 @@ public:
      */
     double GetLastFrameTimeScale();
 
+    /// Gets the frame length histogram of the frames in the rolling history
+    Histogram GetFrameLengthHistogram();
+
+    /// Gets the number of system frames presented since the start of the emulation session
+    u64 GetTotalSystemFrames();
+
+    /**
+     * Writes the frames in the rolling history to a file.
+     * @param path Path of the file to write
+     * @param format Format in which the records are written
+     * @returns true if the file was written successfully
+     */
+    bool DumpFrameRecords(const std::string& path, DumpFormat format);
+
 private:
+    /// Walltime a thread has attributed to each subsystem, in nanoseconds. Only written by the
+    /// thread that owns it, aligned so that threads don't share cache lines.
+    struct alignas(64) ThreadSubsystemTime {
+        std::array<std::atomic<u64>, NumPerfSubsystems> time_ns{};
+    };
+
+    /// Returns the histogram bucket of a frame with the given length
+    static std::size_t GetHistogramBucket(u64 frame_length_us);
+
+    /// Returns a new ID for each instance, used to tell instances apart in per-thread caches
+    static u64 GenerateInstanceId();
+
+    /// Returns the subsystem time counters of the calling thread, creating them on first use
+    ThreadSubsystemTime& GetThreadSubsystemTime();
+
+    const u64 instance_id = GenerateInstanceId();
+
+    std::mutex thread_times_mutex;
+    /// Counters of every thread that attributed time to a subsystem, they outlive their threads
+    std::unordered_map<std::thread::id, std::unique_ptr<ThreadSubsystemTime>> thread_times;
+    /// Sum of all the thread counters when the previous system frame ended, in nanoseconds
+    std::array<u64, NumPerfSubsystems> merged_subsystem_time_ns{};
+
     std::mutex object_mutex;
 
     /// Point when the cumulative counters were reset
@@ -62,6 +177,15 @@ private:
     Clock::time_point frame_begin = reset_point;
     /// Total visible duration (including frame-limiting, etc.) of the previous system frame
     Clock::duration previous_frame_length = Clock::duration::zero();
+
+    /// Records of the most recent system frames, indexed by frame index modulo HistorySize
+    std::array<PerfFrameRecord, HistorySize> frame_history{};
+    /// Total number of system frames recorded in this session
+    u64 total_frames = 0;
+    /// Value of total_frames when the cumulative counters were reset
+    u64 reset_point_frames = 0;
+    /// Frame length histogram of the records in frame_history
+    Histogram histogram{};
 };
 
 class FrameLimiter {
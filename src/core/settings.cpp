@@ -86,6 +86,7 @@ void LogSettings() {
     LogSetting("System_CurrentUser", Settings::values.current_user);
     LogSetting("System_LanguageIndex", Settings::values.language_index);
     LogSetting("Core_UseMultiCore", Settings::values.use_multi_core);
+    LogSetting("Core_UseHostTiming", Settings::values.use_host_timing);
     LogSetting("Renderer_UseResolutionFactor", Settings::values.resolution_factor);
     LogSetting("Renderer_UseFrameLimit", Settings::values.use_frame_limit);
     LogSetting("Renderer_FrameLimit", Settings::values.frame_limit);
@@ -93,6 +94,7 @@ void LogSettings() {
     LogSetting("Renderer_UseAccurateGpuEmulation", Settings::values.use_accurate_gpu_emulation);
     LogSetting("Renderer_UseAsynchronousGpuEmulation",
                Settings::values.use_asynchronous_gpu_emulation);
+    LogSetting("Renderer_PresentMode", static_cast<u32>(Settings::values.present_mode));
     LogSetting("Audio_OutputEngine", Settings::values.sink_id);
     LogSetting("Audio_EnableAudioStretching", Settings::values.enable_audio_stretching);
     LogSetting("Audio_OutputDevice", Settings::values.audio_device_id);
@@ -102,6 +104,16 @@ void LogSettings() {
     LogSetting("Debugging_UseGdbstub", Settings::values.use_gdbstub);
     LogSetting("Debugging_GdbstubPort", Settings::values.gdbstub_port);
     LogSetting("Debugging_ProgramArgs", Settings::values.program_args);
+    LogSetting("Debugging_UseFreezerWriteWatch", Settings::values.use_freezer_write_watch);
+}
+
+PresentMode ToPresentMode(int value) {
+    if (value < static_cast<int>(PresentMode::Immediate) ||
+        value > static_cast<int>(PresentMode::Fifo)) {
+        LOG_WARNING(Config, "Invalid present mode {}, falling back to FIFO", value);
+        return PresentMode::Fifo;
+    }
+    return static_cast<PresentMode>(value);
 }
 
 } // namespace Settings
@@ -324,6 +324,15 @@ enum class ControllerType {
     LeftJoycon,
 };
 
+enum class PresentMode {
+    /// Presents every composition request as soon as it is made
+    Immediate,
+    /// Keeps the newest frame queued while the previous one is still being presented
+    Mailbox,
+    /// Waits for the previous frame to be presented before presenting the next one
+    Fifo,
+};
+
 struct PlayerInput {
     bool connected;
     ControllerType type;
@@ -379,6 +388,7 @@ struct Values {
 
     // Core
     bool use_multi_core;
+    bool use_host_timing;
 
     // Data Storage
     bool use_virtual_sd;
@@ -393,12 +403,14 @@ struct Values {
     bool use_accurate_gpu_emulation;
     bool use_asynchronous_gpu_emulation;
     bool force_30fps_mode;
+    PresentMode present_mode;
 
     float bg_red;
     float bg_green;
     float bg_blue;
 
     std::string log_filter;
+    bool use_compressed_log;
 
     bool use_dev_keys;
 
@@ -416,6 +428,7 @@ struct Values {
     bool dump_nso;
     bool reporting_services;
     bool quest_flag;
+    bool use_freezer_write_watch;
 
     // WebService
     bool enable_telemetry;
@@ -429,4 +442,7 @@ struct Values {
 
 void Apply();
 void LogSettings();
+
+/// Converts a present mode read from a configuration file, unknown values fall back to FIFO.
+PresentMode ToPresentMode(int value);
 } // namespace Settings
@@ -2,12 +2,19 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <cstring>
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "common/memory_hook.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/core_timing_util.h"
+#include "core/hle/kernel/process.h"
+#include "core/hle/kernel/vm_manager.h"
 #include "core/memory.h"
+#include "core/memory_setup.h"
+#include "core/settings.h"
 #include "core/tools/freezer.h"
 
 namespace Tools {
@@ -51,25 +58,113 @@ void MemoryWriteWidth(u32 width, VAddr addr, u64 value) {
     }
 }
 
+/// Set while a hook writes corrected values back, so that the hook lets its own writes through
+thread_local bool is_reapplying = false;
+
 } // Anonymous namespace
 
-Freezer::Freezer(Core::Timing::CoreTiming& core_timing) : core_timing(core_timing) {
+/// Corrects the writes to frozen values as they happen
+class Freezer::WriteWatchHook final : public Common::MemoryHook {
+public:
+    explicit WriteWatchHook(const Freezer& freezer) : freezer{freezer} {}
+
+    std::optional<bool> IsValidAddress(VAddr addr) override {
+        return std::nullopt;
+    }
+
+    std::optional<u8> Read8(VAddr addr) override {
+        return std::nullopt;
+    }
+    std::optional<u16> Read16(VAddr addr) override {
+        return std::nullopt;
+    }
+    std::optional<u32> Read32(VAddr addr) override {
+        return std::nullopt;
+    }
+    std::optional<u64> Read64(VAddr addr) override {
+        return std::nullopt;
+    }
+
+    bool ReadBlock(VAddr src_addr, void* dest_buffer, std::size_t size) override {
+        return false;
+    }
+
+    bool Write8(VAddr addr, u8 data) override {
+        return Write(addr, data);
+    }
+    bool Write16(VAddr addr, u16 data) override {
+        return Write(addr, data);
+    }
+    bool Write32(VAddr addr, u32 data) override {
+        return Write(addr, data);
+    }
+    bool Write64(VAddr addr, u64 data) override {
+        return Write(addr, data);
+    }
+
+    bool WriteBlock(VAddr dest_addr, const void* src_buffer, std::size_t size) override {
+        if (is_reapplying) {
+            return false;
+        }
+
+        // Bulk writes are corrected in a single pass over the written range, instead of one
+        // write per frozen value
+        std::vector<u8> buffer(size);
+        std::memcpy(buffer.data(), src_buffer, size);
+        if (!freezer.OverlayFrozenValues(dest_addr, buffer.data(), size)) {
+            return false;
+        }
+
+        is_reapplying = true;
+        Memory::WriteBlock(dest_addr, buffer.data(), size);
+        is_reapplying = false;
+        return true;
+    }
+
+private:
+    template <typename T>
+    bool Write(VAddr addr, T data) {
+        if (is_reapplying || !freezer.OverlayFrozenValues(addr, &data, sizeof(T))) {
+            return false;
+        }
+
+        is_reapplying = true;
+        MemoryWriteWidth(sizeof(T), addr, data);
+        is_reapplying = false;
+        return true;
+    }
+
+    const Freezer& freezer;
+};
+
+Freezer::Freezer(Core::Timing::CoreTiming& core_timing)
+    : mode{Settings::values.use_freezer_write_watch ? Mode::WriteWatch : Mode::Polling},
+      hook{std::make_shared<WriteWatchHook>(*this)}, core_timing(core_timing) {
     event = core_timing.RegisterEvent(
         "MemoryFreezer::FrameCallback",
         [this](u64 userdata, s64 cycles_late) { FrameCallback(userdata, cycles_late); });
-    core_timing.ScheduleEvent(MEMORY_FREEZER_TICKS, event);
 }
 
 Freezer::~Freezer() {
-    core_timing.UnscheduleEvent(event, 0);
+    std::lock_guard lock{watch_mutex};
+    if (IsActive()) {
+        StopEnforcing();
+    }
 }
 
 void Freezer::SetActive(bool active) {
-    if (!this->active.exchange(active)) {
+    std::lock_guard lock{watch_mutex};
+
+    if (this->active.exchange(active) == active) {
+        return;
+    }
+
+    if (active) {
         FillEntryReads();
-        core_timing.ScheduleEvent(MEMORY_FREEZER_TICKS, event);
+        StartEnforcing();
         LOG_DEBUG(Common_Memory, "Memory freezer activated!");
     } else {
+        StopEnforcing();
         LOG_DEBUG(Common_Memory, "Memory freezer deactivated!");
     }
 }
@@ -78,36 +173,90 @@ bool Freezer::IsActive() const {
     return active.load(std::memory_order_relaxed);
 }
 
+void Freezer::SetMode(Mode mode) {
+    std::lock_guard lock{watch_mutex};
+
+    if (this->mode == mode) {
+        return;
+    }
+
+    LOG_DEBUG(Common_Memory, "Switching memory freezer to {} mode.",
+              mode == Mode::Polling ? "polling" : "write watch");
+
+    if (IsActive()) {
+        StopEnforcing();
+        this->mode = mode;
+        StartEnforcing();
+    } else {
+        this->mode = mode;
+    }
+}
+
+Freezer::Mode Freezer::GetMode() const {
+    return mode;
+}
+
 void Freezer::Clear() {
-    std::lock_guard lock{entries_mutex};
+    std::lock_guard watch_lock{watch_mutex};
 
-    LOG_DEBUG(Common_Memory, "Clearing all frozen memory values.");
+    std::vector<Entry> removed_entries;
+    {
+        std::lock_guard lock{entries_mutex};
+
+        LOG_DEBUG(Common_Memory, "Clearing all frozen memory values.");
+
+        removed_entries = std::move(entries);
+        entries.clear();
+    }
 
-    entries.clear();
+    if (IsWatching()) {
+        Unwatch(removed_entries);
+    }
 }
 
 u64 Freezer::Freeze(VAddr address, u32 width) {
-    std::lock_guard lock{entries_mutex};
+    std::lock_guard watch_lock{watch_mutex};
+
+    Entry entry;
+    {
+        std::lock_guard lock{entries_mutex};
 
-    const auto current_value = MemoryReadWidth(width, address);
-    entries.push_back({address, width, current_value});
+        const auto current_value = MemoryReadWidth(width, address);
+        entry = {address, width, current_value};
+        entries.push_back(entry);
 
-    LOG_DEBUG(Common_Memory,
-              "Freezing memory for address={:016X}, width={:02X}, current_value={:016X}", address,
-              width, current_value);
+        LOG_DEBUG(Common_Memory,
+                  "Freezing memory for address={:016X}, width={:02X}, current_value={:016X}",
+                  address, width, current_value);
+    }
 
-    return current_value;
+    if (IsWatching()) {
+        Watch(entry);
+    }
+
+    return entry.value;
 }
 
 void Freezer::Unfreeze(VAddr address) {
-    std::lock_guard lock{entries_mutex};
+    std::lock_guard watch_lock{watch_mutex};
 
-    LOG_DEBUG(Common_Memory, "Unfreezing memory for address={:016X}", address);
+    std::vector<Entry> removed_entries;
+    {
+        std::lock_guard lock{entries_mutex};
 
-    entries.erase(
-        std::remove_if(entries.begin(), entries.end(),
-                       [&address](const Entry& entry) { return entry.address == address; }),
-        entries.end());
+        LOG_DEBUG(Common_Memory, "Unfreezing memory for address={:016X}", address);
+
+        const auto iter =
+            std::stable_partition(entries.begin(), entries.end(), [&address](const Entry& entry) {
+                return entry.address != address;
+            });
+        removed_entries.assign(iter, entries.end());
+        entries.erase(iter, entries.end());
+    }
+
+    if (IsWatching()) {
+        Unwatch(removed_entries);
+    }
 }
 
 bool Freezer::IsFrozen(VAddr address) const {
@@ -119,22 +268,36 @@ bool Freezer::IsFrozen(VAddr address) const {
 }
 
 void Freezer::SetFrozenValue(VAddr address, u64 value) {
-    std::lock_guard lock{entries_mutex};
-
-    const auto iter = std::find_if(entries.begin(), entries.end(), [&address](const Entry& entry) {
-        return entry.address == address;
-    });
-
-    if (iter == entries.end()) {
-        LOG_ERROR(Common_Memory,
-                  "Tried to set freeze value for address={:016X} that is not frozen!", address);
-        return;
+    std::lock_guard watch_lock{watch_mutex};
+
+    Entry entry;
+    {
+        std::lock_guard lock{entries_mutex};
+
+        const auto iter =
+            std::find_if(entries.begin(), entries.end(),
+                         [&address](const Entry& entry) { return entry.address == address; });
+
+        if (iter == entries.end()) {
+            LOG_ERROR(Common_Memory,
+                      "Tried to set freeze value for address={:016X} that is not frozen!",
+                      address);
+            return;
+        }
+
+        LOG_DEBUG(
+            Common_Memory,
+            "Manually overridden freeze value for address={:016X}, width={:02X} to value={:016X}",
+            iter->address, iter->width, value);
+        iter->value = value;
+        entry = *iter;
     }
 
-    LOG_DEBUG(Common_Memory,
-              "Manually overridden freeze value for address={:016X}, width={:02X} to value={:016X}",
-              iter->address, iter->width, value);
-    iter->value = value;
+    // Hooks only correct future writes, store the new value right away. The write goes through
+    // the hook, which takes the entries lock itself.
+    if (IsWatching()) {
+        MemoryWriteWidth(entry.width, entry.address, entry.value);
+    }
 }
 
 std::optional<Freezer::Entry> Freezer::GetEntry(VAddr address) const {
@@ -158,14 +321,13 @@ std::vector<Freezer::Entry> Freezer::GetEntries() const {
 }
 
 void Freezer::FrameCallback(u64 userdata, s64 cycles_late) {
-    if (!IsActive()) {
+    if (!IsActive() || mode != Mode::Polling) {
         LOG_DEBUG(Common_Memory, "Memory freezer has been deactivated, ending callback events.");
         return;
     }
 
-    std::lock_guard lock{entries_mutex};
-
-    for (const auto& entry : entries) {
+    // Writes are made without the entries lock, a mode switch may already have hooked the pages
+    for (const auto& entry : GetEntries()) {
         LOG_DEBUG(Common_Memory,
                   "Enforcing memory freeze at address={:016X}, value={:016X}, width={:02X}",
                   entry.address, entry.value, entry.width);
@@ -185,4 +347,83 @@ void Freezer::FillEntryReads() {
     }
 }
 
+bool Freezer::IsWatching() const {
+    return IsActive() && mode == Mode::WriteWatch;
+}
+
+void Freezer::StartEnforcing() {
+    if (mode == Mode::Polling) {
+        core_timing.ScheduleEvent(MEMORY_FREEZER_TICKS, event);
+        return;
+    }
+
+    for (const auto& entry : GetEntries()) {
+        Watch(entry);
+    }
+}
+
+void Freezer::StopEnforcing() {
+    if (mode == Mode::Polling) {
+        core_timing.UnscheduleEvent(event, 0);
+        return;
+    }
+
+    Unwatch(GetEntries());
+}
+
+void Freezer::Watch(const Entry& entry) {
+    if (watched_page_table == nullptr) {
+        watched_page_table = &Core::CurrentProcess()->VMManager().page_table;
+    }
+
+    LOG_DEBUG(Common_Memory, "Watching writes to address={:016X}, width={:02X}", entry.address,
+              entry.width);
+    Memory::AddDebugHook(*watched_page_table, entry.address, entry.width, hook);
+
+    // Writes that happened before the hook was in place are not corrected by it
+    MemoryWriteWidth(entry.width, entry.address, entry.value);
+}
+
+void Freezer::Unwatch(const std::vector<Entry>& removed_entries) {
+    if (watched_page_table == nullptr) {
+        return;
+    }
+
+    for (const auto& entry : removed_entries) {
+        Memory::RemoveDebugHook(*watched_page_table, entry.address, entry.width, hook);
+    }
+
+    // A region holds the hook only once, so removing it may have unwatched frozen values that
+    // overlap the removed ones
+    for (const auto& entry : GetEntries()) {
+        const bool overlaps = std::any_of(
+            removed_entries.begin(), removed_entries.end(), [&entry](const Entry& removed) {
+                return entry.address < removed.address + removed.width &&
+                       removed.address < entry.address + entry.width;
+            });
+        if (overlaps) {
+            Memory::AddDebugHook(*watched_page_table, entry.address, entry.width, hook);
+        }
+    }
+}
+
+bool Freezer::OverlayFrozenValues(VAddr address, void* data, std::size_t size) const {
+    std::lock_guard lock{entries_mutex};
+
+    bool overlaps = false;
+    for (const auto& entry : entries) {
+        const VAddr begin = std::max(address, entry.address);
+        const VAddr end = std::min(address + size, entry.address + entry.width);
+        if (begin >= end) {
+            continue;
+        }
+
+        std::memcpy(static_cast<u8*>(data) + (begin - address),
+                    reinterpret_cast<const u8*>(&entry.value) + (begin - entry.address),
+                    end - begin);
+        overlaps = true;
+    }
+    return overlaps;
+}
+
 } // namespace Tools
@@ -5,11 +5,16 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <vector>
 #include "common/common_types.h"
 
+namespace Common {
+struct PageTable;
+}
+
 namespace Core::Timing {
 class CoreTiming;
 struct EventType;
@@ -24,6 +29,8 @@ namespace Tools {
  * One example could be a cheat to prevent Mario from taking damage in SMO. One could freeze the
  * memory address that the game uses to store Mario's health so when he takes damage (and the game
  * tries to write the new health value to memory), the value won't change.
+ *
+ * The freezer must be destroyed before the process whose memory it freezes.
  */
 class Freezer {
 public:
@@ -33,6 +40,14 @@ public:
         u64 value;
     };
 
+    enum class Mode {
+        /// Frozen values are rewritten once per frame, the game may observe changes in between
+        Polling,
+        /// Writes to frozen values are caught by memory hooks and corrected as they happen. Only
+        /// accesses to the pages containing frozen values pay for it.
+        WriteWatch,
+    };
+
     explicit Freezer(Core::Timing::CoreTiming& core_timing);
     ~Freezer();
 
@@ -42,6 +57,13 @@ public:
     // Returns whether or not the freezer is active.
     bool IsActive() const;
 
+    // Selects how frozen values are enforced. Defaults to the mode chosen by the
+    // use_freezer_write_watch setting.
+    void SetMode(Mode mode);
+
+    // Returns how frozen values are enforced.
+    Mode GetMode() const;
+
     // Removes all entries from the freezer.
     void Clear();
 
@@ -67,10 +89,28 @@ public:
     std::vector<Entry> GetEntries() const;
 
 private:
+    class WriteWatchHook;
+
     void FrameCallback(u64 userdata, s64 cycles_late);
     void FillEntryReads();
 
+    bool IsWatching() const;
+    void StartEnforcing();
+    void StopEnforcing();
+    void Watch(const Entry& entry);
+    void Unwatch(const std::vector<Entry>& removed_entries);
+
+    // Overwrites the bytes of data that belong to frozen values with their frozen value. Returns
+    // whether the range [address, address + size) contains frozen bytes.
+    bool OverlayFrozenValues(VAddr address, void* data, std::size_t size) const;
+
     std::atomic_bool active{false};
+    std::atomic<Mode> mode{Mode::Polling};
+
+    // Serializes changes to the entries with the registration of their hooks
+    std::mutex watch_mutex;
+    std::shared_ptr<WriteWatchHook> hook;
+    Common::PageTable* watched_page_table = nullptr;
 
     mutable std::mutex entries_mutex;
     std::vector<Entry> entries;
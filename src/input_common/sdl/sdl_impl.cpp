@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cmath>
 #include <functional>
@@ -14,6 +15,8 @@
 #include <utility>
 #include <vector>
 #include <SDL.h>
+#include "common/common_types.h"
+#include "common/double_buffer.h"
 #include "common/logging/log.h"
 #include "common/math_util.h"
 #include "common/param_package.h"
@@ -52,28 +55,46 @@ public:
         : guid{std::move(guid_)}, port{port_}, sdl_joystick{joystick, &SDL_JoystickClose} {}
 
     void SetButton(int button, bool value) {
-        std::lock_guard lock{mutex};
-        state.buttons.insert_or_assign(button, value);
+        if (button < 0 || button >= MAX_BUTTONS) {
+            return;
+        }
+        std::lock_guard lock{write_mutex};
+        state.Modify([button, value](State& next) {
+            const u64 mask = u64{1} << button;
+            next.buttons = value ? (next.buttons | mask) : (next.buttons & ~mask);
+        });
     }
 
     bool GetButton(int button) const {
-        std::lock_guard lock{mutex};
-        return state.buttons.at(button);
+        if (button < 0 || button >= MAX_BUTTONS) {
+            return false;
+        }
+        return ((state.Read().buttons >> button) & 1) != 0;
     }
 
     void SetAxis(int axis, Sint16 value) {
-        std::lock_guard lock{mutex};
-        state.axes.insert_or_assign(axis, value);
+        if (axis < 0 || axis >= MAX_AXES) {
+            return;
+        }
+        std::lock_guard lock{write_mutex};
+        state.Modify([axis, value](State& next) { next.axes[axis] = value; });
     }
 
     float GetAxis(int axis) const {
-        std::lock_guard lock{mutex};
-        return state.axes.at(axis) / 32767.0f;
+        if (axis < 0 || axis >= MAX_AXES) {
+            return 0.0f;
+        }
+        return state.Read().axes[axis] / 32767.0f;
     }
 
     std::tuple<float, float> GetAnalog(int axis_x, int axis_y) const {
-        float x = GetAxis(axis_x);
-        float y = GetAxis(axis_y);
+        // Read both axes from the same snapshot so they always belong to the same event
+        const State snapshot = state.Read();
+        const auto get_axis = [&snapshot](int axis) {
+            return axis >= 0 && axis < MAX_AXES ? snapshot.axes[axis] / 32767.0f : 0.0f;
+        };
+        float x = get_axis(axis_x);
+        float y = get_axis(axis_y);
         y = -y; // 3DS uses an y-axis inverse from SDL
 
         // Make sure the coordinates are in the unit circle,
@@ -89,13 +110,18 @@ public:
     }
 
     void SetHat(int hat, Uint8 direction) {
-        std::lock_guard lock{mutex};
-        state.hats.insert_or_assign(hat, direction);
+        if (hat < 0 || hat >= MAX_HATS) {
+            return;
+        }
+        std::lock_guard lock{write_mutex};
+        state.Modify([hat, direction](State& next) { next.hats[hat] = direction; });
     }
 
     bool GetHatDirection(int hat, Uint8 direction) const {
-        std::lock_guard lock{mutex};
-        return (state.hats.at(hat) & direction) != 0;
+        if (hat < 0 || hat >= MAX_HATS) {
+            return false;
+        }
+        return (state.Read().hats[hat] & direction) != 0;
     }
     /**
      * The guid of the joystick
@@ -120,15 +146,24 @@ public:
     }
 
 private:
+    static constexpr int MAX_BUTTONS = 64;
+    static constexpr int MAX_AXES = 16;
+    static constexpr int MAX_HATS = 8;
+
+    /// Input state written by the SDL event thread and read by the emulated HID without locking
     struct State {
-        std::unordered_map<int, bool> buttons;
-        std::unordered_map<int, Sint16> axes;
-        std::unordered_map<int, Uint8> hats;
-    } state;
+        u64 buttons;
+        std::array<Sint16, MAX_AXES> axes;
+        std::array<Uint8, MAX_HATS> hats;
+    };
+
+    Common::DoubleBuffer<State> state;
+    /// Serializes writers in case SDL events are pumped from more than one thread. Readers never
+    /// take this lock.
+    std::mutex write_mutex;
     std::string guid;
     int port;
     std::unique_ptr<SDL_Joystick, decltype(&SDL_JoystickClose)> sdl_joystick;
-    mutable std::mutex mutex;
 };
 
 std::shared_ptr<SDLJoystick> SDLState::GetSDLJoystickByGUID(const std::string& guid, int port) {
@@ -391,8 +426,6 @@ public:
             } else {
                 direction = 0;
             }
-            // This is necessary so accessing GetHat with hat won't crash
-            joystick->SetHat(hat, SDL_HAT_CENTERED);
             return std::make_unique<SDLDirectionButton>(joystick, hat, direction);
         }
 
@@ -409,14 +442,10 @@ public:
                 trigger_if_greater = true;
                 LOG_ERROR(Input, "Unknown direction {}", direction_name);
             }
-            // This is necessary so accessing GetAxis with axis won't crash
-            joystick->SetAxis(axis, 0);
             return std::make_unique<SDLAxisButton>(joystick, axis, threshold, trigger_if_greater);
         }
 
         const int button = params.Get("button", 0);
-        // This is necessary so accessing GetButton with button won't crash
-        joystick->SetButton(button, false);
         return std::make_unique<SDLButton>(joystick, button);
     }
 
@@ -444,10 +473,6 @@ public:
         const float deadzone = std::clamp(params.Get("deadzone", 0.0f), 0.0f, .99f);
 
         auto joystick = state.GetSDLJoystickByGUID(guid, port);
-
-        // This is necessary so accessing GetAxis with axis_x and axis_y won't crash
-        joystick->SetAxis(axis_x, 0);
-        joystick->SetAxis(axis_y, 0);
         return std::make_unique<SDLAnalog>(joystick, axis_x, axis_y, deadzone);
     }
 
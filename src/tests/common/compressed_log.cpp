@@ -0,0 +1,104 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/file_util.h"
+#include "common/logging/backend.h"
+
+namespace Log {
+
+namespace {
+
+Entry MakeEntry(Level log_level, std::string message) {
+    Entry entry;
+    entry.timestamp = std::chrono::microseconds{1234};
+    entry.log_class = Class::Common_Filesystem;
+    entry.log_level = log_level;
+    entry.filename = "compressed_log.cpp";
+    entry.line_num = 42;
+    entry.function = "MakeEntry";
+    entry.message = std::move(message);
+    return entry;
+}
+
+/// Entry read back from a compressed log, along with the strings it referenced
+struct ReadEntry {
+    Entry entry;
+    std::string filename;
+    std::string function;
+};
+
+/// Reads back all the entries of a set of compressed logs, oldest first
+std::vector<ReadEntry> ReadEntries(const std::string& base_path) {
+    std::vector<ReadEntry> entries;
+    for (const std::string& path : GetCompressedLogFiles(base_path)) {
+        const bool success = ReadCompressedLogFile(path, [&entries](const Entry& entry) {
+            entries.push_back({entry, entry.filename, entry.function});
+        });
+        REQUIRE(success);
+    }
+    return entries;
+}
+
+/// Directory for the logs of a test, removed along with its contents when the test ends
+class TestDirectory {
+public:
+    TestDirectory() : path{*FileUtil::GetCurrentDir() + "/compressed_log_test"} {
+        FileUtil::DeleteDirRecursively(path);
+        FileUtil::CreateDir(path);
+    }
+
+    ~TestDirectory() {
+        FileUtil::DeleteDirRecursively(path);
+    }
+
+    const std::string path;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("CompressedFileBackend: Round trip", "[common]") {
+    const TestDirectory directory;
+    const std::string base_path = directory.path + "/log";
+    {
+        CompressedFileBackend backend(base_path);
+        backend.Write(MakeEntry(Level::Info, "first"));
+        backend.Write(MakeEntry(Level::Error, "second"));
+        backend.Write(MakeEntry(Level::Debug, std::string(1000, 'x')));
+    }
+
+    const std::vector<ReadEntry> entries = ReadEntries(base_path);
+    REQUIRE(entries.size() == 3);
+    REQUIRE(entries[0].entry.message == "first");
+    REQUIRE(entries[0].entry.log_level == Level::Info);
+    REQUIRE(entries[0].entry.log_class == Class::Common_Filesystem);
+    REQUIRE(entries[0].entry.timestamp == std::chrono::microseconds{1234});
+    REQUIRE(entries[0].entry.line_num == 42);
+    REQUIRE(entries[0].filename == "compressed_log.cpp");
+    REQUIRE(entries[0].function == "MakeEntry");
+    REQUIRE(entries[1].entry.message == "second");
+    REQUIRE(entries[1].entry.log_level == Level::Error);
+    REQUIRE(entries[2].entry.message == std::string(1000, 'x'));
+}
+
+TEST_CASE("CompressedFileBackend: Rotation keeps the newest entries", "[common]") {
+    const TestDirectory directory;
+    const std::string base_path = directory.path + "/log";
+    {
+        // Every error is flushed, and every flush fills a file
+        CompressedFileBackend backend(base_path, 3, 1);
+        backend.Write(MakeEntry(Level::Error, "first"));
+        backend.Write(MakeEntry(Level::Error, "second"));
+        backend.Write(MakeEntry(Level::Error, "third"));
+    }
+
+    const std::vector<ReadEntry> entries = ReadEntries(base_path);
+    REQUIRE(entries.size() == 2);
+    REQUIRE(entries[0].entry.message == "second");
+    REQUIRE(entries[1].entry.message == "third");
+}
+
+} // namespace Log
@@ -0,0 +1,129 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/atomic_ops.h"
+#include "core/arm/striped_exclusive_monitor.h"
+
+namespace Core {
+
+namespace {
+
+constexpr std::size_t NUM_CORES = 4;
+
+/// Guest memory word accessed the way the monitor accesses memory backed by the host
+struct Word {
+    u32 Read() const {
+        return value.load();
+    }
+
+    bool Write(u32 new_value, u32 expected) {
+        return value.compare_exchange_strong(expected, new_value);
+    }
+
+    std::atomic<u32> value{0};
+};
+
+u32 ExclusiveRead(ReservationTable& table, std::size_t core, VAddr addr, const Word& word) {
+    return table.Mark<u32>(core, addr, [&word] { return word.Read(); });
+}
+
+bool ExclusiveWrite(ReservationTable& table, std::size_t core, VAddr addr, Word& word, u32 value) {
+    return table.Commit<u32>(core, addr,
+                             [&word, value](u32 expected) { return word.Write(value, expected); });
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ReservationTable: Exclusive pairs", "[core]") {
+    ReservationTable table{NUM_CORES};
+    Word word;
+    constexpr VAddr addr = 0x1000;
+
+    // An uncontended exclusive pair succeeds and releases the reservation
+    REQUIRE(ExclusiveRead(table, 0, addr, word) == 0);
+    REQUIRE(ExclusiveWrite(table, 0, addr, word, 1));
+    REQUIRE(word.Read() == 1);
+    REQUIRE(!ExclusiveWrite(table, 0, addr, word, 2));
+
+    // A store to a different address than the reserved one fails
+    ExclusiveRead(table, 0, addr, word);
+    REQUIRE(!ExclusiveWrite(table, 0, addr + 4, word, 2));
+
+    // An exclusive store by another core breaks the reservation
+    ExclusiveRead(table, 0, addr, word);
+    ExclusiveRead(table, 1, addr, word);
+    REQUIRE(ExclusiveWrite(table, 1, addr, word, 2));
+    REQUIRE(!ExclusiveWrite(table, 0, addr, word, 3));
+    REQUIRE(word.Read() == 2);
+
+    // A plain store by another core makes the compare-and-swap fail
+    ExclusiveRead(table, 0, addr, word);
+    word.value.store(5);
+    REQUIRE(!ExclusiveWrite(table, 0, addr, word, 3));
+    REQUIRE(word.Read() == 5);
+
+    // Clearing invalidates the reservations of all cores
+    ExclusiveRead(table, 0, addr, word);
+    ExclusiveRead(table, 1, addr + ReservationTable::LINE_SIZE, word);
+    table.Clear();
+    REQUIRE(!ExclusiveWrite(table, 0, addr, word, 6));
+    REQUIRE(!ExclusiveWrite(table, 1, addr + ReservationTable::LINE_SIZE, word, 6));
+}
+
+TEST_CASE("ReservationTable: Concurrent atomics", "[core]") {
+    constexpr u32 NUM_ITERATIONS = 100000;
+    constexpr VAddr counter_addr = 0x2000;
+    constexpr VAddr lock_addr = 0x3000;
+
+    ReservationTable table{NUM_CORES};
+    Word counter;
+    Word lock;
+    u32 protected_counter = 0;
+
+    std::vector<std::thread> threads;
+    for (std::size_t core = 0; core < NUM_CORES; ++core) {
+        threads.emplace_back([&, core] {
+            for (u32 i = 0; i < NUM_ITERATIONS; ++i) {
+                // Atomic increment, as emitted for LDXR/ADD/STXR loops
+                u32 value;
+                do {
+                    value = ExclusiveRead(table, core, counter_addr, counter);
+                } while (!ExclusiveWrite(table, core, counter_addr, counter, value + 1));
+
+                // Spinlock acquired with an exclusive pair and released with a plain store
+                while (ExclusiveRead(table, core, lock_addr, lock) != 0 ||
+                       !ExclusiveWrite(table, core, lock_addr, lock, 1)) {
+                    std::this_thread::yield();
+                }
+                ++protected_counter;
+                lock.value.store(0);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(counter.Read() == NUM_CORES * NUM_ITERATIONS);
+    REQUIRE(protected_counter == NUM_CORES * NUM_ITERATIONS);
+}
+
+TEST_CASE("AtomicCompareAndSwap: 128-bit", "[core]") {
+    alignas(16) u64 memory[2] = {1, 2};
+
+    REQUIRE(!Common::AtomicCompareAndSwap(memory, u128{3, 4}, u128{1, 0}));
+    REQUIRE(memory[0] == 1);
+    REQUIRE(memory[1] == 2);
+
+    REQUIRE(Common::AtomicCompareAndSwap(memory, u128{3, 4}, u128{1, 2}));
+    REQUIRE(memory[0] == 3);
+    REQUIRE(memory[1] == 4);
+}
+
+} // namespace Core
@@ -0,0 +1,145 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include "core/core.h"
+#include "core/file_sys/cheat_engine.h"
+
+namespace FileSys {
+
+namespace {
+
+constexpr VAddr MAIN_BEGIN = 0x1000;
+constexpr VAddr MAIN_END = 0x9000;
+constexpr VAddr HEAP_BEGIN = 0x9000;
+constexpr VAddr HEAP_END = 0x10000;
+
+std::array<u8, HEAP_END> memory;
+
+u64 ReadMemory(u32 width, VAddr addr) {
+    u64 value = 0;
+    std::memcpy(&value, &memory[addr], width);
+    return value;
+}
+
+void WriteMemory(u32 width, VAddr addr, u64 value) {
+    std::memcpy(&memory[addr], &value, width);
+}
+
+u8* ResolveMemory(u32 width, VAddr addr) {
+    return &memory[addr];
+}
+
+CheatList MakeCheatList(const std::string& text, bool use_resolver = true) {
+    const std::vector<u8> data(text.begin(), text.end());
+    CheatList list = TextCheatParser{}.Parse(Core::System::GetInstance(), data);
+    list.SetMemoryParameters(MAIN_BEGIN, HEAP_BEGIN, MAIN_END, HEAP_END, &WriteMemory,
+                             &ReadMemory, use_resolver ? &ResolveMemory : nullptr);
+    return list;
+}
+
+u32 Read32(VAddr addr) {
+    return static_cast<u32>(ReadMemory(4, addr));
+}
+
+} // Anonymous namespace
+
+TEST_CASE("CheatList: Writes and conditionals", "[core]") {
+    memory.fill(0);
+
+    auto list = MakeCheatList("{Master}\n"
+                              "04000000 00000010 12345678\n"
+                              "[Taken]\n"
+                              "14050000 00000010 12345678\n"
+                              "04000000 00000020 00000001\n"
+                              "20000000\n"
+                              "[Not taken]\n"
+                              "14060000 00000010 12345678\n"
+                              "04000000 00000030 00000001\n"
+                              "20000000\n"
+                              "04000000 00000040 00000001\n");
+    list.Execute();
+
+    REQUIRE(Read32(MAIN_BEGIN + 0x10) == 0x12345678);
+    REQUIRE(Read32(MAIN_BEGIN + 0x20) == 1);
+    REQUIRE(Read32(MAIN_BEGIN + 0x30) == 0);
+    REQUIRE(Read32(MAIN_BEGIN + 0x40) == 1);
+}
+
+TEST_CASE("CheatList: Loops and indexed stores", "[core]") {
+    memory.fill(0);
+
+    // Stores 0xABCD four times to consecutive words, through both memory access paths
+    for (const bool use_resolver : {true, false}) {
+        auto list = MakeCheatList("[Loop]\n"
+                                  "40020000 00000000 00001020\n"
+                                  "30010000 00000003\n"
+                                  "64021000 00000000 0000ABCD\n"
+                                  "31010000\n",
+                                  use_resolver);
+        REQUIRE(list.GetProgramSize() == 4);
+        list.Execute();
+
+        for (VAddr addr = 0x1020; addr < 0x1030; addr += 4) {
+            REQUIRE(Read32(addr) == 0xABCD);
+        }
+        REQUIRE(Read32(0x1030) == 0);
+        memory.fill(0);
+    }
+}
+
+TEST_CASE("CheatList: Malformed cheats are dropped", "[core]") {
+    memory.fill(0);
+
+    auto list = MakeCheatList("[Unmatched end]\n"
+                              "04000000 00000010 00000001\n"
+                              "20000000\n"
+                              "[Valid]\n"
+                              "04000000 00000020 00000001\n");
+    REQUIRE(list.GetProgramSize() == 1);
+    list.Execute();
+
+    REQUIRE(Read32(MAIN_BEGIN + 0x10) == 0);
+    REQUIRE(Read32(MAIN_BEGIN + 0x20) == 1);
+}
+
+TEST_CASE("CheatList: Large cheat list benchmark", "[.][benchmark]") {
+    constexpr std::size_t NUM_CHEATS = 2000;
+    constexpr std::size_t NUM_FRAMES = 1000;
+
+    // Every cheat checks a value, patches a few words and fills a small array in a loop
+    std::string text;
+    for (std::size_t i = 0; i < NUM_CHEATS; ++i) {
+        const u32 offset = static_cast<u32>((i * 0x10) % 0x7000);
+        text += fmt::format("[Cheat {}]\n", i);
+        text += fmt::format("14030000 {:08X} FFFFFFFF\n", offset);
+        text += fmt::format("04000000 {:08X} {:08X}\n", offset, static_cast<u32>(i));
+        text += fmt::format("02000000 {:08X} {:08X}\n", offset + 4, static_cast<u32>(i));
+        text += fmt::format("40020000 00000000 {:08X}\n", static_cast<u32>(HEAP_BEGIN));
+        text += "30010000 00000007\n";
+        text += "64021000 00000000 00000001\n";
+        text += "31010000\n";
+        text += "20000000\n";
+    }
+
+    auto list = MakeCheatList(text);
+    const auto begin = std::chrono::steady_clock::now();
+    for (std::size_t frame = 0; frame < NUM_FRAMES; ++frame) {
+        list.Execute();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    WARN(fmt::format("{} cheats ({} instructions): {} us per frame", NUM_CHEATS,
+                     list.GetProgramSize(),
+                     std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() /
+                         NUM_FRAMES));
+}
+
+} // namespace FileSys
@@ -0,0 +1,291 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/memory_hook.h"
+#include "common/page_table.h"
+#include "core/core.h"
+#include "core/file_sys/program_metadata.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/process.h"
+#include "core/hle/kernel/vm_manager.h"
+#include "core/memory.h"
+#include "core/memory_setup.h"
+
+namespace Memory {
+
+namespace {
+
+/// Records the accesses it sees, handles them only when told to
+class TestHook final : public Common::MemoryHook {
+public:
+    std::optional<bool> IsValidAddress(VAddr addr) override {
+        return std::nullopt;
+    }
+
+    std::optional<u8> Read8(VAddr addr) override {
+        return Read<u8>(addr);
+    }
+    std::optional<u16> Read16(VAddr addr) override {
+        return Read<u16>(addr);
+    }
+    std::optional<u32> Read32(VAddr addr) override {
+        return Read<u32>(addr);
+    }
+    std::optional<u64> Read64(VAddr addr) override {
+        return Read<u64>(addr);
+    }
+
+    bool ReadBlock(VAddr src_addr, void* dest_buffer, std::size_t size) override {
+        ++reads;
+        if (!fill) {
+            return false;
+        }
+        std::memset(dest_buffer, *fill, size);
+        return true;
+    }
+
+    bool Write8(VAddr addr, u8 data) override {
+        return Write();
+    }
+    bool Write16(VAddr addr, u16 data) override {
+        return Write();
+    }
+    bool Write32(VAddr addr, u32 data) override {
+        return Write();
+    }
+    bool Write64(VAddr addr, u64 data) override {
+        return Write();
+    }
+
+    bool WriteBlock(VAddr dest_addr, const void* src_buffer, std::size_t size) override {
+        return Write();
+    }
+
+    /// Byte that handled reads return, reads are let through when empty
+    std::optional<u8> fill;
+    /// Whether writes are handled or let through
+    bool handle_writes = false;
+
+    int reads = 0;
+    int writes = 0;
+
+private:
+    template <typename T>
+    std::optional<T> Read(VAddr addr) {
+        ++reads;
+        if (!fill) {
+            return std::nullopt;
+        }
+        T value;
+        std::memset(&value, *fill, sizeof(T));
+        return value;
+    }
+
+    bool Write() {
+        ++writes;
+        return handle_writes;
+    }
+};
+
+/// Processes are expensive to create, all tests share one with a small address space
+Kernel::Process& GetTestProcess() {
+    static Kernel::Process* const process = [] {
+        auto& system = Core::System::GetInstance();
+        const auto process =
+            Kernel::Process::Create(system, "", Kernel::Process::ProcessType::Userland);
+        process->VMManager().Reset(FileSys::ProgramAddressSpaceType::Is32Bit);
+        system.Kernel().MakeCurrentProcess(process.get());
+
+        // The kernel keeps the process alive
+        return process.get();
+    }();
+    return *process;
+}
+
+u32 ReadBuffer32(const std::vector<u8>& buffer, std::size_t offset) {
+    u32 value;
+    std::memcpy(&value, buffer.data() + offset, sizeof(value));
+    return value;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Memory: Debug hooks", "[core]") {
+    auto& process = GetTestProcess();
+    auto& page_table = process.VMManager().page_table;
+
+    constexpr VAddr base = 0x10000;
+    constexpr std::size_t page = base >> PAGE_BITS;
+    std::vector<u8> memory(PAGE_SIZE * 2);
+    MapMemoryRegion(page_table, base, PAGE_SIZE * 2, memory.data());
+
+    const auto hook = std::make_shared<TestHook>();
+    AddDebugHook(page_table, base + 0x10, 4, hook);
+
+    // Only the hooked page takes the slow path, and it is still backed by memory
+    REQUIRE(page_table.attributes[page] == Common::PageType::Special);
+    REQUIRE(page_table.pointers[page] == nullptr);
+    REQUIRE(page_table.attributes[page + 1] == Common::PageType::Memory);
+    REQUIRE(IsValidVirtualAddress(process, base));
+    REQUIRE(GetPointer(base + 0x20) == memory.data() + 0x20);
+
+    // Accesses the hook lets through reach the memory behind it
+    Write32(base + 0x10, 0x12345678);
+    REQUIRE(hook->writes == 1);
+    REQUIRE(ReadBuffer32(memory, 0x10) == 0x12345678);
+    REQUIRE(Read32(base + 0x10) == 0x12345678);
+    REQUIRE(hook->reads == 1);
+
+    // Accesses outside of the hooked range skip it
+    Write32(base + 0x20, 0xCAFEBABE);
+    REQUIRE(Read32(base + 0x20) == 0xCAFEBABE);
+    REQUIRE(hook->writes == 1);
+    REQUIRE(hook->reads == 1);
+
+    // Accesses the hook handles never reach the memory
+    hook->handle_writes = true;
+    hook->fill = 0xAB;
+    Write32(base + 0x10, 0);
+    REQUIRE(ReadBuffer32(memory, 0x10) == 0x12345678);
+    REQUIRE(Read32(base + 0x10) == 0xABABABAB);
+
+    u32 value = 0;
+    WriteBlock(process, base + 0xE, &value, sizeof(value));
+    REQUIRE(hook->writes == 3);
+    REQUIRE(ReadBuffer32(memory, 0x10) == 0x12345678);
+    ReadBlock(process, base + 0xE, &value, sizeof(value));
+    REQUIRE(value == 0xABABABAB);
+
+    // Removing the last hook of a page gives it its fast path back
+    RemoveDebugHook(page_table, base + 0x10, 4, hook);
+    REQUIRE(page_table.attributes[page] == Common::PageType::Memory);
+    REQUIRE(page_table.pointers[page] == memory.data());
+    REQUIRE(Read32(base + 0x10) == 0x12345678);
+    REQUIRE(hook->reads == 3);
+
+    UnmapRegion(page_table, base, PAGE_SIZE * 2);
+}
+
+TEST_CASE("Memory: Overlapping debug hooks", "[core]") {
+    auto& process = GetTestProcess();
+    auto& page_table = process.VMManager().page_table;
+
+    constexpr VAddr base = 0x20000;
+    std::vector<u8> memory(PAGE_SIZE);
+    MapMemoryRegion(page_table, base, PAGE_SIZE, memory.data());
+
+    const auto low_hook = std::make_shared<TestHook>();
+    const auto high_hook = std::make_shared<TestHook>();
+    AddDebugHook(page_table, base, 4, low_hook);
+    AddDebugHook(page_table, base + 4, 4, high_hook);
+
+    // An access straddling both hooks reaches both of them
+    Write64(base, 0x1122334455667788);
+    REQUIRE(low_hook->writes == 1);
+    REQUIRE(high_hook->writes == 1);
+    REQUIRE(Read64(base) == 0x1122334455667788);
+
+    // The page stays hooked until its last hook is removed
+    RemoveDebugHook(page_table, base, 4, low_hook);
+    REQUIRE(page_table.attributes[base >> PAGE_BITS] == Common::PageType::Special);
+    Write32(base, 0);
+    REQUIRE(low_hook->writes == 1);
+    REQUIRE(ReadBuffer32(memory, 0) == 0);
+
+    RemoveDebugHook(page_table, base + 4, 4, high_hook);
+    REQUIRE(page_table.attributes[base >> PAGE_BITS] == Common::PageType::Memory);
+
+    // Remapping hooked memory keeps the hook on it, in front of the new memory
+    std::vector<u8> new_memory(PAGE_SIZE);
+    AddDebugHook(page_table, base, 4, low_hook);
+    MapMemoryRegion(page_table, base, PAGE_SIZE, new_memory.data());
+    REQUIRE(page_table.attributes[base >> PAGE_BITS] == Common::PageType::Special);
+    Write32(base, 0x55AA55AA);
+    REQUIRE(low_hook->writes == 2);
+    REQUIRE(ReadBuffer32(new_memory, 0) == 0x55AA55AA);
+    REQUIRE(ReadBuffer32(memory, 0) == 0);
+
+    RemoveDebugHook(page_table, base, 4, low_hook);
+    REQUIRE(page_table.pointers[base >> PAGE_BITS] == new_memory.data());
+
+    UnmapRegion(page_table, base, PAGE_SIZE);
+}
+
+TEST_CASE("Memory: I/O regions", "[core]") {
+    auto& process = GetTestProcess();
+    auto& page_table = process.VMManager().page_table;
+
+    constexpr VAddr base = 0x30000;
+    const auto device = std::make_shared<TestHook>();
+    MapIoRegion(page_table, base, PAGE_SIZE, device);
+
+    // I/O regions have no memory behind them, unhandled accesses go nowhere
+    REQUIRE(!IsValidVirtualAddress(process, base));
+    Write32(base, 0x12345678);
+    REQUIRE(device->writes == 1);
+    REQUIRE(Read32(base) == 0);
+
+    device->fill = 0x5A;
+    REQUIRE(Read32(base) == 0x5A5A5A5A);
+    std::vector<u8> buffer(0x20);
+    ReadBlock(process, base + 0x10, buffer.data(), buffer.size());
+    REQUIRE(ReadBuffer32(buffer, 0x1C) == 0x5A5A5A5A);
+    REQUIRE(device->reads == 3);
+
+    UnmapRegion(page_table, base, PAGE_SIZE);
+}
+
+TEST_CASE("Memory: Exclusive writes", "[core]") {
+    auto& process = GetTestProcess();
+    auto& page_table = process.VMManager().page_table;
+
+    constexpr VAddr base = 0x40000;
+    std::vector<u64> memory(PAGE_SIZE / sizeof(u64) * 2);
+    MapMemoryRegion(page_table, base, PAGE_SIZE, reinterpret_cast<u8*>(memory.data()));
+
+    // Stores only succeed while the memory holds the expected value
+    REQUIRE(WriteExclusive8(base, 1, 0));
+    REQUIRE(!WriteExclusive8(base, 2, 0));
+    REQUIRE(WriteExclusive16(base + 2, 0x1234, 0));
+    REQUIRE(WriteExclusive32(base + 4, 0x12345678, 0));
+    REQUIRE(!WriteExclusive32(base + 4, 0, 0));
+    REQUIRE(memory[0] == 0x1234567812340001);
+    REQUIRE(WriteExclusive64(base + 8, 0xCAFEBABEDEADBEEF, 0));
+    REQUIRE(!WriteExclusive64(base + 8, 0, 0xCAFEBABE));
+    REQUIRE(memory[1] == 0xCAFEBABEDEADBEEF);
+
+    // A 128-bit store compares both halves
+    REQUIRE(!WriteExclusive128(base + 16, {1, 2}, {0, 1}));
+    REQUIRE(WriteExclusive128(base + 16, {1, 2}, {0, 0}));
+    REQUIRE(memory[2] == 1);
+    REQUIRE(memory[3] == 2);
+
+    // Host memory that is not aligned for an atomic falls back to plain accesses
+    const auto misaligned = reinterpret_cast<u8*>(memory.data()) + 8;
+    MapMemoryRegion(page_table, base, PAGE_SIZE, misaligned);
+    REQUIRE(!WriteExclusive128(base, {3, 4}, {0, 1}));
+    REQUIRE(WriteExclusive128(base, {3, 4}, {0xCAFEBABEDEADBEEF, 1}));
+    REQUIRE(memory[1] == 3);
+    REQUIRE(memory[2] == 4);
+    REQUIRE(WriteExclusive16(base + 1, 0xFFFF, 0));
+    REQUIRE(memory[1] == 0xFFFF03);
+
+    // Stores to hooked memory go through its hooks
+    const auto hook = std::make_shared<TestHook>();
+    AddDebugHook(page_table, base + 0x100, 8, hook);
+    REQUIRE(WriteExclusive64(base + 0x100, 7, 0));
+    REQUIRE(!WriteExclusive64(base + 0x100, 8, 0));
+    REQUIRE(hook->writes == 1);
+    REQUIRE(memory[0x100 / sizeof(u64) + 1] == 7);
+    RemoveDebugHook(page_table, base + 0x100, 8, hook);
+
+    UnmapRegion(page_table, base, PAGE_SIZE);
+}
+
+} // namespace Memory
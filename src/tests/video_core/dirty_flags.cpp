@@ -0,0 +1,38 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <vector>
+#include <catch2/catch.hpp>
+#include "video_core/dirty_flags.h"
+
+namespace VideoCommon {
+
+TEST_CASE("DirtyFlags: Take and iterate", "[video_core]") {
+    DirtyFlags flags;
+    REQUIRE(!flags.Any());
+
+    flags.Set(Dirty::DepthTest);
+    flags.Set(Dirty::VertexArray0, 32);
+    flags.Set(200);
+    REQUIRE(flags[Dirty::DepthTest]);
+    REQUIRE(flags[Dirty::VertexArray31]);
+    REQUIRE(!flags[Dirty::VertexInstances]);
+
+    // Only the flags of the mask are taken, the rest stays set
+    constexpr DirtyFlags mask{Dirty::DepthTest, Dirty::StencilTest, 200};
+    const DirtyFlags taken = flags.Take(mask);
+    REQUIRE(!flags[Dirty::DepthTest]);
+    REQUIRE(!flags[200]);
+    REQUIRE(flags[Dirty::VertexArray0]);
+    REQUIRE(!flags.Any(mask));
+    REQUIRE(flags.Any({Dirty::StencilTest, Dirty::VertexArray31}));
+
+    std::vector<u8> visited;
+    taken.ForEach([&visited](u8 flag) { visited.push_back(flag); });
+    REQUIRE(visited == std::vector<u8>{Dirty::DepthTest, 200});
+
+    REQUIRE(!flags.Take(mask).Any());
+}
+
+} // namespace VideoCommon
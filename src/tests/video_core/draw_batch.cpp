@@ -0,0 +1,108 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "video_core/renderer_opengl/gl_draw_batch.h"
+
+namespace OpenGL {
+
+namespace {
+
+DrawParameters MakeArraysDraw(GLint vertex_first, GLsizei count) {
+    DrawParameters params{};
+    params.primitive_mode = GL_TRIANGLES;
+    params.count = count;
+    params.vertex_first = vertex_first;
+    return params;
+}
+
+DrawParameters MakeElementsDraw(GLintptr index_buffer_offset, GLsizei count) {
+    DrawParameters params{};
+    params.primitive_mode = GL_TRIANGLES;
+    params.count = count;
+    params.use_indexed = true;
+    params.index_format = GL_UNSIGNED_SHORT;
+    params.index_buffer_offset = index_buffer_offset;
+    return params;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("DrawBatch: Break on incompatible draws", "[video_core]") {
+    DrawBatch batch;
+    REQUIRE(batch.IsEmpty());
+    REQUIRE(!batch.Append(MakeArraysDraw(0, 3), 0));
+
+    batch.Open(MakeArraysDraw(0, 3), 0, 0, 1);
+    REQUIRE(batch.Append(MakeArraysDraw(3, 6), 0));
+    REQUIRE(batch.GetNumDraws() == 2);
+
+    // Draws with a different topology, instance or kind of draw need their own setup
+    DrawParameters params = MakeArraysDraw(9, 3);
+    params.primitive_mode = GL_LINES;
+    REQUIRE(!batch.Append(params, 0));
+    params = MakeArraysDraw(9, 3);
+    params.current_instance = 1;
+    REQUIRE(!batch.Append(params, 0));
+    REQUIRE(!batch.Append(MakeElementsDraw(0, 3), 0));
+    REQUIRE(batch.GetNumDraws() == 2);
+
+    // Clearing keeps nothing of the previous batch
+    batch.Clear();
+    REQUIRE(batch.IsEmpty());
+    REQUIRE(batch.GetIndirectCommandsSize() == 0);
+}
+
+TEST_CASE("DrawBatch: Indexed draws use the indices of the batch", "[video_core]") {
+    DrawBatch batch;
+    batch.Open(MakeElementsDraw(0x1000, 60), 100, 300, 2);
+    REQUIRE(batch.CanMerge());
+
+    // Draws within the uploaded indices are pointed at them
+    REQUIRE(batch.Append(MakeElementsDraw(0x1000, 30), 160));
+    REQUIRE(batch.Append(MakeElementsDraw(0x1000, 40), 360));
+    REQUIRE(batch.GetNumDraws() == 3);
+
+    // Draws reaching outside of them need their indices uploaded
+    REQUIRE(!batch.Append(MakeElementsDraw(0x1000, 30), 99));
+    REQUIRE(!batch.Append(MakeElementsDraw(0x1000, 41), 360));
+    REQUIRE(batch.GetNumDraws() == 3);
+
+    REQUIRE(batch.GetIndirectCommandsSize() == 3 * sizeof(DrawElementsIndirectCommand));
+    std::vector<u8> buffer(batch.GetIndirectCommandsSize() + 1);
+    batch.WriteIndirectCommands(buffer.data() + 1);
+
+    std::vector<DrawElementsIndirectCommand> commands(3);
+    std::memcpy(commands.data(), buffer.data() + 1, buffer.size() - 1);
+    REQUIRE(commands[0].count == 60);
+    REQUIRE(commands[0].first_index == 0x1000 / 2);
+    REQUIRE(commands[1].count == 30);
+    REQUIRE(commands[1].first_index == 0x1000 / 2 + 60);
+    REQUIRE(commands[2].count == 40);
+    REQUIRE(commands[2].first_index == 0x1000 / 2 + 260);
+    REQUIRE(commands[2].instance_count == 1);
+}
+
+TEST_CASE("DrawBatch: Misaligned indices can't be merged", "[video_core]") {
+    DrawBatch batch;
+    batch.Open(MakeElementsDraw(0x1001, 3), 0, 3, 2);
+    REQUIRE(!batch.CanMerge());
+    batch.Clear();
+
+    // Non-indexed batches are always aligned
+    batch.Open(MakeArraysDraw(7, 3), 0, 0, 1);
+    REQUIRE(batch.CanMerge());
+    REQUIRE(batch.Append(MakeArraysDraw(10, 5), 0));
+
+    std::vector<DrawArraysIndirectCommand> commands(2);
+    REQUIRE(batch.GetIndirectCommandsSize() == sizeof(DrawArraysIndirectCommand) * 2);
+    batch.WriteIndirectCommands(reinterpret_cast<u8*>(commands.data()));
+    REQUIRE(commands[0].first == 7);
+    REQUIRE(commands[1].first == 10);
+    REQUIRE(commands[1].count == 5);
+}
+
+} // namespace OpenGL
@@ -0,0 +1,48 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <catch2/catch.hpp>
+#include "video_core/renderer_vulkan/fixed_pipeline_state.h"
+
+namespace Vulkan {
+
+TEST_CASE("FixedPipelineState: Hash and equality", "[video_core]") {
+    // The registers are too large for the stack
+    const auto regs = std::make_unique<Maxwell>();
+    const FixedPipelineState base = GetFixedPipelineState(*regs);
+    REQUIRE(GetFixedPipelineState(*regs) == base);
+    REQUIRE(GetFixedPipelineState(*regs).Hash() == base.Hash());
+
+    // State baked into the pipeline makes a different key
+    regs->depth_test_enable = 1;
+    regs->depth_test_func = Maxwell::ComparisonOp::Less;
+    const FixedPipelineState depth_test = GetFixedPipelineState(*regs);
+    REQUIRE(depth_test != base);
+    REQUIRE(depth_test.Hash() != base.Hash());
+    REQUIRE(depth_test.depth_stencil.depth_test_enable == 1);
+
+    // Dynamic state is left out of the key
+    regs->blend_color.r = 0.5f;
+    regs->stencil_front_func_ref = 0x80;
+    regs->viewport_transform[0].scale_x = 2.0f;
+    REQUIRE(GetFixedPipelineState(*regs) == depth_test);
+    REQUIRE(GetFixedPipelineState(*regs).Hash() == depth_test.Hash());
+
+    // Disabled state doesn't split keys
+    regs->depth_test_enable = 0;
+    regs->stencil_front_op_fail = Maxwell::StencilOp::Zero;
+    REQUIRE(GetFixedPipelineState(*regs) == base);
+
+    // Separate back face stencil state mirrors the front face when two sided stencil is off
+    regs->stencil_enable = 1;
+    regs->stencil_two_side_enable = 0;
+    regs->stencil_back_op_fail = Maxwell::StencilOp::Replace;
+    const FixedPipelineState one_sided = GetFixedPipelineState(*regs);
+    REQUIRE(one_sided.depth_stencil.back.action_stencil_fail == Maxwell::StencilOp::Zero);
+    regs->stencil_two_side_enable = 1;
+    REQUIRE(GetFixedPipelineState(*regs) != one_sided);
+}
+
+} // namespace Vulkan
@@ -0,0 +1,138 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/common_types.h"
+#include "video_core/tlsf_allocator.h"
+
+namespace VideoCommon {
+
+namespace {
+
+constexpr u64 DEVICE_ALLOCATION_SIZE = 4 * 1024 * 1024;
+
+/// Device handing out fixed size allocations, sub-allocated like the Vulkan memory manager does
+class FakeDevice {
+public:
+    struct Commit {
+        std::size_t allocation;
+        u64 offset;
+        u64 size;
+        TlsfAllocator::Handle handle;
+    };
+
+    Commit Allocate(u64 size, u64 alignment) {
+        for (std::size_t i = 0; i < allocations.size(); ++i) {
+            if (const auto commit = allocations[i]->Allocate(size, alignment)) {
+                return Track(i, size, *commit);
+            }
+        }
+        allocations.push_back(std::make_unique<TlsfAllocator>(DEVICE_ALLOCATION_SIZE));
+        const auto commit = allocations.back()->Allocate(size, alignment);
+        REQUIRE(commit);
+        return Track(allocations.size() - 1, size, *commit);
+    }
+
+    void Free(const Commit& commit) {
+        live[commit.allocation].erase(commit.offset);
+        allocations[commit.allocation]->Free(commit.handle);
+    }
+
+    std::size_t NumAllocations() const {
+        return allocations.size();
+    }
+
+    const TlsfAllocator& GetAllocation(std::size_t index) const {
+        return *allocations[index];
+    }
+
+private:
+    Commit Track(std::size_t allocation, u64 size, const TlsfAllocator::Allocation& commit) {
+        REQUIRE(commit.offset + size <= DEVICE_ALLOCATION_SIZE);
+
+        // The new commit must not overlap the live commits of its allocation
+        auto& commits = live[allocation];
+        const auto next = commits.lower_bound(commit.offset);
+        if (next != commits.end()) {
+            REQUIRE(commit.offset + size <= next->first);
+        }
+        if (next != commits.begin()) {
+            const auto prev = std::prev(next);
+            REQUIRE(prev->first + prev->second <= commit.offset);
+        }
+        commits.emplace(commit.offset, size);
+        return {allocation, commit.offset, size, commit.handle};
+    }
+
+    std::vector<std::unique_ptr<TlsfAllocator>> allocations;
+    std::map<std::size_t, std::map<u64, u64>> live;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("TlsfAllocator: Alignment and coalescing", "[video_core]") {
+    TlsfAllocator allocator(DEVICE_ALLOCATION_SIZE);
+
+    const auto small = allocator.Allocate(100, 4);
+    const auto large = allocator.Allocate(0x30000, 0x10000);
+    const auto aligned = allocator.Allocate(0x20, 0x4000);
+    REQUIRE(small);
+    REQUIRE(large);
+    REQUIRE(aligned);
+    REQUIRE(large->offset % 0x10000 == 0);
+    REQUIRE(aligned->offset % 0x4000 == 0);
+    REQUIRE(!allocator.Allocate(DEVICE_ALLOCATION_SIZE, 1));
+
+    allocator.Free(large->handle);
+    allocator.Free(small->handle);
+    allocator.Free(aligned->handle);
+    REQUIRE(allocator.IsEmpty());
+
+    // Freed blocks are merged back into a single block spanning the whole range
+    const auto stats = allocator.GetStats();
+    REQUIRE(stats.used_size == 0);
+    REQUIRE(stats.num_free_blocks == 1);
+    REQUIRE(stats.Fragmentation() == 0.0);
+
+    const auto whole = allocator.Allocate(DEVICE_ALLOCATION_SIZE, 1);
+    REQUIRE(whole);
+    REQUIRE(whole->offset == 0);
+}
+
+TEST_CASE("TlsfAllocator: Stress against a fake device", "[video_core]") {
+    FakeDevice device;
+    std::vector<FakeDevice::Commit> commits;
+    std::mt19937 random(1234);
+
+    for (int iteration = 0; iteration < 20000; ++iteration) {
+        if (!commits.empty() && random() % 5 < 2) {
+            const std::size_t index = random() % commits.size();
+            device.Free(commits[index]);
+            commits[index] = commits.back();
+            commits.pop_back();
+            continue;
+        }
+        // Mostly small buffers with some large images, like texture streaming does
+        const u64 size = random() % 4 != 0 ? 1 + random() % 0x2000 : 0x4000 + random() % 0x80000;
+        const u64 alignment = u64{1} << (random() % 13);
+        const auto commit = device.Allocate(size, alignment);
+        REQUIRE(commit.offset % alignment == 0);
+        commits.push_back(commit);
+    }
+
+    for (const auto& commit : commits) {
+        device.Free(commit);
+    }
+    for (std::size_t i = 0; i < device.NumAllocations(); ++i) {
+        const auto& allocation = device.GetAllocation(i);
+        REQUIRE(allocation.IsEmpty());
+        REQUIRE(allocation.GetStats().largest_free_block == DEVICE_ALLOCATION_SIZE);
+    }
+}
+
+} // namespace VideoCommon
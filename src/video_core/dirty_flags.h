@@ -0,0 +1,139 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include "common/bit_util.h"
+#include "common/common_types.h"
+
+namespace VideoCommon {
+
+namespace Dirty {
+
+/// State groups tracked for every rasterizer. Entries past LastCommonEntry are free for backends.
+enum : u8 {
+    NullEntry = 0,
+
+    VertexAttribFormat,
+    VertexArrays,
+    VertexArray0,
+    VertexArray31 = VertexArray0 + 31,
+    VertexInstances,
+    VertexInstance0,
+    VertexInstance31 = VertexInstance0 + 31,
+
+    RenderSettings,
+    RenderTarget0,
+    RenderTarget7 = RenderTarget0 + 7,
+    DepthBuffer,
+
+    Shaders,
+
+    Viewport,
+    ClipCoefficient,
+    CullMode,
+    PrimitiveRestart,
+    DepthTest,
+    StencilTest,
+    BlendState,
+    ScissorTest,
+    TransformFeedback,
+    ColorMask,
+    PolygonOffset,
+    ViewportTransform,
+    ScreenYControl,
+
+    MemoryGeneral,
+
+    /// Any register besides the draw parameters, set when a draw can not join the previous batch
+    DrawState,
+
+    LastCommonEntry,
+};
+
+} // namespace Dirty
+
+/// Set of dirty state groups, iterable in the order of the groups that are set
+class DirtyFlags {
+public:
+    static constexpr std::size_t NUM_FLAGS = 256;
+
+    constexpr DirtyFlags() = default;
+
+    constexpr DirtyFlags(std::initializer_list<u8> flags) {
+        for (const u8 flag : flags) {
+            Set(flag);
+        }
+    }
+
+    constexpr bool operator[](std::size_t flag) const {
+        return (words[flag / 64] >> (flag % 64)) & 1;
+    }
+
+    constexpr void Set(std::size_t flag) {
+        words[flag / 64] |= u64{1} << (flag % 64);
+    }
+
+    /// Sets count consecutive flags starting at first
+    void Set(std::size_t first, std::size_t count) {
+        for (std::size_t flag = first; flag < first + count; ++flag) {
+            Set(flag);
+        }
+    }
+
+    void Reset(std::size_t flag) {
+        words[flag / 64] &= ~(u64{1} << (flag % 64));
+    }
+
+    void SetAll() {
+        words.fill(~u64{0});
+    }
+
+    bool Any() const {
+        for (const u64 word : words) {
+            if (word != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Returns true when any of the flags in mask is set
+    bool Any(const DirtyFlags& mask) const {
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            if ((words[i] & mask.words[i]) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Returns the flags set both here and in mask, and resets them here
+    DirtyFlags Take(const DirtyFlags& mask) {
+        DirtyFlags taken;
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            taken.words[i] = words[i] & mask.words[i];
+            words[i] &= ~mask.words[i];
+        }
+        return taken;
+    }
+
+    /// Calls func with the index of every flag that is set, in ascending order
+    template <typename Func>
+    void ForEach(Func&& func) const {
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            for (u64 word = words[i]; word != 0; word &= word - 1) {
+                func(static_cast<u8>(i * 64 + Common::CountTrailingZeroes64(word)));
+            }
+        }
+    }
+
+private:
+    std::array<u64, NUM_FLAGS / 64> words{};
+};
+
+} // namespace VideoCommon
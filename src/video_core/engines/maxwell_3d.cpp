@@ -91,157 +91,166 @@ void Maxwell3D::InitializeRegisterDefaults() {
     regs.rt_separate_frag_data = 1;
 }
 
-#define DIRTY_REGS_POS(field_name) (offsetof(Maxwell3D::DirtyRegs, field_name))
-
 void Maxwell3D::InitDirtySettings() {
-    const auto set_block = [this](const u32 start, const u32 range, const u8 position) {
-        const auto start_itr = dirty_pointers.begin() + start;
-        const auto end_itr = start_itr + range;
-        std::fill(start_itr, end_itr, position);
+    namespace Dirty = VideoCommon::Dirty;
+
+    auto& table = dirty.tables[0];
+    auto& secondary_table = dirty.tables[1];
+    auto& draw_table = dirty.tables[2];
+    const auto set_block = [](DirtyState::Table& table, u32 start, u32 range, u8 flag) {
+        std::fill_n(table.begin() + start, range, flag);
     };
-    dirty.regs.fill(true);
+    dirty.flags.SetAll();
 
-    // Init Render Targets
+    // Init Render Targets, changes to any of them also change the framebuffer configuration
     constexpr u32 registers_per_rt = sizeof(regs.rt[0]) / sizeof(u32);
-    constexpr u32 rt_start_reg = MAXWELL3D_REG_INDEX(rt);
-    constexpr u32 rt_end_reg = rt_start_reg + registers_per_rt * 8;
-    u32 rt_dirty_reg = DIRTY_REGS_POS(render_target);
-    for (u32 rt_reg = rt_start_reg; rt_reg < rt_end_reg; rt_reg += registers_per_rt) {
-        set_block(rt_reg, registers_per_rt, rt_dirty_reg);
-        rt_dirty_reg++;
-    }
-    constexpr u32 depth_buffer_flag = DIRTY_REGS_POS(depth_buffer);
-    dirty_pointers[MAXWELL3D_REG_INDEX(zeta_enable)] = depth_buffer_flag;
-    dirty_pointers[MAXWELL3D_REG_INDEX(zeta_width)] = depth_buffer_flag;
-    dirty_pointers[MAXWELL3D_REG_INDEX(zeta_height)] = depth_buffer_flag;
+    for (u32 rt = 0; rt < Regs::NumRenderTargets; ++rt) {
+        const u32 rt_reg = MAXWELL3D_REG_INDEX(rt) + rt * registers_per_rt;
+        set_block(table, rt_reg, registers_per_rt, static_cast<u8>(Dirty::RenderTarget0 + rt));
+        set_block(secondary_table, rt_reg, registers_per_rt, Dirty::RenderSettings);
+    }
+    for (const u32 reg : {MAXWELL3D_REG_INDEX(zeta_enable), MAXWELL3D_REG_INDEX(zeta_width),
+                          MAXWELL3D_REG_INDEX(zeta_height)}) {
+        table[reg] = Dirty::DepthBuffer;
+        secondary_table[reg] = Dirty::RenderSettings;
+    }
     constexpr u32 registers_in_zeta = sizeof(regs.zeta) / sizeof(u32);
-    constexpr u32 zeta_reg = MAXWELL3D_REG_INDEX(zeta);
-    set_block(zeta_reg, registers_in_zeta, depth_buffer_flag);
+    set_block(table, MAXWELL3D_REG_INDEX(zeta), registers_in_zeta, Dirty::DepthBuffer);
+    set_block(secondary_table, MAXWELL3D_REG_INDEX(zeta), registers_in_zeta,
+              Dirty::RenderSettings);
 
     // Init Vertex Arrays
-    constexpr u32 vertex_array_start = MAXWELL3D_REG_INDEX(vertex_array);
     constexpr u32 vertex_array_size = sizeof(regs.vertex_array[0]) / sizeof(u32);
-    constexpr u32 vertex_array_end = vertex_array_start + vertex_array_size * Regs::NumVertexArrays;
-    u32 va_reg = DIRTY_REGS_POS(vertex_array);
-    u32 vi_reg = DIRTY_REGS_POS(vertex_instance);
-    for (u32 vertex_reg = vertex_array_start; vertex_reg < vertex_array_end;
-         vertex_reg += vertex_array_size) {
-        set_block(vertex_reg, 3, va_reg);
-        // The divisor concerns vertex array instances
-        dirty_pointers[vertex_reg + 3] = vi_reg;
-        va_reg++;
-        vi_reg++;
-    }
-    constexpr u32 vertex_limit_start = MAXWELL3D_REG_INDEX(vertex_array_limit);
     constexpr u32 vertex_limit_size = sizeof(regs.vertex_array_limit[0]) / sizeof(u32);
-    constexpr u32 vertex_limit_end = vertex_limit_start + vertex_limit_size * Regs::NumVertexArrays;
-    va_reg = DIRTY_REGS_POS(vertex_array);
-    for (u32 vertex_reg = vertex_limit_start; vertex_reg < vertex_limit_end;
-         vertex_reg += vertex_limit_size) {
-        set_block(vertex_reg, vertex_limit_size, va_reg);
-        va_reg++;
-    }
-    constexpr u32 vertex_instance_start = MAXWELL3D_REG_INDEX(instanced_arrays);
     constexpr u32 vertex_instance_size =
         sizeof(regs.instanced_arrays.is_instanced[0]) / sizeof(u32);
-    constexpr u32 vertex_instance_end =
-        vertex_instance_start + vertex_instance_size * Regs::NumVertexArrays;
-    vi_reg = DIRTY_REGS_POS(vertex_instance);
-    for (u32 vertex_reg = vertex_instance_start; vertex_reg < vertex_instance_end;
-         vertex_reg += vertex_instance_size) {
-        set_block(vertex_reg, vertex_instance_size, vi_reg);
-        vi_reg++;
+    for (u32 index = 0; index < Regs::NumVertexArrays; ++index) {
+        const auto va_flag = static_cast<u8>(Dirty::VertexArray0 + index);
+        const auto vi_flag = static_cast<u8>(Dirty::VertexInstance0 + index);
+
+        const u32 vertex_reg = MAXWELL3D_REG_INDEX(vertex_array) + index * vertex_array_size;
+        set_block(table, vertex_reg, 3, va_flag);
+        set_block(secondary_table, vertex_reg, 3, Dirty::VertexArrays);
+        // The divisor concerns vertex array instances
+        table[vertex_reg + 3] = vi_flag;
+        secondary_table[vertex_reg + 3] = Dirty::VertexInstances;
+
+        const u32 limit_reg = MAXWELL3D_REG_INDEX(vertex_array_limit) + index * vertex_limit_size;
+        set_block(table, limit_reg, vertex_limit_size, va_flag);
+        set_block(secondary_table, limit_reg, vertex_limit_size, Dirty::VertexArrays);
+
+        const u32 instance_reg =
+            MAXWELL3D_REG_INDEX(instanced_arrays) + index * vertex_instance_size;
+        set_block(table, instance_reg, vertex_instance_size, vi_flag);
+        set_block(secondary_table, instance_reg, vertex_instance_size, Dirty::VertexInstances);
     }
-    set_block(MAXWELL3D_REG_INDEX(vertex_attrib_format), regs.vertex_attrib_format.size(),
-              DIRTY_REGS_POS(vertex_attrib_format));
+    set_block(table, MAXWELL3D_REG_INDEX(vertex_attrib_format),
+              static_cast<u32>(regs.vertex_attrib_format.size()), Dirty::VertexAttribFormat);
 
     // Init Shaders
     constexpr u32 shader_registers_count =
         sizeof(regs.shader_config[0]) * Regs::MaxShaderProgram / sizeof(u32);
-    set_block(MAXWELL3D_REG_INDEX(shader_config[0]), shader_registers_count,
-              DIRTY_REGS_POS(shaders));
+    set_block(table, MAXWELL3D_REG_INDEX(shader_config[0]), shader_registers_count,
+              Dirty::Shaders);
 
     // State
 
     // Viewport
-    constexpr u32 viewport_dirty_reg = DIRTY_REGS_POS(viewport);
-    constexpr u32 viewport_start = MAXWELL3D_REG_INDEX(viewports);
-    constexpr u32 viewport_size = sizeof(regs.viewports) / sizeof(u32);
-    set_block(viewport_start, viewport_size, viewport_dirty_reg);
-    constexpr u32 view_volume_start = MAXWELL3D_REG_INDEX(view_volume_clip_control);
-    constexpr u32 view_volume_size = sizeof(regs.view_volume_clip_control) / sizeof(u32);
-    set_block(view_volume_start, view_volume_size, viewport_dirty_reg);
-
-    // Viewport transformation
+    set_block(table, MAXWELL3D_REG_INDEX(viewports), sizeof(regs.viewports) / sizeof(u32),
+              Dirty::Viewport);
+    set_block(table, MAXWELL3D_REG_INDEX(view_volume_clip_control),
+              sizeof(regs.view_volume_clip_control) / sizeof(u32), Dirty::Viewport);
+
+    // Viewport transformation, the sign of the first Y scale also decides the front face
     constexpr u32 viewport_trans_start = MAXWELL3D_REG_INDEX(viewport_transform);
     constexpr u32 viewport_trans_size = sizeof(regs.viewport_transform) / sizeof(u32);
-    set_block(viewport_trans_start, viewport_trans_size, DIRTY_REGS_POS(viewport_transform));
+    set_block(table, viewport_trans_start, viewport_trans_size, Dirty::ViewportTransform);
+    set_block(secondary_table, viewport_trans_start, viewport_trans_size, Dirty::CullMode);
 
     // Cullmode
-    constexpr u32 cull_mode_start = MAXWELL3D_REG_INDEX(cull);
-    constexpr u32 cull_mode_size = sizeof(regs.cull) / sizeof(u32);
-    set_block(cull_mode_start, cull_mode_size, DIRTY_REGS_POS(cull_mode));
+    set_block(table, MAXWELL3D_REG_INDEX(cull), sizeof(regs.cull) / sizeof(u32),
+              Dirty::CullMode);
 
     // Screen y control
-    dirty_pointers[MAXWELL3D_REG_INDEX(screen_y_control)] = DIRTY_REGS_POS(screen_y_control);
+    table[MAXWELL3D_REG_INDEX(screen_y_control)] = Dirty::ScreenYControl;
+    secondary_table[MAXWELL3D_REG_INDEX(screen_y_control)] = Dirty::CullMode;
 
     // Primitive Restart
-    constexpr u32 primitive_restart_start = MAXWELL3D_REG_INDEX(primitive_restart);
-    constexpr u32 primitive_restart_size = sizeof(regs.primitive_restart) / sizeof(u32);
-    set_block(primitive_restart_start, primitive_restart_size, DIRTY_REGS_POS(primitive_restart));
+    set_block(table, MAXWELL3D_REG_INDEX(primitive_restart),
+              sizeof(regs.primitive_restart) / sizeof(u32), Dirty::PrimitiveRestart);
 
     // Depth Test
-    constexpr u32 depth_test_dirty_reg = DIRTY_REGS_POS(depth_test);
-    dirty_pointers[MAXWELL3D_REG_INDEX(depth_test_enable)] = depth_test_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(depth_write_enabled)] = depth_test_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(depth_test_func)] = depth_test_dirty_reg;
+    table[MAXWELL3D_REG_INDEX(depth_test_enable)] = Dirty::DepthTest;
+    table[MAXWELL3D_REG_INDEX(depth_write_enabled)] = Dirty::DepthTest;
+    table[MAXWELL3D_REG_INDEX(depth_test_func)] = Dirty::DepthTest;
 
     // Stencil Test
-    constexpr u32 stencil_test_dirty_reg = DIRTY_REGS_POS(stencil_test);
-    dirty_pointers[MAXWELL3D_REG_INDEX(stencil_enable)] = stencil_test_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(stencil_front_func_func)] = stencil_test_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(stencil_front_func_ref)] = stencil_test_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(stencil_front_func_mask)] = stencil_test_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(stencil_front_op_fail)] = stencil_test_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(stencil_front_op_zfail)] = stencil_test_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(stencil_front_op_zpass)] = stencil_test_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(stencil_front_mask)] = stencil_test_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(stencil_two_side_enable)] = stencil_test_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(stencil_back_func_func)] = stencil_test_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(stencil_back_func_ref)] = stencil_test_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(stencil_back_func_mask)] = stencil_test_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(stencil_back_op_fail)] = stencil_test_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(stencil_back_op_zfail)] = stencil_test_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(stencil_back_op_zpass)] = stencil_test_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(stencil_back_mask)] = stencil_test_dirty_reg;
-
-    // Color Mask
-    constexpr u32 color_mask_dirty_reg = DIRTY_REGS_POS(color_mask);
-    dirty_pointers[MAXWELL3D_REG_INDEX(color_mask_common)] = color_mask_dirty_reg;
-    set_block(MAXWELL3D_REG_INDEX(color_mask), sizeof(regs.color_mask) / sizeof(u32),
-              color_mask_dirty_reg);
+    for (const u32 reg : {
+             MAXWELL3D_REG_INDEX(stencil_enable),
+             MAXWELL3D_REG_INDEX(stencil_front_func_func),
+             MAXWELL3D_REG_INDEX(stencil_front_func_ref),
+             MAXWELL3D_REG_INDEX(stencil_front_func_mask),
+             MAXWELL3D_REG_INDEX(stencil_front_op_fail),
+             MAXWELL3D_REG_INDEX(stencil_front_op_zfail),
+             MAXWELL3D_REG_INDEX(stencil_front_op_zpass),
+             MAXWELL3D_REG_INDEX(stencil_front_mask),
+             MAXWELL3D_REG_INDEX(stencil_two_side_enable),
+             MAXWELL3D_REG_INDEX(stencil_back_func_func),
+             MAXWELL3D_REG_INDEX(stencil_back_func_ref),
+             MAXWELL3D_REG_INDEX(stencil_back_func_mask),
+             MAXWELL3D_REG_INDEX(stencil_back_op_fail),
+             MAXWELL3D_REG_INDEX(stencil_back_op_zfail),
+             MAXWELL3D_REG_INDEX(stencil_back_op_zpass),
+             MAXWELL3D_REG_INDEX(stencil_back_mask),
+         }) {
+        table[reg] = Dirty::StencilTest;
+    }
+
+    // Color Mask, independent blending decides whether the first mask applies to all targets
+    table[MAXWELL3D_REG_INDEX(color_mask_common)] = Dirty::ColorMask;
+    set_block(table, MAXWELL3D_REG_INDEX(color_mask), sizeof(regs.color_mask) / sizeof(u32),
+              Dirty::ColorMask);
+    secondary_table[MAXWELL3D_REG_INDEX(independent_blend_enable)] = Dirty::ColorMask;
+
     // Blend State
-    constexpr u32 blend_state_dirty_reg = DIRTY_REGS_POS(blend_state);
-    set_block(MAXWELL3D_REG_INDEX(blend_color), sizeof(regs.blend_color) / sizeof(u32),
-              blend_state_dirty_reg);
-    dirty_pointers[MAXWELL3D_REG_INDEX(independent_blend_enable)] = blend_state_dirty_reg;
-    set_block(MAXWELL3D_REG_INDEX(blend), sizeof(regs.blend) / sizeof(u32), blend_state_dirty_reg);
-    set_block(MAXWELL3D_REG_INDEX(independent_blend), sizeof(regs.independent_blend) / sizeof(u32),
-              blend_state_dirty_reg);
+    set_block(table, MAXWELL3D_REG_INDEX(blend_color), sizeof(regs.blend_color) / sizeof(u32),
+              Dirty::BlendState);
+    table[MAXWELL3D_REG_INDEX(independent_blend_enable)] = Dirty::BlendState;
+    set_block(table, MAXWELL3D_REG_INDEX(blend), sizeof(regs.blend) / sizeof(u32),
+              Dirty::BlendState);
+    set_block(table, MAXWELL3D_REG_INDEX(independent_blend),
+              sizeof(regs.independent_blend) / sizeof(u32), Dirty::BlendState);
 
     // Scissor State
-    constexpr u32 scissor_test_dirty_reg = DIRTY_REGS_POS(scissor_test);
-    set_block(MAXWELL3D_REG_INDEX(scissor_test), sizeof(regs.scissor_test) / sizeof(u32),
-              scissor_test_dirty_reg);
+    set_block(table, MAXWELL3D_REG_INDEX(scissor_test), sizeof(regs.scissor_test) / sizeof(u32),
+              Dirty::ScissorTest);
 
     // Polygon Offset
-    constexpr u32 polygon_offset_dirty_reg = DIRTY_REGS_POS(polygon_offset);
-    dirty_pointers[MAXWELL3D_REG_INDEX(polygon_offset_fill_enable)] = polygon_offset_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(polygon_offset_line_enable)] = polygon_offset_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(polygon_offset_point_enable)] = polygon_offset_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(polygon_offset_units)] = polygon_offset_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(polygon_offset_factor)] = polygon_offset_dirty_reg;
-    dirty_pointers[MAXWELL3D_REG_INDEX(polygon_offset_clamp)] = polygon_offset_dirty_reg;
+    for (const u32 reg : {
+             MAXWELL3D_REG_INDEX(polygon_offset_fill_enable),
+             MAXWELL3D_REG_INDEX(polygon_offset_line_enable),
+             MAXWELL3D_REG_INDEX(polygon_offset_point_enable),
+             MAXWELL3D_REG_INDEX(polygon_offset_units),
+             MAXWELL3D_REG_INDEX(polygon_offset_factor),
+             MAXWELL3D_REG_INDEX(polygon_offset_clamp),
+         }) {
+        table[reg] = Dirty::PolygonOffset;
+    }
+
+    // Draw State, every register except the parameters of a single draw may change what the
+    // following draws render and keeps them out of the batch of the previous draw
+    draw_table.fill(Dirty::DrawState);
+    for (const u32 reg : {
+             MAXWELL3D_REG_INDEX(vertex_buffer.first),
+             MAXWELL3D_REG_INDEX(vertex_buffer.count),
+             MAXWELL3D_REG_INDEX(index_array.first),
+             MAXWELL3D_REG_INDEX(index_array.count),
+             MAXWELL3D_REG_INDEX(vb_element_base),
+             MAXWELL3D_REG_INDEX(draw.vertex_end_gl),
+             MAXWELL3D_REG_INDEX(draw.vertex_begin_gl),
+         }) {
+        draw_table[reg] = Dirty::NullEntry;
+    }
 }
 
 void Maxwell3D::CallMacroMethod(u32 method, std::vector<u32> parameters) {
@@ -303,19 +312,8 @@ void Maxwell3D::CallMethod(const GPU::MethodCall& method_call) {
 
     if (regs.reg_array[method] != method_call.argument) {
         regs.reg_array[method] = method_call.argument;
-        const std::size_t dirty_reg = dirty_pointers[method];
-        if (dirty_reg) {
-            dirty.regs[dirty_reg] = true;
-            if (dirty_reg >= DIRTY_REGS_POS(vertex_array) &&
-                dirty_reg < DIRTY_REGS_POS(vertex_array_buffers)) {
-                dirty.vertex_array_buffers = true;
-            } else if (dirty_reg >= DIRTY_REGS_POS(vertex_instance) &&
-                       dirty_reg < DIRTY_REGS_POS(vertex_instances)) {
-                dirty.vertex_instances = true;
-            } else if (dirty_reg >= DIRTY_REGS_POS(render_target) &&
-                       dirty_reg < DIRTY_REGS_POS(render_settings)) {
-                dirty.render_settings = true;
-            }
+        for (const auto& table : dirty.tables) {
+            dirty.flags.Set(table[method]);
         }
     }
 
@@ -15,6 +15,7 @@
 #include "common/common_funcs.h"
 #include "common/common_types.h"
 #include "common/math_util.h"
+#include "video_core/dirty_flags.h"
 #include "video_core/engines/const_buffer_info.h"
 #include "video_core/engines/engine_upload.h"
 #include "video_core/gpu.h"
@@ -1157,77 +1158,36 @@ public:
 
     State state{};
 
-    struct DirtyRegs {
-        static constexpr std::size_t NUM_REGS = 256;
-        union {
-            struct {
-                bool null_dirty;
-
-                // Vertex Attributes
-                bool vertex_attrib_format;
-
-                // Vertex Arrays
-                std::array<bool, 32> vertex_array;
-
-                bool vertex_array_buffers;
-
-                // Vertex Instances
-                std::array<bool, 32> vertex_instance;
-
-                bool vertex_instances;
-
-                // Render Targets
-                std::array<bool, 8> render_target;
-                bool depth_buffer;
-
-                bool render_settings;
-
-                // Shaders
-                bool shaders;
-
-                // Rasterizer State
-                bool viewport;
-                bool clip_coefficient;
-                bool cull_mode;
-                bool primitive_restart;
-                bool depth_test;
-                bool stencil_test;
-                bool blend_state;
-                bool scissor_test;
-                bool transform_feedback;
-                bool color_mask;
-                bool polygon_offset;
+    /**
+     * Tracks the state groups changed since the rasterizer last synchronized them. Every register
+     * write that changes a value sets the group of the register in each table, so a register can
+     * belong to one group per table. Group 0 is a sink for registers without a group.
+     */
+    struct DirtyState {
+        using Table = std::array<u8, Regs::NUM_REGS>;
 
-                // Complementary
-                bool viewport_transform;
-                bool screen_y_control;
-
-                bool memory_general;
-            };
-            std::array<bool, NUM_REGS> regs;
-        };
+        VideoCommon::DirtyFlags flags;
+        std::array<Table, 3> tables{};
 
         void ResetVertexArrays() {
-            vertex_array.fill(true);
-            vertex_array_buffers = true;
+            flags.Set(VideoCommon::Dirty::VertexArray0, Regs::NumVertexArrays);
+            flags.Set(VideoCommon::Dirty::VertexArrays);
         }
 
         void ResetRenderTargets() {
-            depth_buffer = true;
-            render_target.fill(true);
-            render_settings = true;
+            flags.Set(VideoCommon::Dirty::DepthBuffer);
+            flags.Set(VideoCommon::Dirty::RenderTarget0, Regs::NumRenderTargets);
+            flags.Set(VideoCommon::Dirty::RenderSettings);
         }
 
         void OnMemoryWrite() {
-            shaders = true;
-            memory_general = true;
+            flags.Set(VideoCommon::Dirty::Shaders);
+            flags.Set(VideoCommon::Dirty::MemoryGeneral);
+            flags.Set(VideoCommon::Dirty::DrawState);
             ResetRenderTargets();
             ResetVertexArrays();
         }
-
-    } dirty{};
-
-    std::array<u8, Regs::NUM_REGS> dirty_pointers{};
+    } dirty;
 
     /// Reads a register value located at the input method address
     u32 GetRegisterValue(u32 method) const;
@@ -251,6 +251,12 @@ public:
     /// Swap buffers (render frame)
     virtual void SwapBuffers(const Tegra::FramebufferConfig* framebuffer) = 0;
 
+    /// Returns true if the last requested swap has not been presented by the renderer yet
+    virtual bool IsSwapPending() const = 0;
+
+    /// Waits until the last requested swap has been presented by the renderer
+    virtual void WaitForSwap() = 0;
+
     /// Notify rasterizer that any caches of the specified region should be flushed to Switch memory
     virtual void FlushRegion(CacheAddr addr, u64 size) = 0;
 
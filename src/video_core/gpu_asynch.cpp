@@ -27,6 +27,14 @@ void GPUAsynch::SwapBuffers(const Tegra::FramebufferConfig* framebuffer) {
     gpu_thread.SwapBuffers(framebuffer);
 }
 
+bool GPUAsynch::IsSwapPending() const {
+    return gpu_thread.IsSwapPending();
+}
+
+void GPUAsynch::WaitForSwap() {
+    gpu_thread.WaitForSwap();
+}
+
 void GPUAsynch::FlushRegion(CacheAddr addr, u64 size) {
     gpu_thread.FlushRegion(addr, size);
 }
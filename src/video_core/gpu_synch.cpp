@@ -2,6 +2,8 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include "core/core.h"
+#include "core/perf_stats.h"
 #include "video_core/gpu_synch.h"
 #include "video_core/renderer_base.h"
 
@@ -15,6 +17,7 @@ GPUSynch::~GPUSynch() = default;
 void GPUSynch::Start() {}
 
 void GPUSynch::PushGPUEntries(Tegra::CommandList&& entries) {
+    Core::PerfStats::ScopedTimer timer{system.GetPerfStats(), Core::PerfSubsystem::GpuThread};
     dma_pusher->Push(std::move(entries));
     dma_pusher->DispatchCalls();
 }
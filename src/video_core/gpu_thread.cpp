@@ -8,6 +8,7 @@
 #include "core/core_timing.h"
 #include "core/core_timing_util.h"
 #include "core/frontend/scope_acquire_window_context.h"
+#include "core/perf_stats.h"
 #include "video_core/dma_pusher.h"
 #include "video_core/gpu.h"
 #include "video_core/gpu_thread.h"
@@ -17,7 +18,7 @@ namespace VideoCommon::GPUThread {
 
 /// Runs the GPU thread
 static void RunThread(VideoCore::RendererBase& renderer, Tegra::DmaPusher& dma_pusher,
-                      SynchState& state) {
+                      SynchState& state, Core::PerfStats& perf_stats) {
     MicroProfileOnThreadCreate("GpuThread");
 
     // Wait for first GPU command before acquiring the window context
@@ -35,6 +36,7 @@ static void RunThread(VideoCore::RendererBase& renderer, Tegra::DmaPusher& dma_p
     while (state.is_running) {
         while (!state.queue.Empty()) {
             state.queue.Pop(next);
+            Core::PerfStats::ScopedTimer timer{perf_stats, Core::PerfSubsystem::GpuThread};
             if (const auto submit_list = std::get_if<SubmitListCommand>(&next.data)) {
                 dma_pusher.Push(std::move(submit_list->entries));
                 dma_pusher.DispatchCalls();
@@ -67,7 +69,8 @@ ThreadManager::~ThreadManager() {
 }
 
 void ThreadManager::StartThread(VideoCore::RendererBase& renderer, Tegra::DmaPusher& dma_pusher) {
-    thread = std::thread{RunThread, std::ref(renderer), std::ref(dma_pusher), std::ref(state)};
+    thread = std::thread{RunThread, std::ref(renderer), std::ref(dma_pusher), std::ref(state),
+                         std::ref(system.GetPerfStats())};
     synchronization_event = system.CoreTiming().RegisterEvent(
         "GPUThreadSynch", [this](u64 fence, s64) { state.WaitForSynchronization(fence); });
 }
@@ -79,8 +82,16 @@ void ThreadManager::SubmitList(Tegra::CommandList&& entries) {
 }
 
 void ThreadManager::SwapBuffers(const Tegra::FramebufferConfig* framebuffer) {
-    PushCommand(SwapBuffersCommand(framebuffer ? *framebuffer
-                                               : std::optional<const Tegra::FramebufferConfig>{}));
+    last_swap_fence = PushCommand(SwapBuffersCommand(
+        framebuffer ? *framebuffer : std::optional<const Tegra::FramebufferConfig>{}));
+}
+
+bool ThreadManager::IsSwapPending() const {
+    return state.signaled_fence.load() < last_swap_fence;
+}
+
+void ThreadManager::WaitForSwap() {
+    state.WaitForSynchronization(last_swap_fence);
 }
 
 void ThreadManager::FlushRegion(CacheAddr addr, u64 size) {
@@ -104,6 +115,7 @@ u64 ThreadManager::PushCommand(CommandData&& command_data) {
 
 MICROPROFILE_DEFINE(GPU_wait, "GPU", "Wait for the GPU", MP_RGB(128, 128, 192));
 void SynchState::WaitForSynchronization(u64 fence) {
+    MICROPROFILE_SCOPE(GPU_wait);
     while (signaled_fence.load() < fence)
         ;
 }
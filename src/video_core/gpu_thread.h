@@ -112,6 +112,12 @@ public:
     /// Swap buffers (render frame)
     void SwapBuffers(const Tegra::FramebufferConfig* framebuffer);
 
+    /// Returns true if the GPU thread has not processed the last swap buffers command yet
+    bool IsSwapPending() const;
+
+    /// Waits until the GPU thread has processed the last swap buffers command
+    void WaitForSwap();
+
     /// Notify rasterizer that any caches of the specified region should be flushed to Switch memory
     void FlushRegion(CacheAddr addr, u64 size);
 
@@ -131,6 +137,9 @@ private:
     Core::Timing::EventType* synchronization_event{};
     std::thread thread;
     std::thread::id thread_id;
+
+    /// Fence of the last swap buffers command pushed to the GPU thread
+    u64 last_swap_fence{};
 };
 
 } // namespace VideoCommon::GPUThread
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <cstring>
 #include <memory>
 
 #include <glad/glad.h>
@@ -26,9 +27,10 @@ CachedBufferBlock::CachedBufferBlock(CacheAddr cache_addr, const std::size_t siz
 CachedBufferBlock::~CachedBufferBlock() = default;
 
 OGLBufferCache::OGLBufferCache(RasterizerOpenGL& rasterizer, Core::System& system,
-                               std::size_t stream_size)
+                               std::size_t stream_size, OGLStreamBuffer& upload_buffer)
     : VideoCommon::BufferCache<Buffer, GLuint, OGLStreamBuffer>{
-          rasterizer, system, std::make_unique<OGLStreamBuffer>(stream_size, true)} {}
+          rasterizer, system, std::make_unique<OGLStreamBuffer>(stream_size, true)},
+      upload_buffer{upload_buffer} {}
 
 OGLBufferCache::~OGLBufferCache() = default;
 
@@ -51,8 +53,18 @@ const GLuint* OGLBufferCache::GetEmptyBuffer(std::size_t) {
 
 void OGLBufferCache::UploadBlockData(const Buffer& buffer, std::size_t offset, std::size_t size,
                                      const u8* data) {
-    glNamedBufferSubData(*buffer->GetHandle(), static_cast<GLintptr>(offset),
-                         static_cast<GLsizeiptr>(size), data);
+    const auto upload_size = static_cast<GLsizeiptr>(size);
+    if (upload_size > upload_buffer.GetSize()) {
+        glNamedBufferSubData(*buffer->GetHandle(), static_cast<GLintptr>(offset), upload_size,
+                             data);
+        return;
+    }
+
+    const auto [pointer, upload_offset, invalidated] = upload_buffer.Map(upload_size, 4);
+    std::memcpy(pointer, data, size);
+    upload_buffer.Unmap(upload_size);
+    glCopyNamedBufferSubData(upload_buffer.GetHandle(), *buffer->GetHandle(), upload_offset,
+                             static_cast<GLintptr>(offset), upload_size);
 }
 
 void OGLBufferCache::DownloadBlockData(const Buffer& buffer, std::size_t offset, std::size_t size,
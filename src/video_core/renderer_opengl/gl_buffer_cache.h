@@ -41,7 +41,7 @@ private:
 class OGLBufferCache final : public VideoCommon::BufferCache<Buffer, GLuint, OGLStreamBuffer> {
 public:
     explicit OGLBufferCache(RasterizerOpenGL& rasterizer, Core::System& system,
-                            std::size_t stream_size);
+                            std::size_t stream_size, OGLStreamBuffer& upload_buffer);
     ~OGLBufferCache();
 
     const GLuint* GetEmptyBuffer(std::size_t) override;
@@ -61,6 +61,10 @@ protected:
 
     void CopyBlock(const Buffer& src, const Buffer& dst, std::size_t src_offset,
                    std::size_t dst_offset, std::size_t size) override;
+
+private:
+    /// Ring staging the uploads to cached blocks, the stream buffer is reserved during draws
+    OGLStreamBuffer& upload_buffer;
 };
 
 } // namespace OpenGL
@@ -0,0 +1,99 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include "common/assert.h"
+#include "video_core/renderer_opengl/gl_draw_batch.h"
+
+namespace OpenGL {
+
+void DrawParameters::DispatchDraw() const {
+    if (use_indexed) {
+        const auto index_buffer_ptr = reinterpret_cast<const void*>(index_buffer_offset);
+        if (current_instance > 0) {
+            glDrawElementsInstancedBaseVertexBaseInstance(primitive_mode, count, index_format,
+                                                          index_buffer_ptr, 1, base_vertex,
+                                                          current_instance);
+        } else {
+            glDrawElementsBaseVertex(primitive_mode, count, index_format, index_buffer_ptr,
+                                     base_vertex);
+        }
+    } else {
+        if (current_instance > 0) {
+            glDrawArraysInstancedBaseInstance(primitive_mode, vertex_first, count, 1,
+                                              current_instance);
+        } else {
+            glDrawArrays(primitive_mode, vertex_first, count);
+        }
+    }
+}
+
+void DrawBatch::Open(const DrawParameters& params, u32 first, u32 count, u32 size) {
+    ASSERT(draws.empty());
+    draws.push_back(params);
+    index_first = first;
+    index_count = count;
+    index_size = size;
+}
+
+bool DrawBatch::Append(DrawParameters params, u32 first) {
+    if (draws.empty()) {
+        return false;
+    }
+
+    const DrawParameters& batch_params = draws.front();
+    if (params.use_indexed != batch_params.use_indexed ||
+        params.primitive_mode != batch_params.primitive_mode ||
+        params.current_instance != batch_params.current_instance) {
+        return false;
+    }
+
+    if (params.use_indexed) {
+        const u64 end = u64{first} + static_cast<u64>(params.count);
+        if (first < index_first || end > u64{index_first} + index_count) {
+            return false;
+        }
+        params.index_buffer_offset =
+            batch_params.index_buffer_offset +
+            static_cast<GLintptr>((first - index_first) * index_size);
+    }
+
+    draws.push_back(params);
+    return true;
+}
+
+bool DrawBatch::CanMerge() const {
+    return draws.empty() || draws.front().index_buffer_offset % index_size == 0;
+}
+
+std::size_t DrawBatch::GetIndirectCommandsSize() const {
+    if (draws.empty()) {
+        return 0;
+    }
+    const std::size_t command_size = draws.front().use_indexed
+                                         ? sizeof(DrawElementsIndirectCommand)
+                                         : sizeof(DrawArraysIndirectCommand);
+    return draws.size() * command_size;
+}
+
+void DrawBatch::WriteIndirectCommands(u8* dest) const {
+    for (const auto& params : draws) {
+        if (params.use_indexed) {
+            const DrawElementsIndirectCommand command{
+                static_cast<GLuint>(params.count), 1,
+                static_cast<GLuint>(params.index_buffer_offset / index_size), params.base_vertex,
+                static_cast<GLuint>(params.current_instance)};
+            std::memcpy(dest, &command, sizeof(command));
+            dest += sizeof(command);
+        } else {
+            const DrawArraysIndirectCommand command{
+                static_cast<GLuint>(params.count), 1, static_cast<GLuint>(params.vertex_first),
+                static_cast<GLuint>(params.current_instance)};
+            std::memcpy(dest, &command, sizeof(command));
+            dest += sizeof(command);
+        }
+    }
+}
+
+} // namespace OpenGL
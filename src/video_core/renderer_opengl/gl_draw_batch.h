@@ -0,0 +1,105 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <glad/glad.h>
+#include "common/common_types.h"
+
+namespace OpenGL {
+
+/// Layout of the commands read by glMultiDrawArraysIndirect
+struct DrawArraysIndirectCommand {
+    GLuint count;
+    GLuint instance_count;
+    GLuint first;
+    GLuint base_instance;
+};
+
+/// Layout of the commands read by glMultiDrawElementsIndirect
+struct DrawElementsIndirectCommand {
+    GLuint count;
+    GLuint instance_count;
+    GLuint first_index;
+    GLint base_vertex;
+    GLuint base_instance;
+};
+
+struct DrawParameters {
+    GLenum primitive_mode;
+    GLsizei count;
+    GLint current_instance;
+    bool use_indexed;
+
+    GLint vertex_first;
+
+    GLenum index_format;
+    GLint base_vertex;
+    GLintptr index_buffer_offset;
+
+    void DispatchDraw() const;
+};
+
+/**
+ * Draws sharing the bindings set up for the first of them. The following draws that only differ
+ * in their draw parameters join the batch, which is then dispatched as a single indirect draw.
+ */
+class DrawBatch {
+public:
+    /**
+     * Starts a new batch with a draw whose bindings were set up in full.
+     * @param params Parameters of the draw
+     * @param first  First index uploaded for the draw, zero for non-indexed draws
+     * @param count  Number of indices uploaded for the draw, zero for non-indexed draws
+     * @param size   Size in bytes of each index, one for non-indexed draws
+     */
+    void Open(const DrawParameters& params, u32 first, u32 count, u32 size);
+
+    /**
+     * Appends a draw reusing the bindings of the batch. Indices are not uploaded again, so indexed
+     * draws are pointed at the indices uploaded for the batch.
+     * @param params Parameters of the draw
+     * @param first  First index of the draw, ignored for non-indexed draws
+     * @returns false if the draw can't join the batch and needs a full setup
+     */
+    bool Append(DrawParameters params, u32 first);
+
+    /// Returns true if more draws can be merged into the batch. Indirect draws can only address
+    /// indices at a multiple of their size.
+    bool CanMerge() const;
+
+    /// Size in bytes of the indirect commands of the batch
+    std::size_t GetIndirectCommandsSize() const;
+
+    /// Writes the indirect commands of the batch to dest, which needs not be aligned
+    void WriteIndirectCommands(u8* dest) const;
+
+    /// Forgets the draws of the batch, their storage is kept for the next one
+    void Clear() {
+        draws.clear();
+    }
+
+    bool IsEmpty() const {
+        return draws.empty();
+    }
+
+    std::size_t GetNumDraws() const {
+        return draws.size();
+    }
+
+    /// Returns the draw the bindings of the batch were set up for
+    const DrawParameters& GetFirstDraw() const {
+        return draws.front();
+    }
+
+private:
+    std::vector<DrawParameters> draws;
+    u32 index_first = 0; ///< First index uploaded for the batch
+    u32 index_count = 0; ///< Number of indices uploaded for the batch
+    u32 index_size = 1;  ///< Size in bytes of each index
+};
+
+} // namespace OpenGL
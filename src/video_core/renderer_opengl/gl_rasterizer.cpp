@@ -23,6 +23,7 @@
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/memory_manager.h"
+#include "video_core/renderer_opengl/gl_draw_batch.h"
 #include "video_core/renderer_opengl/gl_rasterizer.h"
 #include "video_core/renderer_opengl/gl_shader_cache.h"
 #include "video_core/renderer_opengl/gl_shader_gen.h"
@@ -36,6 +37,7 @@ using Maxwell = Tegra::Engines::Maxwell3D::Regs;
 using VideoCore::Surface::PixelFormat;
 using VideoCore::Surface::SurfaceTarget;
 using VideoCore::Surface::SurfaceType;
+namespace Dirty = VideoCommon::Dirty;
 
 MICROPROFILE_DEFINE(OpenGL_VAO, "OpenGL", "Vertex Format Setup", MP_RGB(128, 128, 192));
 MICROPROFILE_DEFINE(OpenGL_VB, "OpenGL", "Vertex Buffer Setup", MP_RGB(128, 128, 192));
@@ -45,42 +47,22 @@ MICROPROFILE_DEFINE(OpenGL_Index, "OpenGL", "Index Buffer Setup", MP_RGB(128, 12
 MICROPROFILE_DEFINE(OpenGL_Texture, "OpenGL", "Texture Setup", MP_RGB(128, 128, 192));
 MICROPROFILE_DEFINE(OpenGL_Framebuffer, "OpenGL", "Framebuffer Setup", MP_RGB(128, 128, 192));
 MICROPROFILE_DEFINE(OpenGL_Drawing, "OpenGL", "Drawing", MP_RGB(128, 128, 192));
+MICROPROFILE_DEFINE(OpenGL_DrawBatch, "OpenGL", "Draw Batch", MP_RGB(128, 128, 192));
 MICROPROFILE_DEFINE(OpenGL_Blits, "OpenGL", "Blits", MP_RGB(128, 128, 192));
 MICROPROFILE_DEFINE(OpenGL_CacheManagement, "OpenGL", "Cache Mgmt", MP_RGB(100, 255, 100));
 MICROPROFILE_DEFINE(OpenGL_PrimitiveAssembly, "OpenGL", "Prim Asmbl", MP_RGB(255, 100, 100));
 
-struct DrawParameters {
-    GLenum primitive_mode;
-    GLsizei count;
-    GLint current_instance;
-    bool use_indexed;
-
-    GLint vertex_first;
-
-    GLenum index_format;
-    GLint base_vertex;
-    GLintptr index_buffer_offset;
-
-    void DispatchDraw() const {
-        if (use_indexed) {
-            const auto index_buffer_ptr = reinterpret_cast<const void*>(index_buffer_offset);
-            if (current_instance > 0) {
-                glDrawElementsInstancedBaseVertexBaseInstance(primitive_mode, count, index_format,
-                                                              index_buffer_ptr, 1, base_vertex,
-                                                              current_instance);
-            } else {
-                glDrawElementsBaseVertex(primitive_mode, count, index_format, index_buffer_ptr,
-                                         base_vertex);
-            }
-        } else {
-            if (current_instance > 0) {
-                glDrawArraysInstancedBaseInstance(primitive_mode, vertex_first, count, 1,
-                                                  current_instance);
-            } else {
-                glDrawArrays(primitive_mode, vertex_first, count);
-            }
-        }
-    }
+/// State groups synchronized by SyncDirtyState only when their registers change
+constexpr VideoCommon::DirtyFlags SYNCED_STATE_FLAGS{
+    Dirty::ColorMask, Dirty::DepthTest,        Dirty::StencilTest,   Dirty::BlendState,
+    Dirty::CullMode,  Dirty::PrimitiveRestart, Dirty::PolygonOffset,
+};
+
+/// State groups that keep a draw out of the open batch. Besides the guest register writes, the
+/// caches set some of them when the bindings of the batch are no longer valid.
+constexpr VideoCommon::DirtyFlags BATCH_BREAKING_FLAGS{
+    Dirty::DrawState,       Dirty::VertexAttribFormat, Dirty::VertexArrays,
+    Dirty::VertexInstances, Dirty::RenderSettings,     Dirty::Shaders,
 };
 
 static std::size_t GetConstBufferSize(const Tegra::Engines::ConstBufferInfo& buffer,
@@ -100,8 +82,9 @@ static std::size_t GetConstBufferSize(const Tegra::Engines::ConstBufferInfo& buf
 
 RasterizerOpenGL::RasterizerOpenGL(Core::System& system, Core::Frontend::EmuWindow& emu_window,
                                    ScreenInfo& info)
-    : texture_cache{system, *this, device}, shader_cache{*this, system, emu_window, device},
-      system{system}, screen_info{info}, buffer_cache{*this, system, STREAM_BUFFER_SIZE} {
+    : texture_cache{system, *this, device, upload_buffer},
+      shader_cache{*this, system, emu_window, device}, system{system}, screen_info{info},
+      buffer_cache{*this, system, STREAM_BUFFER_SIZE, upload_buffer} {
     OpenGLState::ApplyDefaultState();
 
     shader_program_manager = std::make_unique<GLShader::ProgramManager>();
@@ -127,10 +110,10 @@ GLuint RasterizerOpenGL::SetupVertexFormat() {
     auto& gpu = system.GPU().Maxwell3D();
     const auto& regs = gpu.regs;
 
-    if (!gpu.dirty.vertex_attrib_format) {
+    if (!gpu.dirty.flags[Dirty::VertexAttribFormat]) {
         return state.draw.vertex_array;
     }
-    gpu.dirty.vertex_attrib_format = false;
+    gpu.dirty.flags.Reset(Dirty::VertexAttribFormat);
 
     MICROPROFILE_SCOPE(OpenGL_VAO);
 
@@ -192,9 +175,9 @@ GLuint RasterizerOpenGL::SetupVertexFormat() {
 
 void RasterizerOpenGL::SetupVertexBuffer(GLuint vao) {
     auto& gpu = system.GPU().Maxwell3D();
-    if (!gpu.dirty.vertex_array_buffers)
+    if (!gpu.dirty.flags[Dirty::VertexArrays])
         return;
-    gpu.dirty.vertex_array_buffers = false;
+    gpu.dirty.flags.Reset(Dirty::VertexArrays);
 
     const auto& regs = gpu.regs;
 
@@ -202,10 +185,10 @@ void RasterizerOpenGL::SetupVertexBuffer(GLuint vao) {
 
     // Upload all guest vertex arrays sequentially to our buffer
     for (u32 index = 0; index < Maxwell::NumVertexArrays; ++index) {
-        if (!gpu.dirty.vertex_array[index])
+        if (!gpu.dirty.flags[Dirty::VertexArray0 + index])
             continue;
-        gpu.dirty.vertex_array[index] = false;
-        gpu.dirty.vertex_instance[index] = false;
+        gpu.dirty.flags.Reset(Dirty::VertexArray0 + index);
+        gpu.dirty.flags.Reset(Dirty::VertexInstance0 + index);
 
         const auto& vertex_array = regs.vertex_array[index];
         if (!vertex_array.IsEnabled())
@@ -235,17 +218,17 @@ void RasterizerOpenGL::SetupVertexBuffer(GLuint vao) {
 void RasterizerOpenGL::SetupVertexInstances(GLuint vao) {
     auto& gpu = system.GPU().Maxwell3D();
 
-    if (!gpu.dirty.vertex_instances)
+    if (!gpu.dirty.flags[Dirty::VertexInstances])
         return;
-    gpu.dirty.vertex_instances = false;
+    gpu.dirty.flags.Reset(Dirty::VertexInstances);
 
     const auto& regs = gpu.regs;
     // Upload all guest vertex arrays sequentially to our buffer
     for (u32 index = 0; index < Maxwell::NumVertexArrays; ++index) {
-        if (!gpu.dirty.vertex_instance[index])
+        if (!gpu.dirty.flags[Dirty::VertexInstance0 + index])
             continue;
 
-        gpu.dirty.vertex_instance[index] = false;
+        gpu.dirty.flags.Reset(Dirty::VertexInstance0 + index);
 
         if (regs.instanced_arrays.IsInstancingEnabled(index) &&
             regs.vertex_array[index].divisor != 0) {
@@ -371,7 +354,7 @@ void RasterizerOpenGL::SetupShaders(GLenum primitive_mode) {
 
     SyncClipEnabled(clip_distances);
 
-    gpu.dirty.shaders = false;
+    gpu.dirty.flags.Reset(Dirty::Shaders);
 }
 
 std::size_t RasterizerOpenGL::CalculateVertexArraysSize() const {
@@ -454,13 +437,14 @@ std::pair<bool, bool> RasterizerOpenGL::ConfigureFramebuffers(
 
     const FramebufferConfigState fb_config_state{using_color_fb, using_depth_fb, preserve_contents,
                                                  single_color_target};
-    if (fb_config_state == current_framebuffer_config_state && !gpu.dirty.render_settings) {
+    if (fb_config_state == current_framebuffer_config_state &&
+        !gpu.dirty.flags[Dirty::RenderSettings]) {
         // Only skip if the previous ConfigureFramebuffers call was from the same kind (multiple or
         // single color targets). This is done because the guest registers may not change but the
         // host framebuffer may contain different attachments
         return current_depth_stencil_usage;
     }
-    gpu.dirty.render_settings = false;
+    gpu.dirty.flags.Reset(Dirty::RenderSettings);
     current_framebuffer_config_state = fb_config_state;
 
     texture_cache.GuardRenderTargets(true);
@@ -543,6 +527,23 @@ std::pair<bool, bool> RasterizerOpenGL::ConfigureFramebuffers(
 
     texture_cache.GuardRenderTargets(false);
 
+    // Render targets are all created at the same scale, attachments of different sizes would make
+    // the framebuffer render to their intersection only
+    render_target_scale = 1.0f;
+    bool is_first_attachment = true;
+    const auto add_attachment_scale = [&](const View& view) {
+        if (!view) {
+            return;
+        }
+        const float scale = view->GetSurfaceParams().resolution_scale;
+        ASSERT_MSG(is_first_attachment || scale == render_target_scale,
+                   "Framebuffer attachments have different resolution scales");
+        render_target_scale = scale;
+        is_first_attachment = false;
+    };
+    std::for_each(fbkey.colors.begin(), fbkey.colors.end(), add_attachment_scale);
+    add_attachment_scale(depth_surface);
+
     current_state.draw.draw_framebuffer = framebuffer_cache.GetFramebuffer(fbkey);
     SyncViewport(current_state);
 
@@ -565,6 +566,13 @@ void RasterizerOpenGL::ConfigureClearFramebuffer(OpenGLState& current_state, boo
     }
     texture_cache.GuardRenderTargets(false);
 
+    ASSERT_MSG(!color_surface || !depth_surface ||
+                   color_surface->GetSurfaceParams().resolution_scale ==
+                       depth_surface->GetSurfaceParams().resolution_scale,
+               "Framebuffer attachments have different resolution scales");
+    const View& scale_surface = color_surface ? color_surface : depth_surface;
+    render_target_scale = scale_surface ? scale_surface->GetSurfaceParams().resolution_scale : 1.0f;
+
     current_state.draw.draw_framebuffer = clear_framebuffer.handle;
     current_state.ApplyFramebufferState();
 
@@ -595,6 +603,8 @@ void RasterizerOpenGL::ConfigureClearFramebuffer(OpenGLState& current_state, boo
 }
 
 void RasterizerOpenGL::Clear() {
+    FlushDrawBatch();
+
     const auto& maxwell3d = system.GPU().Maxwell3D();
 
     if (!maxwell3d.ShouldExecute()) {
@@ -612,6 +622,10 @@ void RasterizerOpenGL::Clear() {
         prev_state.Apply();
     });
 
+    // The clear framebuffer may have a different scale than the framebuffer of the next draw
+    const float draw_target_scale = render_target_scale;
+    SCOPE_EXIT({ render_target_scale = draw_target_scale; });
+
     OpenGLState clear_state{OpenGLState::GetCurState()};
     clear_state.SetDefaultViewports();
     if (regs.clear_buffers.R || regs.clear_buffers.G || regs.clear_buffers.B ||
@@ -708,19 +722,18 @@ void RasterizerOpenGL::DrawArrays() {
         return;
     }
 
-    SyncColorMask();
+    if (BatchDraw()) {
+        accelerate_draw = AccelDraw::Disabled;
+        return;
+    }
+    FlushDrawBatch();
+
+    SyncDirtyState();
     SyncFragmentColorClampState();
     SyncMultiSampleState();
-    SyncDepthTestState();
-    SyncStencilTestState();
-    SyncBlendState();
     SyncLogicOpState();
-    SyncCullMode();
-    SyncPrimitiveRestart();
-    SyncScissorTest(state);
     SyncTransformFeedback();
     SyncPointState();
-    SyncPolygonOffset();
     SyncAlphaTest();
 
     // Draw the vertex batch
@@ -767,6 +780,8 @@ void RasterizerOpenGL::DrawArrays() {
     texture_cache.GuardSamplers(false);
 
     ConfigureFramebuffers(state);
+    // Scissors are scaled with the render targets, they are known after configuring them
+    SyncScissorTest(state);
 
     // Signal the buffer cache that we are not going to upload more things.
     const bool invalidate = buffer_cache.Unmap();
@@ -784,17 +799,72 @@ void RasterizerOpenGL::DrawArrays() {
     shader_program_manager->ApplyTo(state);
     state.Apply();
 
-    if (texture_cache.TextureBarrier()) {
+    const bool texture_barrier = texture_cache.TextureBarrier();
+    if (texture_barrier) {
         glTextureBarrier();
     }
 
-    params.DispatchDraw();
+    // Defer the draw, the following draws with the same bindings are dispatched along with it
+    const auto& regs = gpu.regs;
+    draw_batch.Open(params, is_indexed ? regs.index_array.first : 0,
+                    is_indexed ? regs.index_array.count : 0,
+                    is_indexed ? regs.index_array.FormatSizeInBytes() : 1);
+
+    // Draws sampling their render targets need a barrier between them
+    if (texture_barrier || !draw_batch.CanMerge()) {
+        FlushDrawBatch();
+    }
 
     accelerate_draw = AccelDraw::Disabled;
-    gpu.dirty.memory_general = false;
+    gpu.dirty.flags.Reset(Dirty::MemoryGeneral);
+    gpu.dirty.flags.Reset(Dirty::DrawState);
+}
+
+bool RasterizerOpenGL::BatchDraw() {
+    const auto& gpu = system.GPU().Maxwell3D();
+    const bool invalidated = draw_batch_invalidated.exchange(false);
+    if (draw_batch.IsEmpty() || invalidated || gpu.dirty.flags.Any(BATCH_BREAKING_FLAGS)) {
+        return false;
+    }
+    const DrawParameters params = SetupDraw(draw_batch.GetFirstDraw().index_buffer_offset);
+    return draw_batch.Append(params, gpu.regs.index_array.first);
+}
+
+void RasterizerOpenGL::FlushDrawBatch() {
+    if (draw_batch.IsEmpty()) {
+        return;
+    }
+    if (draw_batch.GetNumDraws() == 1) {
+        draw_batch.GetFirstDraw().DispatchDraw();
+        draw_batch.Clear();
+        return;
+    }
+
+    MICROPROFILE_SCOPE(OpenGL_DrawBatch);
+
+    // The commands are streamed through the upload ring, which keeps them alive until the GPU
+    // has read them
+    const auto size = static_cast<GLsizeiptr>(draw_batch.GetIndirectCommandsSize());
+    const auto [commands, offset, invalidated] = upload_buffer.Map(size, sizeof(GLuint));
+    draw_batch.WriteIndirectCommands(commands);
+    upload_buffer.Unmap(size);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, upload_buffer.GetHandle());
+
+    const DrawParameters& batch_params = draw_batch.GetFirstDraw();
+    const auto indirect = reinterpret_cast<const void*>(offset);
+    const auto draw_count = static_cast<GLsizei>(draw_batch.GetNumDraws());
+    if (batch_params.use_indexed) {
+        glMultiDrawElementsIndirect(batch_params.primitive_mode, batch_params.index_format,
+                                    indirect, draw_count, 0);
+    } else {
+        glMultiDrawArraysIndirect(batch_params.primitive_mode, indirect, draw_count, 0);
+    }
+    draw_batch.Clear();
 }
 
 void RasterizerOpenGL::DispatchCompute(GPUVAddr code_addr) {
+    FlushDrawBatch();
+
     if (!GLAD_GL_ARB_compute_variable_group_size) {
         LOG_ERROR(Render_OpenGL, "Compute is currently not supported on this device due to the "
                                  "lack of GL_ARB_compute_variable_group_size");
@@ -833,13 +903,16 @@ void RasterizerOpenGL::DispatchCompute(GPUVAddr code_addr) {
                                   launch_desc.block_dim_y, launch_desc.block_dim_z);
 }
 
-void RasterizerOpenGL::FlushAll() {}
+void RasterizerOpenGL::FlushAll() {
+    FlushDrawBatch();
+}
 
 void RasterizerOpenGL::FlushRegion(CacheAddr addr, u64 size) {
     MICROPROFILE_SCOPE(OpenGL_CacheManagement);
     if (!addr || !size) {
         return;
     }
+    FlushDrawBatch();
     texture_cache.FlushRegion(addr, size);
     buffer_cache.FlushRegion(addr, size);
 }
@@ -849,6 +922,9 @@ void RasterizerOpenGL::InvalidateRegion(CacheAddr addr, u64 size) {
     if (!addr || !size) {
         return;
     }
+    // This can be called from the CPU thread in asynchronous GPU mode, the open batch is not
+    // dispatched here but it is not extended with draws reading the invalidated memory either
+    draw_batch_invalidated = true;
     texture_cache.InvalidateRegion(addr, size);
     shader_cache.InvalidateRegion(addr, size);
     buffer_cache.InvalidateRegion(addr, size);
@@ -862,10 +938,12 @@ void RasterizerOpenGL::FlushAndInvalidateRegion(CacheAddr addr, u64 size) {
 }
 
 void RasterizerOpenGL::FlushCommands() {
+    FlushDrawBatch();
     glFlush();
 }
 
 void RasterizerOpenGL::TickFrame() {
+    FlushDrawBatch();
     buffer_cache.TickFrame();
 }
 
@@ -873,12 +951,14 @@ bool RasterizerOpenGL::AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Regs
                                              const Tegra::Engines::Fermi2D::Regs::Surface& dst,
                                              const Tegra::Engines::Fermi2D::Config& copy_config) {
     MICROPROFILE_SCOPE(OpenGL_Blits);
+    FlushDrawBatch();
     texture_cache.DoFermiCopy(src, dst, copy_config);
     return true;
 }
 
 bool RasterizerOpenGL::AccelerateDisplay(const Tegra::FramebufferConfig& config,
                                          VAddr framebuffer_addr, u32 pixel_stride) {
+    FlushDrawBatch();
     if (!framebuffer_addr) {
         return {};
     }
@@ -1039,10 +1119,10 @@ void RasterizerOpenGL::SyncViewport(OpenGLState& current_state) {
         auto& viewport = current_state.viewports[i];
         const auto& src = regs.viewports[i];
         const Common::Rectangle<s32> viewport_rect{regs.viewport_transform[i].GetRect()};
-        viewport.x = viewport_rect.left;
-        viewport.y = viewport_rect.bottom;
-        viewport.width = viewport_rect.GetWidth();
-        viewport.height = viewport_rect.GetHeight();
+        viewport.x = ScaleToRenderTarget(viewport_rect.left);
+        viewport.y = ScaleToRenderTarget(viewport_rect.bottom);
+        viewport.width = ScaleToRenderTarget(viewport_rect.GetWidth());
+        viewport.height = ScaleToRenderTarget(viewport_rect.GetHeight());
         viewport.depth_range_far = src.depth_range_far;
         viewport.depth_range_near = src.depth_range_near;
     }
@@ -1069,10 +1149,31 @@ void RasterizerOpenGL::SyncClipCoef() {
     UNIMPLEMENTED();
 }
 
-void RasterizerOpenGL::SyncCullMode() {
+void RasterizerOpenGL::SyncDirtyState() {
+    // Only the state groups whose registers changed since the last draw are synchronized
     auto& maxwell3d = system.GPU().Maxwell3D();
+    maxwell3d.dirty.flags.Take(SYNCED_STATE_FLAGS).ForEach([this](u8 flag) {
+        switch (flag) {
+        case Dirty::ColorMask:
+            return SyncColorMask();
+        case Dirty::DepthTest:
+            return SyncDepthTestState();
+        case Dirty::StencilTest:
+            return SyncStencilTestState();
+        case Dirty::BlendState:
+            return SyncBlendState();
+        case Dirty::CullMode:
+            return SyncCullMode();
+        case Dirty::PrimitiveRestart:
+            return SyncPrimitiveRestart();
+        case Dirty::PolygonOffset:
+            return SyncPolygonOffset();
+        }
+    });
+}
 
-    const auto& regs = maxwell3d.regs;
+void RasterizerOpenGL::SyncCullMode() {
+    const auto& regs = system.GPU().Maxwell3D().regs;
 
     state.cull.enabled = regs.cull.enabled != 0;
     if (state.cull.enabled) {
@@ -1092,6 +1193,7 @@ void RasterizerOpenGL::SyncCullMode() {
                 state.cull.front_face = GL_CCW;
         }
     }
+    state.MarkDirtyCullState();
 }
 
 void RasterizerOpenGL::SyncPrimitiveRestart() {
@@ -1099,6 +1201,7 @@ void RasterizerOpenGL::SyncPrimitiveRestart() {
 
     state.primitive_restart.enabled = regs.primitive_restart.enabled;
     state.primitive_restart.index = regs.primitive_restart.index;
+    state.MarkDirtyPrimitiveRestart();
 }
 
 void RasterizerOpenGL::SyncDepthTestState() {
@@ -1106,6 +1209,7 @@ void RasterizerOpenGL::SyncDepthTestState() {
 
     state.depth.test_enabled = regs.depth_test_enable != 0;
     state.depth.write_mask = regs.depth_write_enabled ? GL_TRUE : GL_FALSE;
+    state.MarkDirtyDepthState();
 
     if (!state.depth.test_enabled) {
         return;
@@ -1115,11 +1219,7 @@ void RasterizerOpenGL::SyncDepthTestState() {
 }
 
 void RasterizerOpenGL::SyncStencilTestState() {
-    auto& maxwell3d = system.GPU().Maxwell3D();
-    if (!maxwell3d.dirty.stencil_test) {
-        return;
-    }
-    const auto& regs = maxwell3d.regs;
+    const auto& regs = system.GPU().Maxwell3D().regs;
 
     state.stencil.test_enabled = regs.stencil_enable != 0;
     if (!regs.stencil_enable) {
@@ -1151,15 +1251,10 @@ void RasterizerOpenGL::SyncStencilTestState() {
         state.stencil.back.action_depth_pass = GL_KEEP;
     }
     state.MarkDirtyStencilState();
-    maxwell3d.dirty.stencil_test = false;
 }
 
 void RasterizerOpenGL::SyncColorMask() {
-    auto& maxwell3d = system.GPU().Maxwell3D();
-    if (!maxwell3d.dirty.color_mask) {
-        return;
-    }
-    const auto& regs = maxwell3d.regs;
+    const auto& regs = system.GPU().Maxwell3D().regs;
 
     const std::size_t count =
         regs.independent_blend_enable ? Tegra::Engines::Maxwell3D::Regs::NumRenderTargets : 1;
@@ -1173,7 +1268,6 @@ void RasterizerOpenGL::SyncColorMask() {
     }
 
     state.MarkDirtyColorMask();
-    maxwell3d.dirty.color_mask = false;
 }
 
 void RasterizerOpenGL::SyncMultiSampleState() {
@@ -1188,11 +1282,7 @@ void RasterizerOpenGL::SyncFragmentColorClampState() {
 }
 
 void RasterizerOpenGL::SyncBlendState() {
-    auto& maxwell3d = system.GPU().Maxwell3D();
-    if (!maxwell3d.dirty.blend_state) {
-        return;
-    }
-    const auto& regs = maxwell3d.regs;
+    const auto& regs = system.GPU().Maxwell3D().regs;
 
     state.blend_color.red = regs.blend_color.r;
     state.blend_color.green = regs.blend_color.g;
@@ -1215,7 +1305,6 @@ void RasterizerOpenGL::SyncBlendState() {
         for (std::size_t i = 1; i < Tegra::Engines::Maxwell3D::Regs::NumRenderTargets; i++) {
             state.blend[i].enabled = false;
         }
-        maxwell3d.dirty.blend_state = false;
         state.MarkDirtyBlendState();
         return;
     }
@@ -1235,7 +1324,6 @@ void RasterizerOpenGL::SyncBlendState() {
     }
 
     state.MarkDirtyBlendState();
-    maxwell3d.dirty.blend_state = false;
 }
 
 void RasterizerOpenGL::SyncLogicOpState() {
@@ -1267,10 +1355,10 @@ void RasterizerOpenGL::SyncScissorTest(OpenGLState& current_state) {
         }
         const u32 width = src.max_x - src.min_x;
         const u32 height = src.max_y - src.min_y;
-        dst.x = src.min_x;
-        dst.y = src.min_y;
-        dst.width = width;
-        dst.height = height;
+        dst.x = ScaleToRenderTarget(static_cast<s32>(src.min_x));
+        dst.y = ScaleToRenderTarget(static_cast<s32>(src.min_y));
+        dst.width = ScaleToRenderTarget(static_cast<s32>(width));
+        dst.height = ScaleToRenderTarget(static_cast<s32>(height));
     }
 }
 
@@ -1287,11 +1375,7 @@ void RasterizerOpenGL::SyncPointState() {
 }
 
 void RasterizerOpenGL::SyncPolygonOffset() {
-    auto& maxwell3d = system.GPU().Maxwell3D();
-    if (!maxwell3d.dirty.polygon_offset) {
-        return;
-    }
-    const auto& regs = maxwell3d.regs;
+    const auto& regs = system.GPU().Maxwell3D().regs;
 
     state.polygon_offset.fill_enable = regs.polygon_offset_fill_enable != 0;
     state.polygon_offset.line_enable = regs.polygon_offset_line_enable != 0;
@@ -1301,7 +1385,6 @@ void RasterizerOpenGL::SyncPolygonOffset() {
     state.polygon_offset.clamp = regs.polygon_offset_clamp;
 
     state.MarkDirtyPolygonOffset();
-    maxwell3d.dirty.polygon_offset = false;
 }
 
 void RasterizerOpenGL::SyncAlphaTest() {
@@ -6,12 +6,14 @@
 
 #include <array>
 #include <atomic>
+#include <cmath>
 #include <cstddef>
 #include <map>
 #include <memory>
 #include <optional>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include <boost/icl/interval_map.hpp>
 #include <glad/glad.h>
@@ -23,6 +25,7 @@
 #include "video_core/rasterizer_interface.h"
 #include "video_core/renderer_opengl/gl_buffer_cache.h"
 #include "video_core/renderer_opengl/gl_device.h"
+#include "video_core/renderer_opengl/gl_draw_batch.h"
 #include "video_core/renderer_opengl/gl_framebuffer_cache.h"
 #include "video_core/renderer_opengl/gl_resource_manager.h"
 #include "video_core/renderer_opengl/gl_sampler_cache.h"
@@ -30,6 +33,7 @@
 #include "video_core/renderer_opengl/gl_shader_decompiler.h"
 #include "video_core/renderer_opengl/gl_shader_manager.h"
 #include "video_core/renderer_opengl/gl_state.h"
+#include "video_core/renderer_opengl/gl_stream_buffer.h"
 #include "video_core/renderer_opengl/gl_texture_cache.h"
 #include "video_core/renderer_opengl/utils.h"
 
@@ -48,8 +52,6 @@ class MemoryManager;
 namespace OpenGL {
 
 struct ScreenInfo;
-struct DrawParameters;
-
 class RasterizerOpenGL : public VideoCore::RasterizerInterface {
 public:
     explicit RasterizerOpenGL(Core::System& system, Core::Frontend::EmuWindow& emu_window,
@@ -140,9 +142,17 @@ private:
     TextureBufferUsage SetupTextures(Tegra::Engines::Maxwell3D::Regs::ShaderStage stage,
                                      const Shader& shader, BaseBindings base_bindings);
 
+    /// Syncs the state groups marked as dirty by the guest since the last draw
+    void SyncDirtyState();
+
     /// Syncs the viewport and depth range to match the guest state
     void SyncViewport(OpenGLState& current_state);
 
+    /// Scales a coordinate or size in guest pixels to the bound render targets.
+    s32 ScaleToRenderTarget(s32 value) const {
+        return static_cast<s32>(std::lround(value * render_target_scale));
+    }
+
     /// Syncs the clip enabled status to match the guest state
     void SyncClipEnabled(
         const std::array<bool, Tegra::Engines::Maxwell3D::Regs::NumClipDistances>& clip_mask);
@@ -199,6 +209,9 @@ private:
     const Device device;
     OpenGLState state;
 
+    /// Ring staging texture and cached buffer uploads
+    OGLStreamBuffer upload_buffer{UPLOAD_BUFFER_SIZE, false};
+
     TextureCacheOpenGL texture_cache;
     ShaderCacheOpenGL shader_cache;
     SamplerCacheOpenGL sampler_cache;
@@ -215,8 +228,11 @@ private:
 
     FramebufferConfigState current_framebuffer_config_state;
     std::pair<bool, bool> current_depth_stencil_usage{};
+    /// Resolution scale of the bound render targets, viewports and scissors are scaled by it
+    float render_target_scale = 1.0f;
 
     static constexpr std::size_t STREAM_BUFFER_SIZE = 128 * 1024 * 1024;
+    static constexpr std::size_t UPLOAD_BUFFER_SIZE = 64 * 1024 * 1024;
     OGLBufferCache buffer_cache;
 
     VertexArrayPushBuffer vertex_array_pushbuffer;
@@ -239,9 +255,22 @@ private:
 
     void SetupShaders(GLenum primitive_mode);
 
+    /// Appends the current draw to the open batch when it only differs from the batched draws in
+    /// its draw parameters. Returns true when the draw was batched.
+    bool BatchDraw();
+
+    /// Dispatches the draws of the open batch, merged in a single indirect draw when possible
+    void FlushDrawBatch();
+
     enum class AccelDraw { Disabled, Arrays, Indexed };
     AccelDraw accelerate_draw = AccelDraw::Disabled;
 
+    /// Draws sharing the bindings set up for the first of them, dispatched by FlushDrawBatch
+    DrawBatch draw_batch;
+
+    /// Set when guest memory is invalidated, the next draw starts a new batch from a full setup
+    std::atomic_bool draw_batch_invalidated{false};
+
     OGLFramebuffer clear_framebuffer;
 
     using CachedPageMap = boost::icl::interval_map<u64, int>;
@@ -9,6 +9,7 @@
 #include <bitset>
 #include <memory>
 #include <set>
+#include <string>
 #include <tuple>
 #include <unordered_map>
 #include <vector>
@@ -42,6 +43,19 @@ using Maxwell = Tegra::Engines::Maxwell3D::Regs;
 using PrecompiledPrograms = std::unordered_map<ShaderDiskCacheUsage, CachedProgram>;
 using PrecompiledShaders = std::unordered_map<u64, GLShader::ProgramResult>;
 
+/// Calculates the size in bytes of a program stream, including its last instruction
+std::size_t CalculateProgramSize(const GLShader::ProgramCode& program);
+
+/// Decompiles an unspecialized program from code streams. It doesn't call OpenGL, so it can be
+/// used without a context.
+GLShader::ProgramResult CreateProgram(const Device& device, ProgramType program_type,
+                                      ProgramCode program_code, ProgramCode program_code_b);
+
+/// Builds the GLSL source of an unspecialized program specialized for a variant, as it's handed
+/// to the driver.
+std::string BuildShaderSource(const std::string& code, const GLShader::ShaderEntries& entries,
+                              ProgramType program_type, const ProgramVariant& variant);
+
 struct ShaderParameters {
     ShaderDiskCacheOpenGL& disk_cache;
     const PrecompiledPrograms& precompiled_programs;
@@ -2,7 +2,9 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <array>
+#include <iterator>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -48,6 +50,8 @@ using TextureIR = std::variant<TextureAoffi, TextureArgument>;
 constexpr u32 MAX_CONSTBUFFER_ELEMENTS =
     static_cast<u32>(Maxwell::MaxConstBufferSize) / (4 * sizeof(float));
 
+/// Writes the GLSL source of a shader. The source is appended to a list of fixed size chunks so
+/// large shaders aren't copied around while they grow, and it's joined once in GetResult.
 class ShaderWriter {
 public:
     void AddExpression(std::string_view text) {
@@ -55,7 +59,7 @@ public:
         if (!text.empty()) {
             AppendIndentation();
         }
-        shader_source += text;
+        Append(text);
     }
 
     // Forwards all arguments directly to libfmt.
@@ -65,13 +69,15 @@ public:
     // etc).
     template <typename... Args>
     void AddLine(std::string_view text, Args&&... args) {
-        AddExpression(fmt::format(text, std::forward<Args>(args)...));
+        line_buffer.clear();
+        fmt::format_to(std::back_inserter(line_buffer), text, std::forward<Args>(args)...);
+        AddExpression(line_buffer);
         AddNewLine();
     }
 
     void AddNewLine() {
         DEBUG_ASSERT(scope >= 0);
-        shader_source += '\n';
+        Append("\n");
     }
 
     std::string GenerateTemporary() {
@@ -79,17 +85,44 @@ public:
     }
 
     std::string GetResult() {
-        return std::move(shader_source);
+        std::string result;
+        result.reserve(size);
+        for (const std::string& chunk : chunks) {
+            result += chunk;
+        }
+        chunks.clear();
+        size = 0;
+        return result;
     }
 
     s32 scope = 0;
 
 private:
+    static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
     void AppendIndentation() {
-        shader_source.append(static_cast<std::size_t>(scope) * 4, ' ');
+        static constexpr std::string_view indentation = "    ";
+        for (s32 i = 0; i < scope; ++i) {
+            Append(indentation);
+        }
+    }
+
+    void Append(std::string_view text) {
+        size += text.size();
+        while (!text.empty()) {
+            if (chunks.empty() || chunks.back().size() == CHUNK_SIZE) {
+                chunks.emplace_back().reserve(CHUNK_SIZE);
+            }
+            std::string& chunk = chunks.back();
+            const std::size_t copy_size = std::min(text.size(), CHUNK_SIZE - chunk.size());
+            chunk.append(text.data(), copy_size);
+            text.remove_prefix(copy_size);
+        }
     }
 
-    std::string shader_source;
+    std::vector<std::string> chunks;
+    std::size_t size = 0;
+    std::string line_buffer; ///< Reused to format lines without allocating
     u32 temporary_index = 1;
 };
 
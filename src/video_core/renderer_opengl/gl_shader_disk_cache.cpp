@@ -144,6 +144,18 @@ ShaderDiskCacheOpenGL::LoadTransferable() {
     }
 
     // Version is valid, load the shaders
+    auto entries = LoadTransferableEntries(file);
+    if (!entries) {
+        return {};
+    }
+    for (const auto& raw : entries->first) {
+        transferable.insert({raw.GetUniqueIdentifier(), {}});
+    }
+    return entries;
+}
+
+std::optional<std::pair<std::vector<ShaderDiskCacheRaw>, std::vector<ShaderDiskCacheUsage>>>
+ShaderDiskCacheOpenGL::LoadTransferableEntries(FileUtil::IOFile& file) {
     std::vector<ShaderDiskCacheRaw> raws;
     std::vector<ShaderDiskCacheUsage> usages;
     while (file.Tell() < file.GetSize()) {
@@ -160,7 +172,6 @@ ShaderDiskCacheOpenGL::LoadTransferable() {
                 LOG_ERROR(Render_OpenGL, "Failed to load transferable raw entry - skipping");
                 return {};
             }
-            transferable.insert({entry.GetUniqueIdentifier(), {}});
             raws.push_back(std::move(entry));
             break;
         }
@@ -180,7 +191,11 @@ ShaderDiskCacheOpenGL::LoadTransferable() {
         }
     }
 
-    return {{raws, usages}};
+    return {{std::move(raws), std::move(usages)}};
+}
+
+u32 ShaderDiskCacheOpenGL::GetNativeVersion() {
+    return NativeVersion;
 }
 
 std::pair<std::unordered_map<u64, ShaderDiskCacheDecompiled>, ShaderDumpsMap>
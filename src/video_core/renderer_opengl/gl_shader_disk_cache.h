@@ -183,6 +183,19 @@ public:
     std::optional<std::pair<std::vector<ShaderDiskCacheRaw>, std::vector<ShaderDiskCacheUsage>>>
     LoadTransferable();
 
+    /**
+     * Reads the entries of a transferable cache file. It doesn't depend on the running game, so
+     * it can be used to inspect cache files offline.
+     * @param file Transferable cache file, positioned right after the version header.
+     * @returns The raw and usage entries of the file or an empty optional on failure.
+     */
+    static std::optional<
+        std::pair<std::vector<ShaderDiskCacheRaw>, std::vector<ShaderDiskCacheUsage>>>
+    LoadTransferableEntries(FileUtil::IOFile& file);
+
+    /// Returns the version of the cache files written and accepted by this build.
+    static u32 GetNativeVersion();
+
     /// Loads current game's precompiled cache. Invalidates on failure.
     std::pair<std::unordered_map<u64, ShaderDiskCacheDecompiled>,
               std::unordered_map<ShaderDiskCacheUsage, ShaderDiskCacheDump>>
@@ -566,9 +566,18 @@ void OpenGLState::Apply() {
         dirty.stencil_state = false;
     }
     ApplySRgb();
-    ApplyCulling();
-    ApplyDepth();
-    ApplyPrimitiveRestart();
+    if (dirty.cull_state) {
+        ApplyCulling();
+        dirty.cull_state = false;
+    }
+    if (dirty.depth_state) {
+        ApplyDepth();
+        dirty.depth_state = false;
+    }
+    if (dirty.primitive_restart) {
+        ApplyPrimitiveRestart();
+        dirty.primitive_restart = false;
+    }
     if (dirty.blend_state) {
         ApplyBlending();
         dirty.blend_state = false;
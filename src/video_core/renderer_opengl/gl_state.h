@@ -254,11 +254,26 @@ public:
         dirty.color_mask = true;
     }
 
+    void MarkDirtyCullState() {
+        dirty.cull_state = true;
+    }
+
+    void MarkDirtyDepthState() {
+        dirty.depth_state = true;
+    }
+
+    void MarkDirtyPrimitiveRestart() {
+        dirty.primitive_restart = true;
+    }
+
     void AllDirty() {
         dirty.blend_state = true;
         dirty.stencil_state = true;
         dirty.polygon_offset = true;
         dirty.color_mask = true;
+        dirty.cull_state = true;
+        dirty.depth_state = true;
+        dirty.primitive_restart = true;
     }
 
 private:
@@ -272,6 +287,9 @@ private:
         bool viewport_state;
         bool polygon_offset;
         bool color_mask;
+        bool cull_state;
+        bool depth_state;
+        bool primitive_restart;
     } dirty{};
 };
 
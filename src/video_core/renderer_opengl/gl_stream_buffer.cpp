@@ -2,22 +2,19 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
-#include <deque>
-#include <vector>
+#include <algorithm>
 #include "common/alignment.h"
 #include "common/assert.h"
 #include "common/microprofile.h"
-#include "video_core/renderer_opengl/gl_state.h"
 #include "video_core/renderer_opengl/gl_stream_buffer.h"
 
-MICROPROFILE_DEFINE(OpenGL_StreamBuffer, "OpenGL", "Stream Buffer Orphaning",
-                    MP_RGB(128, 128, 192));
+MICROPROFILE_DEFINE(OpenGL_StreamBuffer, "OpenGL", "Stream Buffer Stall", MP_RGB(128, 128, 192));
 
 namespace OpenGL {
 
-OGLStreamBuffer::OGLStreamBuffer(GLsizeiptr size, bool vertex_data_usage, bool prefer_coherent,
-                                 bool use_persistent)
-    : buffer_size(size) {
+OGLStreamBuffer::OGLStreamBuffer(GLsizeiptr size, bool vertex_data_usage, bool prefer_coherent)
+    : coherent{prefer_coherent}, buffer_size{size},
+      region_size{size / static_cast<GLsizeiptr>(NUM_REGIONS)} {
     gl_buffer.Create();
 
     GLsizeiptr allocate_size = size;
@@ -30,23 +27,15 @@ OGLStreamBuffer::OGLStreamBuffer(GLsizeiptr size, bool vertex_data_usage, bool p
         allocate_size *= 2;
     }
 
-    if (use_persistent) {
-        persistent = true;
-        coherent = prefer_coherent;
-        const GLbitfield flags =
-            GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | (coherent ? GL_MAP_COHERENT_BIT : 0);
-        glNamedBufferStorage(gl_buffer.handle, allocate_size, nullptr, flags);
-        mapped_ptr = static_cast<u8*>(glMapNamedBufferRange(
-            gl_buffer.handle, 0, buffer_size, flags | (coherent ? 0 : GL_MAP_FLUSH_EXPLICIT_BIT)));
-    } else {
-        glNamedBufferData(gl_buffer.handle, allocate_size, nullptr, GL_STREAM_DRAW);
-    }
+    const GLbitfield flags =
+        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | (coherent ? GL_MAP_COHERENT_BIT : 0);
+    glNamedBufferStorage(gl_buffer.handle, allocate_size, nullptr, flags);
+    mapped_ptr = static_cast<u8*>(glMapNamedBufferRange(
+        gl_buffer.handle, 0, buffer_size, flags | (coherent ? 0 : GL_MAP_FLUSH_EXPLICIT_BIT)));
 }
 
 OGLStreamBuffer::~OGLStreamBuffer() {
-    if (persistent) {
-        glUnmapNamedBuffer(gl_buffer.handle);
-    }
+    glUnmapNamedBuffer(gl_buffer.handle);
     gl_buffer.Release();
 }
 
@@ -67,41 +56,59 @@ std::tuple<u8*, GLintptr, bool> OGLStreamBuffer::Map(GLsizeiptr size, GLintptr a
         buffer_pos = Common::AlignUp<std::size_t>(buffer_pos, alignment);
     }
 
+    // The commands reading the chunks written before this call have been issued by now
+    FenceRegions(GetRegion(buffer_pos));
+
     bool invalidate = false;
     if (buffer_pos + size > buffer_size) {
+        FenceRegions(NUM_REGIONS);
         buffer_pos = 0;
+        used_pos = 0;
+        free_region = 0;
         invalidate = true;
-
-        if (persistent) {
-            glUnmapNamedBuffer(gl_buffer.handle);
-        }
     }
 
-    if (invalidate || !persistent) {
-        MICROPROFILE_SCOPE(OpenGL_StreamBuffer);
-        GLbitfield flags = GL_MAP_WRITE_BIT | (persistent ? GL_MAP_PERSISTENT_BIT : 0) |
-                           (coherent ? GL_MAP_COHERENT_BIT : GL_MAP_FLUSH_EXPLICIT_BIT) |
-                           (invalidate ? GL_MAP_INVALIDATE_BUFFER_BIT : GL_MAP_UNSYNCHRONIZED_BIT);
-        mapped_ptr = static_cast<u8*>(
-            glMapNamedBufferRange(gl_buffer.handle, buffer_pos, buffer_size - buffer_pos, flags));
-        mapped_offset = buffer_pos;
-    }
+    WaitRegions(GetRegion(buffer_pos + std::max<GLsizeiptr>(size, 1) - 1));
 
-    return std::make_tuple(mapped_ptr + buffer_pos - mapped_offset, buffer_pos, invalidate);
+    return std::make_tuple(mapped_ptr + buffer_pos, buffer_pos, invalidate);
 }
 
 void OGLStreamBuffer::Unmap(GLsizeiptr size) {
     ASSERT(size <= mapped_size);
 
     if (!coherent && size > 0) {
-        glFlushMappedNamedBufferRange(gl_buffer.handle, buffer_pos - mapped_offset, size);
+        glFlushMappedNamedBufferRange(gl_buffer.handle, buffer_pos, size);
     }
 
-    if (!persistent) {
-        glUnmapNamedBuffer(gl_buffer.handle);
+    buffer_pos += size;
+}
+
+std::size_t OGLStreamBuffer::GetRegion(GLintptr offset) const {
+    return std::min(static_cast<std::size_t>(offset / region_size), NUM_REGIONS - 1);
+}
+
+void OGLStreamBuffer::FenceRegions(std::size_t end_region) {
+    for (std::size_t region = GetRegion(used_pos); region < end_region; ++region) {
+        fences[region].Create();
     }
+    if (end_region > GetRegion(used_pos)) {
+        used_pos = buffer_pos;
+    }
+}
 
-    buffer_pos += size;
+void OGLStreamBuffer::WaitRegions(std::size_t last_region) {
+    for (; free_region <= last_region; ++free_region) {
+        OGLSync& fence = fences[free_region];
+        if (fence.handle == 0) {
+            continue;
+        }
+        if (glClientWaitSync(fence.handle, 0, 0) == GL_TIMEOUT_EXPIRED) {
+            // Only time spent waiting on the GPU is profiled, signaled fences are cheap to check
+            MICROPROFILE_SCOPE(OpenGL_StreamBuffer);
+            glClientWaitSync(fence.handle, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        }
+        fence.Release();
+    }
 }
 
 } // namespace OpenGL
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <tuple>
 #include <glad/glad.h>
 #include "common/common_types.h"
@@ -11,10 +13,14 @@
 
 namespace OpenGL {
 
+/**
+ * Persistently mapped buffer used as a ring. The ring is split in regions, each guarded by a fence
+ * inserted once the ring moves past it, so reusing a region only waits for the commands that read
+ * from that region.
+ */
 class OGLStreamBuffer : private NonCopyable {
 public:
-    explicit OGLStreamBuffer(GLsizeiptr size, bool vertex_data_usage, bool prefer_coherent = false,
-                             bool use_persistent = true);
+    explicit OGLStreamBuffer(GLsizeiptr size, bool vertex_data_usage, bool prefer_coherent = false);
     ~OGLStreamBuffer();
 
     GLuint GetHandle() const;
@@ -23,7 +29,8 @@ public:
     /*
      * Allocates a linear chunk of memory in the GPU buffer with at least "size" bytes
      * and the optional alignment requirement.
-     * If the buffer is full, the whole buffer is reallocated which invalidates old chunks.
+     * If the end of the buffer is reached, allocation continues from its start once the GPU is done
+     * with the reused regions, which invalidates old chunks.
      * The return values are the pointer to the new chunk, the offset within the buffer,
      * and the invalidation flag for previous chunks.
      * The actual used size must be specified on unmapping the chunk.
@@ -33,16 +40,30 @@ public:
     void Unmap(GLsizeiptr size);
 
 private:
+    static constexpr std::size_t NUM_REGIONS = 16;
+
+    /// Returns the region containing the given offset
+    std::size_t GetRegion(GLintptr offset) const;
+
+    /// Inserts fences for the regions before the given region written since the last fence
+    void FenceRegions(std::size_t end_region);
+
+    /// Waits until the GPU is done reading the regions up to the given region
+    void WaitRegions(std::size_t last_region);
+
     OGLBuffer gl_buffer;
 
     bool coherent = false;
-    bool persistent = false;
 
     GLintptr buffer_pos = 0;
     GLsizeiptr buffer_size = 0;
-    GLintptr mapped_offset = 0;
+    GLsizeiptr region_size = 0;
     GLsizeiptr mapped_size = 0;
     u8* mapped_ptr = nullptr;
+
+    GLintptr used_pos = 0;        ///< Start of the data written after the last inserted fence
+    std::size_t free_region = 0; ///< First region of the ring not yet waited for in this lap
+    std::array<OGLSync, NUM_REGIONS> fences;
 };
 
 } // namespace OpenGL
@@ -2,15 +2,20 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <cstring>
 #include "common/assert.h"
 #include "common/bit_util.h"
 #include "common/common_types.h"
+#include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
 #include "core/core.h"
+#include "core/settings.h"
 #include "video_core/morton.h"
 #include "video_core/renderer_opengl/gl_resource_manager.h"
 #include "video_core/renderer_opengl/gl_state.h"
+#include "video_core/renderer_opengl/gl_stream_buffer.h"
 #include "video_core/renderer_opengl/gl_texture_cache.h"
 #include "video_core/renderer_opengl/utils.h"
 #include "video_core/texture_cache/surface_base.h"
@@ -232,17 +237,42 @@ OGLTexture CreateTexture(const SurfaceParams& params, GLenum target, GLenum inte
     return texture;
 }
 
+/// Attaches a level and layer of a surface to a framebuffer, detaching the other attachments.
+void AttachSurfaceLayer(GLenum framebuffer_target, const CachedSurface& surface, u32 level,
+                        u32 layer) {
+    const auto& params = surface.GetSurfaceParams();
+    GLenum attachment = GL_COLOR_ATTACHMENT0;
+    if (params.type == SurfaceType::Depth) {
+        attachment = GL_DEPTH_ATTACHMENT;
+    } else if (params.type == SurfaceType::DepthStencil) {
+        attachment = GL_DEPTH_STENCIL_ATTACHMENT;
+    }
+    glFramebufferTexture2D(framebuffer_target, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+    glFramebufferTexture2D(framebuffer_target, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, 0, 0);
+    switch (params.target) {
+    case SurfaceTarget::Texture1D:
+    case SurfaceTarget::Texture2D:
+        glFramebufferTexture(framebuffer_target, attachment, surface.GetTexture(), level);
+        break;
+    default:
+        glFramebufferTextureLayer(framebuffer_target, attachment, surface.GetTexture(), level,
+                                  layer);
+        break;
+    }
+}
+
 } // Anonymous namespace
 
-CachedSurface::CachedSurface(const GPUVAddr gpu_addr, const SurfaceParams& params)
-    : VideoCommon::SurfaceBase<View>(gpu_addr, params) {
+CachedSurface::CachedSurface(const GPUVAddr gpu_addr, const SurfaceParams& params,
+                             OGLStreamBuffer& upload_buffer)
+    : VideoCommon::SurfaceBase<View>(gpu_addr, params), upload_buffer{upload_buffer} {
     const auto& tuple{GetFormatTuple(params.pixel_format, params.component_type)};
     internal_format = tuple.internal_format;
     format = tuple.format;
     type = tuple.type;
     is_compressed = tuple.compressed;
     target = GetTextureTarget(params.target);
-    texture = CreateTexture(params, target, internal_format, texture_buffer);
+    texture = CreateTexture(host_params, target, internal_format, texture_buffer);
     DecorateSurfaceName();
     main_view = CreateViewInner(
         ViewParams(params.target, 0, params.is_layered ? params.depth : 1, 0, params.num_levels),
@@ -256,17 +286,17 @@ void CachedSurface::DownloadTexture(std::vector<u8>& staging_buffer) {
 
     SCOPE_EXIT({ glPixelStorei(GL_PACK_ROW_LENGTH, 0); });
 
-    for (u32 level = 0; level < params.emulated_levels; ++level) {
-        glPixelStorei(GL_PACK_ALIGNMENT, std::min(8U, params.GetRowAlignment(level)));
-        glPixelStorei(GL_PACK_ROW_LENGTH, static_cast<GLint>(params.GetMipWidth(level)));
-        const std::size_t mip_offset = params.GetHostMipmapLevelOffset(level);
+    for (u32 level = 0; level < host_params.emulated_levels; ++level) {
+        glPixelStorei(GL_PACK_ALIGNMENT, std::min(8U, host_params.GetRowAlignment(level)));
+        glPixelStorei(GL_PACK_ROW_LENGTH, static_cast<GLint>(host_params.GetMipWidth(level)));
+        const std::size_t mip_offset = host_params.GetHostMipmapLevelOffset(level);
         if (is_compressed) {
             glGetCompressedTextureImage(texture.handle, level,
-                                        static_cast<GLsizei>(params.GetHostMipmapSize(level)),
+                                        static_cast<GLsizei>(host_params.GetHostMipmapSize(level)),
                                         staging_buffer.data() + mip_offset);
         } else {
             glGetTextureImage(texture.handle, level, format, type,
-                              static_cast<GLsizei>(params.GetHostMipmapSize(level)),
+                              static_cast<GLsizei>(host_params.GetHostMipmapSize(level)),
                               staging_buffer.data() + mip_offset);
         }
     }
@@ -275,47 +305,64 @@ void CachedSurface::DownloadTexture(std::vector<u8>& staging_buffer) {
 void CachedSurface::UploadTexture(const std::vector<u8>& staging_buffer) {
     MICROPROFILE_SCOPE(OpenGL_Texture_Upload);
     SCOPE_EXIT({ glPixelStorei(GL_UNPACK_ROW_LENGTH, 0); });
-    for (u32 level = 0; level < params.emulated_levels; ++level) {
-        UploadTextureMipmap(level, staging_buffer);
+
+    // Texture buffers are filled with a buffer write, they can not read from an unpack buffer
+    const auto size = static_cast<GLsizeiptr>(staging_buffer.size());
+    if (host_params.target == SurfaceTarget::TextureBuffer || size > upload_buffer.GetSize()) {
+        for (u32 level = 0; level < host_params.emulated_levels; ++level) {
+            UploadTextureMipmap(level, staging_buffer.data());
+        }
+        return;
+    }
+
+    // Stage the texture in the upload ring, so the driver does not have to copy it synchronously
+    const auto [pointer, offset, invalidated] = upload_buffer.Map(size, 16);
+    std::memcpy(pointer, staging_buffer.data(), staging_buffer.size());
+    upload_buffer.Unmap(size);
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upload_buffer.GetHandle());
+    SCOPE_EXIT({ glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0); });
+    for (u32 level = 0; level < host_params.emulated_levels; ++level) {
+        UploadTextureMipmap(level, reinterpret_cast<const u8*>(offset));
     }
 }
 
-void CachedSurface::UploadTextureMipmap(u32 level, const std::vector<u8>& staging_buffer) {
-    glPixelStorei(GL_UNPACK_ALIGNMENT, std::min(8U, params.GetRowAlignment(level)));
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(params.GetMipWidth(level)));
+void CachedSurface::UploadTextureMipmap(u32 level, const u8* data) {
+    glPixelStorei(GL_UNPACK_ALIGNMENT, std::min(8U, host_params.GetRowAlignment(level)));
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(host_params.GetMipWidth(level)));
 
-    auto compression_type = params.GetCompressionType();
+    auto compression_type = host_params.GetCompressionType();
 
     const std::size_t mip_offset = compression_type == SurfaceCompression::Converted
-                                       ? params.GetConvertedMipmapOffset(level)
-                                       : params.GetHostMipmapLevelOffset(level);
-    const u8* buffer{staging_buffer.data() + mip_offset};
+                                       ? host_params.GetConvertedMipmapOffset(level)
+                                       : host_params.GetHostMipmapLevelOffset(level);
+    const u8* buffer{data + mip_offset};
     if (is_compressed) {
-        const auto image_size{static_cast<GLsizei>(params.GetHostMipmapSize(level))};
-        switch (params.target) {
+        const auto image_size{static_cast<GLsizei>(host_params.GetHostMipmapSize(level))};
+        switch (host_params.target) {
         case SurfaceTarget::Texture2D:
             glCompressedTextureSubImage2D(texture.handle, level, 0, 0,
-                                          static_cast<GLsizei>(params.GetMipWidth(level)),
-                                          static_cast<GLsizei>(params.GetMipHeight(level)),
+                                          static_cast<GLsizei>(host_params.GetMipWidth(level)),
+                                          static_cast<GLsizei>(host_params.GetMipHeight(level)),
                                           internal_format, image_size, buffer);
             break;
         case SurfaceTarget::Texture3D:
         case SurfaceTarget::Texture2DArray:
         case SurfaceTarget::TextureCubeArray:
             glCompressedTextureSubImage3D(texture.handle, level, 0, 0, 0,
-                                          static_cast<GLsizei>(params.GetMipWidth(level)),
-                                          static_cast<GLsizei>(params.GetMipHeight(level)),
-                                          static_cast<GLsizei>(params.GetMipDepth(level)),
+                                          static_cast<GLsizei>(host_params.GetMipWidth(level)),
+                                          static_cast<GLsizei>(host_params.GetMipHeight(level)),
+                                          static_cast<GLsizei>(host_params.GetMipDepth(level)),
                                           internal_format, image_size, buffer);
             break;
         case SurfaceTarget::TextureCubemap: {
-            const std::size_t layer_size{params.GetHostLayerSize(level)};
-            for (std::size_t face = 0; face < params.depth; ++face) {
-                glCompressedTextureSubImage3D(texture.handle, level, 0, 0, static_cast<GLint>(face),
-                                              static_cast<GLsizei>(params.GetMipWidth(level)),
-                                              static_cast<GLsizei>(params.GetMipHeight(level)), 1,
-                                              internal_format, static_cast<GLsizei>(layer_size),
-                                              buffer);
+            const std::size_t layer_size{host_params.GetHostLayerSize(level)};
+            for (std::size_t face = 0; face < host_params.depth; ++face) {
+                glCompressedTextureSubImage3D(
+                    texture.handle, level, 0, 0, static_cast<GLint>(face),
+                    static_cast<GLsizei>(host_params.GetMipWidth(level)),
+                    static_cast<GLsizei>(host_params.GetMipHeight(level)), 1, internal_format,
+                    static_cast<GLsizei>(layer_size), buffer);
                 buffer += layer_size;
             }
             break;
@@ -324,35 +371,37 @@ void CachedSurface::UploadTextureMipmap(u32 level, const std::vector<u8>& stagin
             UNREACHABLE();
         }
     } else {
-        switch (params.target) {
+        switch (host_params.target) {
         case SurfaceTarget::Texture1D:
-            glTextureSubImage1D(texture.handle, level, 0, params.GetMipWidth(level), format, type,
-                                buffer);
+            glTextureSubImage1D(texture.handle, level, 0, host_params.GetMipWidth(level), format,
+                                type, buffer);
             break;
         case SurfaceTarget::TextureBuffer:
             ASSERT(level == 0);
             glNamedBufferSubData(texture_buffer.handle, 0,
-                                 params.GetMipWidth(level) * params.GetBytesPerPixel(), buffer);
+                                 host_params.GetMipWidth(level) * host_params.GetBytesPerPixel(),
+                                 buffer);
             break;
         case SurfaceTarget::Texture1DArray:
         case SurfaceTarget::Texture2D:
-            glTextureSubImage2D(texture.handle, level, 0, 0, params.GetMipWidth(level),
-                                params.GetMipHeight(level), format, type, buffer);
+            glTextureSubImage2D(texture.handle, level, 0, 0, host_params.GetMipWidth(level),
+                                host_params.GetMipHeight(level), format, type, buffer);
             break;
         case SurfaceTarget::Texture3D:
         case SurfaceTarget::Texture2DArray:
         case SurfaceTarget::TextureCubeArray:
-            glTextureSubImage3D(
-                texture.handle, level, 0, 0, 0, static_cast<GLsizei>(params.GetMipWidth(level)),
-                static_cast<GLsizei>(params.GetMipHeight(level)),
-                static_cast<GLsizei>(params.GetMipDepth(level)), format, type, buffer);
+            glTextureSubImage3D(texture.handle, level, 0, 0, 0,
+                                static_cast<GLsizei>(host_params.GetMipWidth(level)),
+                                static_cast<GLsizei>(host_params.GetMipHeight(level)),
+                                static_cast<GLsizei>(host_params.GetMipDepth(level)), format, type,
+                                buffer);
             break;
         case SurfaceTarget::TextureCubemap:
-            for (std::size_t face = 0; face < params.depth; ++face) {
+            for (std::size_t face = 0; face < host_params.depth; ++face) {
                 glTextureSubImage3D(texture.handle, level, 0, 0, static_cast<GLint>(face),
-                                    params.GetMipWidth(level), params.GetMipHeight(level), 1,
-                                    format, type, buffer);
-                buffer += params.GetHostLayerSize(level);
+                                    host_params.GetMipWidth(level),
+                                    host_params.GetMipHeight(level), 1, format, type, buffer);
+                buffer += host_params.GetHostLayerSize(level);
             }
             break;
         default:
@@ -451,16 +500,22 @@ OGLTextureView CachedSurfaceView::CreateTextureView() const {
 
 TextureCacheOpenGL::TextureCacheOpenGL(Core::System& system,
                                        VideoCore::RasterizerInterface& rasterizer,
-                                       const Device& device)
-    : TextureCacheBase{system, rasterizer} {
+                                       const Device& device, OGLStreamBuffer& upload_buffer)
+    : TextureCacheBase{system, rasterizer}, upload_buffer{upload_buffer} {
     src_framebuffer.Create();
     dst_framebuffer.Create();
+
+    if (Settings::values.resolution_factor != 1.0f) {
+        LOG_WARNING(Render_OpenGL,
+                    "Resolution scaling is experimental, shaders using texelFetch, textureSize or "
+                    "gl_FragCoord on scaled render targets see host sizes and may render wrong");
+    }
 }
 
 TextureCacheOpenGL::~TextureCacheOpenGL() = default;
 
 Surface TextureCacheOpenGL::CreateSurface(GPUVAddr gpu_addr, const SurfaceParams& params) {
-    return std::make_shared<CachedSurface>(gpu_addr, params);
+    return std::make_shared<CachedSurface>(gpu_addr, params, upload_buffer);
 }
 
 void TextureCacheOpenGL::ImageCopy(Surface& src_surface, Surface& dst_surface,
@@ -471,15 +526,85 @@ void TextureCacheOpenGL::ImageCopy(Surface& src_surface, Surface& dst_surface,
         // A fallback is needed
         return;
     }
+    if (src_params.resolution_scale != dst_params.resolution_scale) {
+        ScaledImageCopy(src_surface, dst_surface, copy_params);
+        return;
+    }
+    // Both surfaces share the scale, so do their host texture coordinates up to rounding
+    const auto [src_x, src_width] =
+        src_params.ScaleRange(copy_params.source_x, copy_params.width,
+                              src_params.GetHostMipWidth(copy_params.source_level));
+    const auto [src_y, src_height] =
+        src_params.ScaleRange(copy_params.source_y, copy_params.height,
+                              src_params.GetHostMipHeight(copy_params.source_level));
+    const auto [dst_x, dst_width] =
+        dst_params.ScaleRange(copy_params.dest_x, copy_params.width,
+                              dst_params.GetHostMipWidth(copy_params.dest_level));
+    const auto [dst_y, dst_height] =
+        dst_params.ScaleRange(copy_params.dest_y, copy_params.height,
+                              dst_params.GetHostMipHeight(copy_params.dest_level));
+    const u32 width = std::min(src_width, dst_width);
+    const u32 height = std::min(src_height, dst_height);
+    if (width == 0 || height == 0) {
+        // The copied texels collapsed into texels of their neighbours at this scale
+        return;
+    }
+
     const auto src_handle = src_surface->GetTexture();
     const auto src_target = src_surface->GetTarget();
     const auto dst_handle = dst_surface->GetTexture();
     const auto dst_target = dst_surface->GetTarget();
-    glCopyImageSubData(src_handle, src_target, copy_params.source_level, copy_params.source_x,
-                       copy_params.source_y, copy_params.source_z, dst_handle, dst_target,
-                       copy_params.dest_level, copy_params.dest_x, copy_params.dest_y,
-                       copy_params.dest_z, copy_params.width, copy_params.height,
-                       copy_params.depth);
+    glCopyImageSubData(src_handle, src_target, copy_params.source_level, src_x, src_y,
+                       copy_params.source_z, dst_handle, dst_target, copy_params.dest_level, dst_x,
+                       dst_y, copy_params.dest_z, width, height, copy_params.depth);
+}
+
+void TextureCacheOpenGL::ScaledImageCopy(Surface& src_surface, Surface& dst_surface,
+                                         const VideoCommon::CopyParams& copy_params) {
+    const auto& src_params = src_surface->GetSurfaceParams();
+    const auto& dst_params = dst_surface->GetSurfaceParams();
+
+    OpenGLState prev_state{OpenGLState::GetCurState()};
+    SCOPE_EXIT({
+        prev_state.AllDirty();
+        prev_state.Apply();
+    });
+
+    OpenGLState state;
+    state.draw.read_framebuffer = src_framebuffer.handle;
+    state.draw.draw_framebuffer = dst_framebuffer.handle;
+    state.AllDirty();
+    state.Apply();
+
+    GLbitfield buffers = GL_COLOR_BUFFER_BIT;
+    if (src_params.type == SurfaceType::Depth) {
+        buffers = GL_DEPTH_BUFFER_BIT;
+    } else if (src_params.type == SurfaceType::DepthStencil) {
+        buffers = GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT;
+    }
+
+    const auto [src_x, src_width] =
+        src_params.ScaleRange(copy_params.source_x, copy_params.width,
+                              src_params.GetHostMipWidth(copy_params.source_level));
+    const auto [src_y, src_height] =
+        src_params.ScaleRange(copy_params.source_y, copy_params.height,
+                              src_params.GetHostMipHeight(copy_params.source_level));
+    const auto [dst_x, dst_width] =
+        dst_params.ScaleRange(copy_params.dest_x, copy_params.width,
+                              dst_params.GetHostMipWidth(copy_params.dest_level));
+    const auto [dst_y, dst_height] =
+        dst_params.ScaleRange(copy_params.dest_y, copy_params.height,
+                              dst_params.GetHostMipHeight(copy_params.dest_level));
+
+    // Depth and integer formats can't be filtered, texels are picked with nearest filtering
+    for (u32 z = 0; z < copy_params.depth; ++z) {
+        AttachSurfaceLayer(GL_READ_FRAMEBUFFER, *src_surface, copy_params.source_level,
+                           copy_params.source_z + z);
+        AttachSurfaceLayer(GL_DRAW_FRAMEBUFFER, *dst_surface, copy_params.dest_level,
+                           copy_params.dest_z + z);
+        glBlitFramebuffer(src_x, src_y, src_x + src_width, src_y + src_height, dst_x, dst_y,
+                          dst_x + dst_width, dst_y + dst_height, buffers, GL_NEAREST);
+    }
 }
 
 void TextureCacheOpenGL::ImageBlit(View& src_view, View& dst_view,
@@ -534,8 +659,19 @@ void TextureCacheOpenGL::ImageBlit(View& src_view, View& dst_view,
         buffers = GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT;
     }
 
-    const Common::Rectangle<u32>& src_rect = copy_config.src_rect;
-    const Common::Rectangle<u32>& dst_rect = copy_config.dst_rect;
+    // The rectangles are in guest texels, blit between the scaled host textures. Like ScaleRange,
+    // the scaled rectangles are clamped to the host level so rounding never reaches outside it.
+    const auto scale_rect = [](const View& view, const Common::Rectangle<u32>& rect) {
+        const auto& params = view->GetSurfaceParams();
+        const u32 level = view->GetViewParams().base_level;
+        const u32 width = params.GetHostMipWidth(level);
+        const u32 height = params.GetHostMipHeight(level);
+        return Common::Rectangle<u32>{
+            std::min(params.Scale(rect.left), width), std::min(params.Scale(rect.top), height),
+            std::min(params.Scale(rect.right), width), std::min(params.Scale(rect.bottom), height)};
+    };
+    const Common::Rectangle<u32> src_rect = scale_rect(src_view, copy_config.src_rect);
+    const Common::Rectangle<u32> dst_rect = scale_rect(dst_view, copy_config.dst_rect);
     const bool is_linear = copy_config.filter == Tegra::Engines::Fermi2D::Filter::Linear;
 
     glBlitFramebuffer(src_rect.left, src_rect.top, src_rect.right, src_rect.bottom, dst_rect.left,
@@ -572,8 +708,8 @@ void TextureCacheOpenGL::BufferCopy(Surface& src_surface, Surface& dst_surface)
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, copy_pbo_handle);
 
-    const GLsizei width = static_cast<GLsizei>(dst_params.width);
-    const GLsizei height = static_cast<GLsizei>(dst_params.height);
+    const GLsizei width = static_cast<GLsizei>(dst_params.Scale(dst_params.width));
+    const GLsizei height = static_cast<GLsizei>(dst_params.Scale(dst_params.height));
     const GLsizei depth = static_cast<GLsizei>(dst_params.depth);
     if (dest_format.compressed) {
         LOG_CRITICAL(HW_GPU, "Compressed buffer copy is unimplemented!");
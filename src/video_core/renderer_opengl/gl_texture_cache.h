@@ -26,6 +26,7 @@ using VideoCommon::ViewParams;
 
 class CachedSurfaceView;
 class CachedSurface;
+class OGLStreamBuffer;
 class TextureCacheOpenGL;
 
 using Surface = std::shared_ptr<CachedSurface>;
@@ -36,7 +37,8 @@ class CachedSurface final : public VideoCommon::SurfaceBase<View> {
     friend CachedSurfaceView;
 
 public:
-    explicit CachedSurface(GPUVAddr gpu_addr, const SurfaceParams& params);
+    explicit CachedSurface(GPUVAddr gpu_addr, const SurfaceParams& params,
+                           OGLStreamBuffer& upload_buffer);
     ~CachedSurface();
 
     void UploadTexture(const std::vector<u8>& staging_buffer) override;
@@ -57,7 +59,10 @@ protected:
     View CreateViewInner(const ViewParams& view_key, bool is_proxy);
 
 private:
-    void UploadTextureMipmap(u32 level, const std::vector<u8>& staging_buffer);
+    /// Uploads a mipmap level from either host memory or an offset in the bound unpack buffer
+    void UploadTextureMipmap(u32 level, const u8* data);
+
+    OGLStreamBuffer& upload_buffer;
 
     GLenum internal_format{};
     GLenum format{};
@@ -118,7 +123,7 @@ private:
 class TextureCacheOpenGL final : public TextureCacheBase {
 public:
     explicit TextureCacheOpenGL(Core::System& system, VideoCore::RasterizerInterface& rasterizer,
-                                const Device& device);
+                                const Device& device, OGLStreamBuffer& upload_buffer);
     ~TextureCacheOpenGL();
 
 protected:
@@ -133,8 +138,14 @@ protected:
     void BufferCopy(Surface& src_surface, Surface& dst_surface) override;
 
 private:
+    /// Copies between surfaces of different resolution scales, blitting the texels to the
+    /// destination scale.
+    void ScaledImageCopy(Surface& src_surface, Surface& dst_surface,
+                         const VideoCommon::CopyParams& copy_params);
+
     GLuint FetchPBO(std::size_t buffer_size);
 
+    OGLStreamBuffer& upload_buffer;
     OGLFramebuffer src_framebuffer;
     OGLFramebuffer dst_framebuffer;
     std::unordered_map<u32, OGLBuffer> copy_pbo_cache;
@@ -135,7 +135,10 @@ void RendererOpenGL::SwapBuffers(const Tegra::FramebufferConfig* framebuffer) {
 
     render_window.PollEvents();
 
-    system.FrameLimiter().DoFrameLimiting(system.CoreTiming().GetGlobalTimeUs());
+    {
+        Core::PerfStats::ScopedTimer timer{system.GetPerfStats(), Core::PerfSubsystem::Wait};
+        system.FrameLimiter().DoFrameLimiting(system.CoreTiming().GetGlobalTimeUs());
+    }
     system.GetPerfStats().BeginSystemFrame();
 
     // Restore the rasterizer state
@@ -465,7 +468,7 @@ static const char* GetType(GLenum type) {
 
 static void APIENTRY DebugHandler(GLenum source, GLenum type, GLuint id, GLenum severity,
                                   GLsizei length, const GLchar* message, const void* user_param) {
-    const char format[] = "{} {} {}: {}";
+    static constexpr char format[] = "{} {} {}: {}";
     const char* const str_source = GetSource(source);
     const char* const str_type = GetType(type);
 
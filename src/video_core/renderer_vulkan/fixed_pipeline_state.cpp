@@ -0,0 +1,147 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include "common/cityhash.h"
+#include "common/common_types.h"
+#include "video_core/renderer_vulkan/fixed_pipeline_state.h"
+
+namespace Vulkan {
+
+namespace {
+
+FixedPipelineState::VertexInput GetVertexInputState(const Maxwell& regs) {
+    FixedPipelineState::VertexInput vertex_input{};
+    for (std::size_t index = 0; index < Maxwell::NumVertexAttributes; ++index) {
+        const auto& attribute = regs.vertex_attrib_format[index];
+        // Constant attributes are not fetched from vertex arrays
+        vertex_input.attributes[index] = attribute.constant ? 0 : attribute.hex;
+    }
+    for (std::size_t index = 0; index < Maxwell::NumVertexArrays; ++index) {
+        const auto& vertex_array = regs.vertex_array[index];
+        if (!vertex_array.IsEnabled()) {
+            continue;
+        }
+        vertex_input.bindings[index] =
+            vertex_array.stride | FixedPipelineState::VertexInput::BINDING_ENABLE_BIT;
+        if (regs.instanced_arrays.IsInstancingEnabled(static_cast<u32>(index))) {
+            vertex_input.divisors[index] = vertex_array.divisor;
+        }
+    }
+    return vertex_input;
+}
+
+FixedPipelineState::Rasterizer GetRasterizerState(const Maxwell& regs) {
+    FixedPipelineState::Rasterizer rasterizer{};
+    rasterizer.cull_enable = regs.cull.enabled != 0 ? 1 : 0;
+    rasterizer.cull_face = regs.cull.cull_face;
+    rasterizer.front_face = regs.cull.front_face;
+    rasterizer.depth_bias_enable = regs.polygon_offset_point_enable != 0 ||
+                                           regs.polygon_offset_line_enable != 0 ||
+                                           regs.polygon_offset_fill_enable != 0
+                                       ? 1
+                                       : 0;
+    const auto& clip = regs.view_volume_clip_control;
+    rasterizer.depth_clamp_enable = clip.depth_clamp_near != 0 || clip.depth_clamp_far != 0 ? 1 : 0;
+    rasterizer.ndc_minus_one_to_one = clip.depth_range_0_1 == 0 ? 1 : 0;
+    return rasterizer;
+}
+
+FixedPipelineState::DepthStencil GetDepthStencilState(const Maxwell& regs) {
+    FixedPipelineState::DepthStencil depth_stencil{};
+    depth_stencil.depth_test_enable = regs.depth_test_enable != 0 ? 1 : 0;
+    depth_stencil.depth_write_enable = regs.depth_write_enabled != 0 ? 1 : 0;
+    if (depth_stencil.depth_test_enable) {
+        depth_stencil.depth_test_func = regs.depth_test_func;
+    }
+
+    depth_stencil.stencil_enable = regs.stencil_enable != 0 ? 1 : 0;
+    if (!depth_stencil.stencil_enable) {
+        return depth_stencil;
+    }
+    depth_stencil.front = {regs.stencil_front_op_fail, regs.stencil_front_op_zfail,
+                           regs.stencil_front_op_zpass, regs.stencil_front_func_func};
+    if (regs.stencil_two_side_enable) {
+        depth_stencil.back = {regs.stencil_back_op_fail, regs.stencil_back_op_zfail,
+                              regs.stencil_back_op_zpass, regs.stencil_back_func_func};
+    } else {
+        depth_stencil.back = depth_stencil.front;
+    }
+    return depth_stencil;
+}
+
+FixedPipelineState::BlendingAttachment GetBlendingAttachmentState(const Maxwell& regs,
+                                                                  std::size_t index) {
+    FixedPipelineState::BlendingAttachment attachment{};
+
+    const auto& mask = regs.color_mask[regs.color_mask_common ? 0 : index];
+    attachment.components = (mask.R != 0 ? 1 : 0) | (mask.G != 0 ? 2 : 0) |
+                            (mask.B != 0 ? 4 : 0) | (mask.A != 0 ? 8 : 0);
+
+    attachment.enable = regs.blend.enable[regs.independent_blend_enable ? index : 0] != 0 ? 1 : 0;
+    if (!attachment.enable) {
+        return attachment;
+    }
+    if (!regs.independent_blend_enable) {
+        const auto& blend = regs.blend;
+        attachment.rgb_equation = blend.equation_rgb;
+        attachment.src_rgb_func = blend.factor_source_rgb;
+        attachment.dst_rgb_func = blend.factor_dest_rgb;
+        attachment.a_equation = blend.equation_a;
+        attachment.src_a_func = blend.factor_source_a;
+        attachment.dst_a_func = blend.factor_dest_a;
+        return attachment;
+    }
+    const auto& blend = regs.independent_blend[index];
+    attachment.rgb_equation = blend.equation_rgb;
+    attachment.src_rgb_func = blend.factor_source_rgb;
+    attachment.dst_rgb_func = blend.factor_dest_rgb;
+    attachment.a_equation = blend.equation_a;
+    attachment.src_a_func = blend.factor_source_a;
+    attachment.dst_a_func = blend.factor_dest_a;
+    return attachment;
+}
+
+FixedPipelineState::Attachments GetAttachmentsState(const Maxwell& regs) {
+    FixedPipelineState::Attachments attachments{};
+    attachments.num_colors = std::min<u32>(regs.rt_control.count, Maxwell::NumRenderTargets);
+    for (std::size_t index = 0; index < attachments.num_colors; ++index) {
+        attachments.colors[index] = regs.rt[regs.rt_control.GetMap(index)].format;
+    }
+    if (regs.zeta_enable) {
+        attachments.zeta = regs.zeta.format;
+    }
+    return attachments;
+}
+
+} // Anonymous namespace
+
+std::size_t FixedPipelineState::Hash() const {
+    return static_cast<std::size_t>(
+        Common::CityHash64(reinterpret_cast<const char*>(this), sizeof(*this)));
+}
+
+bool FixedPipelineState::operator==(const FixedPipelineState& rhs) const {
+    return std::memcmp(this, &rhs, sizeof(*this)) == 0;
+}
+
+FixedPipelineState GetFixedPipelineState(const Maxwell& regs) {
+    FixedPipelineState state{};
+    state.vertex_input = GetVertexInputState(regs);
+    state.input_assembly.topology = regs.draw.topology;
+    state.input_assembly.primitive_restart_enable = regs.primitive_restart.enabled != 0 ? 1 : 0;
+    state.rasterizer = GetRasterizerState(regs);
+    state.depth_stencil = GetDepthStencilState(regs);
+    for (std::size_t index = 0; index < Maxwell::NumRenderTargets; ++index) {
+        state.color_blending[index] = GetBlendingAttachmentState(regs, index);
+    }
+    state.multisample.alpha_to_coverage_enable =
+        regs.multisample_control.alpha_to_coverage != 0 ? 1 : 0;
+    state.multisample.alpha_to_one_enable = regs.multisample_control.alpha_to_one != 0 ? 1 : 0;
+    state.attachments = GetAttachmentsState(regs);
+    return state;
+}
+
+} // namespace Vulkan
@@ -0,0 +1,122 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+#include "common/common_types.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/gpu.h"
+
+namespace Vulkan {
+
+using Maxwell = Tegra::Engines::Maxwell3D::Regs;
+
+/// Fixed function state baked into a Vulkan pipeline. It's built from the Maxwell registers with
+/// everything Vulkan takes as dynamic state left out, so it can be hashed and compared as raw
+/// memory and stored as is on disk.
+struct FixedPipelineState {
+    struct VertexInput {
+        /// Set in the bindings of enabled vertex arrays
+        static constexpr u32 BINDING_ENABLE_BIT = 1U << 12;
+
+        /// Raw attribute formats, zero for constant attributes
+        std::array<u32, Maxwell::NumVertexAttributes> attributes;
+        /// Vertex array strides with BINDING_ENABLE_BIT set, zero for disabled arrays
+        std::array<u32, Maxwell::NumVertexArrays> bindings;
+        /// Instancing divisors, zero for arrays fetched per vertex
+        std::array<u32, Maxwell::NumVertexArrays> divisors;
+    };
+
+    struct InputAssembly {
+        Maxwell::PrimitiveTopology topology;
+        u32 primitive_restart_enable;
+    };
+
+    struct Rasterizer {
+        u32 cull_enable;
+        Maxwell::Cull::CullFace cull_face;
+        Maxwell::Cull::FrontFace front_face;
+        u32 depth_bias_enable;
+        u32 depth_clamp_enable;
+        u32 ndc_minus_one_to_one;
+    };
+
+    struct StencilFace {
+        Maxwell::StencilOp action_stencil_fail;
+        Maxwell::StencilOp action_depth_fail;
+        Maxwell::StencilOp action_depth_pass;
+        Maxwell::ComparisonOp test_func;
+    };
+
+    struct DepthStencil {
+        u32 depth_test_enable;
+        u32 depth_write_enable;
+        Maxwell::ComparisonOp depth_test_func;
+        u32 stencil_enable;
+        StencilFace front;
+        StencilFace back;
+    };
+
+    struct BlendingAttachment {
+        u32 enable;
+        Maxwell::Blend::Equation rgb_equation;
+        Maxwell::Blend::Factor src_rgb_func;
+        Maxwell::Blend::Factor dst_rgb_func;
+        Maxwell::Blend::Equation a_equation;
+        Maxwell::Blend::Factor src_a_func;
+        Maxwell::Blend::Factor dst_a_func;
+        u32 components; ///< Written components, one bit per component in RGBA order
+    };
+
+    struct Multisample {
+        u32 alpha_to_coverage_enable;
+        u32 alpha_to_one_enable;
+    };
+
+    /// Formats of the attachments, the render pass is built from them
+    struct Attachments {
+        u32 num_colors;
+        std::array<Tegra::RenderTargetFormat, Maxwell::NumRenderTargets> colors;
+        Tegra::DepthFormat zeta; ///< Zero when there's no depth buffer
+    };
+
+    VertexInput vertex_input;
+    InputAssembly input_assembly;
+    Rasterizer rasterizer;
+    DepthStencil depth_stencil;
+    std::array<BlendingAttachment, Maxwell::NumRenderTargets> color_blending;
+    Multisample multisample;
+    Attachments attachments;
+
+    std::size_t Hash() const;
+
+    bool operator==(const FixedPipelineState& rhs) const;
+
+    bool operator!=(const FixedPipelineState& rhs) const {
+        return !operator==(rhs);
+    }
+};
+static_assert(std::has_unique_object_representations_v<FixedPipelineState>,
+              "FixedPipelineState has padding bytes and can't be hashed as raw memory");
+static_assert(std::is_trivially_copyable_v<FixedPipelineState>);
+
+/// Returns the fixed pipeline state of the current Maxwell registers.
+FixedPipelineState GetFixedPipelineState(const Maxwell& regs);
+
+} // namespace Vulkan
+
+namespace std {
+
+template <>
+struct hash<Vulkan::FixedPipelineState> {
+    std::size_t operator()(const Vulkan::FixedPipelineState& k) const noexcept {
+        return k.Hash();
+    }
+};
+
+} // namespace std
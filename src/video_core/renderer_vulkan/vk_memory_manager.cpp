@@ -2,17 +2,14 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
-#include <algorithm>
-#include <optional>
-#include <tuple>
 #include <vector>
-#include "common/alignment.h"
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/logging/log.h"
 #include "video_core/renderer_vulkan/declarations.h"
 #include "video_core/renderer_vulkan/vk_device.h"
 #include "video_core/renderer_vulkan/vk_memory_manager.h"
+#include "video_core/tlsf_allocator.h"
 
 namespace Vulkan {
 
@@ -42,38 +39,26 @@ public:
     }
 
     VKMemoryCommit Commit(vk::DeviceSize commit_size, vk::DeviceSize alignment) {
-        auto found = TryFindFreeSection(free_iterator, alloc_size, static_cast<u64>(commit_size),
-                                        static_cast<u64>(alignment));
-        if (!found) {
-            found = TryFindFreeSection(0, free_iterator, static_cast<u64>(commit_size),
-                                       static_cast<u64>(alignment));
-            if (!found) {
-                // Signal out of memory, it'll try to do more allocations.
-                return nullptr;
-            }
+        const auto allocation =
+            allocator.Allocate(static_cast<u64>(commit_size), static_cast<u64>(alignment));
+        if (!allocation) {
+            // Signal out of memory, it'll try to do more allocations.
+            return nullptr;
         }
-        u8* address = is_mappable ? base_address + *found : nullptr;
-        auto commit = std::make_unique<VKMemoryCommitImpl>(this, memory, address, *found,
-                                                           *found + commit_size);
-        commits.push_back(commit.get());
-
-        // Last commit's address is highly probable to be free.
-        free_iterator = *found + commit_size;
-
-        return commit;
+        u8* address = is_mappable ? base_address + allocation->offset : nullptr;
+        return std::make_unique<VKMemoryCommitImpl>(this, memory, address, allocation->offset,
+                                                    allocation->offset + commit_size,
+                                                    allocation->handle);
     }
 
     void Free(const VKMemoryCommitImpl* commit) {
         ASSERT(commit);
-        const auto it =
-            std::find_if(commits.begin(), commits.end(),
-                         [&](const auto& stored_commit) { return stored_commit == commit; });
-        if (it == commits.end()) {
-            LOG_CRITICAL(Render_Vulkan, "Freeing unallocated commit!");
-            UNREACHABLE();
-            return;
-        }
-        commits.erase(it);
+        allocator.Free(commit->handle);
+    }
+
+    /// Returns the occupancy and fragmentation of this allocation.
+    VideoCommon::TlsfAllocator::Stats GetStats() const {
+        return allocator.GetStats();
     }
 
     /// Returns whether this allocation is compatible with the arguments.
@@ -87,33 +72,6 @@ private:
         return 1U << type;
     }
 
-    /// A memory allocator, it may return a free region between "start" and "end" with the solicited
-    /// requeriments.
-    std::optional<u64> TryFindFreeSection(u64 start, u64 end, u64 size, u64 alignment) const {
-        u64 iterator = start;
-        while (iterator + size < end) {
-            const u64 try_left = Common::AlignUp(iterator, alignment);
-            const u64 try_right = try_left + size;
-
-            bool overlap = false;
-            for (const auto& commit : commits) {
-                const auto [commit_left, commit_right] = commit->interval;
-                if (try_left < commit_right && commit_left < try_right) {
-                    // There's an overlap, continue the search where the overlapping commit ends.
-                    iterator = commit_right;
-                    overlap = true;
-                    break;
-                }
-            }
-            if (!overlap) {
-                // A free address has been found.
-                return try_left;
-            }
-        }
-        // No free regions where found, return an empty optional.
-        return std::nullopt;
-    }
-
     const VKDevice& device;                   ///< Vulkan device.
     const vk::DeviceMemory memory;            ///< Vulkan memory allocation handler.
     const vk::MemoryPropertyFlags properties; ///< Vulkan properties.
@@ -124,11 +82,8 @@ private:
     /// Base address of the mapped pointer.
     u8* base_address{};
 
-    /// Hints where the next free region is likely going to be.
-    u64 free_iterator{};
-
-    /// Stores all commits done from this allocation.
-    std::vector<const VKMemoryCommitImpl*> commits;
+    /// Sub-allocator of the commits done from this allocation.
+    VideoCommon::TlsfAllocator allocator{alloc_size};
 };
 
 VKMemoryManager::VKMemoryManager(const VKDevice& device)
@@ -163,7 +118,18 @@ VKMemoryCommit VKMemoryManager::Commit(const vk::MemoryRequirements& reqs, bool
         return commit;
     }
 
-    // Commit has failed, allocate more memory.
+    // Commit has failed, log why the compatible allocations couldn't serve it and allocate more
+    // memory.
+    for (const auto& alloc : allocs) {
+        if (!alloc->IsCompatible(wanted_properties, reqs.memoryTypeBits))
+            continue;
+        const auto stats = alloc->GetStats();
+        LOG_DEBUG(Render_Vulkan,
+                  "Allocation with {} of {} bytes used by {} commits, largest free block of {} "
+                  "bytes in {} blocks, fragmentation {:.2f}",
+                  stats.used_size, stats.total_size, stats.num_allocations,
+                  stats.largest_free_block, stats.num_free_blocks, stats.Fragmentation());
+    }
     if (!AllocMemory(wanted_properties, reqs.memoryTypeBits, ALLOC_CHUNK_SIZE)) {
         // TODO(Rodrigo): Try to use host memory.
         LOG_CRITICAL(Render_Vulkan, "Ran out of memory!");
@@ -237,8 +203,9 @@ bool VKMemoryManager::AllocMemory(vk::MemoryPropertyFlags wanted_properties, u32
 }
 
 VKMemoryCommitImpl::VKMemoryCommitImpl(VKMemoryAllocation* allocation, vk::DeviceMemory memory,
-                                       u8* data, u64 begin, u64 end)
-    : interval(std::make_pair(begin, end)), memory{memory}, allocation{allocation}, data{data} {}
+                                       u8* data, u64 begin, u64 end, u32 handle)
+    : interval(std::make_pair(begin, end)), memory{memory}, allocation{allocation}, data{data},
+      handle{handle} {}
 
 VKMemoryCommitImpl::~VKMemoryCommitImpl() {
     allocation->Free(this);
@@ -61,7 +61,7 @@ class VKMemoryCommitImpl final {
 
 public:
     explicit VKMemoryCommitImpl(VKMemoryAllocation* allocation, vk::DeviceMemory memory, u8* data,
-                                u64 begin, u64 end);
+                                u64 begin, u64 end, u32 handle);
     ~VKMemoryCommitImpl();
 
     /// Returns the writeable memory map. The commit has to be mappable.
@@ -82,6 +82,7 @@ private:
     vk::DeviceMemory memory;          ///< Vulkan device memory handler.
     VKMemoryAllocation* allocation{}; ///< Pointer to the large memory allocation.
     u8* data{}; ///< Pointer to the host mapped memory, it has the commit offset included.
+    u32 handle{}; ///< Handle of the commit in the allocation's sub-allocator.
 };
 
 } // namespace Vulkan
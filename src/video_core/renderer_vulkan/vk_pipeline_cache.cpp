@@ -0,0 +1,668 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <sirit/sirit.h>
+
+#include "common/assert.h"
+#include "common/cityhash.h"
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "core/core.h"
+#include "core/hle/kernel/process.h"
+#include "core/settings.h"
+#include "video_core/renderer_vulkan/declarations.h"
+#include "video_core/renderer_vulkan/fixed_pipeline_state.h"
+#include "video_core/renderer_vulkan/maxwell_to_vk.h"
+#include "video_core/renderer_vulkan/vk_device.h"
+#include "video_core/renderer_vulkan/vk_pipeline_cache.h"
+#include "video_core/renderer_vulkan/vk_shader_decompiler.h"
+#include "video_core/surface.h"
+
+namespace Vulkan {
+
+namespace {
+
+using VideoCore::Surface::ComponentTypeFromDepthFormat;
+using VideoCore::Surface::ComponentTypeFromRenderTarget;
+using VideoCore::Surface::PixelFormatFromDepthFormat;
+using VideoCore::Surface::PixelFormatFromRenderTargetFormat;
+
+// Increment this when the pipelines file layout or the fixed pipeline state changes
+constexpr u32 NativeVersion = 2;
+
+spv::ExecutionModel GetExecutionModel(Maxwell::ShaderStage stage) {
+    switch (stage) {
+    case Maxwell::ShaderStage::Vertex:
+        return spv::ExecutionModel::Vertex;
+    case Maxwell::ShaderStage::TesselationControl:
+        return spv::ExecutionModel::TessellationControl;
+    case Maxwell::ShaderStage::TesselationEval:
+        return spv::ExecutionModel::TessellationEvaluation;
+    case Maxwell::ShaderStage::Geometry:
+        return spv::ExecutionModel::Geometry;
+    case Maxwell::ShaderStage::Fragment:
+        return spv::ExecutionModel::Fragment;
+    }
+    UNREACHABLE_MSG("Invalid shader stage={}", static_cast<u32>(stage));
+    return spv::ExecutionModel::Vertex;
+}
+
+vk::ColorComponentFlags GetColorComponents(u32 components) {
+    vk::ColorComponentFlags flags;
+    if (components & 1)
+        flags |= vk::ColorComponentFlagBits::eR;
+    if (components & 2)
+        flags |= vk::ColorComponentFlagBits::eG;
+    if (components & 4)
+        flags |= vk::ColorComponentFlagBits::eB;
+    if (components & 8)
+        flags |= vk::ColorComponentFlagBits::eA;
+    return flags;
+}
+
+vk::StencilOpState GetStencilFaceState(const FixedPipelineState::StencilFace& face) {
+    // Masks and reference are dynamic state
+    return vk::StencilOpState(MaxwellToVK::StencilOp(face.action_stencil_fail),
+                              MaxwellToVK::StencilOp(face.action_depth_pass),
+                              MaxwellToVK::StencilOp(face.action_depth_fail),
+                              MaxwellToVK::ComparisonOp(face.test_func), 0, 0, 0);
+}
+
+/// Header of the pipelines file, entries built for another layout of the key are discarded
+struct PipelinesFileHeader {
+    u32 version;
+    u32 key_size;
+};
+
+/// Header of each entry of the pipelines file, followed by the entry itself
+struct PipelineEntryHeader {
+    u32 size;
+    INSERT_PADDING_WORDS(1);
+    u64 checksum; ///< CityHash64 of the entry, guards against truncated or corrupt entries
+};
+static_assert(sizeof(PipelineEntryHeader) == 16, "PipelineEntryHeader has incorrect size.");
+
+template <typename T>
+void AppendArray(std::vector<u8>& buffer, const T* data, std::size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const std::size_t offset = buffer.size();
+    buffer.resize(offset + count * sizeof(T));
+    std::memcpy(buffer.data() + offset, data, count * sizeof(T));
+}
+
+template <typename T>
+void AppendObject(std::vector<u8>& buffer, const T& object) {
+    AppendArray(buffer, &object, 1);
+}
+
+/// Reads objects from a pipelines file entry, failing once the entry runs out of bytes
+class EntryReader {
+public:
+    explicit EntryReader(const std::vector<u8>& entry) : entry{entry} {}
+
+    template <typename T>
+    bool ReadArray(T* data, std::size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (count > (entry.size() - offset) / sizeof(T)) {
+            return false;
+        }
+        std::memcpy(data, entry.data() + offset, count * sizeof(T));
+        offset += count * sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    bool ReadObject(T& object) {
+        return ReadArray(&object, 1);
+    }
+
+    bool IsEnd() const {
+        return offset == entry.size();
+    }
+
+private:
+    const std::vector<u8>& entry;
+    std::size_t offset = 0;
+};
+
+std::vector<u8> SerializeDescription(const GraphicsPipelineDescription& description) {
+    std::vector<u8> entry;
+    AppendObject(entry, description.key);
+    AppendObject(entry, static_cast<u32>(description.stages.size()));
+    for (const auto& stage : description.stages) {
+        AppendObject(entry, static_cast<u32>(stage.stage));
+        AppendObject(entry, static_cast<u32>(stage.code.size()));
+        AppendArray(entry, stage.code.data(), stage.code.size());
+        AppendObject(entry, static_cast<u32>(stage.bindings.size()));
+        AppendArray(entry, stage.bindings.data(), stage.bindings.size());
+    }
+    return entry;
+}
+
+std::optional<GraphicsPipelineDescription> DeserializeDescription(const std::vector<u8>& entry) {
+    EntryReader reader(entry);
+    GraphicsPipelineDescription description;
+    u32 num_stages{};
+    if (!reader.ReadObject(description.key) || !reader.ReadObject(num_stages) ||
+        num_stages > Maxwell::MaxShaderStage) {
+        return std::nullopt;
+    }
+    description.stages.resize(num_stages);
+    for (auto& stage : description.stages) {
+        u32 stage_index{};
+        u32 code_size{};
+        if (!reader.ReadObject(stage_index) || stage_index >= Maxwell::MaxShaderStage ||
+            !reader.ReadObject(code_size) || code_size > entry.size() / sizeof(u32)) {
+            return std::nullopt;
+        }
+        stage.stage = static_cast<Maxwell::ShaderStage>(stage_index);
+        stage.code.resize(code_size);
+
+        u32 num_bindings{};
+        if (!reader.ReadArray(stage.code.data(), code_size) || !reader.ReadObject(num_bindings) ||
+            num_bindings > entry.size() / sizeof(DescriptorBinding)) {
+            return std::nullopt;
+        }
+        stage.bindings.resize(num_bindings);
+        if (!reader.ReadArray(stage.bindings.data(), num_bindings)) {
+            return std::nullopt;
+        }
+    }
+    if (!reader.IsEnd()) {
+        return std::nullopt;
+    }
+    return description;
+}
+
+} // Anonymous namespace
+
+std::size_t GraphicsPipelineCacheKey::Hash() const {
+    return static_cast<std::size_t>(
+        Common::CityHash64(reinterpret_cast<const char*>(this), sizeof(*this)));
+}
+
+bool GraphicsPipelineCacheKey::operator==(const GraphicsPipelineCacheKey& rhs) const {
+    return std::memcmp(this, &rhs, sizeof(*this)) == 0;
+}
+
+PipelineShaderStage MakePipelineShaderStage(Maxwell::ShaderStage stage, Sirit::Module& module,
+                                            const VKShader::ShaderEntries& entries) {
+    UNIMPLEMENTED_IF_MSG(stage == Maxwell::ShaderStage::Geometry,
+                         "Geometry shaders are not supported by the decompiler");
+    module.AddEntryPoint(GetExecutionModel(stage), entries.entry_function, "main",
+                         entries.interfaces);
+    if (stage == Maxwell::ShaderStage::Fragment) {
+        module.AddExecutionMode(entries.entry_function, spv::ExecutionMode::OriginUpperLeft);
+    }
+
+    PipelineShaderStage result;
+    result.stage = stage;
+    result.code = module.Assemble();
+
+    const auto AddBindings = [&result](u32 base_binding, std::size_t count,
+                                       vk::DescriptorType type) {
+        for (std::size_t i = 0; i < count; ++i) {
+            result.bindings.push_back({base_binding + static_cast<u32>(i), type});
+        }
+    };
+    AddBindings(entries.const_buffers_base_binding, entries.const_buffers.size(),
+                vk::DescriptorType::eUniformBuffer);
+    AddBindings(entries.global_buffers_base_binding, entries.global_buffers.size(),
+                vk::DescriptorType::eStorageBuffer);
+    AddBindings(entries.samplers_base_binding, entries.samplers.size(),
+                vk::DescriptorType::eCombinedImageSampler);
+    return result;
+}
+
+VKGraphicsPipeline::VKGraphicsPipeline(const VKDevice& device, vk::PipelineCache pipeline_cache,
+                                       const GraphicsPipelineDescription& description)
+    : device{device}, descriptor_set_layout{CreateDescriptorSetLayout(description.stages)},
+      layout{CreatePipelineLayout()},
+      renderpass{CreateRenderPass(description.key.fixed_state.attachments)},
+      pipeline{CreatePipeline(pipeline_cache, description)} {}
+
+VKGraphicsPipeline::~VKGraphicsPipeline() = default;
+
+UniqueDescriptorSetLayout VKGraphicsPipeline::CreateDescriptorSetLayout(
+    const std::vector<PipelineShaderStage>& stages) const {
+    std::vector<vk::DescriptorSetLayoutBinding> bindings;
+    for (const auto& stage : stages) {
+        const vk::ShaderStageFlags stage_flags = MaxwellToVK::ShaderStage(stage.stage);
+        for (const auto& binding : stage.bindings) {
+            bindings.emplace_back(binding.binding, binding.type, 1, stage_flags, nullptr);
+        }
+    }
+
+    const vk::DescriptorSetLayoutCreateInfo descriptor_set_layout_ci(
+        {}, static_cast<u32>(bindings.size()), bindings.data());
+    const auto dev = device.GetLogical();
+    const auto& dld = device.GetDispatchLoader();
+    return dev.createDescriptorSetLayoutUnique(descriptor_set_layout_ci, nullptr, dld);
+}
+
+UniquePipelineLayout VKGraphicsPipeline::CreatePipelineLayout() const {
+    const vk::DescriptorSetLayout set_layout = *descriptor_set_layout;
+    const vk::PipelineLayoutCreateInfo layout_ci({}, 1, &set_layout, 0, nullptr);
+    const auto dev = device.GetLogical();
+    const auto& dld = device.GetDispatchLoader();
+    return dev.createPipelineLayoutUnique(layout_ci, nullptr, dld);
+}
+
+UniqueRenderPass VKGraphicsPipeline::CreateRenderPass(
+    const FixedPipelineState::Attachments& attachments) const {
+    std::vector<vk::AttachmentDescription> descriptions;
+    std::vector<vk::AttachmentReference> color_references;
+    for (u32 rt = 0; rt < attachments.num_colors; ++rt) {
+        const auto format = attachments.colors[rt];
+        if (format == Tegra::RenderTargetFormat::NONE) {
+            color_references.emplace_back(VK_ATTACHMENT_UNUSED, vk::ImageLayout::eUndefined);
+            continue;
+        }
+        const auto [vk_format, attachable] = MaxwellToVK::SurfaceFormat(
+            device, FormatType::Optimal, PixelFormatFromRenderTargetFormat(format),
+            ComponentTypeFromRenderTarget(format));
+        ASSERT_MSG(attachable, "Render target format={} is not attachable",
+                   static_cast<u32>(format));
+
+        color_references.emplace_back(static_cast<u32>(descriptions.size()),
+                                      vk::ImageLayout::eGeneral);
+        descriptions.emplace_back(vk::AttachmentDescriptionFlags{}, vk_format,
+                                  vk::SampleCountFlagBits::e1, vk::AttachmentLoadOp::eLoad,
+                                  vk::AttachmentStoreOp::eStore, vk::AttachmentLoadOp::eDontCare,
+                                  vk::AttachmentStoreOp::eDontCare, vk::ImageLayout::eGeneral,
+                                  vk::ImageLayout::eGeneral);
+    }
+
+    const bool has_zeta = attachments.zeta != Tegra::DepthFormat{};
+    const vk::AttachmentReference zeta_reference(static_cast<u32>(descriptions.size()),
+                                                 vk::ImageLayout::eGeneral);
+    if (has_zeta) {
+        const auto [vk_format, attachable] = MaxwellToVK::SurfaceFormat(
+            device, FormatType::Optimal, PixelFormatFromDepthFormat(attachments.zeta),
+            ComponentTypeFromDepthFormat(attachments.zeta));
+        ASSERT_MSG(attachable, "Depth format={} is not attachable",
+                   static_cast<u32>(attachments.zeta));
+
+        descriptions.emplace_back(vk::AttachmentDescriptionFlags{}, vk_format,
+                                  vk::SampleCountFlagBits::e1, vk::AttachmentLoadOp::eLoad,
+                                  vk::AttachmentStoreOp::eStore, vk::AttachmentLoadOp::eLoad,
+                                  vk::AttachmentStoreOp::eStore, vk::ImageLayout::eGeneral,
+                                  vk::ImageLayout::eGeneral);
+    }
+
+    const vk::SubpassDescription subpass_description(
+        {}, vk::PipelineBindPoint::eGraphics, 0, nullptr,
+        static_cast<u32>(color_references.size()), color_references.data(), nullptr,
+        has_zeta ? &zeta_reference : nullptr, 0, nullptr);
+
+    const vk::RenderPassCreateInfo renderpass_ci({}, static_cast<u32>(descriptions.size()),
+                                                 descriptions.data(), 1, &subpass_description, 0,
+                                                 nullptr);
+    const auto dev = device.GetLogical();
+    const auto& dld = device.GetDispatchLoader();
+    return dev.createRenderPassUnique(renderpass_ci, nullptr, dld);
+}
+
+UniquePipeline VKGraphicsPipeline::CreatePipeline(
+    vk::PipelineCache pipeline_cache, const GraphicsPipelineDescription& description) const {
+    const auto& state = description.key.fixed_state;
+    const auto& vi = state.vertex_input;
+    const auto dev = device.GetLogical();
+    const auto& dld = device.GetDispatchLoader();
+
+    std::vector<vk::VertexInputBindingDescription> vertex_bindings;
+    for (u32 index = 0; index < Maxwell::NumVertexArrays; ++index) {
+        const u32 binding = vi.bindings[index];
+        if ((binding & FixedPipelineState::VertexInput::BINDING_ENABLE_BIT) == 0) {
+            continue;
+        }
+        const u32 divisor = vi.divisors[index];
+        if (divisor > 1) {
+            LOG_WARNING(Render_Vulkan, "Unimplemented instancing divisor={}", divisor);
+        }
+        vertex_bindings.emplace_back(
+            index, binding & ~FixedPipelineState::VertexInput::BINDING_ENABLE_BIT,
+            divisor != 0 ? vk::VertexInputRate::eInstance : vk::VertexInputRate::eVertex);
+    }
+
+    std::vector<vk::VertexInputAttributeDescription> vertex_attributes;
+    for (u32 index = 0; index < Maxwell::NumVertexAttributes; ++index) {
+        if (vi.attributes[index] == 0) {
+            continue;
+        }
+        Maxwell::VertexAttribute attribute{};
+        attribute.hex = vi.attributes[index];
+        if ((vi.bindings[attribute.buffer] &
+             FixedPipelineState::VertexInput::BINDING_ENABLE_BIT) == 0) {
+            continue;
+        }
+        vertex_attributes.emplace_back(index, attribute.buffer,
+                                       MaxwellToVK::VertexFormat(attribute.type, attribute.size),
+                                       attribute.offset);
+    }
+
+    const vk::PipelineVertexInputStateCreateInfo vertex_input_ci(
+        {}, static_cast<u32>(vertex_bindings.size()), vertex_bindings.data(),
+        static_cast<u32>(vertex_attributes.size()), vertex_attributes.data());
+
+    const vk::PipelineInputAssemblyStateCreateInfo input_assembly_ci(
+        {}, MaxwellToVK::PrimitiveTopology(state.input_assembly.topology),
+        state.input_assembly.primitive_restart_enable != 0);
+
+    // Viewports and scissors are dynamic state
+    const vk::PipelineViewportStateCreateInfo viewport_ci({}, 1, nullptr, 1, nullptr);
+
+    const auto& rs = state.rasterizer;
+    const vk::PipelineRasterizationStateCreateInfo rasterizer_ci(
+        {}, rs.depth_clamp_enable != 0, false, vk::PolygonMode::eFill,
+        rs.cull_enable != 0 ? MaxwellToVK::CullFace(rs.cull_face) : vk::CullModeFlagBits::eNone,
+        MaxwellToVK::FrontFace(rs.front_face), rs.depth_bias_enable != 0, 0.0f, 0.0f, 0.0f, 1.0f);
+
+    const vk::PipelineMultisampleStateCreateInfo multisampling_ci(
+        {}, vk::SampleCountFlagBits::e1, false, 0.0f, nullptr,
+        state.multisample.alpha_to_coverage_enable != 0,
+        state.multisample.alpha_to_one_enable != 0);
+
+    const auto& ds = state.depth_stencil;
+    const bool depth_test = ds.depth_test_enable != 0;
+    const bool stencil_test = ds.stencil_enable != 0;
+    const vk::PipelineDepthStencilStateCreateInfo depth_stencil_ci(
+        {}, depth_test, ds.depth_write_enable != 0,
+        depth_test ? MaxwellToVK::ComparisonOp(ds.depth_test_func) : vk::CompareOp::eAlways,
+        false, stencil_test, stencil_test ? GetStencilFaceState(ds.front) : vk::StencilOpState{},
+        stencil_test ? GetStencilFaceState(ds.back) : vk::StencilOpState{}, 0.0f, 0.0f);
+
+    std::vector<vk::PipelineColorBlendAttachmentState> blend_attachments;
+    for (u32 rt = 0; rt < state.attachments.num_colors; ++rt) {
+        const auto& blend = state.color_blending[rt];
+        const auto components = GetColorComponents(blend.components);
+        if (!blend.enable) {
+            blend_attachments.emplace_back(false, vk::BlendFactor::eOne, vk::BlendFactor::eZero,
+                                           vk::BlendOp::eAdd, vk::BlendFactor::eOne,
+                                           vk::BlendFactor::eZero, vk::BlendOp::eAdd, components);
+            continue;
+        }
+        blend_attachments.emplace_back(
+            true, MaxwellToVK::BlendFactor(blend.src_rgb_func),
+            MaxwellToVK::BlendFactor(blend.dst_rgb_func),
+            MaxwellToVK::BlendEquation(blend.rgb_equation),
+            MaxwellToVK::BlendFactor(blend.src_a_func), MaxwellToVK::BlendFactor(blend.dst_a_func),
+            MaxwellToVK::BlendEquation(blend.a_equation), components);
+    }
+    const vk::PipelineColorBlendStateCreateInfo color_blending_ci(
+        {}, false, vk::LogicOp::eCopy, static_cast<u32>(blend_attachments.size()),
+        blend_attachments.data(), {});
+
+    const std::array dynamic_states = {
+        vk::DynamicState::eViewport,           vk::DynamicState::eScissor,
+        vk::DynamicState::eDepthBias,          vk::DynamicState::eBlendConstants,
+        vk::DynamicState::eDepthBounds,        vk::DynamicState::eStencilCompareMask,
+        vk::DynamicState::eStencilWriteMask,   vk::DynamicState::eStencilReference};
+    const vk::PipelineDynamicStateCreateInfo dynamic_state_ci(
+        {}, static_cast<u32>(dynamic_states.size()), dynamic_states.data());
+
+    // Modules are only needed while the pipeline is being created
+    std::vector<UniqueShaderModule> modules;
+    std::vector<vk::PipelineShaderStageCreateInfo> shader_stages;
+    for (const auto& stage : description.stages) {
+        const vk::ShaderModuleCreateInfo module_ci({}, stage.code.size() * sizeof(u32),
+                                                   stage.code.data());
+        modules.push_back(dev.createShaderModuleUnique(module_ci, nullptr, dld));
+        shader_stages.emplace_back(vk::PipelineShaderStageCreateFlags{},
+                                   MaxwellToVK::ShaderStage(stage.stage), *modules.back(), "main",
+                                   nullptr);
+    }
+
+    const vk::GraphicsPipelineCreateInfo create_info(
+        {}, static_cast<u32>(shader_stages.size()), shader_stages.data(), &vertex_input_ci,
+        &input_assembly_ci, nullptr, &viewport_ci, &rasterizer_ci, &multisampling_ci,
+        &depth_stencil_ci, &color_blending_ci, &dynamic_state_ci, *layout, *renderpass, 0, {},
+        0);
+    return dev.createGraphicsPipelineUnique(pipeline_cache, create_info, nullptr, dld);
+}
+
+VKPipelineCache::VKPipelineCache(Core::System& system, const VKDevice& device)
+    : system{system}, device{device} {}
+
+VKPipelineCache::~VKPipelineCache() {
+    stop_building = true;
+    if (build_thread.joinable()) {
+        build_thread.join();
+    }
+    SaveDriverCache();
+}
+
+void VKPipelineCache::LoadDiskResources() {
+    // The process may be gone by the time the cache is destroyed and the driver cache is saved
+    const auto process = system.CurrentProcess();
+    title_id = process != nullptr ? process->GetTitleID() : 0;
+
+    std::vector<u8> driver_cache;
+    std::vector<GraphicsPipelineDescription> descriptions;
+    if (IsUsable()) {
+        FileUtil::IOFile file(GetDriverCachePath(), "rb");
+        if (file.IsOpen()) {
+            driver_cache.resize(file.GetSize());
+            if (file.ReadBytes(driver_cache.data(), driver_cache.size()) != driver_cache.size()) {
+                LOG_ERROR(Render_Vulkan, "Failed to read driver pipeline cache - skipping");
+                driver_cache.clear();
+            }
+        }
+        descriptions = LoadRecordedPipelines();
+    }
+
+    // Drivers validate the header of the blob and ignore it when it's from another device or
+    // driver version
+    const vk::PipelineCacheCreateInfo pipeline_cache_ci({}, driver_cache.size(),
+                                                       driver_cache.data());
+    const auto dev = device.GetLogical();
+    const auto& dld = device.GetDispatchLoader();
+    pipeline_cache = dev.createPipelineCacheUnique(pipeline_cache_ci, nullptr, dld);
+
+    if (descriptions.empty()) {
+        return;
+    }
+    LOG_INFO(Render_Vulkan, "Building {} pipelines recorded in previous sessions",
+             descriptions.size());
+    for (const auto& description : descriptions) {
+        recorded.insert(description.key);
+    }
+    build_thread = std::thread(&VKPipelineCache::BuildRecordedPipelines, this,
+                               std::move(descriptions));
+}
+
+VKGraphicsPipeline& VKPipelineCache::GetGraphicsPipeline(
+    const GraphicsPipelineDescription& description) {
+    ASSERT_MSG(pipeline_cache, "Pipelines requested before loading disk resources");
+    {
+        std::lock_guard lock{pipelines_mutex};
+        const auto it = pipelines.find(description.key);
+        if (it != pipelines.end()) {
+            return *it->second;
+        }
+    }
+
+    // Build pipelines missing from the cache in this thread, even when the background thread is
+    // going to build it, to avoid waiting for the pipelines queued before it
+    VKGraphicsPipeline& pipeline = BuildPipeline(description);
+    if (recorded.insert(description.key).second) {
+        RecordPipeline(description);
+    }
+    return pipeline;
+}
+
+void VKPipelineCache::BuildRecordedPipelines(
+    std::vector<GraphicsPipelineDescription> descriptions) {
+    Common::SetCurrentThreadName("yuzu:PipelineBuilder");
+    for (const auto& description : descriptions) {
+        if (stop_building) {
+            return;
+        }
+        {
+            std::lock_guard lock{pipelines_mutex};
+            if (pipelines.find(description.key) != pipelines.end()) {
+                continue;
+            }
+        }
+        try {
+            BuildPipeline(description);
+        } catch (const vk::SystemError& error) {
+            LOG_ERROR(Render_Vulkan, "Failed to build recorded pipeline: {}", error.what());
+        }
+    }
+    LOG_INFO(Render_Vulkan, "Finished building recorded pipelines");
+}
+
+VKGraphicsPipeline& VKPipelineCache::BuildPipeline(
+    const GraphicsPipelineDescription& description) {
+    auto pipeline = std::make_unique<VKGraphicsPipeline>(device, *pipeline_cache, description);
+
+    std::lock_guard lock{pipelines_mutex};
+    const auto [it, is_new] = pipelines.emplace(description.key, std::move(pipeline));
+    return *it->second;
+}
+
+std::vector<GraphicsPipelineDescription> VKPipelineCache::LoadRecordedPipelines() {
+    const std::string path = GetPipelinesPath();
+    FileUtil::IOFile file(path, "rb");
+    if (!file.IsOpen()) {
+        LOG_INFO(Render_Vulkan, "No pipeline cache found for game with title id={}",
+                 GetTitleID());
+        return {};
+    }
+
+    PipelinesFileHeader header{};
+    if (file.ReadBytes(&header, sizeof(header)) != sizeof(header) ||
+        header.version != NativeVersion || header.key_size != sizeof(GraphicsPipelineCacheKey)) {
+        LOG_INFO(Render_Vulkan, "Pipeline cache is invalid or from another version - removing");
+        file.Close();
+        FileUtil::Delete(path);
+        return {};
+    }
+
+    std::vector<GraphicsPipelineDescription> descriptions;
+    std::vector<u8> entry;
+    while (file.Tell() < file.GetSize()) {
+        PipelineEntryHeader entry_header{};
+        if (file.ReadBytes(&entry_header, sizeof(entry_header)) != sizeof(entry_header) ||
+            entry_header.size > file.GetSize() - file.Tell()) {
+            LOG_ERROR(Render_Vulkan, "Failed to read pipeline cache entry - skipping the rest");
+            break;
+        }
+        entry.resize(entry_header.size);
+        if (file.ReadBytes(entry.data(), entry.size()) != entry.size()) {
+            LOG_ERROR(Render_Vulkan, "Failed to read pipeline cache entry - skipping the rest");
+            break;
+        }
+
+        // Keys reach the Maxwell to Vulkan translators as is, only intact entries are built
+        const u64 checksum =
+            Common::CityHash64(reinterpret_cast<const char*>(entry.data()), entry.size());
+        std::optional<GraphicsPipelineDescription> description;
+        if (checksum == entry_header.checksum) {
+            description = DeserializeDescription(entry);
+        }
+        if (!description) {
+            LOG_ERROR(Render_Vulkan, "Pipeline cache entry is corrupt - skipping the rest");
+            break;
+        }
+        descriptions.push_back(std::move(*description));
+    }
+    return descriptions;
+}
+
+void VKPipelineCache::RecordPipeline(const GraphicsPipelineDescription& description) {
+    if (!IsUsable() || !EnsureDirectories()) {
+        return;
+    }
+    const std::string path = GetPipelinesPath();
+    FileUtil::IOFile file(path, "ab");
+    if (!file.IsOpen()) {
+        LOG_ERROR(Render_Vulkan, "Failed to open pipeline cache in path={}", path);
+        return;
+    }
+    const PipelinesFileHeader header{NativeVersion, sizeof(GraphicsPipelineCacheKey)};
+    if (file.GetSize() == 0 && file.WriteObject(header) != 1) {
+        LOG_ERROR(Render_Vulkan, "Failed to write pipeline cache header in path={}", path);
+        return;
+    }
+
+    const std::vector<u8> entry = SerializeDescription(description);
+    PipelineEntryHeader entry_header{};
+    entry_header.size = static_cast<u32>(entry.size());
+    entry_header.checksum =
+        Common::CityHash64(reinterpret_cast<const char*>(entry.data()), entry.size());
+    if (file.WriteObject(entry_header) != 1 ||
+        file.WriteBytes(entry.data(), entry.size()) != entry.size()) {
+        LOG_ERROR(Render_Vulkan, "Failed to write pipeline cache entry in path={}", path);
+    }
+}
+
+void VKPipelineCache::SaveDriverCache() {
+    if (!pipeline_cache || !IsUsable() || !EnsureDirectories()) {
+        return;
+    }
+    const auto dev = device.GetLogical();
+    const auto& dld = device.GetDispatchLoader();
+    const std::vector<u8> data = dev.getPipelineCacheData(*pipeline_cache, dld);
+
+    const std::string path = GetDriverCachePath();
+    FileUtil::IOFile file(path, "wb");
+    if (!file.IsOpen() || file.WriteBytes(data.data(), data.size()) != data.size()) {
+        LOG_ERROR(Render_Vulkan, "Failed to write driver pipeline cache in path={}", path);
+    }
+}
+
+bool VKPipelineCache::IsUsable() const {
+    // Skip games without title id
+    return Settings::values.use_disk_shader_cache && title_id != 0;
+}
+
+bool VKPipelineCache::EnsureDirectories() const {
+    const auto CreateDir = [](const std::string& dir) {
+        if (!FileUtil::CreateDir(dir)) {
+            LOG_ERROR(Render_Vulkan, "Failed to create directory={}", dir);
+            return false;
+        }
+        return true;
+    };
+    return CreateDir(FileUtil::GetUserPath(FileUtil::UserPath::ShaderDir)) &&
+           CreateDir(GetBaseDir()) && CreateDir(GetBaseDir() + DIR_SEP "pipelines") &&
+           CreateDir(GetBaseDir() + DIR_SEP "driver");
+}
+
+std::string VKPipelineCache::GetPipelinesPath() const {
+    return FileUtil::SanitizePath(GetBaseDir() + DIR_SEP "pipelines" DIR_SEP + GetTitleID() +
+                                  ".bin");
+}
+
+std::string VKPipelineCache::GetDriverCachePath() const {
+    return FileUtil::SanitizePath(GetBaseDir() + DIR_SEP "driver" DIR_SEP + GetTitleID() +
+                                  ".bin");
+}
+
+std::string VKPipelineCache::GetBaseDir() const {
+    return FileUtil::GetUserPath(FileUtil::UserPath::ShaderDir) + DIR_SEP "vulkan";
+}
+
+std::string VKPipelineCache::GetTitleID() const {
+    return fmt::format("{:016X}", title_id);
+}
+
+} // namespace Vulkan
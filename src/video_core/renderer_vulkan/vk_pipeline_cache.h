@@ -0,0 +1,185 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/renderer_vulkan/declarations.h"
+#include "video_core/renderer_vulkan/fixed_pipeline_state.h"
+#include "video_core/renderer_vulkan/vk_shader_decompiler.h"
+
+namespace Core {
+class System;
+}
+
+namespace Vulkan {
+
+class VKDevice;
+
+struct GraphicsPipelineCacheKey {
+    FixedPipelineState fixed_state;
+    /// Unique identifiers of the shader programs, zero for disabled programs. Keys are stored on
+    /// disk and looked up again in later sessions, so the identifiers have to be derived from the
+    /// program code, never from GPU addresses or values that change between sessions.
+    std::array<u64, Maxwell::MaxShaderProgram> shaders;
+
+    std::size_t Hash() const;
+
+    bool operator==(const GraphicsPipelineCacheKey& rhs) const;
+
+    bool operator!=(const GraphicsPipelineCacheKey& rhs) const {
+        return !operator==(rhs);
+    }
+};
+static_assert(std::has_unique_object_representations_v<GraphicsPipelineCacheKey>);
+static_assert(std::is_trivially_copyable_v<GraphicsPipelineCacheKey>);
+
+} // namespace Vulkan
+
+namespace std {
+
+template <>
+struct hash<Vulkan::GraphicsPipelineCacheKey> {
+    std::size_t operator()(const Vulkan::GraphicsPipelineCacheKey& k) const noexcept {
+        return k.Hash();
+    }
+};
+
+} // namespace std
+
+namespace Vulkan {
+
+/// Descriptor used by a shader stage, all stages share the same descriptor set.
+struct DescriptorBinding {
+    u32 binding;
+    vk::DescriptorType type;
+};
+
+/// Decompiled shader stage of a pipeline, stored on disk to build the pipeline in later sessions.
+struct PipelineShaderStage {
+    Maxwell::ShaderStage stage{};
+    std::vector<u32> code;                   ///< SPIR-V module
+    std::vector<DescriptorBinding> bindings; ///< Descriptors used by the module
+};
+
+struct GraphicsPipelineDescription {
+    GraphicsPipelineCacheKey key;
+    std::vector<PipelineShaderStage> stages;
+};
+
+/// Adds the entry point to a decompiled shader and builds a pipeline stage from it.
+PipelineShaderStage MakePipelineShaderStage(Maxwell::ShaderStage stage, Sirit::Module& module,
+                                            const VKShader::ShaderEntries& entries);
+
+class VKGraphicsPipeline final {
+public:
+    explicit VKGraphicsPipeline(const VKDevice& device, vk::PipelineCache pipeline_cache,
+                                const GraphicsPipelineDescription& description);
+    ~VKGraphicsPipeline();
+
+    vk::Pipeline GetHandle() const {
+        return *pipeline;
+    }
+
+    vk::PipelineLayout GetLayout() const {
+        return *layout;
+    }
+
+    vk::DescriptorSetLayout GetDescriptorSetLayout() const {
+        return *descriptor_set_layout;
+    }
+
+    vk::RenderPass GetRenderPass() const {
+        return *renderpass;
+    }
+
+private:
+    UniqueDescriptorSetLayout CreateDescriptorSetLayout(
+        const std::vector<PipelineShaderStage>& stages) const;
+
+    UniquePipelineLayout CreatePipelineLayout() const;
+
+    UniqueRenderPass CreateRenderPass(const FixedPipelineState::Attachments& attachments) const;
+
+    UniquePipeline CreatePipeline(vk::PipelineCache pipeline_cache,
+                                  const GraphicsPipelineDescription& description) const;
+
+    const VKDevice& device;
+
+    UniqueDescriptorSetLayout descriptor_set_layout;
+    UniquePipelineLayout layout;
+    UniqueRenderPass renderpass;
+    UniquePipeline pipeline;
+};
+
+/// Caches Vulkan pipelines by their fixed state and shaders. The pipelines built in a session are
+/// recorded on disk with the driver's pipeline cache, and built on a background thread in the next
+/// session before the game asks for them.
+class VKPipelineCache final {
+public:
+    explicit VKPipelineCache(Core::System& system, const VKDevice& device);
+    ~VKPipelineCache();
+
+    /// Loads the driver pipeline cache of the running title and starts building the pipelines
+    /// recorded in previous sessions.
+    void LoadDiskResources();
+
+    /// Returns the pipeline of the description, building it on a miss.
+    VKGraphicsPipeline& GetGraphicsPipeline(const GraphicsPipelineDescription& description);
+
+private:
+    /// Builds the pipelines recorded in previous sessions that haven't been built yet.
+    void BuildRecordedPipelines(std::vector<GraphicsPipelineDescription> descriptions);
+
+    /// Builds a pipeline and caches it. Returns the cached one when another thread built it first.
+    VKGraphicsPipeline& BuildPipeline(const GraphicsPipelineDescription& description);
+
+    /// Reads the pipeline descriptions recorded on disk.
+    std::vector<GraphicsPipelineDescription> LoadRecordedPipelines();
+
+    /// Appends a pipeline description to the file read in the next session.
+    void RecordPipeline(const GraphicsPipelineDescription& description);
+
+    /// Writes the contents of the driver pipeline cache to disk.
+    void SaveDriverCache();
+
+    bool IsUsable() const;
+    bool EnsureDirectories() const;
+    std::string GetPipelinesPath() const;
+    std::string GetDriverCachePath() const;
+    std::string GetBaseDir() const;
+    std::string GetTitleID() const;
+
+    Core::System& system;
+    const VKDevice& device;
+
+    /// Title the disk resources belong to, zero when they are not used
+    u64 title_id = 0;
+
+    UniquePipelineCache pipeline_cache;
+
+    std::mutex pipelines_mutex;
+    std::unordered_map<GraphicsPipelineCacheKey, std::unique_ptr<VKGraphicsPipeline>> pipelines;
+
+    /// Pipelines already recorded on disk
+    std::unordered_set<GraphicsPipelineCacheKey> recorded;
+
+    std::atomic_bool stop_building{};
+    std::thread build_thread;
+};
+
+} // namespace Vulkan
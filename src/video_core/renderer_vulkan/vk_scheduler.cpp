@@ -4,6 +4,7 @@
 
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "common/thread.h"
 #include "video_core/renderer_vulkan/declarations.h"
 #include "video_core/renderer_vulkan/vk_device.h"
 #include "video_core/renderer_vulkan/vk_resource_manager.h"
@@ -11,16 +12,53 @@
 
 namespace Vulkan {
 
+VKScheduler::CommandChunk::~CommandChunk() {
+    auto command = first;
+    while (command != nullptr) {
+        auto next = command->GetNext();
+        command->~Command();
+        command = next;
+    }
+}
+
+void VKScheduler::CommandChunk::ExecuteAll(vk::CommandBuffer cmdbuf,
+                                           const vk::DispatchLoaderDynamic& dld) {
+    auto command = first;
+    while (command != nullptr) {
+        auto next = command->GetNext();
+        command->Execute(cmdbuf, dld);
+        command->~Command();
+        command = next;
+    }
+
+    command_offset = 0;
+    first = nullptr;
+    last = nullptr;
+}
+
 VKScheduler::VKScheduler(const VKDevice& device, VKResourceManager& resource_manager)
     : device{device}, resource_manager{resource_manager} {
     next_fence = &resource_manager.CommitFence();
+    AcquireNewChunk();
     AllocateNewContext();
+    worker_thread = std::thread(&VKScheduler::WorkerThread, this);
 }
 
-VKScheduler::~VKScheduler() = default;
+VKScheduler::~VKScheduler() {
+    // A null chunk stops the worker, work that was not submitted is discarded when the chunks
+    // holding it are destroyed
+    chunk_queue.Push(nullptr);
+    worker_thread.join();
+}
 
 void VKScheduler::Flush(bool release_fence, vk::Semaphore semaphore) {
     SubmitExecution(semaphore);
+    if (semaphore) {
+        // The caller is about to wait on the semaphore, likely from a present on a queue that can
+        // be the graphics queue. Its signal has to be submitted and the worker must not be using
+        // the queue by then.
+        WaitWorker();
+    }
     if (release_fence)
         current_fence->Release();
     AllocateNewContext();
@@ -28,29 +66,86 @@ void VKScheduler::Flush(bool release_fence, vk::Semaphore semaphore) {
 
 void VKScheduler::Finish(bool release_fence, vk::Semaphore semaphore) {
     SubmitExecution(semaphore);
+    // This may start waiting before the worker submitted the fence, the wait then covers the
+    // execution of the chunks still queued as well as the GPU work itself
     current_fence->Wait();
     if (release_fence)
         current_fence->Release();
     AllocateNewContext();
 }
 
-void VKScheduler::SubmitExecution(vk::Semaphore semaphore) {
+void VKScheduler::DispatchWork() {
+    if (chunk->Empty()) {
+        return;
+    }
+    chunk_queue.Push(std::move(chunk));
+    ++dispatched_chunks;
+    AcquireNewChunk();
+}
+
+void VKScheduler::WaitWorker() {
+    std::unique_lock lock{worker_mutex};
+    worker_cv.wait(lock, [this] { return executed_chunks == dispatched_chunks; });
+}
+
+void VKScheduler::WorkerThread() {
+    Common::SetCurrentThreadName("yuzu:VulkanWorker");
+    while (true) {
+        std::unique_ptr<CommandChunk> work = chunk_queue.PopWait();
+        if (!work) {
+            return;
+        }
+        ExecuteChunk(*work);
+        chunk_reserve.Push(std::move(work));
+        {
+            std::lock_guard lock{worker_mutex};
+            ++executed_chunks;
+        }
+        worker_cv.notify_all();
+    }
+}
+
+void VKScheduler::ExecuteChunk(CommandChunk& work) {
     const auto& dld = device.GetDispatchLoader();
-    current_cmdbuf.end(dld);
+    if (work.cmdbuf != worker_cmdbuf) {
+        // The first chunk of a context begins its command buffer
+        worker_cmdbuf = work.cmdbuf;
+        worker_cmdbuf.begin({vk::CommandBufferUsageFlagBits::eOneTimeSubmit}, dld);
+    }
+    work.ExecuteAll(worker_cmdbuf, dld);
+    if (!work.submit) {
+        return;
+    }
 
+    worker_cmdbuf.end(dld);
+
+    const vk::Semaphore semaphore = work.submit_semaphore;
     const auto queue = device.GetGraphicsQueue();
-    const vk::SubmitInfo submit_info(0, nullptr, nullptr, 1, &current_cmdbuf, semaphore ? 1u : 0u,
+    const vk::SubmitInfo submit_info(0, nullptr, nullptr, 1, &worker_cmdbuf, semaphore ? 1u : 0u,
                                      &semaphore);
-    queue.submit({submit_info}, *current_fence, dld);
+    queue.submit({submit_info}, work.submit_fence, dld);
+
+    worker_cmdbuf = nullptr;
+    work.submit = false;
+}
+
+void VKScheduler::SubmitExecution(vk::Semaphore semaphore) {
+    chunk->MarkSubmit(*current_fence, semaphore);
+    DispatchWork();
 }
 
 void VKScheduler::AllocateNewContext() {
     current_fence = next_fence;
     current_cmdbuf = resource_manager.CommitCommandBuffer(*current_fence);
     next_fence = &resource_manager.CommitFence();
+    chunk->cmdbuf = current_cmdbuf;
+}
 
-    const auto& dld = device.GetDispatchLoader();
-    current_cmdbuf.begin({vk::CommandBufferUsageFlagBits::eOneTimeSubmit}, dld);
+void VKScheduler::AcquireNewChunk() {
+    if (!chunk_reserve.Pop(chunk)) {
+        chunk = std::make_unique<CommandChunk>();
+    }
+    chunk->cmdbuf = current_cmdbuf;
 }
 
 } // namespace Vulkan
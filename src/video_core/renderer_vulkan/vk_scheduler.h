@@ -4,7 +4,18 @@
 
 #pragma once
 
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "common/assert.h"
 #include "common/common_types.h"
+#include "common/threadsafe_queue.h"
 #include "video_core/renderer_vulkan/declarations.h"
 
 namespace Vulkan {
@@ -30,25 +41,9 @@ private:
     VKFence* const& fence;
 };
 
-class VKCommandBufferView {
-public:
-    VKCommandBufferView() = default;
-    VKCommandBufferView(const vk::CommandBuffer& cmdbuf) : cmdbuf{cmdbuf} {}
-
-    const vk::CommandBuffer* operator->() const noexcept {
-        return &cmdbuf;
-    }
-
-    operator vk::CommandBuffer() const noexcept {
-        return cmdbuf;
-    }
-
-private:
-    const vk::CommandBuffer& cmdbuf;
-};
-
 /// The scheduler abstracts command buffer and fence management with an interface that's able to do
-/// OpenGL-like operations on Vulkan command buffers.
+/// OpenGL-like operations on Vulkan command buffers. Commands are recorded in chunks on the calling
+/// thread and translated to Vulkan calls and submitted by a worker thread.
 class VKScheduler {
 public:
     explicit VKScheduler(const VKDevice& device, VKResourceManager& resource_manager);
@@ -59,27 +54,165 @@ public:
         return current_fence;
     }
 
-    /// Gets a reference to the current command buffer.
-    VKCommandBufferView GetCommandBuffer() const {
-        return current_cmdbuf;
-    }
-
-    /// Sends the current execution context to the GPU.
+    /// Sends the current execution context to the GPU. When a semaphore is passed, this returns
+    /// once the submission signaling it has been made and the worker is idle.
     void Flush(bool release_fence = true, vk::Semaphore semaphore = nullptr);
 
     /// Sends the current execution context to the GPU and waits for it to complete.
     void Finish(bool release_fence = true, vk::Semaphore semaphore = nullptr);
 
+    /// Sends the commands recorded so far to the worker thread without submitting them.
+    void DispatchWork();
+
+    /// Waits for the worker thread to execute every chunk dispatched so far.
+    void WaitWorker();
+
+    /**
+     * Records a command to be executed by the worker thread in the current command buffer.
+     * @param command Callable invoked as
+     *                command(vk::CommandBuffer, const vk::DispatchLoaderDynamic&)
+     */
+    template <typename T>
+    void Record(T&& command) {
+        if (chunk->Record(command)) {
+            return;
+        }
+        DispatchWork();
+        const bool recorded = chunk->Record(command);
+        ASSERT(recorded);
+    }
+
 private:
+    class Command {
+    public:
+        virtual ~Command() = default;
+
+        virtual void Execute(vk::CommandBuffer cmdbuf,
+                             const vk::DispatchLoaderDynamic& dld) const = 0;
+
+        Command* GetNext() const {
+            return next;
+        }
+
+        void SetNext(Command* next_) {
+            next = next_;
+        }
+
+    private:
+        Command* next = nullptr;
+    };
+
+    template <typename T>
+    class TypedCommand final : public Command {
+    public:
+        explicit TypedCommand(T&& command) : command{std::move(command)} {}
+        ~TypedCommand() override = default;
+
+        TypedCommand(TypedCommand&&) = delete;
+        TypedCommand& operator=(TypedCommand&&) = delete;
+
+        void Execute(vk::CommandBuffer cmdbuf,
+                     const vk::DispatchLoaderDynamic& dld) const override {
+            command(cmdbuf, dld);
+        }
+
+    private:
+        T command;
+    };
+
+    /// Preallocated storage for the commands recorded for a command buffer between dispatches.
+    class CommandChunk final {
+    public:
+        /// Destroys the commands that were never executed
+        ~CommandChunk();
+
+        /// Executes and destroys the recorded commands
+        void ExecuteAll(vk::CommandBuffer cmdbuf, const vk::DispatchLoaderDynamic& dld);
+
+        template <typename T>
+        bool Record(T& command) {
+            using FuncType = TypedCommand<std::decay_t<T>>;
+            static_assert(sizeof(FuncType) < STORAGE_SIZE, "Command is too large");
+            static_assert(alignof(FuncType) <= alignof(std::max_align_t),
+                          "Command is overaligned");
+
+            const std::size_t offset = (command_offset + alignof(FuncType) - 1) &
+                                       ~(alignof(FuncType) - 1);
+            if (offset + sizeof(FuncType) > STORAGE_SIZE) {
+                return false;
+            }
+
+            Command* const current_last = last;
+            last = new (data.data() + offset) FuncType(std::move(command));
+            if (current_last) {
+                current_last->SetNext(last);
+            } else {
+                first = last;
+            }
+            command_offset = offset + sizeof(FuncType);
+            return true;
+        }
+
+        /// Marks the chunk to end and submit its command buffer after its commands.
+        void MarkSubmit(vk::Fence fence, vk::Semaphore semaphore) {
+            submit = true;
+            submit_fence = fence;
+            submit_semaphore = semaphore;
+        }
+
+        bool Empty() const {
+            return command_offset == 0 && !submit;
+        }
+
+        /// Command buffer the commands of this chunk are recorded to
+        vk::CommandBuffer cmdbuf;
+
+        bool submit = false;
+        vk::Fence submit_fence;
+        vk::Semaphore submit_semaphore;
+
+    private:
+        static constexpr std::size_t STORAGE_SIZE = 0x8000;
+
+        Command* first = nullptr;
+        Command* last = nullptr;
+
+        std::size_t command_offset = 0;
+        alignas(std::max_align_t) std::array<u8, STORAGE_SIZE> data{};
+    };
+
+    /// Executes the chunks dispatched by the recording thread.
+    void WorkerThread();
+
+    /// Translates a chunk to Vulkan calls, submitting its command buffer when requested.
+    void ExecuteChunk(CommandChunk& chunk);
+
     void SubmitExecution(vk::Semaphore semaphore);
 
     void AllocateNewContext();
 
+    /// Takes a chunk from the ones already executed by the worker or allocates a new one.
+    void AcquireNewChunk();
+
     const VKDevice& device;
     VKResourceManager& resource_manager;
     vk::CommandBuffer current_cmdbuf;
     VKFence* current_fence = nullptr;
     VKFence* next_fence = nullptr;
+
+    std::unique_ptr<CommandChunk> chunk;
+
+    /// Command buffer begun by the worker thread and not submitted yet
+    vk::CommandBuffer worker_cmdbuf;
+
+    Common::SPSCQueue<std::unique_ptr<CommandChunk>> chunk_queue;
+    Common::SPSCQueue<std::unique_ptr<CommandChunk>> chunk_reserve;
+    std::thread worker_thread;
+
+    std::mutex worker_mutex;
+    std::condition_variable worker_cv;
+    u64 dispatched_chunks = 0; ///< Only accessed by the recording thread
+    u64 executed_chunks = 0;   ///< Protected by worker_mutex
 };
 
 } // namespace Vulkan
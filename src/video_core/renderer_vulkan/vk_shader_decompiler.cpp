@@ -89,8 +89,10 @@ bool IsPrecise(Operation operand) {
 
 class SPIRVDecompiler : public Sirit::Module {
 public:
-    explicit SPIRVDecompiler(const VKDevice& device, const ShaderIR& ir, ShaderStage stage)
-        : Module(0x00010300), device{device}, ir{ir}, stage{stage}, header{ir.GetHeader()} {
+    explicit SPIRVDecompiler(const DeviceCapabilities& capabilities, const ShaderIR& ir,
+                             ShaderStage stage)
+        : Module(0x00010300), capabilities{capabilities}, ir{ir}, stage{stage},
+          header{ir.GetHeader()} {
         AddCapability(spv::Capability::Shader);
         AddExtension("SPV_KHR_storage_buffer_storage_class");
         AddExtension("SPV_KHR_variable_pointers");
@@ -371,7 +373,7 @@ private:
         for (const auto& entry : ir.GetConstantBuffers()) {
             const auto [index, size] = entry;
             const Id type =
-                device.IsExtScalarBlockLayoutSupported() ? t_cbuf_scalar_ubo : t_cbuf_std140_ubo;
+                capabilities.ext_scalar_block_layout ? t_cbuf_scalar_ubo : t_cbuf_std140_ubo;
             const Id id = OpVariable(type, spv::StorageClass::Uniform);
             AddGlobalVariable(Name(id, fmt::format("cbuf_{}", index)));
 
@@ -565,7 +567,7 @@ private:
             const Id buffer_id = constant_buffers.at(cbuf->GetIndex());
 
             Id pointer{};
-            if (device.IsExtScalarBlockLayoutSupported()) {
+            if (capabilities.ext_scalar_block_layout) {
                 const Id buffer_offset = Emit(OpShiftRightLogical(
                     t_uint, BitcastTo<Type::Uint>(Visit(offset)), Constant(t_uint, 2u)));
                 pointer = Emit(
@@ -1392,7 +1394,7 @@ private:
     };
     static_assert(operation_decompilers.size() == static_cast<std::size_t>(OperationCode::Amount));
 
-    const VKDevice& device;
+    const DeviceCapabilities capabilities;
     const ShaderIR& ir;
     const ShaderStage stage;
     const Tegra::Shader::Header header;
@@ -1493,11 +1495,22 @@ private:
     std::map<u32, Id> labels;
 };
 
-DecompilerResult Decompile(const VKDevice& device, const VideoCommon::Shader::ShaderIR& ir,
-                           Maxwell::ShaderStage stage) {
-    auto decompiler = std::make_unique<SPIRVDecompiler>(device, ir, stage);
+DeviceCapabilities GetDeviceCapabilities(const VKDevice& device) {
+    DeviceCapabilities capabilities;
+    capabilities.ext_scalar_block_layout = device.IsExtScalarBlockLayoutSupported();
+    return capabilities;
+}
+
+DecompilerResult Decompile(const DeviceCapabilities& capabilities,
+                           const VideoCommon::Shader::ShaderIR& ir, Maxwell::ShaderStage stage) {
+    auto decompiler = std::make_unique<SPIRVDecompiler>(capabilities, ir, stage);
     decompiler->Decompile();
     return {std::move(decompiler), decompiler->GetShaderEntries()};
 }
 
+DecompilerResult Decompile(const VKDevice& device, const VideoCommon::Shader::ShaderIR& ir,
+                           Maxwell::ShaderStage stage) {
+    return Decompile(GetDeviceCapabilities(device), ir, stage);
+}
+
 } // namespace Vulkan::VKShader
@@ -78,6 +78,18 @@ struct ShaderEntries {
 
 using DecompilerResult = std::pair<std::unique_ptr<Sirit::Module>, ShaderEntries>;
 
+/// Device features the decompiler emits different code for. Decompiling from them instead of a
+/// device allows to generate SPIR-V without a Vulkan instance, e.g. from offline tools.
+struct DeviceCapabilities {
+    bool ext_scalar_block_layout{}; ///< VK_EXT_scalar_block_layout is supported
+};
+
+/// Returns the capabilities of a device relevant to the decompiler.
+DeviceCapabilities GetDeviceCapabilities(const VKDevice& device);
+
+DecompilerResult Decompile(const DeviceCapabilities& capabilities,
+                           const VideoCommon::Shader::ShaderIR& ir, Maxwell::ShaderStage stage);
+
 DecompilerResult Decompile(const VKDevice& device, const VideoCommon::Shader::ShaderIR& ir,
                            Maxwell::ShaderStage stage);
 
@@ -14,6 +14,7 @@
 #include "video_core/renderer_vulkan/declarations.h"
 #include "video_core/renderer_vulkan/vk_device.h"
 #include "video_core/renderer_vulkan/vk_resource_manager.h"
+#include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_swapchain.h"
 
 namespace Vulkan {
@@ -53,8 +54,8 @@ vk::Extent2D ChooseSwapExtent(const vk::SurfaceCapabilitiesKHR& capabilities, u3
 }
 } // namespace
 
-VKSwapchain::VKSwapchain(vk::SurfaceKHR surface, const VKDevice& device)
-    : surface{surface}, device{device} {}
+VKSwapchain::VKSwapchain(vk::SurfaceKHR surface, const VKDevice& device, VKScheduler& scheduler)
+    : surface{surface}, device{device}, scheduler{scheduler} {}
 
 VKSwapchain::~VKSwapchain() = default;
 
@@ -69,6 +70,8 @@ void VKSwapchain::Create(u32 width, u32 height) {
         return;
     }
 
+    // The worker thread may still be submitting to the queues waited on here
+    scheduler.WaitWorker();
     dev.waitIdle(dld);
     Destroy();
 
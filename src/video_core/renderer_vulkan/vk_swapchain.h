@@ -17,10 +17,11 @@ namespace Vulkan {
 
 class VKDevice;
 class VKFence;
+class VKScheduler;
 
 class VKSwapchain {
 public:
-    explicit VKSwapchain(vk::SurfaceKHR surface, const VKDevice& device);
+    explicit VKSwapchain(vk::SurfaceKHR surface, const VKDevice& device, VKScheduler& scheduler);
     ~VKSwapchain();
 
     /// Creates (or recreates) the swapchain with a given size.
@@ -69,6 +70,7 @@ private:
 
     const vk::SurfaceKHR surface;
     const VKDevice& device;
+    VKScheduler& scheduler;
 
     UniqueSwapchainKHR swapchain;
 
@@ -2,6 +2,8 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <cstring>
+
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/microprofile.h"
@@ -19,12 +21,34 @@ using Tegra::Texture::ConvertFromGuestToHost;
 using VideoCore::MortonSwizzleMode;
 using VideoCore::Surface::SurfaceCompression;
 
+namespace {
+
+/// Resamples a linear image with nearest filtering, texels are copied as is so it works with any
+/// uncompressed format.
+void RescaleImage(const u8* src, u32 src_width, u32 src_height, u8* dst, u32 dst_width,
+                  u32 dst_height, u32 bytes_per_pixel) {
+    for (u32 y = 0; y < dst_height; ++y) {
+        const u32 src_y = static_cast<u32>(static_cast<u64>(y) * src_height / dst_height);
+        const u8* const src_row =
+            src + static_cast<std::size_t>(src_y) * src_width * bytes_per_pixel;
+        for (u32 x = 0; x < dst_width; ++x) {
+            const u32 src_x = static_cast<u32>(static_cast<u64>(x) * src_width / dst_width);
+            std::memcpy(dst, src_row + static_cast<std::size_t>(src_x) * bytes_per_pixel,
+                        bytes_per_pixel);
+            dst += bytes_per_pixel;
+        }
+    }
+}
+
+} // Anonymous namespace
+
 StagingCache::StagingCache() = default;
 
 StagingCache::~StagingCache() = default;
 
 SurfaceBaseImpl::SurfaceBaseImpl(GPUVAddr gpu_addr, const SurfaceParams& params)
-    : params{params}, host_memory_size{params.GetHostSizeInBytes()}, gpu_addr{gpu_addr},
+    : params{params}, host_params{params.GetHostParams()},
+      host_memory_size{host_params.GetHostSizeInBytes()}, gpu_addr{gpu_addr},
       mipmap_sizes(params.num_levels), mipmap_offsets(params.num_levels) {
     std::size_t offset = 0;
     for (u32 level = 0; level < params.num_levels; ++level) {
@@ -182,7 +206,12 @@ void SurfaceBaseImpl::SwizzleFunc(MortonSwizzleMode mode, u8* memory, const Surf
 void SurfaceBaseImpl::LoadBuffer(Tegra::MemoryManager& memory_manager,
                                  StagingCache& staging_cache) {
     MICROPROFILE_SCOPE(GPU_Load_Texture);
-    auto& staging_buffer = staging_cache.GetBuffer(0);
+    // Scaled surfaces are decoded at the guest resolution and rescaled to the host texture
+    const bool is_scaled = params.IsScaled();
+    auto& staging_buffer = staging_cache.GetBuffer(is_scaled ? 2 : 0);
+    if (is_scaled) {
+        staging_buffer.resize(params.GetHostSizeInBytes());
+    }
     u8* host_ptr;
     is_continuous = memory_manager.IsBlockContinuous(gpu_addr, guest_memory_size);
 
@@ -230,6 +259,20 @@ void SurfaceBaseImpl::LoadBuffer(Tegra::MemoryManager& memory_manager,
         }
     }
 
+    if (is_scaled) {
+        // Only uncompressed surfaces are scaled, rearranged formats are converted in place at the
+        // guest resolution before rescaling
+        if (params.GetCompressionType() == SurfaceCompression::Rearranged) {
+            ConvertFromGuestToHost(staging_buffer.data(), staging_buffer.data(),
+                                   params.pixel_format, params.width, params.height, 1, true,
+                                   true);
+        }
+        RescaleImage(staging_buffer.data(), params.width, params.height,
+                     staging_cache.GetBuffer(0).data(), host_params.width, host_params.height,
+                     params.GetBytesPerPixel());
+        return;
+    }
+
     auto compression_type = params.GetCompressionType();
     if (compression_type == SurfaceCompression::None ||
         compression_type == SurfaceCompression::Compressed)
@@ -252,7 +295,14 @@ void SurfaceBaseImpl::LoadBuffer(Tegra::MemoryManager& memory_manager,
 void SurfaceBaseImpl::FlushBuffer(Tegra::MemoryManager& memory_manager,
                                   StagingCache& staging_cache) {
     MICROPROFILE_SCOPE(GPU_Flush_Texture);
-    auto& staging_buffer = staging_cache.GetBuffer(0);
+    auto& staging_buffer = staging_cache.GetBuffer(params.IsScaled() ? 2 : 0);
+    if (params.IsScaled()) {
+        // Rescale the downloaded texture to the guest resolution before encoding it
+        staging_buffer.resize(params.GetHostSizeInBytes());
+        RescaleImage(staging_cache.GetBuffer(0).data(), host_params.width, host_params.height,
+                     staging_buffer.data(), params.width, params.height,
+                     params.GetBytesPerPixel());
+    }
     u8* host_ptr;
 
     // Handle continuouty
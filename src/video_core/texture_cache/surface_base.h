@@ -112,6 +112,7 @@ public:
         return guest_memory_size;
     }
 
+    /// Returns the size in bytes of the host texture, scaled with the surface.
     std::size_t GetHostSizeInBytes() const {
         return host_memory_size;
     }
@@ -167,6 +168,7 @@ protected:
     virtual void DecorateSurfaceName() = 0;
 
     const SurfaceParams params;
+    const SurfaceParams host_params; ///< Parameters of the host texture, scaled from params
     std::size_t layer_size;
     std::size_t guest_memory_size;
     const std::size_t host_memory_size;
@@ -10,6 +10,7 @@
 #include "video_core/engines/shader_bytecode.h"
 #include "video_core/surface.h"
 #include "video_core/texture_cache/surface_params.h"
+#include "video_core/video_core.h"
 
 namespace VideoCommon {
 
@@ -59,6 +60,11 @@ namespace {
 constexpr u32 GetMipmapSize(bool uncompressed, u32 mip_size, u32 tile) {
     return uncompressed ? mip_size : std::max(1U, (mip_size + tile - 1) / tile);
 }
+
+/// Returns the resolution scale of a render target, only scalable surfaces are scaled.
+float GetRenderTargetScale(Core::System& system, const SurfaceParams& params) {
+    return params.IsScalable() ? VideoCore::GetResolutionScale(system.Renderer()) : 1.0f;
+}
 } // Anonymous namespace
 
 SurfaceParams SurfaceParams::CreateForTexture(Core::System& system,
@@ -143,6 +149,7 @@ SurfaceParams SurfaceParams::CreateForDepthBuffer(
     params.num_levels = 1;
     params.emulated_levels = 1;
     params.is_layered = false;
+    params.resolution_scale = GetRenderTargetScale(system, params);
     return params;
 }
 
@@ -174,6 +181,7 @@ SurfaceParams SurfaceParams::CreateForFramebuffer(Core::System& system, std::siz
     params.num_levels = 1;
     params.emulated_levels = 1;
     params.is_layered = false;
+    params.resolution_scale = GetRenderTargetScale(system, params);
     return params;
 }
 
@@ -202,6 +210,14 @@ SurfaceParams SurfaceParams::CreateForFermiCopySurface(
     return params;
 }
 
+SurfaceParams SurfaceParams::GetHostParams() const {
+    SurfaceParams host_params = *this;
+    host_params.width = std::max(1U, Scale(width));
+    host_params.height = std::max(1U, Scale(height));
+    host_params.resolution_scale = 1.0f;
+    return host_params;
+}
+
 bool SurfaceParams::IsLayered() const {
     switch (target) {
     case SurfaceTarget::Texture1DArray:
@@ -307,10 +323,12 @@ std::size_t SurfaceParams::GetInnerMipmapMemorySize(u32 level, bool as_host_size
 
 bool SurfaceParams::operator==(const SurfaceParams& rhs) const {
     return std::tie(is_tiled, block_width, block_height, block_depth, tile_width_spacing, width,
-                    height, depth, pitch, num_levels, pixel_format, component_type, type, target) ==
+                    height, depth, pitch, num_levels, pixel_format, component_type, type, target,
+                    resolution_scale) ==
            std::tie(rhs.is_tiled, rhs.block_width, rhs.block_height, rhs.block_depth,
                     rhs.tile_width_spacing, rhs.width, rhs.height, rhs.depth, rhs.pitch,
-                    rhs.num_levels, rhs.pixel_format, rhs.component_type, rhs.type, rhs.target);
+                    rhs.num_levels, rhs.pixel_format, rhs.component_type, rhs.type, rhs.target,
+                    rhs.resolution_scale);
 }
 
 std::string SurfaceParams::TargetName() const {
@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <cmath>
 #include <map>
+#include <utility>
 
 #include "common/alignment.h"
 #include "common/bit_util.h"
@@ -185,6 +187,52 @@ public:
         return target == VideoCore::Surface::SurfaceTarget::TextureBuffer;
     }
 
+    /// Returns true if the surface can be allocated at a different resolution than the guest's.
+    /// Every render target format is scalable, so all attachments of a framebuffer share a scale.
+    bool IsScalable() const {
+        const SurfaceCompression compression = GetCompressionType();
+        return target == VideoCore::Surface::SurfaceTarget::Texture2D && num_levels == 1 &&
+               !is_layered &&
+               (compression == SurfaceCompression::None ||
+                compression == SurfaceCompression::Rearranged);
+    }
+
+    /// Returns true if the host texture has a different resolution than the guest surface.
+    bool IsScaled() const {
+        return resolution_scale != 1.0f;
+    }
+
+    /// Scales a coordinate or a size in texels of the guest surface to the host texture.
+    u32 Scale(u32 value) const {
+        return static_cast<u32>(std::lround(static_cast<float>(value) * resolution_scale));
+    }
+
+    /**
+     * Scales a range of texels along the width or height of a mipmap level to the host texture.
+     * The end of the range is scaled rather than its size, so it stays inside the host level.
+     * @param host_level_size Width or height of the mipmap level in the host texture
+     * @returns the first texel and the number of texels of the range in the host texture
+     */
+    std::pair<u32, u32> ScaleRange(u32 offset, u32 size, u32 host_level_size) const {
+        const u32 start = std::min(Scale(offset), host_level_size);
+        const u32 end = std::min(Scale(offset + size), host_level_size);
+        return {start, end - start};
+    }
+
+    /// Returns the width of a given mipmap level of the host texture.
+    u32 GetHostMipWidth(u32 level) const {
+        return std::max(1U, std::max(1U, Scale(width)) >> level);
+    }
+
+    /// Returns the height of a given mipmap level of the host texture.
+    u32 GetHostMipHeight(u32 level) const {
+        return std::max(1U, std::max(1U, Scale(height)) >> level);
+    }
+
+    /// Returns the parameters of the host texture, the guest parameters with the size scaled by
+    /// the resolution scale. They're only valid to allocate and transfer the host texture.
+    SurfaceParams GetHostParams() const;
+
     /// Returns the debug name of the texture for use in graphic debuggers.
     std::string TargetName() const;
 
@@ -250,6 +298,7 @@ public:
     VideoCore::Surface::ComponentType component_type;
     VideoCore::Surface::SurfaceType type;
     VideoCore::Surface::SurfaceTarget target;
+    float resolution_scale = 1.0f; ///< Scale of the host texture resolution, one when not scaled
 
 private:
     /// Returns the size of a given mipmap level inside a layer.
@@ -116,10 +116,10 @@ public:
         std::lock_guard lock{mutex};
         auto& maxwell3d = system.GPU().Maxwell3D();
 
-        if (!maxwell3d.dirty.depth_buffer) {
+        if (!maxwell3d.dirty.flags[VideoCommon::Dirty::DepthBuffer]) {
             return depth_buffer.view;
         }
-        maxwell3d.dirty.depth_buffer = false;
+        maxwell3d.dirty.flags.Reset(VideoCommon::Dirty::DepthBuffer);
 
         const auto& regs{maxwell3d.regs};
         const auto gpu_addr{regs.zeta.Address()};
@@ -145,10 +145,10 @@ public:
         std::lock_guard lock{mutex};
         ASSERT(index < Tegra::Engines::Maxwell3D::Regs::NumRenderTargets);
         auto& maxwell3d = system.GPU().Maxwell3D();
-        if (!maxwell3d.dirty.render_target[index]) {
+        if (!maxwell3d.dirty.flags[VideoCommon::Dirty::RenderTarget0 + index]) {
             return render_targets[index].view;
         }
-        maxwell3d.dirty.render_target[index] = false;
+        maxwell3d.dirty.flags.Reset(VideoCommon::Dirty::RenderTarget0 + index);
 
         const auto& regs{maxwell3d.regs};
         if (index >= regs.rt_control.count || regs.rt[index].Address() == 0 ||
@@ -242,7 +242,7 @@ protected:
         }
 
         SetEmptyDepthBuffer();
-        staging_cache.SetSize(2);
+        staging_cache.SetSize(3);
 
         const auto make_siblings = [this](PixelFormat a, PixelFormat b) {
             siblings_table[static_cast<std::size_t>(a)] = b;
@@ -274,11 +274,11 @@ protected:
         auto& maxwell3d = system.GPU().Maxwell3D();
         const u32 index = surface->GetRenderTarget();
         if (index == DEPTH_RT) {
-            maxwell3d.dirty.depth_buffer = true;
+            maxwell3d.dirty.flags.Set(VideoCommon::Dirty::DepthBuffer);
         } else {
-            maxwell3d.dirty.render_target[index] = true;
+            maxwell3d.dirty.flags.Set(VideoCommon::Dirty::RenderTarget0 + index);
         }
-        maxwell3d.dirty.render_settings = true;
+        maxwell3d.dirty.flags.Set(VideoCommon::Dirty::RenderSettings);
     }
 
     void Register(TSurface surface) {
@@ -431,21 +431,29 @@ private:
                                               bool is_render) {
         const auto gpu_addr = current_surface->GetGpuAddr();
         const auto& cr_params = current_surface->GetSurfaceParams();
-        TSurface new_surface;
+        SurfaceParams new_params = params;
         if (cr_params.pixel_format != params.pixel_format && !is_render &&
             GetSiblingFormat(cr_params.pixel_format) == params.pixel_format) {
-            SurfaceParams new_params = params;
             new_params.pixel_format = cr_params.pixel_format;
             new_params.component_type = cr_params.component_type;
             new_params.type = cr_params.type;
-            new_surface = GetUncachedSurface(gpu_addr, new_params);
-        } else {
-            new_surface = GetUncachedSurface(gpu_addr, params);
         }
+        if (!is_render && new_params.IsScalable()) {
+            // Sampled surfaces keep the resolution the guest rendered them at
+            new_params.resolution_scale = cr_params.resolution_scale;
+        }
+        TSurface new_surface = GetUncachedSurface(gpu_addr, new_params);
         const auto& final_params = new_surface->GetSurfaceParams();
         if (cr_params.type != final_params.type ||
             (cr_params.component_type != final_params.component_type)) {
-            BufferCopy(current_surface, new_surface);
+            if (cr_params.resolution_scale != final_params.resolution_scale) {
+                // Reinterpreting the texels of surfaces of different sizes is not possible, go
+                // through guest memory instead
+                FlushSurface(current_surface);
+                LoadSurface(new_surface);
+            } else {
+                BufferCopy(current_surface, new_surface);
+            }
         } else {
             std::vector<CopyParams> bricks = current_surface->BreakDown(final_params);
             for (auto& brick : bricks) {
@@ -470,6 +478,11 @@ private:
                                                      const SurfaceParams& params, bool is_render) {
         const bool is_mirage = !current_surface->MatchFormat(params.pixel_format);
         const bool matches_target = current_surface->MatchTarget(params.target);
+        if (is_render &&
+            current_surface->GetSurfaceParams().resolution_scale != params.resolution_scale) {
+            // The resolution scale changed, render targets are recreated at the new scale
+            return RebuildSurface(current_surface, params, is_render);
+        }
         const auto match_check = [&]() -> std::pair<TSurface, TView> {
             if (matches_target) {
                 return {current_surface, current_surface->GetMainView()};
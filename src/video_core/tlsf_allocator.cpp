@@ -0,0 +1,313 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include "common/alignment.h"
+#include "common/assert.h"
+#include "common/bit_util.h"
+#include "video_core/tlsf_allocator.h"
+
+namespace VideoCommon {
+
+double TlsfAllocator::Stats::Fragmentation() const {
+    const u64 free_size = total_size - used_size;
+    if (free_size == 0) {
+        return 0.0;
+    }
+    return 1.0 - static_cast<double>(largest_free_block) / static_cast<double>(free_size);
+}
+
+TlsfAllocator::TlsfAllocator(u64 size) : total_size{Common::AlignDown(size, GRANULARITY)} {
+    ASSERT(total_size > 0);
+    for (auto& lists : free_lists) {
+        lists.fill(NONE);
+    }
+    partial_pages.fill(NONE);
+
+    const u32 index = NewBlock();
+    blocks[index].size = total_size;
+    InsertFreeBlock(index);
+}
+
+TlsfAllocator::~TlsfAllocator() = default;
+
+std::optional<TlsfAllocator::Allocation> TlsfAllocator::Allocate(u64 size, u64 alignment) {
+    std::optional<Allocation> allocation;
+    const u32 size_log2 = Common::Log2Ceil64(std::max({size, alignment, u64{1}}));
+    if (size_log2 < MIN_SLOT_LOG2 + NUM_SLOT_CLASSES) {
+        allocation = AllocateSlot(size_log2 > MIN_SLOT_LOG2 ? size_log2 - MIN_SLOT_LOG2 : 0);
+    }
+    if (!allocation) {
+        // Large allocations, or small ones when no slab page could be allocated.
+        allocation = AllocateBlock(size, alignment);
+    }
+    if (allocation) {
+        ++num_allocations;
+    }
+    return allocation;
+}
+
+void TlsfAllocator::Free(Handle handle) {
+    if (handle & SLOT_HANDLE_BIT) {
+        FreeSlot(handle);
+    } else {
+        ASSERT_MSG(!blocks[handle].is_free, "Freeing a free block");
+        FreeBlock(handle);
+    }
+    --num_allocations;
+}
+
+TlsfAllocator::Stats TlsfAllocator::GetStats() const {
+    Stats stats;
+    stats.total_size = total_size;
+    stats.used_size = used_size;
+    stats.num_allocations = num_allocations;
+    for (const auto& lists : free_lists) {
+        for (const u32 head : lists) {
+            for (u32 index = head; index != NONE; index = blocks[index].next_free) {
+                stats.largest_free_block = std::max(stats.largest_free_block, blocks[index].size);
+                ++stats.num_free_blocks;
+            }
+        }
+    }
+    return stats;
+}
+
+std::pair<u32, u32> TlsfAllocator::Mapping(u64 size) {
+    if (size < LINEAR_SIZE) {
+        return {0, static_cast<u32>(size >> GRANULARITY_LOG2)};
+    }
+    const u32 msb = Common::MostSignificantBit64(size);
+    const u32 fl = msb - (SL_LOG2 + GRANULARITY_LOG2) + 1;
+    const u32 sl = static_cast<u32>(size >> (msb - SL_LOG2)) - SL_COUNT;
+    return {fl, sl};
+}
+
+u32 TlsfAllocator::FindSuitableBlock(u64 size) const {
+    if (size >= LINEAR_SIZE) {
+        // Round up to the next list so any block found in it is large enough.
+        const u64 round = (u64{1} << (Common::MostSignificantBit64(size) - SL_LOG2)) - 1;
+        if (size > total_size) {
+            return NONE;
+        }
+        size += round;
+    }
+    auto [fl, sl] = Mapping(size);
+    u32 sl_map = sl_bitmaps[fl] & (~0U << sl);
+    if (sl_map == 0) {
+        const u64 fl_map = fl + 1 < FL_COUNT ? fl_bitmap & (~u64{0} << (fl + 1)) : 0;
+        if (fl_map == 0) {
+            return NONE;
+        }
+        fl = Common::CountTrailingZeroes64(fl_map);
+        sl_map = sl_bitmaps[fl];
+    }
+    sl = Common::CountTrailingZeroes32(sl_map);
+    return free_lists[fl][sl];
+}
+
+std::optional<TlsfAllocator::Allocation> TlsfAllocator::AllocateBlock(u64 size, u64 alignment) {
+    size = Common::AlignUp(std::max<u64>(size, 1), GRANULARITY);
+    alignment = std::max(alignment, GRANULARITY);
+
+    u32 index = FindSuitableBlock(size + alignment - GRANULARITY);
+    if (index == NONE) {
+        return std::nullopt;
+    }
+    RemoveFreeBlock(index);
+
+    // Physical neighbours of a free block are never free, the split blocks can be inserted as is.
+    const u64 offset = blocks[index].offset;
+    if (const u64 padding = Common::AlignUp(offset, alignment) - offset; padding != 0) {
+        const u32 aligned = SplitBlock(index, padding);
+        InsertFreeBlock(index);
+        index = aligned;
+    }
+    if (blocks[index].size > size) {
+        InsertFreeBlock(SplitBlock(index, size));
+    }
+
+    used_size += blocks[index].size;
+    return Allocation{blocks[index].offset, index};
+}
+
+void TlsfAllocator::FreeBlock(u32 index) {
+    used_size -= blocks[index].size;
+
+    if (const u32 next = blocks[index].next_phys; next != NONE && blocks[next].is_free) {
+        RemoveFreeBlock(next);
+        MergeNext(index);
+    }
+    if (const u32 prev = blocks[index].prev_phys; prev != NONE && blocks[prev].is_free) {
+        RemoveFreeBlock(prev);
+        MergeNext(prev);
+        index = prev;
+    }
+    InsertFreeBlock(index);
+}
+
+std::optional<TlsfAllocator::Allocation> TlsfAllocator::AllocateSlot(u32 slot_class) {
+    const u32 num_slots = MAX_SLOTS >> slot_class;
+    u32 page_index = partial_pages[slot_class];
+    if (page_index == NONE) {
+        const auto block = AllocateBlock(SLAB_PAGE_SIZE, SLAB_PAGE_SIZE);
+        if (!block) {
+            return std::nullopt;
+        }
+        if (unused_pages.empty()) {
+            page_index = static_cast<u32>(pages.size());
+            ASSERT(page_index < (SLOT_HANDLE_BIT >> 8));
+            pages.emplace_back();
+        } else {
+            page_index = unused_pages.back();
+            unused_pages.pop_back();
+        }
+
+        SlabPage& page = pages[page_index];
+        page = SlabPage{};
+        page.block = block->handle;
+        page.slot_class = slot_class;
+        for (u32 slot = 0; slot < num_slots; ++slot) {
+            page.free_slots[slot / 64] |= u64{1} << (slot % 64);
+        }
+        LinkPage(page_index);
+    }
+
+    SlabPage& page = pages[page_index];
+    const auto word = std::find_if(page.free_slots.begin(), page.free_slots.end(),
+                                   [](u64 slots) { return slots != 0; });
+    ASSERT(word != page.free_slots.end());
+    const u32 slot = static_cast<u32>(word - page.free_slots.begin()) * 64 +
+                     Common::CountTrailingZeroes64(*word);
+    *word &= *word - 1;
+
+    if (++page.num_used == num_slots) {
+        UnlinkPage(page_index);
+    }
+
+    const u64 offset = blocks[page.block].offset + (u64{slot} << (MIN_SLOT_LOG2 + slot_class));
+    return Allocation{offset, SLOT_HANDLE_BIT | (page_index << 8) | slot};
+}
+
+void TlsfAllocator::FreeSlot(Handle handle) {
+    const u32 page_index = (handle & ~SLOT_HANDLE_BIT) >> 8;
+    const u32 slot = handle & 0xff;
+    SlabPage& page = pages[page_index];
+
+    u64& word = page.free_slots[slot / 64];
+    const u64 mask = u64{1} << (slot % 64);
+    ASSERT_MSG((word & mask) == 0, "Freeing a free slot");
+    word |= mask;
+
+    if (page.num_used-- == MAX_SLOTS >> page.slot_class) {
+        LinkPage(page_index);
+    }
+    if (page.num_used == 0) {
+        UnlinkPage(page_index);
+        FreeBlock(page.block);
+        unused_pages.push_back(page_index);
+    }
+}
+
+void TlsfAllocator::InsertFreeBlock(u32 index) {
+    const auto [fl, sl] = Mapping(blocks[index].size);
+    Block& block = blocks[index];
+    block.is_free = true;
+    block.prev_free = NONE;
+    block.next_free = free_lists[fl][sl];
+    if (block.next_free != NONE) {
+        blocks[block.next_free].prev_free = index;
+    }
+    free_lists[fl][sl] = index;
+    fl_bitmap |= u64{1} << fl;
+    sl_bitmaps[fl] |= 1U << sl;
+}
+
+void TlsfAllocator::RemoveFreeBlock(u32 index) {
+    const auto [fl, sl] = Mapping(blocks[index].size);
+    Block& block = blocks[index];
+    if (block.prev_free != NONE) {
+        blocks[block.prev_free].next_free = block.next_free;
+    } else {
+        free_lists[fl][sl] = block.next_free;
+    }
+    if (block.next_free != NONE) {
+        blocks[block.next_free].prev_free = block.prev_free;
+    }
+    block.is_free = false;
+    block.prev_free = NONE;
+    block.next_free = NONE;
+
+    if (free_lists[fl][sl] == NONE) {
+        sl_bitmaps[fl] &= ~(1U << sl);
+        if (sl_bitmaps[fl] == 0) {
+            fl_bitmap &= ~(u64{1} << fl);
+        }
+    }
+}
+
+u32 TlsfAllocator::SplitBlock(u32 index, u64 size) {
+    const u32 remainder = NewBlock();
+    Block& block = blocks[index];
+    Block& rest = blocks[remainder];
+    rest.offset = block.offset + size;
+    rest.size = block.size - size;
+    rest.prev_phys = index;
+    rest.next_phys = block.next_phys;
+    if (block.next_phys != NONE) {
+        blocks[block.next_phys].prev_phys = remainder;
+    }
+    block.next_phys = remainder;
+    block.size = size;
+    return remainder;
+}
+
+void TlsfAllocator::MergeNext(u32 index) {
+    const u32 next = blocks[index].next_phys;
+    Block& block = blocks[index];
+    block.size += blocks[next].size;
+    block.next_phys = blocks[next].next_phys;
+    if (block.next_phys != NONE) {
+        blocks[block.next_phys].prev_phys = index;
+    }
+    blocks[next] = Block{};
+    unused_blocks.push_back(next);
+}
+
+u32 TlsfAllocator::NewBlock() {
+    if (unused_blocks.empty()) {
+        blocks.emplace_back();
+        return static_cast<u32>(blocks.size() - 1);
+    }
+    const u32 index = unused_blocks.back();
+    unused_blocks.pop_back();
+    return index;
+}
+
+void TlsfAllocator::LinkPage(u32 page_index) {
+    SlabPage& page = pages[page_index];
+    u32& head = partial_pages[page.slot_class];
+    page.prev = NONE;
+    page.next = head;
+    if (head != NONE) {
+        pages[head].prev = page_index;
+    }
+    head = page_index;
+}
+
+void TlsfAllocator::UnlinkPage(u32 page_index) {
+    SlabPage& page = pages[page_index];
+    if (page.prev != NONE) {
+        pages[page.prev].next = page.next;
+    } else {
+        partial_pages[page.slot_class] = page.next;
+    }
+    if (page.next != NONE) {
+        pages[page.next].prev = page.prev;
+    }
+    page.prev = NONE;
+    page.next = NONE;
+}
+
+} // namespace VideoCommon
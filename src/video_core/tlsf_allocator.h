@@ -0,0 +1,145 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "common/common_types.h"
+
+namespace VideoCommon {
+
+/// Two-level segregated fit allocator of offsets inside a range of memory it doesn't access, like a
+/// device memory allocation. Allocations and releases run in constant time. Small allocations are
+/// served from pages of fixed size slots so they don't fragment the rest of the range.
+class TlsfAllocator final {
+public:
+    using Handle = u32;
+
+    struct Allocation {
+        u64 offset{};  ///< Offset of the allocation relative to the start of the range
+        Handle handle; ///< Handle to release the allocation with
+    };
+
+    struct Stats {
+        u64 total_size{};              ///< Size of the range
+        u64 used_size{};               ///< Size of the allocated blocks, including padding
+        u64 largest_free_block{};      ///< Size of the largest contiguous free block
+        std::size_t num_free_blocks{}; ///< Number of contiguous free blocks
+        std::size_t num_allocations{}; ///< Number of live allocations
+
+        /// Returns the ratio of free memory that can't serve an allocation of the largest free
+        /// block size, from 0 (not fragmented) to 1.
+        double Fragmentation() const;
+    };
+
+    explicit TlsfAllocator(u64 size);
+    ~TlsfAllocator();
+
+    /**
+     * Allocates a block of the range.
+     * @param size      Size in bytes of the allocation.
+     * @param alignment Alignment of the offset of the allocation, it must be a power of two.
+     * @returns The allocated block or an empty optional when there's no free block large enough.
+     */
+    std::optional<Allocation> Allocate(u64 size, u64 alignment);
+
+    /// Releases an allocation returned by Allocate.
+    void Free(Handle handle);
+
+    /// Returns true when there are no live allocations.
+    bool IsEmpty() const {
+        return num_allocations == 0;
+    }
+
+    /// Returns the occupancy and fragmentation of the range. Runs in linear time.
+    Stats GetStats() const;
+
+private:
+    static constexpr u32 NONE = ~u32{0};
+
+    static constexpr u32 GRANULARITY_LOG2 = 4;
+    static constexpr u64 GRANULARITY = u64{1} << GRANULARITY_LOG2;
+    static constexpr u32 SL_LOG2 = 4;
+    static constexpr u32 SL_COUNT = 1U << SL_LOG2;
+    static constexpr u32 FL_COUNT = 64;
+    /// Blocks smaller than this are mapped linearly to the second level lists of the first level 0
+    static constexpr u64 LINEAR_SIZE = u64{1} << (SL_LOG2 + GRANULARITY_LOG2);
+
+    static constexpr u32 MIN_SLOT_LOG2 = 8;
+    static constexpr u32 NUM_SLOT_CLASSES = 6;
+    static constexpr u32 SLAB_PAGE_LOG2 = 16;
+    static constexpr u64 SLAB_PAGE_SIZE = u64{1} << SLAB_PAGE_LOG2;
+    static constexpr u32 MAX_SLOTS = 1U << (SLAB_PAGE_LOG2 - MIN_SLOT_LOG2);
+    /// Handles with this bit set refer to a slot of a slab page
+    static constexpr Handle SLOT_HANDLE_BIT = Handle{1} << 31;
+
+    /// Contiguous block of the range, either free or allocated.
+    struct Block {
+        u64 offset{};
+        u64 size{};
+        u32 prev_phys = NONE; ///< Block ending where this one starts
+        u32 next_phys = NONE; ///< Block starting where this one ends
+        u32 prev_free = NONE; ///< Previous block in the same free list
+        u32 next_free = NONE; ///< Next block in the same free list
+        bool is_free = false;
+    };
+
+    /// Page of the range split in equally sized slots.
+    struct SlabPage {
+        u32 block = NONE; ///< Block backing the page
+        u32 slot_class{};
+        u32 num_used{};
+        u32 prev = NONE; ///< Previous page of the same class with free slots
+        u32 next = NONE; ///< Next page of the same class with free slots
+        std::array<u64, MAX_SLOTS / 64> free_slots{};
+    };
+
+    /// Returns the first and second level indices of the list holding blocks of the given size.
+    static std::pair<u32, u32> Mapping(u64 size);
+
+    /// Returns a free block of at least the given size or NONE.
+    u32 FindSuitableBlock(u64 size) const;
+
+    std::optional<Allocation> AllocateBlock(u64 size, u64 alignment);
+    void FreeBlock(u32 index);
+
+    std::optional<Allocation> AllocateSlot(u32 slot_class);
+    void FreeSlot(Handle handle);
+
+    void InsertFreeBlock(u32 index);
+    void RemoveFreeBlock(u32 index);
+
+    /// Splits the block at size, returning the index of the block with the remaining range.
+    u32 SplitBlock(u32 index, u64 size);
+
+    /// Absorbs the next physical block into the block at index.
+    void MergeNext(u32 index);
+
+    u32 NewBlock();
+
+    void LinkPage(u32 page_index);
+    void UnlinkPage(u32 page_index);
+
+    const u64 total_size;
+    u64 used_size = 0;
+    std::size_t num_allocations = 0;
+
+    std::vector<Block> blocks;
+    std::vector<u32> unused_blocks;
+
+    u64 fl_bitmap = 0;
+    std::array<u32, FL_COUNT> sl_bitmaps{};
+    std::array<std::array<u32, SL_COUNT>, FL_COUNT> free_lists;
+
+    std::vector<SlabPage> pages;
+    std::vector<u32> unused_pages;
+    /// Head of the list of pages with free slots of each slot class
+    std::array<u32, NUM_SLOT_CLASSES> partial_pages;
+};
+
+} // namespace VideoCommon
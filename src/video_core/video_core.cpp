@@ -33,4 +33,11 @@ u16 GetResolutionScaleFactor(const RendererBase& renderer) {
             : renderer.GetRenderWindow().GetFramebufferLayout().GetScalingRatio());
 }
 
+float GetResolutionScale(const RendererBase& renderer) {
+    const float scale = Settings::values.resolution_factor
+                            ? Settings::values.resolution_factor
+                            : renderer.GetRenderWindow().GetFramebufferLayout().GetScalingRatio();
+    return scale > 0.0f ? scale : 1.0f;
+}
+
 } // namespace VideoCore
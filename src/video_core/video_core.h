@@ -36,4 +36,8 @@ std::unique_ptr<Tegra::GPU> CreateGPU(Core::System& system);
 
 u16 GetResolutionScaleFactor(const RendererBase& renderer);
 
+/// Returns the scale applied to the resolution of render targets. Unlike the scale factor, it can
+/// be fractional, scales below one render at a lower resolution than the guest.
+float GetResolutionScale(const RendererBase& renderer);
+
 } // namespace VideoCore
@@ -437,6 +437,8 @@ void Config::ReadCoreValues() {
     qt_config->beginGroup(QStringLiteral("Core"));
 
     Settings::values.use_multi_core = ReadSetting(QStringLiteral("use_multi_core"), false).toBool();
+    Settings::values.use_host_timing =
+        ReadSetting(QStringLiteral("use_host_timing"), false).toBool();
 
     qt_config->endGroup();
 }
@@ -475,6 +477,8 @@ void Config::ReadDebuggingValues() {
     Settings::values.reporting_services =
         ReadSetting(QStringLiteral("reporting_services"), false).toBool();
     Settings::values.quest_flag = ReadSetting(QStringLiteral("quest_flag"), false).toBool();
+    Settings::values.use_freezer_write_watch =
+        ReadSetting(QStringLiteral("use_freezer_write_watch"), false).toBool();
 
     qt_config->endGroup();
 }
@@ -507,6 +511,8 @@ void Config::ReadMiscellaneousValues() {
             .toString()
             .toStdString();
     Settings::values.use_dev_keys = ReadSetting(QStringLiteral("use_dev_keys"), false).toBool();
+    Settings::values.use_compressed_log =
+        ReadSetting(QStringLiteral("use_compressed_log"), false).toBool();
 
     qt_config->endGroup();
 }
@@ -542,6 +548,8 @@ void Config::ReadRendererValues() {
         ReadSetting(QStringLiteral("use_asynchronous_gpu_emulation"), false).toBool();
     Settings::values.force_30fps_mode =
         ReadSetting(QStringLiteral("force_30fps_mode"), false).toBool();
+    Settings::values.present_mode =
+        Settings::ToPresentMode(ReadSetting(QStringLiteral("present_mode"), 0).toInt());
 
     Settings::values.bg_red = ReadSetting(QStringLiteral("bg_red"), 0.0).toFloat();
     Settings::values.bg_green = ReadSetting(QStringLiteral("bg_green"), 0.0).toFloat();
@@ -831,6 +839,7 @@ void Config::SaveCoreValues() {
     qt_config->beginGroup(QStringLiteral("Core"));
 
     WriteSetting(QStringLiteral("use_multi_core"), Settings::values.use_multi_core, false);
+    WriteSetting(QStringLiteral("use_host_timing"), Settings::values.use_host_timing, false);
 
     qt_config->endGroup();
 }
@@ -859,6 +868,8 @@ void Config::SaveDebuggingValues() {
     WriteSetting(QStringLiteral("dump_exefs"), Settings::values.dump_exefs, false);
     WriteSetting(QStringLiteral("dump_nso"), Settings::values.dump_nso, false);
     WriteSetting(QStringLiteral("quest_flag"), Settings::values.quest_flag, false);
+    WriteSetting(QStringLiteral("use_freezer_write_watch"),
+                 Settings::values.use_freezer_write_watch, false);
 
     qt_config->endGroup();
 }
@@ -889,6 +900,7 @@ void Config::SaveMiscellaneousValues() {
     WriteSetting(QStringLiteral("log_filter"), QString::fromStdString(Settings::values.log_filter),
                  QStringLiteral("*:Info"));
     WriteSetting(QStringLiteral("use_dev_keys"), Settings::values.use_dev_keys, false);
+    WriteSetting(QStringLiteral("use_compressed_log"), Settings::values.use_compressed_log, false);
 
     qt_config->endGroup();
 }
@@ -922,6 +934,8 @@ void Config::SaveRendererValues() {
     WriteSetting(QStringLiteral("use_asynchronous_gpu_emulation"),
                  Settings::values.use_asynchronous_gpu_emulation, false);
     WriteSetting(QStringLiteral("force_30fps_mode"), Settings::values.force_30fps_mode, false);
+    WriteSetting(QStringLiteral("present_mode"), static_cast<int>(Settings::values.present_mode),
+                 0);
 
     // Cast to double because Qt's written float values are not human-readable
     WriteSetting(QStringLiteral("bg_red"), static_cast<double>(Settings::values.bg_red), 0.0);
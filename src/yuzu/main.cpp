@@ -165,7 +165,12 @@ static void InitializeLogging() {
 
     const std::string& log_dir = FileUtil::GetUserPath(FileUtil::UserPath::LogDir);
     FileUtil::CreateFullPath(log_dir);
-    Log::AddBackend(std::make_unique<Log::FileBackend>(log_dir + LOG_FILE));
+    if (Settings::values.use_compressed_log) {
+        Log::AddBackend(
+            std::make_unique<Log::CompressedFileBackend>(log_dir + COMPRESSED_LOG_FILE));
+    } else {
+        Log::AddBackend(std::make_unique<Log::FileBackend>(log_dir + LOG_FILE));
+    }
 #ifdef _WIN32
     Log::AddBackend(std::make_unique<Log::DebuggerBackend>());
 #endif
@@ -341,6 +341,7 @@ void Config::ReadValues() {
 
     // Core
     Settings::values.use_multi_core = sdl2_config->GetBoolean("Core", "use_multi_core", false);
+    Settings::values.use_host_timing = sdl2_config->GetBoolean("Core", "use_host_timing", false);
 
     // Renderer
     Settings::values.resolution_factor =
@@ -354,6 +355,8 @@ void Config::ReadValues() {
         sdl2_config->GetBoolean("Renderer", "use_accurate_gpu_emulation", false);
     Settings::values.use_asynchronous_gpu_emulation =
         sdl2_config->GetBoolean("Renderer", "use_asynchronous_gpu_emulation", false);
+    Settings::values.present_mode = Settings::ToPresentMode(
+        static_cast<int>(sdl2_config->GetInteger("Renderer", "present_mode", 0)));
 
     Settings::values.bg_red = static_cast<float>(sdl2_config->GetReal("Renderer", "bg_red", 0.0));
     Settings::values.bg_green =
@@ -371,6 +374,8 @@ void Config::ReadValues() {
 
     // Miscellaneous
     Settings::values.log_filter = sdl2_config->Get("Miscellaneous", "log_filter", "*:Trace");
+    Settings::values.use_compressed_log =
+        sdl2_config->GetBoolean("Miscellaneous", "use_compressed_log", false);
     Settings::values.use_dev_keys = sdl2_config->GetBoolean("Miscellaneous", "use_dev_keys", false);
 
     // Debugging
@@ -383,6 +388,8 @@ void Config::ReadValues() {
     Settings::values.reporting_services =
         sdl2_config->GetBoolean("Debugging", "reporting_services", false);
     Settings::values.quest_flag = sdl2_config->GetBoolean("Debugging", "quest_flag", false);
+    Settings::values.use_freezer_write_watch =
+        sdl2_config->GetBoolean("Debugging", "use_freezer_write_watch", false);
 
     const auto title_list = sdl2_config->Get("AddOns", "title_ids", "");
     std::stringstream ss(title_list);
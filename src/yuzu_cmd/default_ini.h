@@ -80,6 +80,10 @@ touch_device=
 # 0 (default): Disabled, 1: Enabled
 use_multi_core=
 
+# Whether guest time follows the host clock instead of the estimated number of executed cycles
+# 0 (default): Disabled, 1: Enabled
+use_host_timing=
+
 [Renderer]
 # Whether to use software or hardware rendering.
 # 0: Software, 1 (default): Hardware
@@ -89,7 +93,8 @@ use_hw_renderer =
 # 0: Interpreter (slow), 1 (default): JIT (fast)
 use_shader_jit =
 
-# Resolution scale factor
+# Resolution scale factor, experimental: shaders sizing or addressing render targets themselves
+# may render wrong when it's not 1
 # 0: Auto (scales resolution to window size), 1: Native Switch screen resolution, Otherwise a scale
 # factor for the Switch resolution
 resolution_factor =
@@ -118,6 +123,10 @@ use_accurate_gpu_emulation =
 # 0 : Off (slow), 1 (default): On (fast)
 use_asynchronous_gpu_emulation =
 
+# How composed frames are paced against the GPU thread when asynchronous GPU emulation is on
+# 0 (default): Immediate, 1: Mailbox (hold the newest frame while one is in flight), 2: FIFO (wait)
+present_mode =
+
 # The clear color for the renderer. What shows up on the sides of the bottom screen.
 # Must be in range of 0.0-1.0. Defaults to 1.0 for all.
 bg_red =
@@ -212,6 +221,11 @@ region_value =
 # Examples: *:Debug Kernel.SVC:Trace Service.*:Critical
 log_filter = *:Trace
 
+# Whether to write the log as compressed binary files rotated across yuzu_log.<n>.zlog, which keeps
+# the end of long sessions. Use yuzu-log-decoder to read them.
+# 0 (default): Off, 1: On
+use_compressed_log =
+
 [Debugging]
 # Port for listening to GDB connections.
 use_gdbstub=false
@@ -223,6 +237,9 @@ dump_nso=false
 # Determines whether or not yuzu will report to the game that the emulated console is in Kiosk Mode
 # false: Retail/Normal Mode (default), true: Kiosk Mode
 quest_flag =
+# How the memory freezer keeps frozen values in place
+# false (default): Rewrite them once per frame, true: Correct writes to them as they happen
+use_freezer_write_watch =
 
 [WebService]
 # Whether or not to enable telemetry
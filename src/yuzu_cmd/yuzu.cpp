@@ -20,12 +20,15 @@
 #include "common/scope_exit.h"
 #include "common/string_util.h"
 #include "common/telemetry.h"
+#include "common/trace.h"
 #include "core/core.h"
 #include "core/crypto/key_manager.h"
 #include "core/file_sys/vfs_real.h"
 #include "core/gdbstub/gdbstub.h"
+#include "core/guest_profiler.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/loader/loader.h"
+#include "core/perf_stats.h"
 #include "core/settings.h"
 #include "core/telemetry_session.h"
 #include "video_core/renderer_base.h"
@@ -64,7 +67,14 @@ static void PrintHelp(const char* argv0) {
                  "-f, --fullscreen      Start in fullscreen mode\n"
                  "-h, --help            Display this help and exit\n"
                  "-v, --version         Output version information and exit\n"
-                 "-p, --program         Pass following string as arguments to executable\n";
+                 "-p, --program         Pass following string as arguments to executable\n"
+                 "-s, --perf-stats=FILE Write per-frame performance records to FILE on exit\n"
+                 "                      (JSON if FILE ends in .json, CSV otherwise)\n"
+                 "-t, --trace=FILE      Record profiling scopes and write them to FILE on exit\n"
+                 "                      as a Chrome trace\n"
+                 "-c, --cpu-profile=FILE\n"
+                 "                      Sample guest code and write the hottest functions and\n"
+                 "                      interpreter fallbacks to FILE on exit\n";
 }
 
 static void PrintVersion() {
@@ -80,7 +90,12 @@ static void InitializeLogging() {
 
     const std::string& log_dir = FileUtil::GetUserPath(FileUtil::UserPath::LogDir);
     FileUtil::CreateFullPath(log_dir);
-    Log::AddBackend(std::make_unique<Log::FileBackend>(log_dir + LOG_FILE));
+    if (Settings::values.use_compressed_log) {
+        Log::AddBackend(
+            std::make_unique<Log::CompressedFileBackend>(log_dir + COMPRESSED_LOG_FILE));
+    } else {
+        Log::AddBackend(std::make_unique<Log::FileBackend>(log_dir + LOG_FILE));
+    }
 #ifdef _WIN32
     Log::AddBackend(std::make_unique<Log::DebuggerBackend>());
 #endif
@@ -109,16 +124,22 @@ int main(int argc, char** argv) {
 #endif
     std::string filepath;
 
+    std::string perf_stats_path;
+    std::string trace_path;
+    std::string cpu_profile_path;
+
     bool fullscreen = false;
 
     static struct option long_options[] = {
-        {"gdbport", required_argument, 0, 'g'}, {"fullscreen", no_argument, 0, 'f'},
-        {"help", no_argument, 0, 'h'},          {"version", no_argument, 0, 'v'},
-        {"program", optional_argument, 0, 'p'}, {0, 0, 0, 0},
+        {"gdbport", required_argument, 0, 'g'},    {"fullscreen", no_argument, 0, 'f'},
+        {"help", no_argument, 0, 'h'},             {"version", no_argument, 0, 'v'},
+        {"program", optional_argument, 0, 'p'},    {"perf-stats", required_argument, 0, 's'},
+        {"trace", required_argument, 0, 't'},      {"cpu-profile", required_argument, 0, 'c'},
+        {0, 0, 0, 0},
     };
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "g:fhvp::", long_options, &option_index);
+        int arg = getopt_long(argc, argv, "g:fhvp::s:t:c:", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
             case 'g':
@@ -146,6 +167,16 @@ int main(int argc, char** argv) {
                 Settings::values.program_args = argv[optind];
                 ++optind;
                 break;
+            case 's':
+                perf_stats_path = optarg;
+                break;
+            case 't':
+                trace_path = optarg;
+                Common::Trace::Enable();
+                break;
+            case 'c':
+                cpu_profile_path = optarg;
+                break;
             }
         } else {
 #ifdef _WIN32
@@ -223,10 +254,33 @@ int main(int argc, char** argv) {
     emu_window->MakeCurrent();
     system.Renderer().Rasterizer().LoadDiskResources();
 
+    if (!cpu_profile_path.empty()) {
+        system.GetGuestProfiler().Start();
+    }
+
     while (emu_window->IsOpen()) {
         system.RunLoop();
     }
 
+    if (!trace_path.empty()) {
+        Common::Trace::Disable();
+        Common::Trace::WriteChromeTrace(trace_path);
+    }
+
+    if (!cpu_profile_path.empty()) {
+        system.GetGuestProfiler().Stop();
+        system.GetGuestProfiler().WriteReport(cpu_profile_path);
+    }
+
+    if (!perf_stats_path.empty()) {
+        std::string extension;
+        Common::SplitPath(perf_stats_path, nullptr, nullptr, &extension);
+        const bool is_json = Common::ToLower(extension) == ".json";
+        system.GetPerfStats().DumpFrameRecords(
+            perf_stats_path, is_json ? Core::PerfStats::DumpFormat::JSON
+                                     : Core::PerfStats::DumpFormat::CSV);
+    }
+
     detached_tasks.WaitForAllTasks();
     return 0;
 }
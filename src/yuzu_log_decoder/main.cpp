@@ -0,0 +1,56 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "common/file_util.h"
+#include "common/logging/backend.h"
+#include "common/logging/text_formatter.h"
+
+static void PrintHelp(const char* argv0) {
+    std::cout << "Usage: " << argv0
+              << " <log>...\n"
+                 "Prints compressed yuzu logs as text. Each <log> is either a single .zlog file\n"
+                 "or the base path of a set of rotated log files, e.g. \"yuzu_log\".\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        PrintHelp(argv[0]);
+        return 1;
+    }
+
+    const auto print_entry = [](const Log::Entry& entry) {
+        std::fputs(Log::FormatLogMessage(entry).append(1, '\n').c_str(), stdout);
+    };
+
+    int result = 0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string path = argv[i];
+
+        std::vector<std::string> files;
+        if (FileUtil::Exists(path) && !FileUtil::IsDirectory(path)) {
+            files.push_back(path);
+        } else {
+            files = Log::GetCompressedLogFiles(path);
+        }
+
+        if (files.empty()) {
+            std::cerr << "No log files found at " << path << '\n';
+            result = 1;
+        }
+
+        for (const auto& file : files) {
+            if (!Log::ReadCompressedLogFile(file, print_entry)) {
+                std::cerr << "Failed to read " << file << ", the log may be truncated\n";
+                result = 1;
+            }
+        }
+    }
+
+    return result;
+}
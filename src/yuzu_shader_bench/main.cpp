@@ -0,0 +1,344 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/common_paths.h"
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "common/logging/backend.h"
+#include "common/logging/filter.h"
+#include "video_core/renderer_opengl/gl_device.h"
+#include "video_core/renderer_opengl/gl_shader_cache.h"
+#include "video_core/renderer_opengl/gl_shader_decompiler.h"
+#include "video_core/renderer_opengl/gl_shader_disk_cache.h"
+#include "video_core/shader/shader_ir.h"
+
+#ifdef HAS_VULKAN
+#include "video_core/renderer_vulkan/vk_pipeline_cache.h"
+#include "video_core/renderer_vulkan/vk_shader_decompiler.h"
+#endif
+
+namespace {
+
+using OpenGL::ProgramType;
+using OpenGL::ShaderDiskCacheOpenGL;
+using OpenGL::ShaderDiskCacheRaw;
+using VideoCommon::Shader::ProgramCode;
+using VideoCommon::Shader::ShaderIR;
+
+/// Offset of the first instruction, after the shader program header
+constexpr u32 MAIN_OFFSET = 10;
+/// Compute programs have no header
+constexpr u32 COMPUTE_OFFSET = 0;
+
+using Clock = std::chrono::steady_clock;
+
+/// Time spent on each stage of a shader, in microseconds
+struct ShaderTimes {
+    s64 ir{};
+    s64 glsl{};
+    std::optional<s64> spirv;
+};
+
+struct Options {
+    std::string dump_dir; ///< Directory to write the generated sources to, empty to not dump
+    std::vector<std::string> files;
+};
+
+void PrintHelp(const char* argv0) {
+    std::cout << "Usage: " << argv0
+              << " [--dump <dir>] <transferable cache>...\n"
+                 "Decodes the shaders of transferable OpenGL shader caches and decompiles them to "
+                 "GLSL\nand SPIR-V, reporting the time spent on each shader.\n"
+                 "With --dump, the generated sources are written to <dir> with the extensions "
+                 "expected\nby glslangValidator (.vert, .geom, .frag, .comp) and spirv-val "
+                 "(.spv).\n";
+}
+
+std::optional<Options> ParseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--dump") {
+            if (++i == argc) {
+                return {};
+            }
+            options.dump_dir = argv[i];
+        } else if (arg == "-h" || arg == "--help") {
+            return {};
+        } else {
+            options.files.emplace_back(arg);
+        }
+    }
+    if (options.files.empty()) {
+        return {};
+    }
+    return options;
+}
+
+template <typename Function>
+s64 Measure(Function&& function) {
+    const auto start = Clock::now();
+    function();
+    const auto end = Clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+const char* GetStageName(ProgramType program_type) {
+    switch (program_type) {
+    case ProgramType::VertexA:
+        return "vertex_a";
+    case ProgramType::VertexB:
+        return "vertex";
+    case ProgramType::Geometry:
+        return "geometry";
+    case ProgramType::Fragment:
+        return "fragment";
+    case ProgramType::Compute:
+        return "compute";
+    default:
+        return "unknown";
+    }
+}
+
+/// Returns the file extension glslangValidator infers the stage of a source from.
+const char* GetGlslExtension(ProgramType program_type) {
+    switch (program_type) {
+    case ProgramType::VertexA:
+    case ProgramType::VertexB:
+        return "vert";
+    case ProgramType::Geometry:
+        return "geom";
+    case ProgramType::Fragment:
+        return "frag";
+    case ProgramType::Compute:
+    default:
+        return "comp";
+    }
+}
+
+/// Returns the suffix the OpenGL backend gives to the function it decompiles a program to.
+const char* GetDecompileSuffix(ProgramType program_type) {
+    switch (program_type) {
+    case ProgramType::VertexA:
+    case ProgramType::VertexB:
+        return "vertex";
+    case ProgramType::Geometry:
+        return "geometry";
+    case ProgramType::Fragment:
+        return "fragment";
+    case ProgramType::Compute:
+    default:
+        return "compute";
+    }
+}
+
+u32 GetMainOffset(ProgramType program_type) {
+    return program_type == ProgramType::Compute ? COMPUTE_OFFSET : MAIN_OFFSET;
+}
+
+bool IsSupported(ProgramType program_type) {
+    switch (program_type) {
+    case ProgramType::VertexA:
+    case ProgramType::VertexB:
+    case ProgramType::Geometry:
+    case ProgramType::Fragment:
+    case ProgramType::Compute:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void WriteDump(const Options& options, const std::string& name, std::string_view data) {
+    if (options.dump_dir.empty()) {
+        return;
+    }
+    const std::string path = options.dump_dir + DIR_SEP + name;
+    if (FileUtil::WriteStringToFile(false, path, data) != data.size()) {
+        std::cerr << "Failed to write " << path << '\n';
+    }
+}
+
+#ifdef HAS_VULKAN
+std::optional<Tegra::Engines::Maxwell3D::Regs::ShaderStage> GetVulkanStage(
+    ProgramType program_type) {
+    using Stage = Tegra::Engines::Maxwell3D::Regs::ShaderStage;
+    switch (program_type) {
+    case ProgramType::VertexA:
+    case ProgramType::VertexB:
+        return Stage::Vertex;
+    case ProgramType::Fragment:
+        return Stage::Fragment;
+    default:
+        // The Vulkan backend can't build geometry stages yet, MakePipelineShaderStage asserts
+        return {};
+    }
+}
+
+/// Decompiles a program to a SPIR-V module with its entry point. Returns an empty module when the
+/// stage isn't supported by the Vulkan decompiler.
+std::vector<u32> DecompileSpirv(const ShaderIR& ir, ProgramType program_type) {
+    const auto stage = GetVulkanStage(program_type);
+    if (!stage) {
+        return {};
+    }
+    // Decompile for the most restrictive device, the generated code is valid on every device
+    const Vulkan::VKShader::DeviceCapabilities capabilities;
+    auto [module, entries] = Vulkan::VKShader::Decompile(capabilities, ir, *stage);
+    return Vulkan::MakePipelineShaderStage(*stage, *module, entries).code;
+}
+
+void DumpSpirv(const Options& options, const std::string& name, const std::vector<u32>& code) {
+    WriteDump(options, name,
+              std::string_view(reinterpret_cast<const char*>(code.data()),
+                               code.size() * sizeof(u32)));
+}
+#endif
+
+/**
+ * Decodes and decompiles a shader of a transferable cache.
+ * @param options Command line options.
+ * @param device  Device the GLSL is generated for.
+ * @param raw     Shader to decompile.
+ * @returns The time spent on each stage.
+ */
+ShaderTimes ProcessShader(const Options& options, const OpenGL::Device& device,
+                          const ShaderDiskCacheRaw& raw) {
+    const ProgramType program_type = raw.GetProgramType();
+    const ProgramCode& code = raw.GetProgramCode();
+    const ProgramCode& code_b = raw.GetProgramCodeB();
+    const std::string name = fmt::format("{:016x}", raw.GetUniqueIdentifier());
+
+    ShaderTimes times;
+
+    std::optional<ShaderIR> ir;
+    std::optional<ShaderIR> ir_b;
+    times.ir = Measure([&] {
+        ir.emplace(code, GetMainOffset(program_type), OpenGL::CalculateProgramSize(code));
+        if (raw.HasProgramA()) {
+            ir_b.emplace(code_b, MAIN_OFFSET, OpenGL::CalculateProgramSize(code_b));
+        }
+    });
+
+    // Only the decompiler is timed, like for SPIR-V, the IR is shared by both
+    times.glsl = Measure([&] {
+        OpenGL::GLShader::Decompile(device, *ir, program_type, GetDecompileSuffix(program_type));
+        if (ir_b) {
+            OpenGL::GLShader::Decompile(device, *ir_b, ProgramType::VertexB, "vertex_b");
+        }
+    });
+
+    if (!options.dump_dir.empty()) {
+        // The dumped source is complete, with the headers and main function of the backend
+        const auto program = OpenGL::CreateProgram(device, program_type, code, code_b);
+        WriteDump(options, fmt::format("{}.{}", name, GetGlslExtension(program_type)),
+                  OpenGL::BuildShaderSource(program.first, program.second, program_type, {}));
+    }
+
+#ifdef HAS_VULKAN
+    std::vector<u32> spirv;
+    std::vector<u32> spirv_b;
+    times.spirv = Measure([&] {
+        spirv = DecompileSpirv(*ir, program_type);
+        if (ir_b) {
+            spirv_b = DecompileSpirv(*ir_b, ProgramType::VertexB);
+        }
+    });
+    if (spirv.empty()) {
+        times.spirv.reset();
+    } else {
+        DumpSpirv(options, name + ".spv", spirv);
+    }
+    if (!spirv_b.empty()) {
+        DumpSpirv(options, name + "_b.spv", spirv_b);
+    }
+#endif
+
+    return times;
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    const auto options = ParseOptions(argc, argv);
+    if (!options) {
+        PrintHelp(argv[0]);
+        return 1;
+    }
+
+    Log::Filter log_filter(Log::Level::Error);
+    Log::SetGlobalFilter(log_filter);
+    Log::AddBackend(std::make_unique<Log::ColorConsoleBackend>());
+
+    if (!options->dump_dir.empty() && !FileUtil::CreateFullPath(options->dump_dir + DIR_SEP)) {
+        std::cerr << "Failed to create " << options->dump_dir << '\n';
+        return 1;
+    }
+
+    const OpenGL::Device device(nullptr);
+
+    int result = 0;
+    std::size_t num_shaders = 0;
+    std::size_t num_spirv_unsupported = 0;
+    ShaderTimes total;
+    for (const auto& path : options->files) {
+        FileUtil::IOFile file(path, "rb");
+        u32 version{};
+        if (!file.IsOpen() || file.ReadBytes(&version, sizeof(version)) != sizeof(version)) {
+            std::cerr << "Failed to read " << path << '\n';
+            result = 1;
+            continue;
+        }
+        if (version != ShaderDiskCacheOpenGL::GetNativeVersion()) {
+            std::cerr << path << " has version " << version << ", expected "
+                      << ShaderDiskCacheOpenGL::GetNativeVersion() << '\n';
+            result = 1;
+            continue;
+        }
+        const auto entries = ShaderDiskCacheOpenGL::LoadTransferableEntries(file);
+        if (!entries) {
+            std::cerr << "Failed to load the entries of " << path << '\n';
+            result = 1;
+            continue;
+        }
+
+        std::cout << path << '\n';
+        for (const auto& raw : entries->first) {
+            if (!IsSupported(raw.GetProgramType())) {
+                continue;
+            }
+            const ShaderTimes times = ProcessShader(*options, device, raw);
+            const std::string spirv = times.spirv ? std::to_string(*times.spirv) : "-";
+            std::cout << fmt::format("  {:016x} {:<9} ir {:>7} us  glsl {:>7} us  spirv {:>7} us\n",
+                                     raw.GetUniqueIdentifier(), GetStageName(raw.GetProgramType()),
+                                     times.ir, times.glsl, spirv);
+            ++num_shaders;
+            total.ir += times.ir;
+            total.glsl += times.glsl;
+            if (times.spirv) {
+                total.spirv = total.spirv.value_or(0) + *times.spirv;
+            } else {
+                ++num_spirv_unsupported;
+            }
+        }
+    }
+
+    const std::string spirv = total.spirv ? std::to_string(*total.spirv) : "-";
+    std::cout << fmt::format(
+        "{} shaders ({} without SPIR-V), total ir {} us  glsl {} us  spirv {} us\n", num_shaders,
+        num_spirv_unsupported, total.ir, total.glsl, spirv);
+    return result;
+}
@@ -0,0 +1,349 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include <fmt/format.h>
+#include <json.hpp>
+#include "common/common_paths.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/string_util.h"
+#include "yuzu_tester/batch_runner.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <csignal>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Extra time given to a tester process to report a timeout itself before it is killed
+constexpr std::chrono::seconds KILL_GRACE_PERIOD{5};
+
+/// How often running tester processes are checked for exit or timeout
+constexpr std::chrono::milliseconds POLL_INTERVAL{10};
+
+double GetGuestMips(const TestRunReport& report) {
+    if (report.wall_time <= 0.0) {
+        return 0.0;
+    }
+    return static_cast<double>(report.guest_instructions.value_or(0)) / report.wall_time / 1e6;
+}
+
+nlohmann::json ToJson(const TestRunReport& report) {
+    nlohmann::json results = nlohmann::json::array();
+    for (const auto& result : report.results) {
+        results.push_back({{"name", result.name}, {"code", result.code}, {"data", result.data}});
+    }
+
+    nlohmann::json json{
+        {"path", report.path},
+        {"status", GetTestRunStatusName(report.status)},
+        {"wall_time", report.wall_time},
+        {"emulated_frames", report.emulated_frames},
+        {"results", std::move(results)},
+    };
+    if (report.guest_instructions) {
+        json["guest_instructions"] = *report.guest_instructions;
+        json["guest_mips"] = GetGuestMips(report);
+    }
+    return json;
+}
+
+bool WriteJson(const std::string& path, const nlohmann::json& json) {
+    FileUtil::IOFile file(path, "w");
+    if (!file.IsOpen()) {
+        LOG_ERROR(Frontend, "Failed to open {} for writing", path);
+        return false;
+    }
+
+    const std::string out = json.dump(4);
+    return file.WriteString(out) == out.size();
+}
+
+/// A tester process running a single test program
+struct RunningTest {
+    std::size_t index;
+    std::string report_path;
+    Clock::time_point start;
+    bool killed = false;
+#ifdef _WIN32
+    HANDLE process;
+#else
+    pid_t pid;
+#endif
+};
+
+std::vector<std::string> BuildArguments(const std::string& path, const std::string& report_path,
+                                        const BatchOptions& options) {
+    std::vector<std::string> args{options.executable, "--result-file", report_path};
+    if (options.timeout.count() != 0) {
+        args.emplace_back("--timeout");
+        args.emplace_back(std::to_string(options.timeout.count()));
+    }
+    if (!options.datastring.empty()) {
+        args.emplace_back("-d");
+        args.emplace_back(options.datastring);
+    }
+    args.push_back(path);
+    return args;
+}
+
+#ifdef _WIN32
+/// Quotes an argument the way CommandLineToArgvW parses it back. Backslashes are only special
+/// before a quote, where they have to be doubled.
+std::wstring QuoteArgument(const std::string& arg) {
+    std::wstring quoted = L"\"";
+    std::size_t num_backslashes = 0;
+    for (const wchar_t c : Common::UTF8ToUTF16W(arg)) {
+        if (c == L'\\') {
+            ++num_backslashes;
+        } else if (c == L'"') {
+            quoted.append(num_backslashes + 1, L'\\');
+            num_backslashes = 0;
+        } else {
+            num_backslashes = 0;
+        }
+        quoted += c;
+    }
+    // The closing quote must not be escaped by trailing backslashes
+    quoted.append(num_backslashes, L'\\');
+    return quoted + L"\"";
+}
+
+bool StartTest(RunningTest& test, const std::vector<std::string>& args) {
+    std::wstring command_line;
+    for (const auto& arg : args) {
+        command_line += QuoteArgument(arg) + L" ";
+    }
+
+    STARTUPINFOW startup_info{};
+    startup_info.cb = sizeof(startup_info);
+    PROCESS_INFORMATION process_info{};
+    if (!CreateProcessW(nullptr, command_line.data(), nullptr, nullptr, FALSE, 0, nullptr, nullptr,
+                        &startup_info, &process_info)) {
+        return false;
+    }
+    CloseHandle(process_info.hThread);
+    test.process = process_info.hProcess;
+    return true;
+}
+
+bool HasExited(RunningTest& test) {
+    if (WaitForSingleObject(test.process, 0) != WAIT_OBJECT_0) {
+        return false;
+    }
+    CloseHandle(test.process);
+    return true;
+}
+
+void Kill(RunningTest& test) {
+    TerminateProcess(test.process, 1);
+}
+#else
+bool StartTest(RunningTest& test, const std::vector<std::string>& args) {
+    std::vector<char*> argv;
+    for (const auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    const pid_t pid = fork();
+    if (pid < 0) {
+        return false;
+    }
+    if (pid == 0) {
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+    test.pid = pid;
+    return true;
+}
+
+bool HasExited(RunningTest& test) {
+    int status;
+    return waitpid(test.pid, &status, WNOHANG) == test.pid;
+}
+
+void Kill(RunningTest& test) {
+    kill(test.pid, SIGKILL);
+}
+#endif
+
+/// Builds the report of a finished tester process from what it reported itself
+TestRunReport CollectReport(const std::string& path, const RunningTest& test) {
+    const double wall_time = std::chrono::duration<double>(Clock::now() - test.start).count();
+
+    auto report = ReadTestRunReport(test.report_path);
+    FileUtil::Delete(test.report_path);
+    if (!report) {
+        report = TestRunReport{};
+        report->status = test.killed ? TestRunStatus::Timeout : TestRunStatus::Crashed;
+        report->wall_time = wall_time;
+    }
+    report->path = path;
+    return *report;
+}
+
+} // Anonymous namespace
+
+const char* GetTestRunStatusName(TestRunStatus status) {
+    switch (status) {
+    case TestRunStatus::Passed:
+        return "passed";
+    case TestRunStatus::Failed:
+        return "failed";
+    case TestRunStatus::Timeout:
+        return "timeout";
+    case TestRunStatus::Crashed:
+        return "crashed";
+    case TestRunStatus::LoadError:
+        return "load_error";
+    }
+    return "unknown";
+}
+
+bool WriteTestRunReport(const std::string& path, const TestRunReport& report) {
+    return WriteJson(path, ToJson(report));
+}
+
+std::optional<TestRunReport> ReadTestRunReport(const std::string& path) {
+    std::string contents;
+    if (FileUtil::ReadFileToString(true, path, contents) == 0) {
+        return std::nullopt;
+    }
+
+    const auto json = nlohmann::json::parse(contents, nullptr, false);
+    if (json.is_discarded()) {
+        LOG_ERROR(Frontend, "Invalid test report {}", path);
+        return std::nullopt;
+    }
+
+    TestRunReport report;
+    try {
+        report.path = json.at("path").get<std::string>();
+        const auto status_name = json.at("status").get<std::string>();
+        for (const auto status : {TestRunStatus::Passed, TestRunStatus::Failed,
+                                  TestRunStatus::Timeout, TestRunStatus::Crashed,
+                                  TestRunStatus::LoadError}) {
+            if (status_name == GetTestRunStatusName(status)) {
+                report.status = status;
+            }
+        }
+        report.wall_time = json.at("wall_time").get<double>();
+        report.emulated_frames = json.at("emulated_frames").get<u64>();
+        if (const auto it = json.find("guest_instructions"); it != json.end()) {
+            report.guest_instructions = it->get<u64>();
+        }
+        for (const auto& result : json.at("results")) {
+            report.results.push_back({result.at("code").get<u32>(),
+                                      result.at("data").get<std::string>(),
+                                      result.at("name").get<std::string>()});
+        }
+    } catch (const nlohmann::json::exception& e) {
+        LOG_ERROR(Frontend, "Invalid test report {}: {}", path, e.what());
+        return std::nullopt;
+    }
+    return report;
+}
+
+bool WriteBatchReport(const std::string& path, const std::vector<TestRunReport>& reports) {
+    nlohmann::json tests = nlohmann::json::array();
+    std::size_t passed = 0;
+    double wall_time = 0.0;
+    for (const auto& report : reports) {
+        tests.push_back(ToJson(report));
+        passed += report.status == TestRunStatus::Passed ? 1 : 0;
+        wall_time += report.wall_time;
+    }
+
+    const nlohmann::json json{
+        {"summary",
+         {{"total", reports.size()},
+          {"passed", passed},
+          {"failed", reports.size() - passed},
+          {"wall_time", wall_time}}},
+        {"tests", std::move(tests)},
+    };
+    return WriteJson(path, json);
+}
+
+void PrintBatchSummary(const std::vector<TestRunReport>& reports) {
+    std::size_t passed = 0;
+    for (const auto& report : reports) {
+        const std::string guest_mips = report.guest_instructions
+                                           ? fmt::format("{:.2f}", GetGuestMips(report))
+                                           : "-";
+        std::cout << fmt::format("{:<10} {:8.2f}s {:>8} frames {:>10} MIPS | {}",
+                                 GetTestRunStatusName(report.status), report.wall_time,
+                                 report.emulated_frames, guest_mips, report.path)
+                  << std::endl;
+        passed += report.status == TestRunStatus::Passed ? 1 : 0;
+    }
+
+    const std::size_t failed = reports.size() - passed;
+    std::cout << std::endl
+              << fmt::format("{:4d} Passed | {:4d} Failed | {:4d} Total", passed, failed,
+                             reports.size())
+              << std::endl
+              << (failed == 0 ? "PASSED" : "FAILED") << std::endl;
+}
+
+std::vector<TestRunReport> RunBatch(const std::vector<std::string>& paths,
+                                    const BatchOptions& options) {
+    const std::string report_dir =
+        FileUtil::GetUserPath(FileUtil::UserPath::CacheDir) + "tester" DIR_SEP;
+    FileUtil::CreateFullPath(report_dir);
+    const auto batch_id = Clock::now().time_since_epoch().count();
+
+    std::vector<TestRunReport> reports(paths.size());
+    std::vector<RunningTest> running;
+    std::size_t next = 0;
+
+    while (next < paths.size() || !running.empty()) {
+        while (next < paths.size() && running.size() < std::max<std::size_t>(options.jobs, 1)) {
+            RunningTest test;
+            test.index = next++;
+            test.report_path = fmt::format("{}{}_{}.json", report_dir, batch_id, test.index);
+            test.start = Clock::now();
+
+            LOG_INFO(Frontend, "Starting test {}", paths[test.index]);
+            if (!StartTest(test, BuildArguments(paths[test.index], test.report_path, options))) {
+                LOG_ERROR(Frontend, "Failed to start a tester process for {}", paths[test.index]);
+                reports[test.index].path = paths[test.index];
+                continue;
+            }
+            running.push_back(std::move(test));
+        }
+
+        std::this_thread::sleep_for(POLL_INTERVAL);
+
+        for (auto iter = running.begin(); iter != running.end();) {
+            if (HasExited(*iter)) {
+                reports[iter->index] = CollectReport(paths[iter->index], *iter);
+                iter = running.erase(iter);
+                continue;
+            }
+
+            // The tester enforces the budget itself, only kill processes stuck beyond it
+            if (options.timeout.count() != 0 && !iter->killed &&
+                Clock::now() - iter->start > options.timeout + KILL_GRACE_PERIOD) {
+                LOG_WARNING(Frontend, "Killing test {} after its time budget",
+                            paths[iter->index]);
+                Kill(*iter);
+                iter->killed = true;
+            }
+            ++iter;
+        }
+    }
+    return reports;
+}
@@ -0,0 +1,75 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+#include "common/common_types.h"
+#include "yuzu_tester/service/yuzutest.h"
+
+/// Outcome of running a single test program
+enum class TestRunStatus {
+    Passed,    ///< The program exited and all its tests passed
+    Failed,    ///< The program exited and at least one of its tests failed
+    Timeout,   ///< The program did not exit within its time budget
+    Crashed,   ///< The tester process running the program died without reporting
+    LoadError, ///< The program could not be loaded
+};
+
+/// Results and performance counters of a single test program
+struct TestRunReport {
+    std::string path;
+    TestRunStatus status = TestRunStatus::Crashed;
+    std::vector<Service::Yuzu::TestResult> results;
+    /// Walltime from loading the program until it exited, in seconds
+    double wall_time = 0.0;
+    /// System frames presented while the program ran
+    u64 emulated_frames = 0;
+    /// Guest CPU cycles spent outside of idle loops. The JIT charges one cycle per instruction.
+    /// Unknown under host timing, where cycles follow the host clock rather than the guest code.
+    std::optional<u64> guest_instructions;
+};
+
+struct BatchOptions {
+    /// Path of the tester executable the test programs are run with
+    std::string executable;
+    /// Data passed to the yuzutest service of every test program
+    std::string datastring;
+    /// Number of test programs run in parallel
+    std::size_t jobs = 1;
+    /// Time budget of a single test program, zero for none
+    std::chrono::seconds timeout{0};
+};
+
+const char* GetTestRunStatusName(TestRunStatus status);
+
+/**
+ * Writes the report of a test program run by a tester process, for the batch runner to collect.
+ * @returns true if the file was written successfully
+ */
+bool WriteTestRunReport(const std::string& path, const TestRunReport& report);
+
+/// Reads a report written with WriteTestRunReport, returns std::nullopt if it is missing or invalid
+std::optional<TestRunReport> ReadTestRunReport(const std::string& path);
+
+/**
+ * Writes the machine-readable report of a batch of test programs.
+ * @returns true if the file was written successfully
+ */
+bool WriteBatchReport(const std::string& path, const std::vector<TestRunReport>& reports);
+
+/// Prints a human readable summary of a batch of test programs
+void PrintBatchSummary(const std::vector<TestRunReport>& reports);
+
+/**
+ * Runs every test program in its own tester process, so that each gets a fresh Core::System.
+ * Processes exceeding their time budget are killed.
+ * @param paths Paths of the test programs
+ * @returns the reports of the test programs, in the order of paths
+ */
+std::vector<TestRunReport> RunBatch(const std::vector<std::string>& paths,
+                                    const BatchOptions& options);
@@ -2,10 +2,14 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <fmt/ostream.h>
 
@@ -21,13 +25,16 @@
 #include "common/string_util.h"
 #include "common/telemetry.h"
 #include "core/core.h"
+#include "core/core_timing.h"
 #include "core/crypto/key_manager.h"
 #include "core/file_sys/vfs_real.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/loader/loader.h"
+#include "core/perf_stats.h"
 #include "core/settings.h"
 #include "core/telemetry_session.h"
 #include "video_core/renderer_base.h"
+#include "yuzu_tester/batch_runner.h"
 #include "yuzu_tester/config.h"
 #include "yuzu_tester/emu_window/emu_window_sdl2_hide.h"
 #include "yuzu_tester/service/yuzutest.h"
@@ -56,12 +63,16 @@ __declspec(dllexport) int AmdPowerXpressRequestHighPerformance = 1;
 
 static void PrintHelp(const char* argv0) {
     std::cout << "Usage: " << argv0
-              << " [options] <filename>\n"
+              << " [options] <filename>...\n"
                  "-h, --help            Display this help and exit\n"
                  "-v, --version         Output version information and exit\n"
                  "-d, --datastring      Pass following string as data to test service command #2\n"
                  "-l, --log             Log to console in addition to file (will log to file only "
-                 "by default)\n";
+                 "by default)\n"
+                 "-j, --jobs=N          Run up to N test programs in parallel\n"
+                 "-t, --timeout=SECONDS Fail test programs that run longer than SECONDS\n"
+                 "-r, --report=FILE     Write a JSON report of all test programs to FILE\n"
+                 "Passing several files or a directory runs every .nro file in its own process.\n";
 }
 
 static void PrintVersion() {
@@ -69,7 +80,7 @@ static void PrintVersion() {
               << std::endl;
 }
 
-static void InitializeLogging(bool console) {
+static void InitializeLogging(bool console, const std::string& log_file) {
     Log::Filter log_filter(Log::Level::Debug);
     log_filter.ParseFilterString(Settings::values.log_filter);
     Log::SetGlobalFilter(log_filter);
@@ -79,12 +90,38 @@ static void InitializeLogging(bool console) {
 
     const std::string& log_dir = FileUtil::GetUserPath(FileUtil::UserPath::LogDir);
     FileUtil::CreateFullPath(log_dir);
-    Log::AddBackend(std::make_unique<Log::FileBackend>(log_dir + LOG_FILE));
+    Log::AddBackend(std::make_unique<Log::FileBackend>(log_dir + log_file));
 #ifdef _WIN32
     Log::AddBackend(std::make_unique<Log::DebuggerBackend>());
 #endif
 }
 
+/// Expands directories to the test programs they contain
+static std::vector<std::string> ExpandTestPaths(const std::vector<std::string>& paths) {
+    std::vector<std::string> expanded;
+    for (const auto& path : paths) {
+        if (!FileUtil::IsDirectory(path)) {
+            expanded.push_back(path);
+            continue;
+        }
+
+        const std::size_t first = expanded.size();
+        FileUtil::ForeachDirectoryEntry(
+            nullptr, path,
+            [&expanded](u64*, const std::string& directory, const std::string& virtual_name) {
+                const std::string entry = directory + DIR_SEP + virtual_name;
+                if (!FileUtil::IsDirectory(entry) &&
+                    Common::ToLower(std::string(FileUtil::GetExtensionFromFilename(
+                        virtual_name))) == "nro") {
+                    expanded.push_back(entry);
+                }
+                return true;
+            });
+        std::sort(expanded.begin() + first, expanded.end());
+    }
+    return expanded;
+}
+
 /// Application entry point
 int main(int argc, char** argv) {
     Common::DetachedTasks detached_tasks;
@@ -101,21 +138,30 @@ int main(int argc, char** argv) {
         return -1;
     }
 #endif
-    std::string filepath;
+    std::vector<std::string> filepaths;
 
     static struct option long_options[] = {
         {"help", no_argument, 0, 'h'},
         {"version", no_argument, 0, 'v'},
         {"datastring", optional_argument, 0, 'd'},
         {"log", no_argument, 0, 'l'},
+        {"jobs", required_argument, 0, 'j'},
+        {"timeout", required_argument, 0, 't'},
+        {"report", required_argument, 0, 'r'},
+        // Used by the batch runner to collect the report of a single test program
+        {"result-file", required_argument, 0, 'o'},
         {0, 0, 0, 0},
     };
 
     bool console_log = false;
     std::string datastring;
+    std::size_t jobs = 0;
+    std::chrono::seconds timeout{0};
+    std::string report_file;
+    std::string result_file;
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "hvdl::", long_options, &option_index);
+        int arg = getopt_long(argc, argv, "hvdlj:t:r:o:", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
             case 'h':
@@ -131,33 +177,79 @@ int main(int argc, char** argv) {
             case 'l':
                 console_log = true;
                 break;
+            case 'j':
+                jobs = std::strtoul(optarg, nullptr, 0);
+                break;
+            case 't':
+                timeout = std::chrono::seconds{std::strtoul(optarg, nullptr, 0)};
+                break;
+            case 'r':
+                report_file = optarg;
+                break;
+            case 'o':
+                result_file = optarg;
+                break;
             }
         } else {
 #ifdef _WIN32
-            filepath = Common::UTF16ToUTF8(argv_w[optind]);
+            filepaths.push_back(Common::UTF16ToUTF8(argv_w[optind]));
 #else
-            filepath = argv[optind];
+            filepaths.push_back(argv[optind]);
 #endif
             optind++;
         }
     }
 
-    InitializeLogging(console_log);
-
 #ifdef _WIN32
+    const std::string executable = Common::UTF16ToUTF8(argv_w[0]);
     LocalFree(argv_w);
+#else
+    const std::string executable = argv[0];
 #endif
 
-    MicroProfileOnThreadCreate("EmuThread");
-    SCOPE_EXIT({ MicroProfileShutdown(); });
+    filepaths = ExpandTestPaths(filepaths);
+    const bool is_batch = result_file.empty() &&
+                          (filepaths.size() > 1 || jobs != 0 || !report_file.empty());
+
+    // Tester processes started by the batch runner log to a file of their own
+    InitializeLogging(console_log,
+                      result_file.empty() || filepaths.empty()
+                          ? LOG_FILE
+                          : std::string(FileUtil::GetFilename(filepaths.front())) + ".log");
 
-    if (filepath.empty()) {
+    if (filepaths.empty()) {
         LOG_CRITICAL(Frontend, "Failed to load application: No application specified");
         std::cout << "Failed to load application: No application specified" << std::endl;
         PrintHelp(argv[0]);
         return -1;
     }
 
+    if (is_batch) {
+        BatchOptions options;
+        options.executable = executable;
+        options.datastring = datastring;
+        options.jobs = std::max<std::size_t>(jobs, 1);
+        options.timeout = timeout;
+
+        const auto reports = RunBatch(filepaths, options);
+        PrintBatchSummary(reports);
+        if (!report_file.empty() && !WriteBatchReport(report_file, reports)) {
+            std::cout << "Failed to write report to " << report_file << std::endl;
+            return -1;
+        }
+
+        const bool passed =
+            std::all_of(reports.begin(), reports.end(), [](const TestRunReport& report) {
+                return report.status == TestRunStatus::Passed;
+            });
+        return passed ? 0 : -1;
+    }
+
+    const std::string filepath = filepaths.front();
+
+    MicroProfileOnThreadCreate("EmuThread");
+    SCOPE_EXIT({ MicroProfileShutdown(); });
+
     Settings::values.use_gdbstub = false;
     Settings::Apply();
 
@@ -170,10 +262,20 @@ int main(int argc, char** argv) {
 
     bool finished = false;
     int return_value = 0;
-    const auto callback = [&finished,
-                           &return_value](std::vector<Service::Yuzu::TestResult> results) {
+    std::vector<Service::Yuzu::TestResult> test_results;
+    const auto callback = [&finished, &return_value, &test_results,
+                           &result_file](std::vector<Service::Yuzu::TestResult> results) {
         finished = true;
         return_value = 0;
+        test_results = results;
+
+        if (!result_file.empty()) {
+            const bool all_passed =
+                std::all_of(results.begin(), results.end(),
+                            [](const Service::Yuzu::TestResult& res) { return res.code == 0; });
+            return_value = all_passed ? 0 : -1;
+            return;
+        }
 
         // Find the minimum length needed to fully enclose all test names (and the header field) in
         // the fmt::format column by first finding the maximum size of any test name and comparing
@@ -221,8 +323,16 @@ int main(int argc, char** argv) {
 
     SCOPE_EXIT({ system.Shutdown(); });
 
+    const auto start_time = std::chrono::steady_clock::now();
     const Core::System::ResultStatus load_result{system.Load(*emu_window, filepath)};
 
+    if (!result_file.empty() && load_result != Core::System::ResultStatus::Success) {
+        TestRunReport report;
+        report.path = filepath;
+        report.status = TestRunStatus::LoadError;
+        WriteTestRunReport(result_file, report);
+    }
+
     switch (load_result) {
     case Core::System::ResultStatus::ErrorGetLoader:
         LOG_CRITICAL(Frontend, "Failed to obtain loader for {}!", filepath);
@@ -257,8 +367,35 @@ int main(int argc, char** argv) {
 
     system.Renderer().Rasterizer().LoadDiskResources();
 
+    bool timed_out = false;
     while (!finished) {
         system.RunLoop();
+
+        if (timeout.count() != 0 && std::chrono::steady_clock::now() - start_time > timeout) {
+            LOG_CRITICAL(Frontend, "{} did not finish within {} seconds", filepath,
+                         timeout.count());
+            timed_out = true;
+            return_value = -1;
+            break;
+        }
+    }
+
+    if (!result_file.empty()) {
+        const auto& core_timing = system.CoreTiming();
+
+        TestRunReport report;
+        report.path = filepath;
+        report.status = timed_out ? TestRunStatus::Timeout
+                                  : (return_value == 0 ? TestRunStatus::Passed
+                                                       : TestRunStatus::Failed);
+        report.results = std::move(test_results);
+        report.wall_time =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        report.emulated_frames = system.GetPerfStats().GetTotalSystemFrames();
+        if (!core_timing.IsHostTiming()) {
+            report.guest_instructions = core_timing.GetTicks() - core_timing.GetIdleTicks();
+        }
+        WriteTestRunReport(result_file, report);
     }
 
     detached_tasks.WaitForAllTasks();